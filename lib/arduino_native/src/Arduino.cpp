@@ -0,0 +1,307 @@
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <ctype.h>
+
+// =====================================================
+// VIRTUAL CLOCK
+// =====================================================
+static uint64_t clockMicros = 0;
+static NativeClockHook clockHook = nullptr;
+static uint64_t clockStopAt = UINT64_MAX;
+
+uint64_t nativeClockMicros()
+{
+    return clockMicros;
+}
+
+void nativeClockAdvance(uint64_t us)
+{
+    uint64_t target = clockMicros + us;
+    // A hook may advance the clock itself (delay() in a callback)
+    while (clockStopAt <= target && clockMicros < target)
+    {
+        clockMicros = std::max(clockMicros, clockStopAt);
+        clockStopAt = UINT64_MAX;
+        if (clockHook)
+            clockHook(clockMicros);
+    }
+    clockMicros = std::max(clockMicros, target);
+    if (clockHook)
+        clockHook(clockMicros);
+}
+
+void nativeClockScheduleHook(uint64_t atUs)
+{
+    clockStopAt = atUs;
+}
+
+void nativeClockSetHook(NativeClockHook hook)
+{
+    clockHook = hook;
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(clockMicros / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)clockMicros;
+}
+
+void delay(unsigned long ms)
+{
+    nativeClockAdvance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    nativeClockAdvance(us);
+}
+
+void yield()
+{
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// =====================================================
+// SERIAL / ESP
+// =====================================================
+HardwareSerial Serial;
+EspClass ESP;
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (!muted)
+        fputc(c, stdout);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t size)
+{
+    if (!muted)
+        fwrite(buf, 1, size, stdout);
+    return size;
+}
+
+void EspClass::restart()
+{
+    fflush(stdout);
+    fprintf(stderr, "ESP.restart() requested at %lu ms\n", millis());
+    exit(3);
+}
+
+// =====================================================
+// PRINT
+// =====================================================
+size_t Print::write(const uint8_t *buf, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+        n += write(*buf++);
+    return n;
+}
+
+size_t Print::write(const char *s)
+{
+    if (!s)
+        return 0;
+    return write((const uint8_t *)s, strlen(s));
+}
+
+size_t Print::print(long v, int base)
+{
+    char buf[40];
+    if (base == HEX)
+        snprintf(buf, sizeof(buf), "%lX", (unsigned long)v);
+    else
+        snprintf(buf, sizeof(buf), "%ld", v);
+    return write(buf);
+}
+
+size_t Print::print(unsigned long v, int base)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+    return write(buf);
+}
+
+size_t Print::print(double v, int digits)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return write(buf);
+}
+
+size_t Print::printf(const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len < 0)
+        return 0;
+    return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+}
+
+// =====================================================
+// STRING
+// =====================================================
+static std::string formatInteger(long long v, unsigned char base)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), base == 16 ? "%llx" : "%lld", v);
+    return buf;
+}
+
+static std::string formatUnsigned(unsigned long long v, unsigned char base)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), base == 16 ? "%llx" : "%llu", v);
+    return buf;
+}
+
+static std::string formatFloat(double v, unsigned char decimals)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+}
+
+String::String(int v, unsigned char base) : str(formatInteger(v, base)) {}
+String::String(unsigned int v, unsigned char base) : str(formatUnsigned(v, base)) {}
+String::String(long v, unsigned char base) : str(formatInteger(v, base)) {}
+String::String(unsigned long v, unsigned char base) : str(formatUnsigned(v, base)) {}
+String::String(float v, unsigned char decimals) : str(formatFloat(v, decimals)) {}
+String::String(double v, unsigned char decimals) : str(formatFloat(v, decimals)) {}
+
+bool String::equalsIgnoreCase(const String &rhs) const
+{
+    if (str.size() != rhs.str.size())
+        return false;
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        if (tolower((unsigned char)str[i]) != tolower((unsigned char)rhs.str[i]))
+            return false;
+    }
+    return true;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+    if (suffix.str.size() > str.size())
+        return false;
+    return str.compare(str.size() - suffix.str.size(), suffix.str.size(), suffix.str) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t pos = str.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String &s, unsigned int from) const
+{
+    size_t pos = str.find(s.str, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int begin) const
+{
+    if (begin >= str.size())
+        return String();
+    return String(str.substr(begin));
+}
+
+String String::substring(unsigned int begin, unsigned int end) const
+{
+    if (begin > end)
+        std::swap(begin, end);
+    if (begin >= str.size())
+        return String();
+    return String(str.substr(begin, end - begin));
+}
+
+void String::trim()
+{
+    size_t first = 0;
+    while (first < str.size() && isspace((unsigned char)str[first]))
+        first++;
+    size_t last = str.size();
+    while (last > first && isspace((unsigned char)str[last - 1]))
+        last--;
+    str = str.substr(first, last - first);
+}
+
+void String::toLowerCase()
+{
+    for (char &c : str)
+        c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase()
+{
+    for (char &c : str)
+        c = (char)toupper((unsigned char)c);
+}
+
+long String::toInt() const
+{
+    return strtol(str.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const
+{
+    return strtof(str.c_str(), nullptr);
+}
+
+double String::toDouble() const
+{
+    return strtod(str.c_str(), nullptr);
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const
+{
+    if (!buf || bufsize == 0)
+        return;
+    size_t n = 0;
+    if (index < str.size())
+        n = std::min((size_t)bufsize - 1, str.size() - index);
+    memcpy(buf, str.c_str() + std::min((size_t)index, str.size()), n);
+    buf[n] = '\0';
+}
+
+String operator+(const String &lhs, const String &rhs)
+{
+    String r(lhs);
+    r += rhs;
+    return r;
+}
+
+String operator+(const String &lhs, const char *rhs)
+{
+    String r(lhs);
+    r += rhs;
+    return r;
+}
+
+String operator+(const char *lhs, const String &rhs)
+{
+    String r(lhs);
+    r += rhs;
+    return r;
+}
+
+String operator+(const String &lhs, char rhs)
+{
+    String r(lhs);
+    r += rhs;
+    return r;
+}
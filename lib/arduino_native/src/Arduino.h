@@ -0,0 +1,82 @@
+#ifndef ST_NATIVE_ARDUINO_H
+#define ST_NATIVE_ARDUINO_H
+
+// Host stand-in for the Arduino core. Time is virtual: millis()/micros()
+// only move when delay() is called or the host driver advances the clock,
+// so the tracker runs as fast as the host CPU allows.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <cmath>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+
+using std::abs;
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define PGM_P const char *
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define HIGH 1
+#define LOW 0
+
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Virtual clock control for host drivers. The hook runs after every
+// advance so fakes can fire their timers.
+typedef void (*NativeClockHook)(uint64_t nowUs);
+uint64_t nativeClockMicros();
+void nativeClockAdvance(uint64_t us);
+void nativeClockSetHook(NativeClockHook hook);
+// Next advance stops at atUs and calls the hook there (one pending stop)
+void nativeClockScheduleHook(uint64_t atUs);
+
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void setMuted(bool m) { muted = m; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    using Print::write;
+
+private:
+    bool muted = false;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass
+{
+public:
+    void restart();
+    uint32_t getFreeHeap() { return 200000; }
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef ST_NATIVE_ESP32SERVO_H
+#define ST_NATIVE_ESP32SERVO_H
+
+#include "Arduino.h"
+
+// Servo stand-in, the native HAL records positions itself
+class Servo
+{
+public:
+    int attach(int pin)
+    {
+        (void)pin;
+        return 0;
+    }
+    int attach(int pin, int minUs, int maxUs)
+    {
+        (void)pin;
+        (void)minUs;
+        (void)maxUs;
+        return 0;
+    }
+    void write(int value) { lastValue = value; }
+    void writeMicroseconds(int value) { lastValue = value; }
+    int read() { return lastValue; }
+
+private:
+    int lastValue = 90;
+};
+
+#endif
@@ -0,0 +1,289 @@
+#include <strings.h>
+#include "ESPAsyncWebServer.h"
+
+bool AsyncChunkedResponse::fill(size_t maxLen)
+{
+    std::string buf(maxLen, '\0');
+    size_t n = filler((uint8_t *)&buf[0], maxLen, index);
+    if (n == RESPONSE_TRY_AGAIN)
+        return true;
+    if (n == 0)
+        return false;
+    body.append(buf, 0, n);
+    index += n;
+    return true;
+}
+
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethodComposite method, const String &url,
+                                             const std::map<std::string, std::string> &args,
+                                             const std::map<std::string, std::string> &headerMap)
+    : requestMethod(method), requestUrl(url), args(args)
+{
+    for (const auto &h : headerMap)
+        headers.push_back(new AsyncWebHeader(String(h.first), String(h.second)));
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest()
+{
+    delete response;
+    for (AsyncWebHeader *h : headers)
+        delete h;
+}
+
+AsyncWebHeader *AsyncWebServerRequest::getHeader(const String &name) const
+{
+    for (AsyncWebHeader *h : headers)
+    {
+        if (strcasecmp(h->name().c_str(), name.c_str()) == 0)
+            return h;
+    }
+    return nullptr;
+}
+
+void AsyncWebServerRequest::pruneHeaders()
+{
+    std::vector<AsyncWebHeader *> kept;
+    for (AsyncWebHeader *h : headers)
+    {
+        bool wanted = false;
+        for (const std::string &name : interesting)
+            wanted = wanted || strcasecmp(name.c_str(), "ANY") == 0 || strcasecmp(name.c_str(), h->name().c_str()) == 0;
+        if (wanted)
+            kept.push_back(h);
+        else
+            delete h;
+    }
+    headers = kept;
+}
+
+String AsyncWebServerRequest::arg(const char *name) const
+{
+    auto it = args.find(name);
+    return it == args.end() ? String() : String(it->second);
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content)
+{
+    send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *r)
+{
+    delete response;
+    response = r;
+    streaming = dynamic_cast<AsyncChunkedResponse *>(r) != nullptr;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType, const String &content)
+{
+    AsyncWebServerResponse *r = new AsyncWebServerResponse(code, contentType);
+    r->body = content.c_str();
+    return r;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse_P(int code, const String &contentType,
+                                                               const uint8_t *content, size_t len)
+{
+    AsyncWebServerResponse *r = new AsyncWebServerResponse(code, contentType);
+    r->body.assign((const char *)content, len);
+    return r;
+}
+
+AsyncResponseStream *AsyncWebServerRequest::beginResponseStream(const String &contentType, size_t bufferSize)
+{
+    (void)bufferSize;
+    return new AsyncResponseStream(contentType);
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginChunkedResponse(const String &contentType, AwsResponseFiller callback)
+{
+    return new AsyncChunkedResponse(contentType, callback);
+}
+
+// Same matching as the library's callback handler
+class CallbackHandler : public AsyncWebHandler
+{
+public:
+    CallbackHandler(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction fn)
+        : uri(uri), method(method), fn(fn) {}
+    bool canHandle(AsyncWebServerRequest *request) override
+    {
+        if (!(method & request->method()))
+            return false;
+        std::string url = request->url().c_str();
+        return url == uri || url.compare(0, uri.size() + 1, uri + "/") == 0;
+    }
+    void handleRequest(AsyncWebServerRequest *request) override { fn(request); }
+
+private:
+    std::string uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction fn;
+};
+
+void AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction fn)
+{
+    owned.emplace_back(new CallbackHandler(uri, method, fn));
+    handlers.push_back(owned.back().get());
+}
+
+AsyncWebHandler &AsyncWebServer::addHandler(AsyncWebHandler *handler)
+{
+    handlers.push_back(handler);
+    return *handler;
+}
+
+static void closeConnection(std::shared_ptr<AsyncWebServerRequest> &req)
+{
+    if (req && req->disconnectHandler)
+    {
+        ArDisconnectHandler fn = req->disconnectHandler;
+        req->disconnectHandler = nullptr;
+        fn();
+    }
+}
+
+int AsyncWebServer::request(WebRequestMethodComposite method, const String &uri,
+                            const std::map<std::string, std::string> &args,
+                            const std::map<std::string, std::string> &headers)
+{
+    // A finished response closes its connection before the next one opens
+    if (last != stream)
+        closeConnection(last);
+
+    // Query string is not part of url(), as on the board
+    String path = uri;
+    int q = path.indexOf('?');
+    if (q >= 0)
+        path = path.substring(0, q);
+
+    last = std::make_shared<AsyncWebServerRequest>(method, path, args, headers);
+    AsyncWebHandler *handler = nullptr;
+    for (AsyncWebHandler *h : handlers)
+    {
+        if (h->canHandle(last.get()))
+        {
+            handler = h;
+            break;
+        }
+    }
+    // Headers nobody asked for are gone by the time the handler runs
+    last->pruneHeaders();
+
+    if (handler)
+        handler->handleRequest(last.get());
+    else if (notFound)
+        notFound(last.get());
+
+    if (last->streaming)
+        stream = last;
+    return responseCode();
+}
+
+int AsyncWebServer::responseCode() const
+{
+    return last && last->response ? last->response->code : 0;
+}
+
+const std::string &AsyncWebServer::responseBody() const
+{
+    static const std::string empty;
+    return last && last->response ? last->response->body : empty;
+}
+
+String AsyncWebServer::responseType() const
+{
+    return last && last->response ? last->response->contentType : String();
+}
+
+String AsyncWebServer::responseHeader(const char *name) const
+{
+    if (!last || !last->response)
+        return String();
+    auto it = last->response->headers.find(name);
+    return it == last->response->headers.end() ? String() : String(it->second);
+}
+
+bool AsyncWebServer::pump(size_t maxLen)
+{
+    if (!stream)
+        return false;
+    if (stream->response->fill(maxLen))
+        return true;
+    closeConnection(stream);
+    stream.reset();
+    return false;
+}
+
+void AsyncWebServer::disconnect()
+{
+    if (stream)
+    {
+        closeConnection(stream);
+        stream.reset();
+    }
+    else
+    {
+        closeConnection(last);
+    }
+}
+
+// SSE framing as the library writes it
+static std::string formatEvent(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+    std::string out;
+    if (reconnect)
+        out += "retry: " + std::to_string(reconnect) + "\r\n";
+    if (id)
+        out += "id: " + std::to_string(id) + "\r\n";
+    if (event)
+        out += std::string("event: ") + event + "\r\n";
+    if (message)
+        out += std::string("data: ") + message + "\r\n";
+    out += "\r\n";
+    return out;
+}
+
+void AsyncEventSourceClient::send(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+    if (!open)
+        return;
+    received.push_back({event ? event : "", message ? message : "", id});
+    bytes += formatEvent(message, event, id, reconnect).size();
+    if (id)
+        last = id;
+}
+
+void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect)
+{
+    broadcasts++;
+    for (auto &c : clients)
+        c->send(message, event, id, reconnect);
+}
+
+size_t AsyncEventSource::count() const
+{
+    size_t n = 0;
+    for (const auto &c : clients)
+        n += c->connected() ? 1 : 0;
+    return n;
+}
+
+void AsyncEventSource::close()
+{
+    for (auto &c : clients)
+        c->close();
+}
+
+bool AsyncEventSource::canHandle(AsyncWebServerRequest *request)
+{
+    return request->method() == HTTP_GET && url == request->url().c_str();
+}
+
+void AsyncEventSource::handleRequest(AsyncWebServerRequest *request)
+{
+    request->send(200, "text/event-stream");
+    clients.emplace_back(new AsyncEventSourceClient());
+    if (connectHandler)
+        connectHandler(clients.back().get());
+}
@@ -0,0 +1,237 @@
+#ifndef ST_NATIVE_ESPASYNCWEBSERVER_H
+#define ST_NATIVE_ESPASYNCWEBSERVER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+// ESPAsyncWebServer stand-in. There is no TCP stack; host drivers call
+// request() to run a registered handler, like a new connection would on
+// the async_tcp task. Streamed (chunked) responses stay open until the
+// driver pulls them with pump(), so loop() can run in between.
+
+enum WebRequestMethod
+{
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111
+};
+typedef uint8_t WebRequestMethodComposite;
+
+// Filler result: nothing to send yet, call again later
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+class AsyncWebServerRequest;
+
+class AsyncWebHeader
+{
+public:
+    AsyncWebHeader(const String &name, const String &value) : headerName(name), headerValue(value) {}
+    const String &name() const { return headerName; }
+    const String &value() const { return headerValue; }
+
+private:
+    String headerName;
+    String headerValue;
+};
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(void)> ArDisconnectHandler;
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+
+class AsyncWebServerResponse
+{
+public:
+    AsyncWebServerResponse(int code, const String &contentType) : code(code), contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() {}
+    void setCode(int c) { code = c; }
+    void addHeader(const String &name, const String &value) { headers[name.c_str()] = value.c_str(); }
+
+    // Native only
+    int code;
+    String contentType;
+    std::string body;
+    std::map<std::string, std::string> headers;
+    // Appends up to maxLen bytes to body; false once the response is complete
+    virtual bool fill(size_t maxLen)
+    {
+        (void)maxLen;
+        return false;
+    }
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print
+{
+public:
+    explicit AsyncResponseStream(const String &contentType) : AsyncWebServerResponse(200, contentType) {}
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        body.append((const char *)buf, size);
+        return size;
+    }
+    using Print::write;
+};
+
+class AsyncChunkedResponse : public AsyncWebServerResponse
+{
+public:
+    AsyncChunkedResponse(const String &contentType, AwsResponseFiller filler)
+        : AsyncWebServerResponse(200, contentType), filler(filler) {}
+    bool fill(size_t maxLen) override;
+
+private:
+    AwsResponseFiller filler;
+    size_t index = 0;
+};
+
+class AsyncWebServerRequest
+{
+public:
+    AsyncWebServerRequest(WebRequestMethodComposite method, const String &url,
+                          const std::map<std::string, std::string> &args,
+                          const std::map<std::string, std::string> &headers);
+    ~AsyncWebServerRequest();
+
+    // GET and POST parameters alike
+    bool hasArg(const char *name) const { return args.count(name) > 0; }
+    String arg(const char *name) const;
+    const String &url() const { return requestUrl; }
+    WebRequestMethodComposite method() const { return requestMethod; }
+    // The library drops headers no handler asked for in canHandle()
+    void addInterestingHeader(const String &name) { interesting.push_back(name.c_str()); }
+    bool hasHeader(const String &name) const { return getHeader(name) != nullptr; }
+    AsyncWebHeader *getHeader(const String &name) const;
+
+    void send(int code, const String &contentType = String(), const String &content = String());
+    void send_P(int code, const String &contentType, PGM_P content) { send(code, contentType, String(content)); }
+    void send(AsyncWebServerResponse *r);
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(), const String &content = String());
+    AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content, size_t len);
+    AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460);
+    AsyncWebServerResponse *beginChunkedResponse(const String &contentType, AwsResponseFiller callback);
+    void onDisconnect(ArDisconnectHandler fn) { disconnectHandler = fn; }
+
+    // Native only
+    void pruneHeaders();
+    AsyncWebServerResponse *response = nullptr;
+    ArDisconnectHandler disconnectHandler;
+    bool streaming = false;
+
+private:
+    WebRequestMethodComposite requestMethod;
+    String requestUrl;
+    std::map<std::string, std::string> args;
+    std::vector<AsyncWebHeader *> headers;
+    std::vector<std::string> interesting;
+};
+
+class AsyncWebHandler
+{
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *request)
+    {
+        (void)request;
+        return false;
+    }
+    virtual void handleRequest(AsyncWebServerRequest *request) { (void)request; }
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+// Server-sent events. A GET on the source's URL connects a client; host
+// drivers read what each client received through client(i).
+struct AsyncEventMessage
+{
+    std::string event;
+    std::string data;
+    uint32_t id;
+};
+
+class AsyncEventSourceClient
+{
+public:
+    void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    uint32_t lastId() const { return last; }
+    bool connected() const { return open; }
+    void close() { open = false; }
+
+    // Native only
+    std::vector<AsyncEventMessage> received;
+    size_t bytes = 0; // on the wire, SSE framing included
+
+private:
+    uint32_t last = 0;
+    bool open = true;
+};
+
+class AsyncEventSource;
+typedef std::function<void(AsyncEventSourceClient *client)> ArEventHandlerFunction;
+
+class AsyncEventSource : public AsyncWebHandler
+{
+public:
+    explicit AsyncEventSource(const String &url) : url(url.c_str()) {}
+    void onConnect(ArEventHandlerFunction cb) { connectHandler = cb; }
+    void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+    size_t count() const;
+    void close();
+    bool canHandle(AsyncWebServerRequest *request) override;
+    void handleRequest(AsyncWebServerRequest *request) override;
+
+    // Native only
+    size_t clientCount() const { return clients.size(); } // including closed ones
+    AsyncEventSourceClient &client(size_t i) { return *clients[i]; }
+    uint32_t broadcasts = 0; // send() calls, one formatted message each
+
+private:
+    std::string url;
+    ArEventHandlerFunction connectHandler;
+    std::vector<std::unique_ptr<AsyncEventSourceClient>> clients;
+};
+
+class AsyncWebServer
+{
+public:
+    explicit AsyncWebServer(uint16_t port) { (void)port; }
+
+    void begin() {}
+    void on(const char *uri, ArRequestHandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+    void on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction fn);
+    void onNotFound(ArRequestHandlerFunction fn) { notFound = fn; }
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler);
+
+    // Native only: dispatch a request on a new connection and inspect the
+    // response. A streamed response keeps its connection open. Handlers
+    // are asked in registration order; like the library, on("/geo") also
+    // takes "/geo/..." unless an earlier handler claimed it.
+    int request(WebRequestMethodComposite method, const String &uri,
+                const std::map<std::string, std::string> &args = {},
+                const std::map<std::string, std::string> &headers = {});
+    int responseCode() const;
+    const std::string &responseBody() const;
+    String responseType() const;
+    String responseHeader(const char *name) const;
+    // Pulls up to maxLen bytes (one TCP window) from the last streamed
+    // response; false once it is complete or the connection is gone
+    bool pump(size_t maxLen = 1460);
+    // Client closes the open streamed connection (else the last one)
+    void disconnect();
+
+private:
+    std::vector<std::unique_ptr<AsyncWebHandler>> owned; // from on()
+    std::vector<AsyncWebHandler *> handlers;
+    ArRequestHandlerFunction notFound;
+    std::shared_ptr<AsyncWebServerRequest> last;   // last request, for the response accessors
+    std::shared_ptr<AsyncWebServerRequest> stream; // streamed response still being sent
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include "LittleFS.h"
+
+#include <sys/stat.h>
+#include <dirent.h>
+
+LittleFSFS LittleFS;
+
+static const char *fsRoot()
+{
+    const char *root = getenv("ST_FS_ROOT");
+    return (root && *root) ? root : ".native_fs";
+}
+
+// =====================================================
+// FILE
+// =====================================================
+File::File(FILE *f, const char *p) : handle(f, [](FILE *fp) { fclose(fp); }), path(p)
+{
+}
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    if (!handle)
+        return 0;
+    size_t n = fwrite(buf, 1, size, handle.get());
+    LittleFS.noteWrite(n);
+    return n;
+}
+
+int File::available()
+{
+    if (!handle)
+        return 0;
+    return (int)(size() - position());
+}
+
+int File::read()
+{
+    if (!handle)
+        return -1;
+    return fgetc(handle.get());
+}
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+    if (!handle)
+        return 0;
+    return fread(buf, 1, size, handle.get());
+}
+
+int File::peek()
+{
+    if (!handle)
+        return -1;
+    int c = fgetc(handle.get());
+    if (c != EOF)
+        ungetc(c, handle.get());
+    return c;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    if (!handle)
+        return false;
+    int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(handle.get(), (long)pos, whence) == 0;
+}
+
+size_t File::position() const
+{
+    if (!handle)
+        return 0;
+    return (size_t)ftell(handle.get());
+}
+
+size_t File::size() const
+{
+    if (!handle)
+        return 0;
+    struct stat st;
+    fflush(handle.get());
+    if (fstat(fileno(handle.get()), &st) != 0)
+        return 0;
+    return (size_t)st.st_size;
+}
+
+void File::flush()
+{
+    if (handle)
+        fflush(handle.get());
+}
+
+void File::close()
+{
+    handle.reset();
+}
+
+String File::readString()
+{
+    std::string s;
+    int c;
+    while ((c = read()) >= 0)
+        s += (char)c;
+    return String(s);
+}
+
+String File::readStringUntil(char terminator)
+{
+    std::string s;
+    int c;
+    while ((c = read()) >= 0 && c != terminator)
+        s += (char)c;
+    return String(s);
+}
+
+// =====================================================
+// FILESYSTEM
+// =====================================================
+String LittleFSFS::hostPath(const char *path)
+{
+    String p(fsRoot());
+    if (path[0] != '/')
+        p += "/";
+    p += path;
+    return p;
+}
+
+bool LittleFSFS::begin(bool formatOnFail)
+{
+    (void)formatOnFail;
+    mkdir(fsRoot(), 0755);
+    struct stat st;
+    return stat(fsRoot(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool LittleFSFS::exists(const char *path)
+{
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+File LittleFSFS::open(const char *path, const char *mode)
+{
+    // Arduino modes map 1:1 onto stdio, always binary
+    std::string m(mode);
+    if (m.find('b') == std::string::npos)
+        m += "b";
+    FILE *f = fopen(hostPath(path).c_str(), m.c_str());
+    if (!f)
+        return File();
+    fsStats.opens++;
+    return File(f, path);
+}
+
+bool LittleFSFS::remove(const char *path)
+{
+    return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool LittleFSFS::rename(const char *from, const char *to)
+{
+    return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+size_t LittleFSFS::usedBytes()
+{
+    size_t used = 0;
+    DIR *dir = opendir(fsRoot());
+    if (!dir)
+        return 0;
+    struct dirent *e;
+    while ((e = readdir(dir)) != nullptr)
+    {
+        struct stat st;
+        String p = hostPath(e->d_name);
+        if (stat(p.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+            used += (size_t)st.st_size;
+    }
+    closedir(dir);
+    return used;
+}
@@ -0,0 +1,81 @@
+#ifndef ST_NATIVE_LITTLEFS_H
+#define ST_NATIVE_LITTLEFS_H
+
+#include <memory>
+#include "Arduino.h"
+
+// LittleFS stand-in: paths map into a host directory
+// ($ST_FS_ROOT, default ./.native_fs).
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+class File : public Print
+{
+public:
+    File() {}
+    explicit File(FILE *f, const char *path);
+
+    operator bool() const { return (bool)handle; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    using Print::write;
+
+    int available();
+    int read();
+    size_t read(uint8_t *buf, size_t size);
+    int peek();
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void flush();
+    void close();
+    const char *name() const { return path.c_str(); }
+
+    String readString();
+    String readStringUntil(char terminator);
+
+private:
+    std::shared_ptr<FILE> handle;
+    String path;
+};
+
+struct FsStats
+{
+    uint64_t bytesWritten;
+    uint32_t opens;
+};
+
+class LittleFSFS
+{
+public:
+    bool begin(bool formatOnFail = false);
+    void end() {}
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    File open(const char *path, const char *mode = "r");
+    File open(const String &path, const char *mode = "r") { return open(path.c_str(), mode); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *from, const char *to);
+    size_t totalBytes() { return 1536 * 1024; }
+    size_t usedBytes();
+
+    // Native only: write accounting for flash-wear benchmarks
+    const FsStats &stats() const { return fsStats; }
+    void resetStats() { fsStats = FsStats(); }
+    void noteWrite(size_t n) { fsStats.bytesWritten += n; }
+
+private:
+    String hostPath(const char *path);
+    FsStats fsStats = {0, 0};
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
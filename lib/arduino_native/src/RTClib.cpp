@@ -0,0 +1,49 @@
+#include "RTClib.h"
+
+// Civil date <-> day count (H. Hinnant's algorithm)
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+DateTime::DateTime(uint32_t t)
+{
+    int64_t z = t / 86400;
+    uint32_t rem = t % 86400;
+    hh = rem / 3600;
+    mm = (rem / 60) % 60;
+    ss = rem % 60;
+
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t year = (int64_t)yoe + era * 400;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = (uint16_t)(year + (m <= 2));
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day,
+                   uint8_t hour, uint8_t min, uint8_t sec)
+    : y(year), m(month), d(day), hh(hour), mm(min), ss(sec)
+{
+}
+
+uint8_t DateTime::dayOfTheWeek() const
+{
+    // 1970-01-01 was a Thursday, 0 = Sunday like RTClib
+    return (uint8_t)((daysFromCivil(y, m, d) + 4) % 7);
+}
+
+uint32_t DateTime::unixtime() const
+{
+    return (uint32_t)(daysFromCivil(y, m, d) * 86400 + hh * 3600 + mm * 60 + ss);
+}
@@ -0,0 +1,28 @@
+#ifndef ST_NATIVE_RTCLIB_H
+#define ST_NATIVE_RTCLIB_H
+
+#include "Arduino.h"
+
+// DateTime from RTClib (no timezone, seconds since 1970-01-01)
+class DateTime
+{
+public:
+    DateTime(uint32_t t = 946684800);
+    DateTime(uint16_t year, uint8_t month, uint8_t day,
+             uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+
+    uint16_t year() const { return y; }
+    uint8_t month() const { return m; }
+    uint8_t day() const { return d; }
+    uint8_t hour() const { return hh; }
+    uint8_t minute() const { return mm; }
+    uint8_t second() const { return ss; }
+    uint8_t dayOfTheWeek() const;
+    uint32_t unixtime() const;
+
+private:
+    uint16_t y;
+    uint8_t m, d, hh, mm, ss;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef ST_NATIVE_WSTRING_H
+#define ST_NATIVE_WSTRING_H
+
+#include <stddef.h>
+#include <string>
+
+// Subset of the Arduino String class backed by std::string
+class String
+{
+public:
+    String() {}
+    String(const char *s) : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    explicit String(char c) : str(1, c) {}
+    explicit String(int v, unsigned char base = 10);
+    explicit String(unsigned int v, unsigned char base = 10);
+    explicit String(long v, unsigned char base = 10);
+    explicit String(unsigned long v, unsigned char base = 10);
+    explicit String(float v, unsigned char decimals = 2);
+    explicit String(double v, unsigned char decimals = 2);
+
+    unsigned int length() const { return (unsigned int)str.size(); }
+    const char *c_str() const { return str.c_str(); }
+    bool reserve(unsigned int size)
+    {
+        str.reserve(size);
+        return true;
+    }
+
+    String &operator+=(const String &rhs)
+    {
+        str += rhs.str;
+        return *this;
+    }
+    String &operator+=(const char *rhs)
+    {
+        str += rhs;
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        str += c;
+        return *this;
+    }
+    bool concat(const String &rhs)
+    {
+        str += rhs.str;
+        return true;
+    }
+    bool concat(const char *rhs)
+    {
+        str += rhs;
+        return true;
+    }
+    bool concat(char c)
+    {
+        str += c;
+        return true;
+    }
+
+    bool operator==(const String &rhs) const { return str == rhs.str; }
+    bool operator==(const char *rhs) const { return str == rhs; }
+    bool operator!=(const String &rhs) const { return str != rhs.str; }
+    bool operator!=(const char *rhs) const { return str != rhs; }
+    char operator[](unsigned int i) const { return i < str.size() ? str[i] : 0; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    bool equals(const String &rhs) const { return str == rhs.str; }
+    bool equalsIgnoreCase(const String &rhs) const;
+    bool startsWith(const String &prefix) const { return str.compare(0, prefix.str.size(), prefix.str) == 0; }
+    bool endsWith(const String &suffix) const;
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &s, unsigned int from = 0) const;
+    String substring(unsigned int begin) const;
+    String substring(unsigned int begin, unsigned int end) const;
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const;
+
+private:
+    std::string str;
+};
+
+String operator+(const String &lhs, const String &rhs);
+String operator+(const String &lhs, const char *rhs);
+String operator+(const char *lhs, const String &rhs);
+String operator+(const String &lhs, char rhs);
+
+#endif
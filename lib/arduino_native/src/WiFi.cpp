@@ -0,0 +1,31 @@
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+String IPAddress::toString() const
+{
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *pass)
+{
+    (void)ssid;
+    (void)pass;
+    beginCalls++;
+    connected = false;
+    associating = networkReachable;
+    associateAt = millis() + associateDelayMs;
+    return status();
+}
+
+wl_status_t WiFiClass::status()
+{
+    if (associating && (long)(millis() - associateAt) >= 0)
+    {
+        associating = false;
+        connected = true;
+    }
+    return connected ? WL_CONNECTED : WL_DISCONNECTED;
+}
@@ -0,0 +1,112 @@
+#ifndef ST_NATIVE_WIFI_H
+#define ST_NATIVE_WIFI_H
+
+#include "Arduino.h"
+
+// Wi-Fi stand-in: the AP always comes up. The station associates
+// associateMs (virtual) after begin() if the host driver made the network
+// reachable with setNetwork(); setConnected() forces the link state.
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class IPAddress : public Printable
+{
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+    // Network byte order, like lwIP's ip4_addr_t
+    explicit IPAddress(uint32_t addr)
+    {
+        memcpy(octets, &addr, 4);
+    }
+    operator uint32_t() const
+    {
+        uint32_t addr;
+        memcpy(&addr, octets, 4);
+        return addr;
+    }
+    uint8_t operator[](int i) const { return octets[i]; }
+    String toString() const;
+    size_t printTo(Print &p) const override { return p.print(toString()); }
+
+private:
+    uint8_t octets[4];
+};
+
+class WiFiClass
+{
+public:
+    bool mode(wifi_mode_t m)
+    {
+        wifiMode = m;
+        return true;
+    }
+    bool softAP(const char *ssid, const char *pass = nullptr)
+    {
+        (void)ssid;
+        (void)pass;
+        return true;
+    }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    wl_status_t begin(const char *ssid, const char *pass = nullptr);
+    bool disconnect(bool wifiOff = false)
+    {
+        (void)wifiOff;
+        connected = false;
+        associating = false;
+        return true;
+    }
+    bool reconnect() { return true; }
+    bool setAutoReconnect(bool autoReconnect)
+    {
+        autoReconnectOn = autoReconnect;
+        return true;
+    }
+    bool getAutoReconnect() { return autoReconnectOn; }
+    wl_status_t status();
+    IPAddress localIP() { return status() == WL_CONNECTED ? IPAddress(192, 168, 1, 50) : IPAddress(); }
+    int8_t RSSI() { return status() == WL_CONNECTED ? -60 : 0; }
+
+    // Native only
+    void setConnected(bool c)
+    {
+        connected = c;
+        associating = false;
+    }
+    // Later begin() calls associate after associateMs, or never
+    void setNetwork(bool reachable, unsigned long associateMs = 0)
+    {
+        networkReachable = reachable;
+        associateDelayMs = associateMs;
+    }
+    uint32_t begins() const { return beginCalls; }
+
+private:
+    wifi_mode_t wifiMode = WIFI_OFF;
+    bool connected = false;
+    bool autoReconnectOn = true;
+    bool networkReachable = false;
+    unsigned long associateDelayMs = 0;
+    bool associating = false;
+    unsigned long associateAt = 0;
+    uint32_t beginCalls = 0;
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef ST_NATIVE_WIFICLIENT_H
+#define ST_NATIVE_WIFICLIENT_H
+
+#include "Arduino.h"
+
+// TCP client stand-in: never connected, writes go nowhere
+class WiFiClient : public Print
+{
+public:
+    size_t write(uint8_t c) override
+    {
+        (void)c;
+        return 0;
+    }
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        (void)buf;
+        (void)size;
+        return 0;
+    }
+    using Print::write;
+    bool connected() { return false; }
+    void stop() {}
+    operator bool() { return false; }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "WiFiUdp.h"
+
+static UdpPeer *udpPeer = nullptr;
+static uint32_t udpSent = 0;
+
+void WiFiUDP::setPeer(UdpPeer *peer)
+{
+    udpPeer = peer;
+}
+
+uint32_t WiFiUDP::sent()
+{
+    return udpSent;
+}
+
+uint8_t WiFiUDP::begin(uint16_t port)
+{
+    (void)port;
+    open = true;
+    return 1;
+}
+
+void WiFiUDP::stop()
+{
+    open = false;
+    rx.clear();
+    current.clear();
+    readPos = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    txIp = ip;
+    txPort = port;
+    tx.clear();
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t *buf, size_t size)
+{
+    tx.append((const char *)buf, size);
+    return size;
+}
+
+int WiFiUDP::endPacket()
+{
+    if (!open || WiFi.status() != WL_CONNECTED)
+        return 0;
+    udpSent++;
+    if (udpPeer)
+        udpPeer->receive(*this, txIp, txPort, (const uint8_t *)tx.data(), tx.size());
+    tx.clear();
+    return 1;
+}
+
+void WiFiUDP::reply(const uint8_t *data, size_t len, unsigned long arriveAtMs)
+{
+    // Kept in arrival order, the network may reorder
+    auto it = rx.begin();
+    while (it != rx.end() && (long)(it->arriveAt - arriveAtMs) <= 0)
+        ++it;
+    rx.insert(it, Datagram{std::string((const char *)data, len), arriveAtMs});
+}
+
+int WiFiUDP::parsePacket()
+{
+    current.clear();
+    readPos = 0;
+    if (!open || rx.empty() || (long)(millis() - rx.front().arriveAt) < 0)
+        return 0;
+    current = rx.front().data;
+    rx.pop_front();
+    return (int)current.size();
+}
+
+int WiFiUDP::read(uint8_t *buf, size_t len)
+{
+    size_t n = std::min(len, current.size() - readPos);
+    memcpy(buf, current.data() + readPos, n);
+    readPos += n;
+    return (int)n;
+}
@@ -0,0 +1,57 @@
+#ifndef ST_NATIVE_WIFIUDP_H
+#define ST_NATIVE_WIFIUDP_H
+
+#include <deque>
+#include <string>
+#include "WiFi.h"
+
+// WiFiUDP stand-in. There is no socket; endPacket() hands the datagram to
+// the host driver's UdpPeer (e.g. an NTP server stand-in), which answers
+// with reply(). A reply shows up in parsePacket() once the virtual clock
+// reaches its arrival time. Nothing leaves without a station link.
+
+class WiFiUDP;
+
+class UdpPeer
+{
+public:
+    virtual ~UdpPeer() {}
+    virtual void receive(WiFiUDP &from, const IPAddress &to, uint16_t port,
+                         const uint8_t *data, size_t len) = 0;
+};
+
+class WiFiUDP
+{
+public:
+    uint8_t begin(uint16_t port);
+    void stop();
+    int beginPacket(IPAddress ip, uint16_t port);
+    size_t write(const uint8_t *buf, size_t size);
+    int endPacket();
+    // Size of the next arrived datagram, 0 if none (drops the unread rest)
+    int parsePacket();
+    int available() { return (int)(current.size() - readPos); }
+    int read(uint8_t *buf, size_t len);
+    void flush() {}
+
+    // Native only
+    static void setPeer(UdpPeer *peer);
+    void reply(const uint8_t *data, size_t len, unsigned long arriveAtMs);
+    static uint32_t sent(); // datagrams handed to the network
+
+private:
+    struct Datagram
+    {
+        std::string data;
+        unsigned long arriveAt;
+    };
+    bool open = false;
+    IPAddress txIp;
+    uint16_t txPort = 0;
+    std::string tx;
+    std::deque<Datagram> rx;
+    std::string current;
+    size_t readPos = 0;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef ST_NATIVE_WIRE_H
+#define ST_NATIVE_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire
+{
+public:
+    bool begin() { return true; }
+};
+
+extern TwoWire Wire;
+
+#endif
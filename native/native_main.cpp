@@ -0,0 +1,141 @@
+// Host driver for [env:native]: boots the firmware against the HAL fakes.
+//
+//   program [bench] [loop-passes]     loop() latency at full host speed
+//   program sim [options]             day/year tracking simulation
+//   program ephemeris [options]       ephemeris accuracy and cost
+//   program sensors [--noise N]       LDR sampler vs. single-shot noise
+//   program controller [--offset deg] controller step response
+//   program servo                     servo mapping/clamping check
+//   program history [--days N]        history log append/flash benchmark
+//   program export [--days N]         /history streaming export check
+//   program json [--iterations N]     /status JSON allocation benchmark
+//   program calibration               Non-blocking calibration sweep check
+//   program control [--days MIN]      Control-period jitter, loop() vs. task
+//   program web                       Web UI bytes per page load, ETag/304
+//   program telemetry [--days MIN]    /events stream vs. /status polling
+//   program statusbin [--days MIN]    /status.bin vs. /status, ring batch
+//   program metrics [--days MIN]      Stage histograms at /metrics
+//   program supervisor [--days MIN]   Hangs per subsystem, reset log
+//   program ntp                       WLAN/NTP state machines, NTP stand-in
+//   program clock                     Software clock drift over a week
+//   program config                    /config.bin vs. the text files
+//   program boot                      Fast boot: resumed pointing, first track
+//   program backtrack                 Row backtracking, a year vs. plain tracking
+//   program motion                    Servo planner: trapezoid limits, coordinated moves
+//
+// Simulation options: --lat --lon --start YYYY-MM-DD --days N --clouds 0..1
+//                     --noise N --seed N --step-ms N --daily
+//                     --strategy astro|ldr|hybrid|backtrack|all (sim)
+//                     --row-pitch M --panel-width M --row-az DEG --no-backtrack
+
+#include <chrono>
+#include <vector>
+#include <Arduino.h>
+#include "st_hal_fake.h"
+#include "st_sim.h"
+
+void setup();
+void loop();
+
+static int benchLoop(int argc, char **argv)
+{
+    unsigned long passes = argc > 0 ? strtoul(argv[0], nullptr, 10) : 200000;
+    const uint64_t passMicros = 1000; // virtual time per loop() pass
+    if (passes == 0)
+    {
+        fprintf(stderr, "unknown mode or pass count: %s (see native_main.cpp)\n", argv[0]);
+        return 2;
+    }
+
+    Serial.setMuted(true);
+    fakeRtcSet(DateTime(2025, 6, 21, 12, 0, 0));
+    fakeSetLdr(2400, 2400, 2400, 2400);
+
+    setup();
+
+    std::vector<uint32_t> latency;
+    latency.reserve(passes);
+    auto wallStart = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < passes; i++)
+    {
+        nativeClockAdvance(passMicros);
+        auto t0 = std::chrono::steady_clock::now();
+        loop();
+        auto t1 = std::chrono::steady_clock::now();
+        latency.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::sort(latency.begin(), latency.end());
+    double sum = 0;
+    for (uint32_t v : latency)
+        sum += v;
+
+    printf("loop() passes:   %lu (%.1f s virtual, %.3f s wall, x%.0f)\n",
+           passes, passes * passMicros / 1e6, wall, passes * passMicros / 1e6 / wall);
+    printf("latency ns:      min %u  avg %.0f  p50 %u  p99 %u  max %u\n",
+           latency.front(), sum / passes, latency[passes / 2],
+           latency[passes * 99 / 100], latency.back());
+    printf("servo writes:    yaw %u  tilt %u\n",
+           fakeServoStats().yawWrites, fakeServoStats().tiltWrites);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    String mode = argc > 1 ? argv[1] : "bench";
+
+    if (mode == "sim" || mode == "ephemeris" || mode == "sensors" || mode == "controller" || mode == "servo" ||
+        mode == "history" || mode == "export" || mode == "json" || mode == "calibration" || mode == "control" || mode == "web" ||
+        mode == "telemetry" || mode == "statusbin" ||
+        mode == "metrics" || mode == "supervisor" || mode == "ntp" ||
+        mode == "clock" || mode == "config" || mode == "boot" ||
+        mode == "backtrack" || mode == "motion")
+    {
+        Serial.setMuted(true);
+        if (mode == "sim")
+            return simRunTracking(argc - 2, argv + 2);
+        if (mode == "ephemeris")
+            return simCheckEphemeris(argc - 2, argv + 2);
+        if (mode == "sensors")
+            return simCheckSensors(argc - 2, argv + 2);
+        if (mode == "servo")
+            return simCheckServo(argc - 2, argv + 2);
+        if (mode == "history")
+            return simBenchHistory(argc - 2, argv + 2);
+        if (mode == "export")
+            return simCheckExport(argc - 2, argv + 2);
+        if (mode == "json")
+            return simBenchJson(argc - 2, argv + 2);
+        if (mode == "calibration")
+            return simCheckCalibration(argc - 2, argv + 2);
+        if (mode == "control")
+            return simCheckControl(argc - 2, argv + 2);
+        if (mode == "web")
+            return simCheckWeb(argc - 2, argv + 2);
+        if (mode == "telemetry")
+            return simCheckTelemetry(argc - 2, argv + 2);
+        if (mode == "statusbin")
+            return simCheckStatusBin(argc - 2, argv + 2);
+        if (mode == "metrics")
+            return simCheckMetrics(argc - 2, argv + 2);
+        if (mode == "supervisor")
+            return simCheckSupervisor(argc - 2, argv + 2);
+        if (mode == "ntp")
+            return simCheckNtp(argc - 2, argv + 2);
+        if (mode == "clock")
+            return simCheckClock(argc - 2, argv + 2);
+        if (mode == "config")
+            return simCheckConfig(argc - 2, argv + 2);
+        if (mode == "boot")
+            return simCheckBoot(argc - 2, argv + 2);
+        if (mode == "backtrack")
+            return simCheckBacktrack(argc - 2, argv + 2);
+        if (mode == "motion")
+            return simCheckMotion(argc - 2, argv + 2);
+        return simCheckController(argc - 2, argv + 2);
+    }
+    if (mode == "bench")
+        return benchLoop(argc - 2, argv + 2);
+    return benchLoop(argc - 1, argv + 1);
+}
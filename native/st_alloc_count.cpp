@@ -0,0 +1,61 @@
+#include <new>
+#include <stdlib.h>
+#include "st_alloc_count.h"
+
+static bool counting = false;
+static AllocStats stats = {0, 0};
+
+void allocCountStart()
+{
+    stats = AllocStats();
+    counting = true;
+}
+
+AllocStats allocCountStop()
+{
+    counting = false;
+    return stats;
+}
+
+static void *countedAlloc(size_t size)
+{
+    if (counting)
+    {
+        stats.allocations++;
+        stats.bytes += size;
+    }
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size)
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
@@ -0,0 +1,17 @@
+#ifndef ST_ALLOC_COUNT_H
+#define ST_ALLOC_COUNT_H
+
+#include <stdint.h>
+
+// Counts heap allocations made through operator new (String, std::
+// containers) while enabled. Host-only, for the JSON benchmark.
+struct AllocStats
+{
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+void allocCountStart();
+AllocStats allocCountStop();
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef ST_HAL_FAKE_H
+#define ST_HAL_FAKE_H
+
+#include "st_hal.h"
+
+// =====================================================
+// HOST FAKES BEHIND st_hal.h
+// =====================================================
+// Control surface for native drivers: what the LDRs see, what the RTC
+// says, and what the servos were told to do.
+
+// Poses are centidegrees, recovered from the written pulse width
+typedef void (*FakeLdrModel)(int32_t yaw, int32_t tilt, int &tl, int &tr, int &bl, int &br);
+
+struct FakeServoStats
+{
+    uint32_t yawWrites;
+    uint32_t tiltWrites;
+    uint64_t yawTravel;  // sum of |delta| in centidegrees
+    uint64_t tiltTravel;
+    uint16_t yawPulseUs; // last written pulse widths
+    uint16_t tiltPulseUs;
+};
+
+// LDRs: fixed values, or a model evaluated at the current servo pose.
+// The model result is cached per pose until fakeLdrModelChanged(); ADC
+// noise (uniform ±amplitude) is added on every read.
+void fakeSetLdr(int tl, int tr, int bl, int br);
+void fakeSetLdrModel(FakeLdrModel model);
+void fakeLdrModelChanged();
+void fakeSetLdrNoise(int amplitude);
+uint32_t fakeLdrReads();
+
+// Control task: off by default, so drivers keep calling controlStep()
+// from loop(). When enabled, halStartControlTask() succeeds and the step
+// fires from the virtual clock like a higher-priority task, also in the
+// middle of a delay() inside a web handler.
+void fakeControlTaskEnable(bool enable);
+// The next control task wake-up blocks for ms (virtual) before the step
+// runs; meanwhile() as for fakeServoHang()
+void fakeControlHang(uint32_t ms, void (*meanwhile)());
+
+// Servos
+int32_t fakeServoYaw();
+int32_t fakeServoTilt();
+const FakeServoStats &fakeServoStats();
+void fakeResetServoStats();
+// The next yaw write (motion tick) blocks for ms (virtual); meanwhile()
+// runs every millisecond, standing in for the tasks that keep going
+// (e.g. loop)
+void fakeServoHang(uint32_t ms, void (*meanwhile)());
+
+// RTC: runs off the virtual clock from the moment it was set, its seconds
+// tick from that moment (the DS3231 restarts its divider on a write)
+void fakeRtcSet(const DateTime &now, bool lostPower = false);
+// Oscillator errors in parts per billion against the virtual clock (true
+// time): the RTC, and halMonotonicUs() (the ESP32 crystal). Set before boot.
+void fakeSetRtcDrift(int32_t ppb);
+void fakeSetTimebaseDrift(int32_t ppb);
+void fakeRtcRemove();
+uint32_t fakeRtcReads(); // halRtcNow() calls (I2C transactions on the board)
+
+// Reset: halRestart() only counts and marks the next boot as a software
+// reset; drivers run setup() again to boot. Power-on on process start.
+void fakeSetResetReason(HalResetReason reason);
+uint32_t fakeRestarts();
+uint32_t fakeWatchdogFeeds();
+
+// DNS: every name resolves to FAKE_DNS_ADDR after delayMs (virtual), or
+// fails; no answer without a station link
+#define FAKE_DNS_ADDR IPAddress(10, 0, 0, 123)
+void fakeSetDns(bool resolves, uint32_t delayMs = 0);
+uint32_t fakeDnsLookups();
+
+#endif
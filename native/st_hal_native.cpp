@@ -0,0 +1,492 @@
+#include <chrono>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include "st_hal_fake.h"
+#include "st_servo.h"
+
+// Host backend of the hardware abstraction layer
+
+static int ldrValues[4] = {0, 0, 0, 0};
+static FakeLdrModel ldrModel = nullptr;
+static bool ldrModelValid = false;
+static int32_t ldrModelYaw = 0;
+static int32_t ldrModelTilt = 0;
+static int ldrNoise = 0;
+static uint32_t ldrNoiseState = 2463534242u;
+static uint32_t ldrReads = 0;
+
+// Sampler timer, fired from the virtual clock. Catch-up is capped: older
+// ticks would only be overwritten in the sampler ring anyway.
+static const uint32_t SAMPLER_MAX_CATCHUP = 256;
+static void (*samplerTick)() = nullptr;
+static uint32_t samplerPeriodUs = 0;
+static uint64_t samplerNextUs = 0;
+
+// Motion timer, fired from the virtual clock. Every period runs: the
+// planner counts ticks, not time, and an idle tick returns at once.
+static void (*motionTickFn)() = nullptr;
+static uint64_t motionPeriodUs = 0;
+static uint64_t motionNextUs = 0;
+static bool motionBusy = false;
+
+// Control task, fired from the virtual clock at its period. The clock
+// stops at each wake-up, so the step sees the right millis().
+static bool controlTaskEnabled = false;
+static void (*controlStepFn)() = nullptr;
+static uint64_t controlPeriodUs = 0;
+static uint64_t controlNextUs = 0;
+static bool controlBusy = false;
+static uint32_t controlHangMs = 0;
+static void (*controlHangMeanwhile)() = nullptr;
+
+// Supervisor check, fired from the virtual clock (also during a delay()
+// in a hanging step or handler, like the esp_timer task would)
+static void (*supervisorCheckFn)() = nullptr;
+static uint64_t supervisorPeriodUs = 0;
+static uint64_t supervisorNextUs = 0;
+static bool supervisorBusy = false;
+
+static HalResetReason resetReason = HAL_RESET_POWER_ON;
+static uint8_t noinitArea[HAL_NOINIT_SIZE];
+static uint32_t restarts = 0;
+static uint32_t watchdogFeeds = 0;
+
+static int32_t servoYawPos = 9000;
+static int32_t servoTiltPos = 9000;
+static FakeServoStats servoStats = {};
+static uint32_t servoHangMs = 0;
+static void (*servoHangMeanwhile)() = nullptr;
+
+static bool rtcPresent = false;
+static bool rtcPowerLost = false;
+static uint32_t rtcEpochAtSet = 0;
+static uint64_t rtcClockAtSet = 0;
+static uint32_t rtcReads = 0;
+static int32_t rtcDriftPpb = 0;
+static int32_t timebaseDriftPpb = 0;
+
+static bool dnsResolves = true;
+static uint32_t dnsDelayMs = 0;
+static bool dnsBusy = false;
+static unsigned long dnsReadyAt = 0;
+static uint32_t dnsLookups = 0;
+
+void fakeSetLdr(int tl, int tr, int bl, int br)
+{
+    ldrModel = nullptr;
+    ldrValues[0] = tl;
+    ldrValues[1] = tr;
+    ldrValues[2] = bl;
+    ldrValues[3] = br;
+}
+
+void fakeSetLdrModel(FakeLdrModel model)
+{
+    ldrModel = model;
+    ldrModelValid = false;
+}
+
+void fakeLdrModelChanged()
+{
+    ldrModelValid = false;
+}
+
+void fakeSetLdrNoise(int amplitude)
+{
+    ldrNoise = amplitude;
+}
+
+uint32_t fakeLdrReads()
+{
+    return ldrReads;
+}
+
+static int addNoise(int value)
+{
+    if (ldrNoise <= 0)
+        return value;
+    // xorshift32, cheap enough for thousands of samples per virtual second
+    ldrNoiseState ^= ldrNoiseState << 13;
+    ldrNoiseState ^= ldrNoiseState >> 17;
+    ldrNoiseState ^= ldrNoiseState << 5;
+    int n = (int)(ldrNoiseState % (uint32_t)(2 * ldrNoise + 1)) - ldrNoise;
+    return constrain(value + n, 0, 4095);
+}
+
+static void samplerDispatch(uint64_t nowUs)
+{
+    if (!samplerTick)
+        return;
+    uint64_t window = (uint64_t)SAMPLER_MAX_CATCHUP * samplerPeriodUs;
+    if (nowUs > samplerNextUs + window)
+        samplerNextUs = nowUs - window;
+    while (samplerNextUs <= nowUs)
+    {
+        samplerTick();
+        samplerNextUs += samplerPeriodUs;
+    }
+}
+
+// A tick stuck in a servo write is not fired again until it returns
+static void motionDispatch(uint64_t nowUs)
+{
+    if (!motionTickFn || motionBusy)
+        return;
+    motionBusy = true;
+    while (motionNextUs <= nowUs)
+    {
+        motionNextUs += motionPeriodUs;
+        motionTickFn();
+    }
+    motionBusy = false;
+}
+
+// The clock stops at the next control wake-up or supervisor check,
+// whichever comes first; a busy step is not woken again
+static void scheduleNext()
+{
+    uint64_t next = UINT64_MAX;
+    if (controlStepFn && !controlBusy)
+        next = controlNextUs;
+    if (supervisorCheckFn && !supervisorBusy)
+        next = min(next, supervisorNextUs);
+    nativeClockScheduleHook(next);
+}
+
+// Like vTaskDelayUntil: wake-ups missed while busy run back to back. A
+// step never preempts itself (e.g. delay() inside doStartInit()).
+static void controlDispatch(uint64_t nowUs)
+{
+    if (!controlStepFn || controlBusy)
+        return;
+    controlBusy = true;
+    while (controlNextUs <= nowUs)
+    {
+        controlNextUs += controlPeriodUs;
+        if (controlHangMs > 0)
+        {
+            uint32_t ms = controlHangMs;
+            controlHangMs = 0;
+            for (uint32_t i = 0; i < ms; i++)
+            {
+                nativeClockAdvance(1000);
+                if (controlHangMeanwhile)
+                    controlHangMeanwhile();
+            }
+        }
+        controlStepFn();
+    }
+    controlBusy = false;
+}
+
+// esp_timer skips missed periods instead of queueing them
+static void supervisorDispatch(uint64_t nowUs)
+{
+    if (!supervisorCheckFn || supervisorBusy || supervisorNextUs > nowUs)
+        return;
+    supervisorBusy = true;
+    while (supervisorNextUs <= nowUs)
+        supervisorNextUs += supervisorPeriodUs;
+    supervisorCheckFn();
+    supervisorBusy = false;
+}
+
+static void clockHook(uint64_t nowUs)
+{
+    samplerDispatch(nowUs);
+    motionDispatch(nowUs);
+    supervisorDispatch(nowUs);
+    controlDispatch(nowUs);
+    scheduleNext();
+}
+
+void fakeControlTaskEnable(bool enable)
+{
+    controlTaskEnabled = enable;
+}
+
+void fakeControlHang(uint32_t ms, void (*meanwhile)())
+{
+    controlHangMs = ms;
+    controlHangMeanwhile = meanwhile;
+}
+
+int32_t fakeServoYaw()
+{
+    return servoYawPos;
+}
+
+int32_t fakeServoTilt()
+{
+    return servoTiltPos;
+}
+
+const FakeServoStats &fakeServoStats()
+{
+    return servoStats;
+}
+
+void fakeResetServoStats()
+{
+    servoStats = FakeServoStats();
+}
+
+void fakeRtcSet(const DateTime &now, bool lostPower)
+{
+    rtcPresent = true;
+    rtcPowerLost = lostPower;
+    rtcEpochAtSet = now.unixtime();
+    rtcClockAtSet = nativeClockMicros();
+}
+
+void fakeRtcRemove()
+{
+    rtcPresent = false;
+}
+
+uint32_t fakeRtcReads()
+{
+    return rtcReads;
+}
+
+void fakeSetRtcDrift(int32_t ppb)
+{
+    rtcDriftPpb = ppb;
+}
+
+void fakeSetTimebaseDrift(int32_t ppb)
+{
+    timebaseDriftPpb = ppb;
+}
+
+// =====================================================
+// st_hal.h
+// =====================================================
+void halReadLdr(int &tl, int &tr, int &bl, int &br)
+{
+    if (ldrModel && (!ldrModelValid || ldrModelYaw != servoYawPos || ldrModelTilt != servoTiltPos))
+    {
+        ldrModel(servoYawPos, servoTiltPos, ldrValues[0], ldrValues[1], ldrValues[2], ldrValues[3]);
+        ldrModelYaw = servoYawPos;
+        ldrModelTilt = servoTiltPos;
+        ldrModelValid = true;
+    }
+    ldrReads++;
+    tl = addNoise(ldrValues[0]);
+    tr = addNoise(ldrValues[1]);
+    bl = addNoise(ldrValues[2]);
+    br = addNoise(ldrValues[3]);
+}
+
+bool halStartSampler(void (*tick)(), uint32_t periodUs)
+{
+    samplerTick = tick;
+    samplerPeriodUs = periodUs;
+    samplerNextUs = nativeClockMicros() + periodUs;
+    nativeClockSetHook(clockHook);
+    return true;
+}
+
+bool halStartMotion(void (*tick)(), uint32_t periodUs)
+{
+    motionTickFn = tick;
+    motionPeriodUs = periodUs;
+    motionNextUs = nativeClockMicros() + periodUs;
+    nativeClockSetHook(clockHook);
+    return true;
+}
+
+bool halStartControlTask(void (*step)(), uint32_t periodMs)
+{
+    if (!controlTaskEnabled)
+        return false;
+    controlStepFn = step;
+    controlPeriodUs = (uint64_t)periodMs * 1000;
+    controlNextUs = nativeClockMicros() + controlPeriodUs;
+    nativeClockSetHook(clockHook);
+    scheduleNext();
+    return true;
+}
+
+bool halWatchdogBegin(uint32_t timeoutMs)
+{
+    (void)timeoutMs;
+    return true;
+}
+
+void halWatchdogAddTask()
+{
+}
+
+void halWatchdogFeed()
+{
+    watchdogFeeds++;
+}
+
+bool halStartSupervisor(void (*check)(), uint32_t periodMs)
+{
+    supervisorCheckFn = check;
+    supervisorPeriodUs = (uint64_t)periodMs * 1000;
+    supervisorNextUs = nativeClockMicros() + supervisorPeriodUs;
+    nativeClockSetHook(clockHook);
+    scheduleNext();
+    return true;
+}
+
+HalResetReason halResetReason()
+{
+    return resetReason;
+}
+
+uint8_t *halNoinit()
+{
+    return noinitArea;
+}
+
+// No process exit: the driver decides when to "boot" again (setup())
+void halRestart()
+{
+    restarts++;
+    resetReason = HAL_RESET_SOFTWARE;
+}
+
+void fakeSetResetReason(HalResetReason reason)
+{
+    resetReason = reason;
+}
+
+uint32_t fakeRestarts()
+{
+    return restarts;
+}
+
+uint32_t fakeWatchdogFeeds()
+{
+    return watchdogFeeds;
+}
+
+void halCriticalEnter()
+{
+}
+
+void halCriticalExit()
+{
+}
+
+// Host time, not the virtual clock: a stage costs no virtual time, but
+// st_metrics should still show where the host spends it. 1 cycle = 1 ns.
+uint32_t halCycles()
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint32_t halCyclesPerUs()
+{
+    return 1000;
+}
+
+uint64_t halMonotonicUs()
+{
+    int64_t us = (int64_t)nativeClockMicros();
+    return (uint64_t)(us + us * timebaseDriftPpb / 1000000000LL);
+}
+
+void halServoAttach()
+{
+}
+
+void fakeServoHang(uint32_t ms, void (*meanwhile)())
+{
+    servoHangMs = ms;
+    servoHangMeanwhile = meanwhile;
+}
+
+void halServoWriteYawUs(uint16_t pulseUs)
+{
+    if (servoHangMs > 0)
+    {
+        uint32_t ms = servoHangMs;
+        servoHangMs = 0;
+        for (uint32_t i = 0; i < ms; i++)
+        {
+            nativeClockAdvance(1000);
+            if (servoHangMeanwhile)
+                servoHangMeanwhile();
+        }
+    }
+    int32_t angle = servoPulseToCd(pulseUs);
+    servoStats.yawWrites++;
+    servoStats.yawTravel += (uint64_t)abs(angle - servoYawPos);
+    servoStats.yawPulseUs = pulseUs;
+    servoYawPos = angle;
+}
+
+void halServoWriteTiltUs(uint16_t pulseUs)
+{
+    int32_t angle = servoPulseToCd(pulseUs);
+    servoStats.tiltWrites++;
+    servoStats.tiltTravel += (uint64_t)abs(angle - servoTiltPos);
+    servoStats.tiltPulseUs = pulseUs;
+    servoTiltPos = angle;
+}
+
+bool halRtcBegin()
+{
+    return rtcPresent;
+}
+
+bool halRtcLostPower()
+{
+    return rtcPowerLost;
+}
+
+DateTime halRtcNow()
+{
+    rtcReads++;
+    int64_t us = (int64_t)(nativeClockMicros() - rtcClockAtSet);
+    us += us * rtcDriftPpb / 1000000000LL;
+    return DateTime((uint32_t)(rtcEpochAtSet + us / 1000000LL));
+}
+
+void halRtcAdjust(const DateTime &dt)
+{
+    rtcPowerLost = false;
+    rtcEpochAtSet = dt.unixtime();
+    rtcClockAtSet = nativeClockMicros();
+}
+
+bool halFsBegin()
+{
+    return LittleFS.begin(true);
+}
+
+void fakeSetDns(bool resolves, uint32_t delayMs)
+{
+    dnsResolves = resolves;
+    dnsDelayMs = delayMs;
+}
+
+uint32_t fakeDnsLookups()
+{
+    return dnsLookups;
+}
+
+HalDnsResult halDnsLookup(const char *host, uint32_t &addr)
+{
+    (void)host;
+    if (!dnsBusy)
+    {
+        dnsLookups++;
+        dnsBusy = true;
+        dnsReadyAt = millis() + dnsDelayMs;
+    }
+    if ((long)(millis() - dnsReadyAt) < 0)
+        return HAL_DNS_PENDING;
+    dnsBusy = false;
+    if (!dnsResolves || WiFi.status() != WL_CONNECTED)
+        return HAL_DNS_FAILED;
+    addr = (uint32_t)FAKE_DNS_ADDR;
+    return HAL_DNS_OK;
+}
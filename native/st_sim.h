@@ -0,0 +1,76 @@
+#ifndef ST_SIM_H
+#define ST_SIM_H
+
+// Host-side drivers built on the HAL fakes, one st_sim_<subsystem>.cpp
+// each; sky model, fixtures and the ok/FAIL lines are in st_sim_common.h.
+// Each one boots the firmware once, so run one mode per process.
+
+// Faster-than-real-time replay of the INIT/TRACKING/SLEEP machine against
+// a synthetic sun + cloud irradiance model.
+int simRunTracking(int argc, char **argv);
+
+// Ephemeris table vs. calcHorizontalCoordinates: accuracy over a year and
+// cost per lookup.
+int simCheckEphemeris(int argc, char **argv);
+
+// Noise behaviour of the background LDR sampler vs. single-shot reads.
+int simCheckSensors(int argc, char **argv);
+
+// Convergence time and overshoot of the pointing controller vs. the old
+// bang-bang law.
+int simCheckController(int argc, char **argv);
+
+// Angle -> pulse mapping, limit clamping and quantization error; exit
+// code 1 on failure.
+int simCheckServo(int argc, char **argv);
+
+// Bytes and flash blocks per append: history.csv vs. the ring files;
+// wrap-around, torn record, import of the former history.csv.
+int simBenchHistory(int argc, char **argv);
+
+// /history export: chunked stream, window/step buckets, work per loop() pass.
+int simCheckExport(int argc, char **argv);
+
+// Calibration sweep: non-blocking, cancel, resume after reboot.
+int simCheckCalibration(int argc, char **argv);
+
+// Control-period jitter: step in loop() vs. control task, slow handlers.
+int simCheckControl(int argc, char **argv);
+
+// /status JSON: String concatenation vs. st_json (allocations, time).
+int simBenchJson(int argc, char **argv);
+
+// Web UI: bytes per page load with gzip assets, ETag/304, JSON endpoints.
+int simCheckWeb(int argc, char **argv);
+
+// Live telemetry: /events stream vs. /status polling (work, staleness).
+int simCheckTelemetry(int argc, char **argv);
+
+// /status.bin: values vs. /status, ring batch, layout versioning.
+int simCheckStatusBin(int argc, char **argv);
+
+// /metrics: bucket edges, p99, Prometheus text, per-stage numbers.
+int simCheckMetrics(int argc, char **argv);
+
+// Supervisor: hang per subsystem -> restart, reset log, overhead.
+int simCheckSupervisor(int argc, char **argv);
+
+// Time sync: WLAN/NTP state machines against a local NTP stand-in.
+int simCheckNtp(int argc, char **argv);
+
+// Software clock: a week of drift against RTC and NTP references.
+int simCheckClock(int argc, char **argv);
+
+// Config store: migration, boot reads, skipped saves, torn writes.
+int simCheckConfig(int argc, char **argv);
+
+// Fast boot: resumed pointing vs. sun target, time to first track.
+int simCheckBoot(int argc, char **argv);
+
+// Row backtracking: shade-free tilt, a year of energy vs. plain tracking.
+int simCheckBacktrack(int argc, char **argv);
+
+// Servo motion planner: profile limits, coordinated moves, coalescing.
+int simCheckMotion(int argc, char **argv);
+
+#endif
@@ -0,0 +1,181 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "st_strategy.h"
+#include "st_backtrack.h"
+#include "st_control.h"
+#include "st_config.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// BACKTRACKING
+// =====================================================
+struct RowEnergy
+{
+    double ideal = 0;    // unshaded, pointed at the sun
+    double plain = 0;    // pointed at the sun, in the neighbour's shadow
+    double backtrack = 0; // backtrackAim(): off the sun, no shadow
+    uint32_t minutes = 0; // with backtracking active
+};
+
+// Clear-sky beam on the geometry alone, no firmware: five minute steps,
+// yaw always on the sun
+static void rowYear(const SimOptions &o, RowEnergy months[12])
+{
+    const double stepHours = 5.0 / 60.0;
+    DateTime t(o.year, 1, 1, 0, 0, 0);
+    while (t.year() == o.year)
+    {
+        updateSky(t, o.latitude, o.longitude, false);
+        if (sky.altitude > 0.0)
+        {
+            RowEnergy &m = months[t.month() - 1];
+            float aim;
+            bool active = backtrackAim(sky.azimuth, sky.altitude, aim);
+            m.ideal += sky.direct * stepHours;
+            m.plain += sky.direct * (1.0 - rowLoss(sky.altitude)) * stepHours;
+            m.backtrack += sky.direct * cos(radians(sky.altitude - aim)) * (1.0 - rowLoss(aim)) * stepHours;
+            m.minutes += active ? 5 : 0;
+        }
+        t = DateTime(t.unixtime() + 300);
+    }
+}
+
+int simCheckBacktrack(int argc, char **argv)
+{
+    SimOptions o;
+    o.month = 12;
+    o.rowPitch = 5.0;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    settings.rowPitch = o.rowPitch;
+    settings.panelWidth = o.panelWidth;
+    settings.rowAzimuth = o.rowAzimuth;
+    float gcr = backtrackGcr();
+
+    // The target itself, sun towards the rows
+    float aim;
+    bool highSun = !backtrackAim(o.rowAzimuth, 60.0f, aim) && aim == 60.0f;
+    bool alongRows = !backtrackAim(o.rowAzimuth + 90.0f, 5.0f, aim) && aim == 5.0f;
+    bool shadeFree = true;
+    bool steepest = true;
+    bool shadedWithout = true;
+    sky.azimuth = o.rowAzimuth + 30.0;
+    for (double alt = 0.5; alt < degrees(asin(gcr * cos(radians(30.0)))); alt += 0.5)
+    {
+        sky.altitude = alt;
+        shadeFree = shadeFree && backtrackAim(sky.azimuth, alt, aim) && rowShade(aim) < 1e-4;
+        steepest = steepest && rowShade(aim - 0.5) > 0.0;
+        shadedWithout = shadedWithout && rowShade(alt) > 0.0;
+    }
+    settings.rowPitch = 0.0f;
+    bool single = !backtrackAim(o.rowAzimuth, 5.0f, aim) && aim == 5.0f && backtrackGcr() == 0.0f;
+    settings.rowPitch = o.rowPitch;
+
+    RowEnergy months[12];
+    rowYear(o, months);
+    RowEnergy year;
+    static const char *const monthNames[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                               "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    printf("Rows %.2f m apart towards %.0f°, panels %.2f m wide (GCR %.2f) @ %.4f, %.4f, %d\n", o.rowPitch,
+           o.rowAzimuth, o.panelWidth, gcr, o.latitude, o.longitude, o.year);
+    printf("  %-5s %9s %9s %9s %9s %8s %8s\n", "month", "ideal", "plain", "backtrack", "recovered", "gain",
+           "active");
+    for (int i = 0; i < 12; i++)
+    {
+        const RowEnergy &m = months[i];
+        double lost = m.ideal - m.plain;
+        printf("  %-5s %9.1f %9.1f %9.1f %8.1f%% %+7.1f%% %6.1f h\n", monthNames[i], m.ideal / 1000.0,
+               m.plain / 1000.0, m.backtrack / 1000.0, lost > 0 ? 100.0 * (m.backtrack - m.plain) / lost : 0.0,
+               m.plain > 0 ? 100.0 * (m.backtrack / m.plain - 1.0) : 0.0, m.minutes / 60.0);
+        year.ideal += m.ideal;
+        year.plain += m.plain;
+        year.backtrack += m.backtrack;
+        year.minutes += m.minutes;
+    }
+    double yearLost = year.ideal - year.plain;
+    double recovered = yearLost > 0 ? 100.0 * (year.backtrack - year.plain) / yearLost : 0.0;
+    printf("  %-5s %9.1f %9.1f %9.1f %8.1f%% %+7.1f%% %6.0f h   (kWh/m² beam, clear sky)\n", "year",
+           year.ideal / 1000.0, year.plain / 1000.0, year.backtrack / 1000.0, recovered,
+           100.0 * (year.backtrack / year.plain - 1.0), year.minutes / 60.0);
+
+    printf("Firmware %04d-%02d-%02d, share of unshaded two-axis tracking:\n", o.year, o.month, o.day);
+#ifdef ST_STRATEGY_RUNTIME
+    // The firmware on one day: unaware of the rows, rows with the hybrid
+    // strategy (LDR tilt error pulls back into the shadow), backtracking
+    SimOptions day = o;
+    day.days = 1;
+    struct DayRun
+    {
+        const char *name;
+        TrackStrategyId strategy;
+        bool rows;
+        double capture;
+    };
+    DayRun runs[] = {{"plain", STRATEGY_HYBRID, false, 0},
+                     {"hybrid + rows", STRATEGY_HYBRID, true, 0},
+                     {"backtrack + rows", STRATEGY_BACKTRACK, true, 0}};
+    for (DayRun &r : runs)
+    {
+        strategySelect(r.strategy);
+        day.backtrack = r.rows;
+        r.capture = runTracking(day).capture();
+        printf("  %-18s %5.1f %%\n", r.name, r.capture);
+    }
+#else
+    printf("  (built for strategy %s only, -DST_STRATEGY_RUNTIME compares them)\n",
+           strategyName(strategySelected()));
+#endif
+
+    // Morning after: /status reports the backtracked target
+    DateTime morning(o.year, o.month, o.day, 9, 0, 0);
+    simSkyAt(morning, o);
+    setup();
+    settings.latitude = o.latitude;
+    settings.longitude = o.longitude;
+    settings.rowPitch = o.rowPitch;
+    settings.panelWidth = o.panelWidth;
+    settings.rowAzimuth = o.rowAzimuth;
+    simRun(50, READ_INTERVAL * 1000);
+    server.request(HTTP_GET, "/status");
+    bool statusReports = String(server.responseBody()).indexOf("\"backtracking\":true") >= 0;
+
+    bool saved = server.request(HTTP_POST, "/geo/save",
+                                {{"lat", "52.52"}, {"lon", "13.405"}, {"autodst", "1"}, {"tzoffset", "1"},
+                                 {"rowpitch", "6.5"}, {"panelwidth", "2.6"}, {"rowaz", "95"}}) == 200;
+    controlStep();
+    saved = saved && server.request(HTTP_GET, "/geo.json") == 200;
+    String geo = String(server.responseBody());
+    bool geoRoundtrip = saved && geo.indexOf("\"rowPitch\":6.50") >= 0 && geo.indexOf("\"panelWidth\":2.60") >= 0 &&
+                        geo.indexOf("\"rowAzimuth\":95.0") >= 0 && geo.indexOf("\"gcr\":0.400") >= 0;
+    // GCR > 1 and a width without a pitch: 400, the saved geometry stays
+    bool rejected = true;
+    for (const char *pitch : {"2.0", "0"})
+    {
+        rejected = rejected && server.request(HTTP_POST, "/geo/save",
+                                              {{"lat", "48.0"}, {"lon", "11.0"}, {"autodst", "1"}, {"tzoffset", "1"},
+                                               {"rowpitch", pitch}, {"panelwidth", "2.6"}, {"rowaz", "95"}}) == 400;
+        controlStep();
+    }
+    rejected = rejected && server.request(HTTP_GET, "/geo.json") == 200 && String(server.responseBody()) == geo;
+    LittleFS.remove("/config.bin");
+
+    check.expect(highSun && alongRows && single, "no backtracking for high sun, sun along the rows, single tracker");
+    check.expect(shadeFree && shadedWithout, "backtracked tilt is shade free, pointing at the sun is not");
+    check.expect(steepest, "backtracked tilt is the steepest shade-free one");
+    check.expect(year.backtrack > year.plain && year.backtrack <= year.ideal,
+                 "year: backtracking recovers energy lost to row shading");
+#ifdef ST_STRATEGY_RUNTIME
+    check.expect(runs[2].capture > runs[0].capture && runs[2].capture >= runs[1].capture,
+                 "firmware day: backtrack strategy beats tracking into the shadow");
+#endif
+    check.expect(statusReports, "/status reports backtracking in the morning");
+    check.expect(geoRoundtrip, "/geo/save stores the row geometry, /geo.json returns it with the GCR");
+    check.expect(rejected, "/geo/save rejects panels wider than the pitch and a width without a pitch");
+
+    return check.finish();
+}
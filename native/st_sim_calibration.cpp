@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_sensors.h"
+#include "st_servo.h"
+#include "st_history_log.h"
+#include "st_clock.h"
+#include "st_motion.h"
+#include "st_calibration.h"
+#include "st_control.h"
+#include "time_rtc.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// CALIBRATION CHECK
+// =====================================================
+// The search as a tracker state: loop() never blocks, /status stays
+// live, cancel works and a reboot resumes from the persisted cursor.
+// Reference is the old blocking sweep (nested loops with delay()).
+// Then grid vs. adaptive search on a mount that is off by a few degrees,
+// so the sun seed is close but not right.
+
+struct LegacySweep
+{
+    int32_t yaw;
+    int32_t tilt;
+    uint64_t blockedMs;
+};
+
+static LegacySweep legacyCalibrationSweep()
+{
+    LegacySweep r = {9000, 9000, 0};
+    int maxLightSum = 0;
+    uint64_t t0 = nativeClockMicros();
+    for (int32_t y = YAW_MIN * ANGLE_SCALE; y <= YAW_MAX * ANGLE_SCALE; y += 10 * ANGLE_SCALE)
+    {
+        for (int32_t t = TILT_MIN * ANGLE_SCALE; t <= TILT_MAX * ANGLE_SCALE; t += 10 * ANGLE_SCALE)
+        {
+            servoWriteYaw(y);
+            servoWriteTilt(t);
+            sensorsFlush();
+            delay(300);
+            LdrFrame ldr;
+            sensorsRead(ldr);
+            int lightSum = ldr.tl + ldr.tr + ldr.bl + ldr.br;
+            if (lightSum > maxLightSum)
+            {
+                maxLightSum = lightSum;
+                r.yaw = y;
+                r.tilt = t;
+            }
+        }
+    }
+    r.blockedMs = (nativeClockMicros() - t0) / 1000;
+    return r;
+}
+
+struct SweepRun
+{
+    uint32_t passes;
+    uint64_t maxBlockedUs; // virtual time spent inside one loop() pass
+    bool statusLive;       // /status answered while calibrating
+};
+
+// Runs loop() in 20 ms steps until the sweep ends or `stopAt` points are done
+static SweepRun runSweep(uint16_t stopAt)
+{
+    SweepRun r = {0, 0, true};
+    CalibrationStatus cal;
+    calibrationGetStatus(cal);
+    while (trackerState == STATE_CALIBRATING && cal.done < stopAt && r.passes < 1000000)
+    {
+        nativeClockAdvance(20000);
+        uint64_t t0 = nativeClockMicros();
+        loop();
+        r.maxBlockedUs = std::max(r.maxBlockedUs, nativeClockMicros() - t0);
+        if (r.passes % 100 == 0 && trackerState == STATE_CALIBRATING)
+            r.statusLive = r.statusLive && server.request(HTTP_GET, "/status") == 200 &&
+                           String(server.responseBody()).indexOf("\"state\":\"CALIBRATING\"") >= 0;
+        calibrationGetStatus(cal);
+        r.passes++;
+    }
+    return r;
+}
+
+struct SearchResult
+{
+    uint16_t points;
+    double travel;     // servo travel, degrees
+    double seconds;    // virtual time until back in TRACKING
+    double pointError; // panel normal vs. sun, degrees
+};
+
+static SearchResult runSearch(CalibrationMode mode, bool seeded)
+{
+    bool timeWas = timeInitialized;
+    timeInitialized = seeded;
+    fakeResetServoStats();
+    uint64_t t0 = nativeClockMicros();
+    calibrationStart(mode);
+    timeInitialized = timeWas;
+    runSweep(UINT16_MAX);
+
+    SearchResult r;
+    CalibrationStatus cal;
+    calibrationGetStatus(cal);
+    r.points = cal.done;
+    r.travel = (fakeServoStats().yawTravel + fakeServoStats().tiltTravel) / (double)ANGLE_SCALE;
+    r.seconds = (nativeClockMicros() - t0) / 1e6;
+    double az, alt;
+    poseToDirection(cal.bestYaw, cal.bestTilt, az, alt);
+    r.pointError = angleBetween(az, alt, sky.azimuth, sky.altitude);
+    return r;
+}
+
+int simCheckCalibration(int argc, char **argv)
+{
+    SimOptions o;
+    o.mountAz = 6.0;
+    o.mountAlt = -3.0;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    // Fixed sky: the sun does not move during one search. Exact LDRs for
+    // the equality checks, noise only for the comparison.
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    fakeRtcSet(start);
+    fakeSetLdrModel(ldrModel);
+    fakeSetLdrNoise(0);
+    halFsBegin();
+    LittleFS.remove("/config.bin");
+    LittleFS.remove("/calibration.run");
+    updateSky(start, o.latitude, o.longitude, false);
+    setup();
+    nativeClockAdvance(READ_INTERVAL * 1000);
+    loop();
+
+    LegacySweep legacy = legacyCalibrationSweep();
+    printf("Calibration, sun at az %.1f° alt %.1f°\n", sky.azimuth, sky.altitude);
+    printf("       old: one loop() pass blocked for %llu ms, best yaw %.0f° tilt %.0f°\n",
+           (unsigned long long)legacy.blockedMs, cdToDeg(legacy.yaw), cdToDeg(legacy.tilt));
+
+    // Handlers post commands; the next control step applies them
+    check.expect(server.request(HTTP_GET, "/calibrate/start", {{"mode", "grid"}}) == 200,
+                 "/calibrate/start -> 200");
+    check.expect(server.request(HTTP_GET, "/calibrate/start") == 409, "second start while one is pending -> 409");
+    loop();
+    check.expect(trackerState == STATE_CALIBRATING, "next control step -> STATE_CALIBRATING");
+    check.expect(server.request(HTTP_GET, "/calibrate/start") == 409, "start while running -> 409");
+
+    CalibrationStatus cal;
+    calibrationGetStatus(cal);
+    SweepRun full = runSweep(cal.total);
+    int32_t savedYaw, savedTilt;
+    loadCalibrationData(savedYaw, savedTilt);
+    calibrationGetStatus(cal);
+    check.expect(trackerState == STATE_TRACKING && cal.result == CAL_RESULT_DONE && cal.done == cal.total,
+                 "grid sweep completes and returns to TRACKING");
+    check.expect(savedYaw == legacy.yaw && savedTilt == legacy.tilt, "grid: same best position as the blocking sweep");
+    check.expect(full.maxBlockedUs < 1000, "no loop() pass blocks (virtual time < 1 ms)");
+    check.expect(full.statusLive, "/status answers during the sweep and reports CALIBRATING");
+    printf("       new: %u points over %u loop() passes, max %llu us blocked per pass\n",
+           cal.total, full.passes, (unsigned long long)full.maxBlockedUs);
+
+    // Adaptive search once straight through, once with a reboot halfway:
+    // setup() must pick up the cursor (phase, step, direction) from flash.
+    // Same RTC time for both, so both get the same sun seed.
+    fakeRtcSet(start);
+    clockSeedFromRtc();
+    calibrationStart(CAL_MODE_ADAPTIVE);
+    runSweep(UINT16_MAX);
+    int32_t straightYaw, straightTilt;
+    loadCalibrationData(straightYaw, straightTilt);
+    calibrationGetStatus(cal);
+    uint16_t straightPoints = cal.done;
+
+    LittleFS.remove("/config.bin");
+    fakeRtcSet(start);
+    clockSeedFromRtc();
+    calibrationStart(CAL_MODE_ADAPTIVE);
+    uint16_t rebootAt = straightPoints / 2;
+    runSweep(rebootAt);
+    setup();
+    calibrationGetStatus(cal);
+    check.expect(trackerState == STATE_CALIBRATING && cal.resumed && cal.done == rebootAt,
+                 "reboot resumes at the persisted point");
+    MotionStatus motion;
+    HistoryRecord lastPose;
+    motionRead(motion);
+    check.expect(historyLogLast(lastPose) && motion.yaw == clampYawCd(lastPose.yaw) &&
+                     motion.tilt == clampTiltCd(lastPose.tilt),
+                 "resumed search: the planner starts from the last logged pose, not a direct write");
+    server.request(HTTP_GET, "/calibrate/status");
+    check.expect(server.responseCode() == 200 && String(server.responseBody()).indexOf("\"resumed\":true") >= 0,
+                 "/calibrate/status reports the resumed search");
+    runSweep(UINT16_MAX);
+    loadCalibrationData(savedYaw, savedTilt);
+    calibrationGetStatus(cal);
+    check.expect(trackerState == STATE_TRACKING && savedYaw == straightYaw && savedTilt == straightTilt &&
+                     cal.done == straightPoints,
+                 "resumed search takes the same path to the same position");
+
+    // Cancel keeps the previous calibration and the cursor is dropped.
+    // On the way: the control step alone never opens a file, loop() writes
+    // the cursor it left behind.
+    calibrationStart(CAL_MODE_GRID);
+    LittleFS.resetStats();
+    calibrationGetStatus(cal);
+    for (int i = 0; i < 1000 && cal.done < 3; i++)
+    {
+        nativeClockAdvance(20000);
+        controlStep();
+        calibrationGetStatus(cal);
+    }
+    bool stepOpened = LittleFS.stats().opens > 0 || LittleFS.exists("/calibration.run");
+    calibrationService();
+    check.expect(cal.done == 3 && !stepOpened && LittleFS.exists("/calibration.run"),
+                 "control step leaves /calibration.run to calibrationService() in loop()");
+    runSweep(10);
+    check.expect(server.request(HTTP_GET, "/calibrate/cancel") == 200, "/calibrate/cancel -> 200");
+    loop();
+    check.expect(trackerState == STATE_TRACKING, "next control step -> TRACKING");
+    calibrationGetStatus(cal);
+    loadCalibrationData(savedYaw, savedTilt);
+    check.expect(cal.result == CAL_RESULT_CANCELLED && !LittleFS.exists("/calibration.run") &&
+                     savedYaw == straightYaw && savedTilt == straightTilt,
+                 "cancel drops the cursor and keeps the stored calibration");
+    check.expect(server.request(HTTP_GET, "/calibrate/cancel") == 409, "cancel without a sweep -> 409");
+
+    // A corrupt cursor is dropped as a whole and leaves the last search alone
+    const char *corrupt[] = {"2,7,0,0,0,0,0,0,0,0,0,255", "2,1,2,0,5,0,0,0,500,0,0,7", "2,1,2,0,5,0,0,0,500,0,9,255"};
+    bool rejected = true;
+    for (const char *line : corrupt)
+    {
+        File f = LittleFS.open("/calibration.run", "w");
+        f.print(line);
+        f.close();
+        rejected = rejected && !calibrationResume() && !LittleFS.exists("/calibration.run");
+    }
+    calibrationGetStatus(cal);
+    check.expect(rejected && cal.mode == CAL_MODE_GRID && cal.result == CAL_RESULT_CANCELLED,
+                 "cursor with bad mode, back or fails is discarded without touching the state");
+
+    // Grid vs. adaptive over the day, with ADC noise
+    fakeSetLdrNoise(o.noise);
+    printf("\nMount off by az %+.1f° alt %+.1f°, noise ±%d\n", o.mountAz, o.mountAlt, o.noise);
+    printf("  %-5s %-17s %6s %9s %8s %11s\n", "time", "search", "points", "travel", "time", "point err");
+    const char *names[] = {"grid 10°", "adaptive, sun", "adaptive, coarse"};
+    SearchResult sum[3] = {};
+    int runs = 0;
+    for (int hour = 8; hour <= 16; hour += 2)
+    {
+        DateTime t(o.year, o.month, o.day, hour, 0, 0);
+        fakeRtcSet(t);
+        clockSeedFromRtc();
+        simSkyMove(t, o);
+        SearchResult r[3] = {runSearch(CAL_MODE_GRID, false), runSearch(CAL_MODE_ADAPTIVE, true),
+                             runSearch(CAL_MODE_ADAPTIVE, false)};
+        for (int k = 0; k < 3; k++)
+        {
+            printf("  %02d:00 %-17s %6u %8.0f° %7.1fs %10.2f°\n", hour, names[k], r[k].points, r[k].travel,
+                   r[k].seconds, r[k].pointError);
+            sum[k].points += r[k].points;
+            sum[k].travel += r[k].travel;
+            sum[k].seconds += r[k].seconds;
+            sum[k].pointError += r[k].pointError;
+        }
+        runs++;
+    }
+    printf("  %-5s %-17s %6s %9s %8s %11s\n", "", "mean", "", "", "", "");
+    for (int k = 0; k < 3; k++)
+        printf("        %-17s %6.0f %8.0f° %7.1fs %10.2f°\n", names[k], (double)sum[k].points / runs,
+               sum[k].travel / runs, sum[k].seconds / runs, sum[k].pointError / runs);
+
+    check.expect(sum[1].points * 4 < sum[0].points && sum[1].pointError < sum[0].pointError,
+                 "seeded adaptive: under a quarter of the points, lower pointing error than the grid");
+    check.expect(sum[2].points * 2 < sum[0].points && sum[2].pointError < sum[0].pointError,
+                 "coarse adaptive: under half of the points, lower pointing error than the grid");
+
+    return check.finish();
+}
@@ -0,0 +1,265 @@
+#include <random>
+#include <algorithm>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <SolarCalculator.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+
+// =====================================================
+// OPTIONS
+// =====================================================
+static double mountAz = 0.0;
+static double mountAlt = 0.0;
+
+struct SimRows
+{
+    double pitch; // 0 = single tracker, no shading
+    double width;
+    double azimuth;
+};
+
+static SimRows rows = {0.0, 2.0, 90.0};
+
+bool parseOptions(int argc, char **argv, SimOptions &o)
+{
+    for (int i = 0; i < argc; i++)
+    {
+        String key(argv[i]);
+        if (key == "--daily")
+        {
+            o.daily = true;
+            continue;
+        }
+        if (key == "--no-backtrack")
+        {
+            o.backtrack = false;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "missing value for %s\n", argv[i]);
+            return false;
+        }
+        const char *v = argv[++i];
+        if (key == "--lat")
+            o.latitude = atof(v);
+        else if (key == "--lon")
+            o.longitude = atof(v);
+        else if (key == "--start")
+        {
+            if (sscanf(v, "%d-%d-%d", &o.year, &o.month, &o.day) != 3)
+            {
+                fprintf(stderr, "--start expects YYYY-MM-DD\n");
+                return false;
+            }
+        }
+        else if (key == "--days")
+            o.days = atoi(v);
+        else if (key == "--clouds")
+            o.clouds = constrain(atof(v), 0.0, 1.0);
+        else if (key == "--seed")
+            o.seed = (unsigned)strtoul(v, nullptr, 10);
+        else if (key == "--noise")
+            o.noise = atoi(v);
+        else if (key == "--mount-az")
+            o.mountAz = atof(v);
+        else if (key == "--mount-alt")
+            o.mountAlt = atof(v);
+        else if (key == "--step-ms")
+            o.stepMs = strtoul(v, nullptr, 10);
+        else if (key == "--strategy")
+            o.strategy = v;
+        else if (key == "--row-pitch")
+            o.rowPitch = atof(v);
+        else if (key == "--panel-width")
+            o.panelWidth = atof(v);
+        else if (key == "--row-az")
+            o.rowAzimuth = atof(v);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+    mountAz = o.mountAz;
+    mountAlt = o.mountAlt;
+    rows = {o.rowPitch, o.panelWidth, o.rowAzimuth};
+    return o.days > 0 && o.stepMs > 0;
+}
+
+// =====================================================
+// SKY MODEL
+// =====================================================
+Sky sky = {0, 0, 0, 0};
+std::mt19937 rng;
+
+double radians(double deg)
+{
+    return deg * M_PI / 180.0;
+}
+
+double degrees(double rad)
+{
+    return rad * 180.0 / M_PI;
+}
+
+// Servo pose (centidegrees) -> panel normal, inverse of sunPositionToServoAngles()
+// plus the simulated mounting error
+void poseToDirection(int32_t yaw, int32_t tilt, double &az, double &alt)
+{
+    az = cdToDeg(yaw) * 360.0 / 180.0 + mountAz;
+    alt = (constrain(cdToDeg(tilt), (float)TILT_MIN, (float)TILT_MAX) - TILT_MIN) * 90.0 / (TILT_MAX - TILT_MIN) + mountAlt;
+}
+
+double angleBetween(double az1, double alt1, double az2, double alt2)
+{
+    double c = sin(radians(alt1)) * sin(radians(alt2)) +
+               cos(radians(alt1)) * cos(radians(alt2)) * cos(radians(az1 - az2));
+    return degrees(acos(constrain(c, -1.0, 1.0)));
+}
+
+// Fraction of the panel in the neighbouring row's shadow, neighbours
+// posed alike. Cross-section in the vertical plane through the sun: the
+// panel (tilt 90° - panelAlt) spans width * sin(alt + tilt) across the
+// rays, the next row along the sun's azimuth is pitch / |cos(az - rowAz)|
+// away and covers all but pitch' * sin(alt) of it.
+double rowShade(double panelAlt)
+{
+    if (rows.pitch <= 0.0 || rows.width <= 0.0 || sky.altitude <= 0.0)
+        return 0.0;
+    double c = fabs(cos(radians(sky.azimuth - rows.azimuth)));
+    double across = rows.width * sin(radians(sky.altitude + 90.0 - panelAlt));
+    if (c < 1e-9 || across <= 0.0)
+        return 0.0;
+    double clear = rows.pitch / c * sin(radians(sky.altitude));
+    return constrain(1.0 - clear / across, 0.0, 1.0);
+}
+
+// Beam lost to the shadow. Linear in the shaded area, tracking into the
+// shadow and backtracking would catch the same beam (both equal
+// pitch' * sin(alt) / width); the cells are what differs: the width holds
+// ROW_SUBSTRINGS bypass-diode substrings, one with a shaded cell is
+// bypassed.
+static const int ROW_SUBSTRINGS = 3;
+
+double rowLoss(double panelAlt)
+{
+    double shade = rowShade(panelAlt);
+    return shade < 1e-6 ? 0.0 : std::min(ceil(shade * ROW_SUBSTRINGS - 1e-6), (double)ROW_SUBSTRINGS) / ROW_SUBSTRINGS;
+}
+
+double wrap180(double deg)
+{
+    while (deg > 180.0)
+        deg -= 360.0;
+    while (deg < -180.0)
+        deg += 360.0;
+    return deg;
+}
+
+void updateSky(const DateTime &t, double lat, double lon, bool cloudy)
+{
+    calcHorizontalCoordinates(t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second(),
+                              lat, lon, sky.azimuth, sky.altitude);
+
+    if (sky.altitude <= 0.0)
+    {
+        // Civil twilight fades out over 6° below the horizon
+        sky.direct = 0.0;
+        sky.diffuse = sky.altitude > -6.0 ? 20.0 * (1.0 + sky.altitude / 6.0) : 0.0;
+    }
+    else
+    {
+        double airMass = std::min(1.0 / sin(radians(sky.altitude)), 38.0);
+        sky.direct = 1353.0 * pow(0.7, pow(airMass, 0.678));
+        sky.diffuse = 20.0 + 0.1 * sky.direct * sin(radians(sky.altitude));
+    }
+
+    if (cloudy)
+    {
+        sky.diffuse = 0.3 * (sky.direct + sky.diffuse) * sin(radians(std::max(sky.altitude, 0.0)));
+        sky.direct *= 0.1;
+    }
+}
+
+// Quad LDR behind a cross-shaped shade: the half facing the sun gets more
+// beam light, saturating at ±20° off-axis.
+void ldrModel(int32_t yaw, int32_t tilt, int &tl, int &tr, int &bl, int &br)
+{
+    double panelAz, panelAlt;
+    poseToDirection(yaw, tilt, panelAz, panelAlt);
+
+    double offAxis = angleBetween(panelAz, panelAlt, sky.azimuth, sky.altitude);
+    double beam = sky.direct * std::max(0.0, cos(radians(offAxis)));
+    double sYaw = constrain(wrap180(sky.azimuth - panelAz) / 2.0 / 20.0, -0.8, 0.8) * YAW_DIR;
+    double sTilt = constrain((sky.altitude - panelAlt) / 20.0, -0.8, 0.8) * TILT_DIR;
+
+    auto adc = [&](double left, double top) {
+        double e = sky.diffuse + beam * (1.0 + left * sYaw) * (1.0 + top * sTilt);
+        return constrain((int)(e * 3.0), 0, 4095);
+    };
+    tl = adc(+1, +1);
+    tr = adc(-1, +1);
+    bl = adc(+1, -1);
+    br = adc(-1, -1);
+}
+
+// =====================================================
+// FIXTURES
+// =====================================================
+void simBegin(const SimOptions &o)
+{
+    rng.seed(o.seed);
+    fakeSetLdrModel(ldrModel);
+    fakeSetLdrNoise(o.noise);
+    halFsBegin();
+    LittleFS.remove("/calibration.run");
+}
+
+void simSkyAt(const DateTime &t, const SimOptions &o)
+{
+    fakeRtcSet(t);
+    simSkyMove(t, o);
+}
+
+void simSkyMove(const DateTime &t, const SimOptions &o)
+{
+    updateSky(t, o.latitude, o.longitude, false);
+    fakeLdrModelChanged();
+}
+
+void simRun(uint32_t passes, uint64_t stepUs)
+{
+    for (uint32_t i = 0; i < passes; i++)
+    {
+        nativeClockAdvance(stepUs);
+        loop();
+    }
+}
+
+bool simRunUntil(TrackerState state, uint32_t maxPasses, uint64_t stepUs)
+{
+    for (uint32_t i = 0; i < maxPasses && trackerState != state; i++)
+    {
+        nativeClockAdvance(stepUs);
+        loop();
+    }
+    return trackerState == state;
+}
+
+void SimCheck::expect(bool ok, const char *what)
+{
+    if (!ok)
+        failures++;
+    printf("  %-4s %s\n", ok ? "ok" : "FAIL", what);
+}
+
+int SimCheck::finish() const
+{
+    printf("%s (%d failed)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+#ifndef ST_SIM_COMMON_H
+#define ST_SIM_COMMON_H
+
+#include <atomic>
+#include <random>
+#include <vector>
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <RTClib.h>
+#include "config.h"
+#include "tracker_state.h"
+
+// =====================================================
+// SHARED BY THE HOST CHECKS (st_sim_*.cpp)
+// =====================================================
+// Options, the sky and LDR model, the firmware globals the checks poke,
+// boot fixtures and the pass/fail lines. One check mode per process.
+
+void setup();
+void loop();
+
+extern AsyncWebServer server;
+extern AsyncEventSource events;
+extern int32_t yawAngle;
+extern int32_t tiltAngle;
+extern std::atomic<bool> weatherSaysStop;
+extern TrackerState trackerState;
+extern bool littlefsAvailable;
+
+// =====================================================
+// OPTIONS
+// =====================================================
+struct SimOptions
+{
+    double latitude = DEFAULT_LATITUDE;
+    double longitude = DEFAULT_LONGITUDE;
+    int year = 2025;
+    int month = 6;
+    int day = 21;
+    int days = 1;
+    double clouds = 0.0; // long-run fraction of cloudy time, 0..1
+    unsigned seed = 1;
+    unsigned long stepMs = READ_INTERVAL;
+    int noise = 8; // ADC noise, ± counts per raw sample
+    double mountAz = 0.0;  // mounting error of the panel, degrees
+    double mountAlt = 0.0;
+    bool daily = false;
+    String strategy; // sim: tracking strategy name or "all", empty = built in
+    double rowPitch = 0.0; // neighbouring rows for the shading model (m), 0 = none
+    double panelWidth = 2.0;
+    double rowAzimuth = 90.0;
+    bool backtrack = true; // the firmware is told about the rows (settings)
+};
+
+// Also sets the mounting error and rows of the sky model
+bool parseOptions(int argc, char **argv, SimOptions &o);
+
+// =====================================================
+// SKY MODEL
+// =====================================================
+struct Sky
+{
+    double azimuth;  // degrees
+    double altitude; // degrees
+    double direct;   // W/m², beam normal
+    double diffuse;  // W/m², isotropic
+};
+
+extern Sky sky;
+extern std::mt19937 rng;
+
+double radians(double deg);
+double degrees(double rad);
+double wrap180(double deg);
+// Servo pose (centidegrees) -> panel normal, inverse of sunPositionToServoAngles()
+// plus the simulated mounting error
+void poseToDirection(int32_t yaw, int32_t tilt, double &az, double &alt);
+double angleBetween(double az1, double alt1, double az2, double alt2);
+// Fraction of the panel in the neighbouring row's shadow, and the beam
+// lost to it (whole bypass-diode substrings)
+double rowShade(double panelAlt);
+double rowLoss(double panelAlt);
+void updateSky(const DateTime &t, double lat, double lon, bool cloudy);
+// LDR model for fakeSetLdrModel()
+void ldrModel(int32_t yaw, int32_t tilt, int &tl, int &tr, int &bl, int &br);
+
+// =====================================================
+// FIXTURES
+// =====================================================
+// Seeded sky, LDR model with the option's noise, file system mounted,
+// no calibration run left over
+void simBegin(const SimOptions &o);
+// RTC and clear sky at `t`, LDR model re-read
+void simSkyAt(const DateTime &t, const SimOptions &o);
+// Clear sky at `t` without touching the RTC, LDR model re-read
+void simSkyMove(const DateTime &t, const SimOptions &o);
+// `passes` loop() passes, stepUs of virtual time before each
+void simRun(uint32_t passes, uint64_t stepUs = 1000);
+// loop() until the tracker is in `state`; false after maxPasses
+bool simRunUntil(TrackerState state, uint32_t maxPasses, uint64_t stepUs = 1000);
+
+// Day/year tracking run (st_sim_tracking.cpp)
+struct TrackingRun
+{
+    std::vector<uint32_t> errorHist; // 0.1° bins
+    uint64_t errorSamples = 0;
+    double errorSum = 0;
+    double energy = 0;
+    double ideal = 0;
+    uint32_t transitions = 0;
+    uint32_t toTracking = 0;
+    uint32_t toSleep = 0;
+    uint32_t historyRows = 0;
+    double wall = 0;
+
+    double percentile(double p) const
+    {
+        uint64_t target = (uint64_t)(errorSamples * p);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < errorHist.size(); i++)
+        {
+            seen += errorHist[i];
+            if (seen > target)
+                return i / 10.0;
+        }
+        return 180.0;
+    }
+    double maxError() const
+    {
+        for (size_t i = errorHist.size(); i-- > 0;)
+        {
+            if (errorHist[i])
+                return i / 10.0;
+        }
+        return 0.0;
+    }
+    double meanError() const { return errorSamples ? errorSum / errorSamples : 0.0; }
+    double capture() const { return ideal > 0 ? 100.0 * energy / ideal : 0.0; }
+};
+
+// Same sky (seeded clouds), same start for every run; servo stats in
+// fakeServoStats() afterwards
+TrackingRun runTracking(const SimOptions &o);
+
+// Pass/fail lines of one check, then the verdict
+class SimCheck
+{
+public:
+    void expect(bool ok, const char *what);
+    // Prints PASSED/FAILED, returns the exit code
+    int finish() const;
+
+private:
+    int failures = 0;
+};
+
+#endif
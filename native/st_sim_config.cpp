@@ -0,0 +1,297 @@
+#include <chrono>
+#include <map>
+#include <string>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_calibration.h"
+#include "st_control.h"
+#include "st_helpers.h"
+#include "st_config.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// CONFIG STORE CHECK
+// =====================================================
+// The four text files against /config.bin: migration, boot cost (file
+// opens, host time), skipped saves, a power cut in the middle of a save
+// and a record from an older, shorter schema.
+
+#define CONFIG_SIM_MAGIC 0x46435453 // "STCF", st_config.cpp
+
+static void writeTextFile(const char *path, const char *text)
+{
+    File f = LittleFS.open(path, "w");
+    f.print(text);
+    f.close();
+}
+
+static void writeLegacyConfig()
+{
+    writeTextFile("/geo.txt", "47.500000,9.750000,0,7200\n");
+    writeTextFile("/wifi.txt", "Gartenhaus,sonne2025\n");
+    writeTextFile("/calibration.txt", "123.45,67.80\n");
+    writeTextFile("/debug.txt", "0\n");
+}
+
+// loadDebugConfig/loadGeoConfig/loadWifiConfig/loadCalibrationData as
+// they were, minus the log output
+static void legacyLoadConfig(Settings &s)
+{
+    if (LittleFS.exists("/debug.txt"))
+    {
+        File f = LittleFS.open("/debug.txt", "r");
+        String data = f.readString();
+        f.close();
+        data.trim();
+        s.debug = (data == "1" || data.equalsIgnoreCase("true"));
+    }
+    if (LittleFS.exists("/geo.txt"))
+    {
+        File f = LittleFS.open("/geo.txt", "r");
+        String data = f.readString();
+        f.close();
+        int firstComma = data.indexOf(',');
+        if (firstComma > 0)
+        {
+            s.latitude = data.substring(0, firstComma).toDouble();
+            int secondComma = data.indexOf(',', firstComma + 1);
+            if (secondComma > 0)
+            {
+                s.longitude = data.substring(firstComma + 1, secondComma).toDouble();
+                int thirdComma = data.indexOf(',', secondComma + 1);
+                if (thirdComma > 0)
+                {
+                    s.autoDst = (data.substring(secondComma + 1, thirdComma).toInt() == 1);
+                    s.timezoneOffset = data.substring(thirdComma + 1).toInt();
+                }
+            }
+        }
+    }
+    if (LittleFS.exists("/wifi.txt"))
+    {
+        File f = LittleFS.open("/wifi.txt", "r");
+        String data = f.readString();
+        f.close();
+        int firstComma = data.indexOf(',');
+        if (firstComma > 0)
+        {
+            String ssid = data.substring(0, firstComma);
+            String pass = data.substring(firstComma + 1);
+            ssid.trim();
+            pass.trim();
+            ssid.toCharArray(s.staSsid, 64);
+            pass.toCharArray(s.staPass, 64);
+        }
+    }
+    if (LittleFS.exists("/calibration.txt"))
+    {
+        File f = LittleFS.open("/calibration.txt", "r");
+        String data = f.readString();
+        f.close();
+        int commaIndex = data.indexOf(',');
+        if (commaIndex > 0)
+        {
+            s.calibYaw = clampYawCd(degToCd(data.substring(0, commaIndex).toFloat()));
+            s.calibTilt = clampTiltCd(degToCd(data.substring(commaIndex + 1).toFloat()));
+        }
+    }
+}
+
+// saveGeoConfig as it was: the whole file, every time
+static void legacySaveGeo(const Settings &s)
+{
+    File f = LittleFS.open("/geo.txt", "w");
+    f.print(s.latitude, 6);
+    f.print(",");
+    f.print(s.longitude, 6);
+    f.print(",");
+    f.print(s.autoDst ? "1" : "0");
+    f.print(",");
+    f.println(s.timezoneOffset);
+    f.close();
+}
+
+static bool migratedValues(const Settings &s)
+{
+    return s.latitude == 47.5 && s.longitude == 9.75 && !s.autoDst && s.timezoneOffset == 7200 &&
+           strcmp(s.staSsid, "Gartenhaus") == 0 && strcmp(s.staPass, "sonne2025") == 0 && s.calibYaw == 12345 &&
+           s.calibTilt == 6780 && !s.debug;
+}
+
+// Flips one payload byte of a slot, like a save cut off halfway
+static void corruptSlot(uint8_t slot)
+{
+    File f = LittleFS.open("/config.bin", "r+");
+    f.seek(slot * CONFIG_SLOT_SIZE + 24);
+    uint8_t b = 0;
+    f.read(&b, 1);
+    b ^= 0x5A;
+    f.seek(slot * CONFIG_SLOT_SIZE + 24);
+    f.write(&b, 1);
+    f.close();
+}
+
+int simCheckConfig(int argc, char **argv)
+{
+    SimOptions o;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+    auto status = []() {
+        ConfigStoreStatus s;
+        configStoreRead(s);
+        return s;
+    };
+
+    fakeRtcSet(DateTime(o.year, o.month, o.day, 10, 0, 0));
+    halFsBegin();
+    LittleFS.remove("/config.bin");
+    LittleFS.remove("/calibration.run");
+    writeLegacyConfig();
+
+    // First boot after the update: the text files become the record
+    setup();
+    ConfigStoreStatus st = status();
+    bool gone = !LittleFS.exists("/geo.txt") && !LittleFS.exists("/wifi.txt") &&
+                !LittleFS.exists("/calibration.txt") && !LittleFS.exists("/debug.txt");
+    int32_t calYaw, calTilt;
+    loadCalibrationData(calYaw, calTilt);
+    check.expect(st.migrated && st.seq == 1 && migratedValues(settings) && gone && calYaw == 12345 && calTilt == 6780,
+                 "legacy text files migrated into /config.bin and removed");
+
+    // Boot cost: four files with String parsing vs. one read
+    const int boots = 2000;
+    Settings legacy = SETTINGS_DEFAULTS;
+    writeLegacyConfig();
+    LittleFS.resetStats();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < boots; i++)
+    {
+        legacy = SETTINGS_DEFAULTS;
+        legacyLoadConfig(legacy);
+    }
+    double legacyUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / boots;
+    uint32_t legacyOpens = LittleFS.stats().opens / boots;
+    for (const char *p : {"/geo.txt", "/wifi.txt", "/calibration.txt", "/debug.txt"})
+        LittleFS.remove(p);
+
+    LittleFS.resetStats();
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < boots; i++)
+        configLoad();
+    double storeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / boots;
+    uint32_t storeOpens = LittleFS.stats().opens / boots;
+    printf("Boot: text files %u opens %.1f us, /config.bin %u open %.1f us (host)\n", (unsigned)legacyOpens, legacyUs,
+           (unsigned)storeOpens, storeUs);
+    check.expect(migratedValues(legacy) && migratedValues(settings), "both read the same values");
+    check.expect(storeOpens == 1 && legacyOpens == 4 && storeUs < legacyUs,
+                 "one open and one read instead of four parsed files");
+
+    // The geo form saved ten times unchanged, then once changed
+    std::map<std::string, std::string> geo = {{"lat", "47.5"}, {"lon", "9.75"}, {"autodst", "0"}, {"tzoffset", "2"}};
+    LittleFS.resetStats();
+    for (int i = 0; i < 10; i++)
+        legacySaveGeo(settings);
+    FsStats legacySaves = LittleFS.stats();
+    LittleFS.remove("/geo.txt");
+    LittleFS.resetStats();
+    st = status();
+    bool answered = true;
+    for (int i = 0; i < 10; i++)
+    {
+        answered = answered && server.request(HTTP_POST, "/geo/save", geo) == 200;
+        controlStep();
+        configService();
+    }
+    FsStats unchanged = LittleFS.stats();
+    uint32_t skipped = status().skipped - st.skipped;
+    geo["lat"] = "48.25";
+    server.request(HTTP_POST, "/geo/save", geo);
+    controlStep();
+    configService();
+    FsStats changed = LittleFS.stats();
+    printf("10 unchanged geo saves: text file %u opens %llu bytes, /config.bin %u opens %llu bytes; one change: %llu bytes\n",
+           (unsigned)legacySaves.opens, (unsigned long long)legacySaves.bytesWritten, (unsigned)unchanged.opens,
+           (unsigned long long)unchanged.bytesWritten, (unsigned long long)(changed.bytesWritten - unchanged.bytesWritten));
+    check.expect(answered && skipped == 10 && unchanged.bytesWritten == 0 && unchanged.opens == 0,
+                 "unchanged saves skip the flash");
+    st = status();
+    check.expect(changed.bytesWritten == 16 + sizeof(Settings) && st.seq == 2 && st.slot == 1 &&
+                     settings.latitude == 48.25,
+                 "a change writes one slot, the other keeps the previous record");
+
+    // Power cut in the middle of the next save: its slot fails the CRC
+    corruptSlot(st.slot);
+    configLoad();
+    check.expect(status().seq == 1 && settings.latitude == 47.5 && migratedValues(settings),
+                 "torn save: boot falls back to the previous record");
+    settings.latitude = 48.25;
+    configSave();
+    st = status();
+    configLoad();
+    check.expect(st.slot == 1 && status().seq == st.seq && settings.latitude == 48.25,
+                 "next save overwrites the torn slot, never the good one");
+
+    // Only the fields count: tail padding differs, the strings have junk
+    // past their terminator
+    size_t used = offsetof(Settings, rowAzimuth) + sizeof(settings.rowAzimuth);
+    memset((uint8_t *)&settings + used, 0xA5, sizeof(Settings) - used);
+    memset(settings.staSsid + strlen(settings.staSsid) + 1, 'y', 4);
+    LittleFS.resetStats();
+    bool same = !configSave() && LittleFS.stats().bytesWritten == 0;
+    // Requests from any task: loop() saves once
+    settings.latitude = 48.5;
+    configRequestSave();
+    configRequestSave();
+    uint32_t writes = status().writes;
+    configService();
+    configService();
+    check.expect(same && status().writes == writes + 1 && status().seq == st.seq + 1,
+                 "padding and bytes past a string end are no change, requests collapse into one save");
+
+    corruptSlot(0);
+    corruptSlot(1);
+    configLoad();
+    check.expect(status().seq == 0 && settings.latitude == SETTINGS_DEFAULTS.latitude &&
+                     strcmp(settings.staSsid, SETTINGS_DEFAULTS.staSsid) == 0,
+                 "both slots broken: defaults, no garbage");
+
+    // Schema version 0: a record that ended before the calibration
+    struct
+    {
+        uint32_t magic, seq;
+        uint16_t version, size, reserved, check;
+    } h = {CONFIG_SIM_MAGIC, 7, 0, (uint16_t)offsetof(Settings, calibYaw), 0, 0};
+    Settings old = SETTINGS_DEFAULTS;
+    old.latitude = 46.0;
+    old.longitude = 8.0;
+    uint8_t slot[CONFIG_SLOT_SIZE] = {};
+    memcpy(slot, &h, sizeof(h));
+    memcpy(slot + sizeof(h), &old, h.size);
+    h.check = crc16(slot + sizeof(h), h.size, crc16(slot, offsetof(decltype(h), check)));
+    memcpy(slot, &h, sizeof(h));
+    File f = LittleFS.open("/config.bin", "w");
+    f.write(slot, sizeof(h) + h.size);
+    f.close();
+    configLoad();
+    st = status();
+    loadCalibrationData(calYaw, calTilt);
+    Settings upgraded = settings;
+    configLoad();
+    check.expect(upgraded.latitude == 46.0 && upgraded.longitude == 8.0 && calYaw == SETTINGS_DEFAULTS.calibYaw &&
+                     st.seq == 8 && st.writes == 1 && memcmp(&settings, &upgraded, sizeof(Settings)) == 0,
+                 "older schema: its fields kept, new ones default, rewritten as the current version");
+
+    LittleFS.remove("/config.bin");
+    littlefsAvailable = false;
+    settings.latitude = 1.0;
+    check.expect(!configSave(), "no file system: save is a no-op");
+    littlefsAvailable = true;
+
+    return check.finish();
+}
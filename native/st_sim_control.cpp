@@ -0,0 +1,125 @@
+#include <random>
+#include <algorithm>
+#include <Arduino.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_control.h"
+#include "st_snapshot.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// CONTROL TASK CHECK
+// =====================================================
+// Control-period jitter with the control step in loop() vs. in its own
+// (emulated) task, while a web handler blocks for 20..400 ms once per
+// second - the stand-in for a slow page, a LittleFS write or an NTP
+// round trip.
+
+static unsigned long slowHandlerMs = 0;
+
+static void handleSlow(AsyncWebServerRequest *request)
+{
+    delay(slowHandlerMs);
+    request->send(200, "text/plain", "ok");
+}
+
+struct ControlRun
+{
+    ControlTiming timing;
+    double meanError;
+    bool statusReportsTask;
+};
+
+static ControlRun runControl(bool task, bool slowLoad, int minutes, const SimOptions &o)
+{
+    fakeControlTaskEnable(task);
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    simSkyAt(start, o);
+    setup();
+    server.on("/slow", handleSlow);
+
+    // Through INIT before measuring
+    simRunUntil(STATE_TRACKING, 1000);
+    controlResetTiming();
+
+    std::uniform_int_distribution<int> slowMs(20, 400);
+    ControlRun r = {};
+    double errorSum = 0;
+    uint32_t errorSamples = 0;
+    const uint32_t endMs = minutes * 60000;
+    for (uint32_t ms = 1; ms <= endMs; ms++)
+    {
+        nativeClockAdvance(1000);
+        loop();
+        if (ms % 1000 == 0)
+        {
+            DateTime now(start.unixtime() + ms / 1000);
+            simSkyMove(now, o);
+            if (slowLoad)
+            {
+                slowHandlerMs = slowMs(rng);
+                server.request(HTTP_GET, "/slow");
+            }
+        }
+        if (ms % READ_INTERVAL == 0)
+        {
+            double az, alt;
+            poseToDirection(fakeServoYaw(), fakeServoTilt(), az, alt);
+            errorSum += angleBetween(az, alt, sky.azimuth, sky.altitude);
+            errorSamples++;
+        }
+    }
+
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    r.timing = snap.timing;
+    r.meanError = errorSamples ? errorSum / errorSamples : 0.0;
+    server.request(HTTP_GET, "/status");
+    r.statusReportsTask = String(server.responseBody()).indexOf(task ? "\"control\":{\"task\":true" : "\"control\":{\"task\":false") >= 0;
+    return r;
+}
+
+int simCheckControl(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 5; // minutes per run
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    simBegin(o);
+
+    // The task emulation stays on once started, so loop() runs go first
+    ControlRun quiet = runControl(false, false, o.days, o);
+    ControlRun inlineLoad = runControl(false, true, o.days, o);
+    ControlRun taskLoad = runControl(true, true, o.days, o);
+
+    printf("Control period %lu ms, %d min per run, slow handler 20..400 ms once per second\n",
+           READ_INTERVAL, o.days);
+    printf("  %-26s %8s %12s %11s %6s %10s\n", "", "periods", "jitter mean", "jitter max", "late", "point err");
+    auto row = [](const char *name, const ControlRun &r) {
+        printf("  %-26s %8u %9.2f ms %8.2f ms %6u %9.2f°\n", name, r.timing.periods, r.timing.meanJitterUs / 1000.0,
+               r.timing.maxJitterUs / 1000.0, r.timing.late, r.meanError);
+    };
+    row("loop(), no load", quiet);
+    row("loop(), slow handlers", inlineLoad);
+    row("control task, slow handlers", taskLoad);
+
+    check.expect(taskLoad.timing.maxJitterUs < CONTROL_TASK_PERIOD_MS * 1000 && taskLoad.timing.late == 0,
+                 "control task: jitter below one task period, no late periods under load");
+    check.expect(inlineLoad.timing.maxJitterUs > 10 * std::max(taskLoad.timing.maxJitterUs, (uint32_t)1000),
+                 "slow handlers show up as jitter when the step runs in loop()");
+    check.expect(quiet.statusReportsTask && taskLoad.statusReportsTask, "/status reports the control metrics");
+
+    // Commands from the web side reach the task within one period
+    server.request(HTTP_GET, "/calibrate/start", {{"mode", "grid"}});
+    nativeClockAdvance(CONTROL_TASK_PERIOD_MS * 1000);
+    bool started = trackerState == STATE_CALIBRATING;
+    server.request(HTTP_GET, "/calibrate/cancel");
+    nativeClockAdvance(CONTROL_TASK_PERIOD_MS * 1000);
+    check.expect(started && trackerState == STATE_TRACKING, "calibration start/cancel via the command mailbox");
+
+    return check.finish();
+}
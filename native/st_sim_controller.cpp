@@ -0,0 +1,148 @@
+#include <vector>
+#include <algorithm>
+#include <Arduino.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_sensors.h"
+#include "st_servo.h"
+#include "st_controller.h"
+#include "time_rtc.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// CONTROLLER STEP RESPONSE
+// =====================================================
+// Fixed sun, tracker starts 60° off in azimuth and 30° low. The
+// astronomical target carries a mounting offset the LDRs have to correct.
+
+typedef void (*ControlLaw)(bool haveTarget, int32_t targetYaw, int32_t targetTilt,
+                           float errorYaw, float errorTilt, int32_t &yaw, int32_t &tilt);
+
+// The ±1° bang-bang law loop() used before st_controller, on whole degrees
+static void legacyControlLaw(bool haveTarget, int32_t targetYaw, int32_t targetTilt,
+                             float errorYaw, float errorTilt, int32_t &yaw, int32_t &tilt)
+{
+    const int32_t one = ANGLE_SCALE;
+    targetYaw = targetYaw / one * one;
+    targetTilt = targetTilt / one * one;
+    if (haveTarget)
+    {
+        yaw += yaw < targetYaw ? one : (yaw > targetYaw ? -one : 0);
+        tilt += tilt < targetTilt ? one : (tilt > targetTilt ? -one : 0);
+    }
+    if (fabs(errorYaw) > DEAD_BAND_YAW)
+        yaw += (errorYaw > 0 ? one : -one) * YAW_DIR;
+    if (fabs(errorTilt) > DEAD_BAND_TILT)
+        tilt += (errorTilt > 0 ? one : -one) * TILT_DIR;
+    yaw = clampYawCd(yaw);
+    tilt = clampTiltCd(tilt);
+}
+
+struct StepResponse
+{
+    int settleTicks;      // -1: never settled
+    double overshoot;     // degrees past the final pointing
+    double finalError;    // degrees
+    uint32_t reversals;   // direction changes in the second half
+    double travel;        // servo degrees, both axes
+};
+
+static StepResponse runStepResponse(ControlLaw law, double offset, int ticks)
+{
+    const double sunAz = 200.0;
+    const double sunAlt = 40.0;
+    sky = {sunAz, sunAlt, 900.0, 40.0};
+    fakeLdrModelChanged();
+
+    sunPositionToServoAngles(sunAz + offset, sunAlt + offset);
+    int32_t targetYaw = targetYawFromSun;
+    int32_t targetTilt = targetTiltFromSun;
+
+    int32_t yaw = targetYaw - 30 * ANGLE_SCALE;
+    int32_t tilt = targetTilt - 30 * ANGLE_SCALE;
+    servoWriteYaw(yaw);
+    servoWriteTilt(tilt);
+    fakeResetServoStats();
+    controllerReset();
+    sensorsFlush();
+
+    std::vector<double> error;
+    std::vector<int32_t> yawTrace;
+    for (int i = 0; i < ticks; i++)
+    {
+        delay(READ_INTERVAL);
+        LdrFrame f;
+        sensorsRead(f);
+        float total = f.tl + f.tr + f.bl + f.br;
+        float errorYaw = ((f.tl + f.bl) - (f.tr + f.br)) / total;
+        float errorTilt = ((f.tl + f.tr) - (f.bl + f.br)) / total;
+
+        law(true, targetYaw, targetTilt, errorYaw, errorTilt, yaw, tilt);
+        if (yaw != fakeServoYaw())
+            servoWriteYaw(yaw);
+        if (tilt != fakeServoTilt())
+            servoWriteTilt(tilt);
+
+        double panelAz, panelAlt;
+        poseToDirection(fakeServoYaw(), fakeServoTilt(), panelAz, panelAlt);
+        error.push_back(angleBetween(panelAz, panelAlt, sunAz, sunAlt));
+        yawTrace.push_back(yaw);
+    }
+
+    StepResponse r = {-1, 0.0, error.back(), 0, 0};
+    const double settleBand = 2.5; // one yaw step is 2° of azimuth
+    for (int i = ticks - 1; i >= 0 && error[i] <= settleBand; i--)
+        r.settleTicks = i;
+
+    int32_t finalYaw = yawTrace.back();
+    for (int32_t y : yawTrace)
+        r.overshoot = std::max(r.overshoot, cdToDeg(y - finalYaw) * 2.0);
+
+    int lastDir = 0;
+    for (int i = ticks / 2 + 1; i < ticks; i++)
+    {
+        int32_t d = yawTrace[i] - yawTrace[i - 1];
+        if (d == 0)
+            continue;
+        int dir = d > 0 ? 1 : -1;
+        if (lastDir != 0 && dir != lastDir)
+            r.reversals++;
+        lastDir = dir;
+    }
+    r.travel = (fakeServoStats().yawTravel + fakeServoStats().tiltTravel) / (double)ANGLE_SCALE;
+    return r;
+}
+
+int simCheckController(int argc, char **argv)
+{
+    SimOptions o;
+    double offset = 3.0;
+    int ticks = 300;
+    for (int i = 0; i + 1 < argc; i += 2)
+    {
+        if (String(argv[i]) == "--offset")
+            offset = atof(argv[i + 1]);
+        else if (String(argv[i]) == "--ticks")
+            ticks = atoi(argv[i + 1]);
+        else if (String(argv[i]) == "--noise")
+            o.noise = atoi(argv[i + 1]);
+    }
+
+    fakeSetLdrModel(ldrModel);
+    fakeSetLdrNoise(o.noise);
+    sensorsBegin();
+
+    printf("Controller step response: 60° az / 30° tilt away, target offset %.1f°, %d ticks of %lu ms\n",
+           offset, ticks, READ_INTERVAL);
+    const char *names[] = {"bang-bang ±1°", "PI + feed-forward"};
+    ControlLaw laws[] = {legacyControlLaw, controllerStep};
+    for (int i = 0; i < 2; i++)
+    {
+        StepResponse r = runStepResponse(laws[i], offset, ticks);
+        printf("  %-18s settle %6.1f s  overshoot %4.1f°  final error %4.1f°  reversals %3u  travel %4.0f°\n",
+               names[i], r.settleTicks < 0 ? -1.0 : r.settleTicks * READ_INTERVAL / 1000.0,
+               r.overshoot, r.finalError, r.reversals, r.travel);
+    }
+    return 0;
+}
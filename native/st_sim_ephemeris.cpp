@@ -0,0 +1,86 @@
+#include <chrono>
+#include <algorithm>
+#include <Arduino.h>
+#include <SolarCalculator.h>
+#include "st_ephemeris.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// EPHEMERIS CHECK
+// =====================================================
+int simCheckEphemeris(int argc, char **argv)
+{
+    SimOptions o;
+    o.month = 1;
+    o.day = 1;
+    o.days = 365;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    DateTime start(o.year, o.month, o.day, 0, 0, 0);
+    double maxAz = 0, maxAlt = 0, sumAz2 = 0, sumAlt2 = 0;
+    uint64_t nAz = 0, nAlt = 0;
+
+    for (int d = 0; d < o.days; d++)
+    {
+        for (uint32_t s = 0; s < 86400; s += 60)
+        {
+            DateTime t(start.unixtime() + d * 86400 + s);
+            double az, alt, eAz, eAlt;
+            calcHorizontalCoordinates(t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second(),
+                                      o.latitude, o.longitude, az, alt);
+            ephemerisSunPosition(t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second(),
+                                 o.latitude, o.longitude, eAz, eAlt);
+
+            double dAlt = fabs(eAlt - alt);
+            maxAlt = std::max(maxAlt, dAlt);
+            sumAlt2 += dAlt * dAlt;
+            nAlt++;
+            if (alt > 0.0)
+            {
+                double dAz = fabs(wrap180(eAz - az));
+                maxAz = std::max(maxAz, dAz);
+                sumAz2 += dAz * dAz;
+                nAz++;
+            }
+        }
+    }
+
+    // Cost per call: full solution vs. table lookup on today's table
+    const int calls = 200000;
+    volatile double sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++)
+    {
+        double az, alt;
+        uint32_t s = (uint32_t)(i * 37) % 86400;
+        calcHorizontalCoordinates(o.year, o.month, o.day, s / 3600, (s / 60) % 60, s % 60,
+                                  o.latitude, o.longitude, az, alt);
+        sink = sink + az;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++)
+    {
+        int32_t az, alt;
+        ephemerisLookup((uint32_t)(i * 37) % 86400, az, alt);
+        sink = sink + az;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    ephemerisBuild(o.year, o.month, o.day, o.latitude, o.longitude);
+    auto t3 = std::chrono::steady_clock::now();
+
+    double fullNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+    double tableNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / calls;
+    double buildUs = std::chrono::duration<double, std::micro>(t3 - t2).count();
+
+    printf("Ephemeris vs calcHorizontalCoordinates, %d days from %04d-%02d-%02d @ %.4f, %.4f\n",
+           o.days, o.year, o.month, o.day, o.latitude, o.longitude);
+    printf("  azimuth error    max %.3f°  rms %.4f°  (sun above horizon, %llu samples)\n",
+           maxAz, nAz ? sqrt(sumAz2 / nAz) : 0.0, (unsigned long long)nAz);
+    printf("  altitude error   max %.3f°  rms %.4f°  (%llu samples)\n",
+           maxAlt, nAlt ? sqrt(sumAlt2 / nAlt) : 0.0, (unsigned long long)nAlt);
+    printf("  cost per call    full %.0f ns  table %.1f ns  (x%.0f), daily build %.0f us\n",
+           fullNs, tableNs, fullNs / tableNs, buildUs);
+    return 0;
+}
@@ -0,0 +1,374 @@
+#include <chrono>
+#include <map>
+#include <algorithm>
+#include <string>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_history_log.h"
+#include "st_history_export.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// HISTORY LOG BENCHMARK
+// =====================================================
+// One row per HISTORY_WRITE_MIN_MS interval (5 min), old append-only CSV
+// vs. the binary ring. The LittleFS stand-in is a plain host file, so
+// neither its timing nor its byte count says what the flash sees; the
+// bytes and opens are what the firmware hands to LittleFS, the block
+// programs follow from LittleFS's CTZ layout: a flushed write copies
+// every block from the written one to the end of the file.
+
+// pushHistory() as it was before st_history_log
+static void legacyCsvAppend(const DateTime &now, int y, int t, double az, double alt)
+{
+    File file = LittleFS.open("/history.csv", "a");
+    if (file)
+    {
+        char buffer[30];
+        sprintf(buffer, "%04d-%02d-%02d %02d:%02d:%02d",
+                now.year(), now.month(), now.day(),
+                now.hour(), now.minute(), now.second());
+        String timestamp = String(buffer);
+        file.print(timestamp + "," + String(y) + "," + String(t));
+        file.println("," + String(az, 2) + "," + String(alt, 2));
+        file.close();
+    }
+}
+
+struct AppendStats
+{
+    uint64_t bytes;
+    uint32_t opens;
+    uint64_t blocks; // 4 KiB block programs (CTZ model)
+};
+
+static void printAppendStats(const char *name, const AppendStats &s, uint32_t rows)
+{
+    printf("  %-26s %6.1f bytes  %5.2f opens  %6.2f blocks per append\n", name, (double)s.bytes / rows,
+           (double)s.opens / rows, (double)s.blocks / rows);
+}
+
+int simBenchHistory(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 7;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    const uint32_t rowsPerDay = 86400UL * 1000UL / (5UL * 60UL * 1000UL);
+    const uint32_t rows = rowsPerDay * o.days;
+    DateTime start(o.year, o.month, o.day, 0, 0, 0);
+
+    halFsBegin();
+    LittleFS.remove("/history.csv");
+    historyLogRemove();
+
+    // Appended at the end, each append copies the last partial block
+    AppendStats csv = {0, 0, rows};
+    LittleFS.resetStats();
+    for (uint32_t i = 0; i < rows; i++)
+    {
+        DateTime t(start.unixtime() + i * 300);
+        legacyCsvAppend(t, 90 + i % 50, 40 + i % 70, 123.45 + i % 100, 45.67);
+    }
+    csv.bytes = LittleFS.stats().bytesWritten;
+    csv.opens = LittleFS.stats().opens;
+    File f = LittleFS.open("/history.csv", "r");
+    size_t csvSize = f.size();
+    f.close();
+    LittleFS.remove("/history.csv");
+
+    // Sector files: the record's block is the last one; a new sector adds
+    // the header. The former single pre-allocated file rewrote from the
+    // record's sector to the end of the file.
+    AppendStats bin = {0, 0, 0};
+    uint64_t singleBlocks = 0;
+    LittleFS.resetStats();
+    historyLogBegin();
+    for (uint32_t i = 0; i < rows; i++)
+    {
+        HistoryRecord rec = {};
+        rec.time = start.unixtime() + i * 300;
+        rec.yaw = (int16_t)((90 + i % 50) * 100);
+        rec.tilt = (int16_t)((40 + i % 70) * 100);
+        rec.sunAz = (uint16_t)((123 + i % 100) * 100 + 45);
+        rec.sunAlt = 4567;
+        rec.state = STATE_TRACKING;
+        rec.flags = HISTORY_FLAG_TIME | HISTORY_FLAG_SUN;
+        historyLogAppend(rec);
+        uint32_t seq = i / HISTORY_LOG_RECORDS_PER_SECTOR;
+        bool sectorStart = i % HISTORY_LOG_RECORDS_PER_SECTOR == 0;
+        bin.blocks += sectorStart ? 2 : 1;
+        singleBlocks += (HISTORY_LOG_SECTORS - seq % HISTORY_LOG_SECTORS) * (sectorStart ? 2 : 1);
+    }
+    bin.bytes = LittleFS.stats().bytesWritten;
+    bin.opens = LittleFS.stats().opens;
+
+    printf("History log, %u rows/day over %d days (one per 5 min)\n", rowsPerDay, o.days);
+    printAppendStats("CSV append", csv, rows);
+    printAppendStats("ring, sector files", bin, rows);
+    printf("  %-26s %34.2f blocks per append\n", "ring, one file (before)", (double)singleBlocks / rows);
+    printf("  CSV file       %zu bytes after %d days, fills a %zu KiB partition in %.0f days\n",
+           csvSize, o.days, LittleFS.totalBytes() / 1024,
+           (double)LittleFS.totalBytes() / ((double)csvSize / o.days));
+    printf("  binary ring    at most %u bytes in %u files, %u of %u records, %.1f days kept\n",
+           (unsigned)(HISTORY_LOG_SECTORS * HISTORY_LOG_SECTOR_SIZE), (unsigned)HISTORY_LOG_SECTORS,
+           historyLogCount(), historyLogCapacity(), (double)historyLogCapacity() / rowsPerDay);
+
+    // Wrap-around, reboot recovery and read-back order
+    SimCheck check;
+    historyLogEnd();
+    historyLogBegin();
+    HistoryCursor cursor;
+    HistoryRecord rec;
+    historyLogRewind(cursor);
+    uint32_t readBack = 0;
+    uint32_t lastTime = 0;
+    bool ordered = true;
+    while (historyLogNext(cursor, rec))
+    {
+        if (readBack > 0 && rec.time != lastTime + 300)
+            ordered = false;
+        lastTime = rec.time;
+        readBack++;
+    }
+    uint32_t expected = std::min(rows, historyLogCount());
+    bool recovered = readBack == expected && ordered && lastTime == start.unixtime() + (rows - 1) * 300;
+    printf("  recovery       %u records read back after reopen, %s, newest %s\n", readBack,
+           ordered ? "in order" : "OUT OF ORDER",
+           lastTime == start.unixtime() + (rows - 1) * 300 ? "present" : "MISSING");
+
+    char line[80];
+    size_t csvBytes = 0;
+    historyLogRewind(cursor);
+    auto t0 = std::chrono::steady_clock::now();
+    while (historyLogNext(cursor, rec))
+        csvBytes += historyFormatCsv(rec, line, sizeof(line));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    printf("  CSV on demand  %zu bytes rendered in %.1f ms\n", csvBytes, ms);
+
+    auto record = [&](uint32_t i) {
+        HistoryRecord r = {};
+        r.time = start.unixtime() + i * 300;
+        r.yaw = (int16_t)(i % 18000);
+        r.state = STATE_TRACKING;
+        r.flags = HISTORY_FLAG_TIME;
+        return r;
+    };
+    auto readAll = [&](uint32_t &count, uint32_t &newest) {
+        HistoryCursor c;
+        HistoryRecord r;
+        historyLogRewind(c);
+        count = 0;
+        bool inOrder = true;
+        while (historyLogNext(c, r))
+        {
+            inOrder = inOrder && (count == 0 || r.time == newest + 300);
+            newest = r.time;
+            count++;
+        }
+        return inOrder;
+    };
+
+    // Past the end of the ring, then a record torn by a power cut
+    uint32_t total = rows;
+    for (; total < historyLogCapacity() + HISTORY_LOG_RECORDS_PER_SECTOR; total++)
+        historyLogAppend(record(total));
+    historyLogEnd();
+    char path[24];
+    historyLogPath(((total - 1) / HISTORY_LOG_RECORDS_PER_SECTOR) % HISTORY_LOG_SECTORS, path, sizeof(path));
+    File torn = LittleFS.open(path, "a");
+    torn.write((const uint8_t *)"\x01\x02\x03\x04\x05\x06\x07", 7);
+    torn.close();
+    historyLogBegin();
+    historyLogAppend(record(total++));
+    uint32_t wrapped = 0;
+    uint32_t newest = 0;
+    bool wrapOk = readAll(wrapped, newest) && newest == record(total - 1).time &&
+                  wrapped >= historyLogCapacity() - HISTORY_LOG_RECORDS_PER_SECTOR;
+    printf("  wrap + torn    %u records after %u appends and a torn record, %s\n", wrapped, total,
+           wrapOk ? "in order, newest present" : "WRONG");
+
+    // history.csv of the earlier firmware: the newest rows that fit the
+    // ring are imported, the last one from before the time was valid
+    historyLogRemove();
+    File old = LittleFS.open("/history.csv", "w");
+    old.println("Timestamp,Yaw,Tilt,SunAzimuth,SunAltitude");
+    old.close();
+    const uint32_t csvRows = historyLogCapacity() + 100;
+    for (uint32_t i = 0; i < csvRows - 1; i++)
+        legacyCsvAppend(DateTime(start.unixtime() + i * 300), 90 + i % 50, 40, 123.45, 45.67);
+    old = LittleFS.open("/history.csv", "a");
+    old.println("123456,91,42,,");
+    old.close();
+    historyLogBegin();
+    HistoryCursor c;
+    HistoryRecord first, last;
+    historyLogRewind(c);
+    uint32_t imported = historyLogNext(c, first) ? 1 : 0;
+    while (historyLogNext(c, last))
+        imported++;
+    bool importOk = imported == historyLogCapacity() && !LittleFS.exists("/history.csv") &&
+                    first.time == start.unixtime() + 100 * 300 && first.yaw == 9000 && first.tilt == 4000 &&
+                    first.sunAz == 12345 && first.sunAlt == 4567 &&
+                    first.flags == (HISTORY_FLAG_TIME | HISTORY_FLAG_SUN) && last.time == 123456 &&
+                    last.yaw == 9100 && last.tilt == 4200 && last.flags == 0;
+    printf("  history.csv    %u of %u rows imported, %s\n", imported, csvRows,
+           importOk ? "newest kept, CSV removed" : "WRONG");
+
+    check.expect(recovered, "reopened log reads back every record in order");
+    check.expect(wrapOk, "wrap-around and a torn record: in order, newest present");
+    check.expect(importOk, "history.csv of earlier firmware: newest rows imported once, file removed");
+
+    historyLogRemove();
+    LittleFS.remove("/history.csv");
+    return check.finish();
+}
+
+// =====================================================
+// HISTORY EXPORT CHECK
+// =====================================================
+// A month of 5 min rows, exported through /history while loop() keeps
+// running. The client takes one TCP window (1460 bytes) per loop() pass.
+// Checks the streamed body, window and buckets, that a stalled client
+// does not hold up loop(), and reports how much work one pass does.
+
+static uint32_t countLines(const std::string &s)
+{
+    return (uint32_t)std::count(s.begin(), s.end(), '\n');
+}
+
+struct ExportRun
+{
+    std::string body;
+    uint32_t chunks;
+    uint32_t passes;
+    size_t maxChunk;
+    double maxPassUs;
+    bool wellFormed;
+};
+
+// stallPasses: loop() passes before the client starts reading
+static ExportRun runExport(const std::map<std::string, std::string> &args, uint32_t stallPasses = 0)
+{
+    ExportRun r = {"", 0, 0, 0, 0.0, false};
+    bool started = server.request(HTTP_GET, "/history", args) == 200;
+    bool open = started;
+    while (open && r.passes < 1000000)
+    {
+        nativeClockAdvance(1000);
+        auto t0 = std::chrono::steady_clock::now();
+        loop();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        r.maxPassUs = std::max(r.maxPassUs, us);
+        r.passes++;
+        if (r.passes <= stallPasses)
+            continue;
+
+        size_t seen = server.responseBody().size();
+        open = server.pump();
+        size_t chunk = server.responseBody().size() - seen;
+        if (chunk > 0)
+            r.chunks++;
+        r.maxChunk = std::max(r.maxChunk, chunk);
+    }
+    r.body = server.responseBody();
+    r.wellFormed = started && !open && !historyExportBusy() && server.responseType() == "text/csv" &&
+                   server.responseHeader("Content-Disposition") == "attachment; filename=tracking_history.csv";
+    return r;
+}
+
+int simCheckExport(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 30;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    DateTime start(o.year, o.month, o.day, 0, 0, 0);
+    fakeRtcSet(start);
+    fakeSetLdr(2400, 2400, 2400, 2400);
+    halFsBegin();
+    historyLogRemove();
+    setup();
+
+    // Known pattern: yaw = minute of the hour, so every 1 h bucket has
+    // min 0, max 55 and avg 27.5
+    const uint32_t rows = 288 * o.days;
+    for (uint32_t i = 0; i < rows; i++)
+    {
+        HistoryRecord rec = {};
+        rec.time = start.unixtime() + i * 300;
+        rec.yaw = (int16_t)((i % 12) * 5 * 100);
+        rec.tilt = 4500;
+        rec.sunAz = 18000;
+        rec.sunAlt = 3000;
+        rec.state = STATE_TRACKING;
+        rec.flags = HISTORY_FLAG_TIME | HISTORY_FLAG_SUN;
+        historyLogAppend(rec);
+    }
+    uint32_t stored = historyLogCount();
+
+    printf("History export, %u rows stored (%d days at 5 min)\n", stored, o.days);
+
+    uint32_t epoch = 0, step = 0;
+    check.expect(historyParseTime("2025-06-21", epoch) && epoch == DateTime(2025, 6, 21, 0, 0, 0).unixtime(),
+                 "parse YYYY-MM-DD");
+    check.expect(historyParseTime("2025-06-21T12:30", epoch) && epoch == DateTime(2025, 6, 21, 12, 30, 0).unixtime(),
+                 "parse YYYY-MM-DDTHH:MM");
+    check.expect(historyParseTime("1750500000", epoch) && epoch == 1750500000u, "parse epoch seconds");
+    check.expect(!historyParseTime("21.06.2025", epoch), "reject other date formats");
+    check.expect(historyParseStep("15m", step) && step == 900 && historyParseStep("1d", step) && step == 86400,
+                 "parse step suffixes");
+    check.expect(server.request(HTTP_GET, "/history", {{"step", "1x"}}) == 400, "bad step -> 400");
+
+    ExportRun full = runExport({});
+    std::string expected(HISTORY_CSV_HEADER);
+    HistoryCursor cursor;
+    HistoryRecord rec;
+    char line[96];
+    historyLogRewind(cursor);
+    while (historyLogNext(cursor, rec))
+        expected.append(line, historyFormatCsv(rec, line, sizeof(line)));
+    check.expect(full.wellFormed && full.body == expected, "full export: chunked stream equals the log as CSV");
+    printf("       %zu bytes in %u chunks over %u loop() passes, max %zu bytes and %.0f us host time per pass\n",
+           full.body.size(), full.chunks, full.passes, full.maxChunk, full.maxPassUs);
+
+    ExportRun stalled = runExport({}, 2000);
+    check.expect(stalled.wellFormed && stalled.body == expected,
+                 "client stalled for 2000 passes: loop() keeps running, export resumes intact");
+    printf("       max %.0f us host time per pass\n", stalled.maxPassUs);
+
+    char from[24], to[24];
+    DateTime d0(start.unixtime() + 10 * 86400UL), d1(start.unixtime() + 12 * 86400UL - 1);
+    snprintf(from, sizeof(from), "%04d-%02d-%02d", d0.year(), d0.month(), d0.day());
+    snprintf(to, sizeof(to), "%lu", (unsigned long)d1.unixtime());
+    ExportRun window = runExport({{"from", from}, {"to", to}, {"step", "1h"}});
+    bool bucketsOk = window.wellFormed && countLines(window.body) == 1 + 48;
+    size_t p = window.body.find('\n') + 1;
+    while (bucketsOk && p < window.body.size())
+    {
+        size_t eol = window.body.find('\n', p);
+        std::string row = window.body.substr(p, eol - p);
+        bucketsOk = row.find(",12,27.50,0.00,55.00,45.00,45.00,45.00,180.00,30.00,TRACKING") != std::string::npos;
+        p = eol + 1;
+    }
+    check.expect(bucketsOk, "2 day window at 1 h: 48 buckets, 12 samples, avg/min/max per bucket");
+    printf("       %zu bytes over %u loop() passes\n", window.body.size(), window.passes);
+
+    server.request(HTTP_GET, "/history");
+    check.expect(server.request(HTTP_GET, "/history") == 503 && server.responseHeader("Retry-After") == "10",
+                 "second export while one runs -> 503 with Retry-After");
+    server.disconnect();
+    loop();
+    check.expect(!historyExportBusy(), "client disconnect aborts the export");
+
+    historyLogEnd();
+    return check.finish();
+}
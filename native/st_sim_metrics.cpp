@@ -0,0 +1,198 @@
+#include <chrono>
+#include <vector>
+#include <map>
+#include <string>
+#include <Arduino.h>
+#include "st_hal_fake.h"
+#include "st_metrics.h"
+#include "st_alloc_count.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// METRICS CHECK
+// =====================================================
+// Bucket edges and p99 on known durations, then /metrics after a few
+// minutes of tracking with the control task: well-formed Prometheus
+// text, consistent histograms, and what one METRIC_SCOPE costs.
+
+#ifdef ST_METRICS
+
+// "name{labels} value" -> value, keyed by "name{labels}"
+static bool parsePrometheus(const std::string &text, std::map<std::string, double> &samples,
+                            std::vector<std::string> &typeOrder, bool &grouped)
+{
+    grouped = true;
+    std::string family;
+    std::map<std::string, bool> closed;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos)
+            return false;
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (line.rfind("# TYPE ", 0) == 0)
+        {
+            std::string name = line.substr(7, line.find(' ', 7) - 7);
+            if (closed.count(name))
+                grouped = false;
+            if (!family.empty())
+                closed[family] = true;
+            family = name;
+            typeOrder.push_back(name);
+            continue;
+        }
+        if (line.rfind("# ", 0) == 0)
+            continue;
+        size_t space = line.rfind(' ');
+        if (space == std::string::npos || line.find('{') == std::string::npos)
+            return false;
+        if (line.compare(0, family.size(), family) != 0)
+            grouped = false;
+        char *tail;
+        double v = strtod(line.c_str() + space + 1, &tail);
+        if (*tail != '\0')
+            return false;
+        samples[line.substr(0, space)] = v;
+    }
+    return true;
+}
+
+int simCheckMetrics(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 5; // minutes of tracking
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    // Known durations (host: 1 cycle = 1 ns)
+    metricsReset();
+    metricRecord(METRIC_LOOP, 1000);   // 1 us      -> le 1e-06
+    metricRecord(METRIC_LOOP, 1001);   // 1.001 us  -> le 2e-06
+    metricRecord(METRIC_LOOP, 300000); // 300 us    -> le 0.000512
+    metricRecord(METRIC_LOOP, 600000000); // 600 ms -> +Inf
+    MetricStats known;
+    metricRead(METRIC_LOOP, known);
+    check.expect(known.count == 4 && known.buckets[0] == 1 && known.buckets[1] == 1 && known.buckets[9] == 1 &&
+                     known.buckets[METRIC_BOUNDS] == 1 && known.minCycles == 1000 && known.maxCycles == 600000000,
+                 "bucket edges: <= 1 us, <= 2 us, <= 512 us, +Inf; min and max exact");
+    metricsReset();
+    for (int i = 0; i < 99; i++)
+        metricRecord(METRIC_LOOP, 3000);
+    metricRecord(METRIC_LOOP, 90000);
+    metricRead(METRIC_LOOP, known);
+    uint32_t p99Low = metricP99Cycles(known);
+    metricRecord(METRIC_LOOP, 90000);
+    metricRead(METRIC_LOOP, known);
+    check.expect(p99Low == 4000 && metricP99Cycles(known) == 90000,
+                 "p99: bucket bound of the 99th percentile, capped at max");
+
+    // A loop() stage blocked past the cycle counter's range (host: 4.3 s)
+    metricsReset();
+    metricRecord(METRIC_HISTORY_WRITE, METRIC_SATURATED - 1);
+    {
+        METRIC_SCOPE_LONG(METRIC_HISTORY_WRITE);
+        nativeClockAdvance(20000000);
+    }
+    metricRead(METRIC_HISTORY_WRITE, known);
+    check.expect(known.count == 2 && known.buckets[METRIC_BOUNDS] == 2 && known.maxCycles == METRIC_SATURATED,
+                 "passes past the cycle counter's range saturate into +Inf instead of wrapping");
+
+    allocCountStart();
+    const int scopes = 1000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < scopes; i++)
+    {
+        METRIC_SCOPE(METRIC_STATUS_RING);
+    }
+    double scopeNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / scopes;
+    AllocStats alloc = allocCountStop();
+    check.expect(alloc.allocations == 0, "recording never allocates");
+
+    // Tracking with the control task, a dashboard polling /status
+    simBegin(o);
+    fakeControlTaskEnable(true);
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    simSkyAt(start, o);
+    setup();
+    metricsReset();
+    const uint32_t endMs = o.days * 60000;
+    for (uint32_t ms = 1; ms <= endMs; ms++)
+    {
+        nativeClockAdvance(1000);
+        loop();
+        if (ms % 1000 == 0)
+            simSkyMove(DateTime(start.unixtime() + ms / 1000), o);
+        if (ms % 5000 == 0)
+            server.request(HTTP_GET, "/status");
+    }
+
+    server.request(HTTP_GET, "/metrics");
+    bool streamed = server.responseCode() == 200 && server.responseType().startsWith("text/plain");
+    int pumps = 0;
+    while (server.pump(536))
+        pumps++;
+    std::string text = server.responseBody();
+
+    std::map<std::string, double> samples;
+    std::vector<std::string> types;
+    bool grouped;
+    bool parsed = parsePrometheus(text, samples, types, grouped);
+    check.expect(streamed && parsed && grouped && types.size() == 5,
+                 "/metrics: Prometheus text, one histogram and four gauge families, each one group");
+
+    bool consistent = true;
+    bool recorded = true;
+    printf("Stages after %d min tracking (host time, %zu bytes in %d chunks)\n", o.days, text.size(), pumps + 1);
+    printf("  %-16s %9s %10s %10s %10s %10s\n", "", "count", "min us", "avg us", "p99 us", "max us");
+    for (int i = 0; i < METRIC_STAGE_COUNT; i++)
+    {
+        std::string stage = std::string("{stage=\"") + metricStageName((MetricStage)i) + "\"";
+        double count = samples["st_stage_seconds_count" + stage + "}"];
+        double last = 0;
+        for (int b = 0; b < METRIC_BOUNDS; b++)
+        {
+            char le[24];
+            snprintf(le, sizeof(le), ",le=\"%g\"}", (1UL << b) * 1e-6);
+            double v = samples["st_stage_seconds_bucket" + stage + le];
+            consistent = consistent && v >= last;
+            last = v;
+        }
+        double inf = samples["st_stage_seconds_bucket" + stage + ",le=\"+Inf\"}"];
+        double mn = samples["st_stage_min_seconds" + stage + "}"] * 1e6;
+        double avg = samples["st_stage_avg_seconds" + stage + "}"] * 1e6;
+        double p99 = samples["st_stage_p99_seconds" + stage + "}"] * 1e6;
+        double mx = samples["st_stage_max_seconds" + stage + "}"] * 1e6;
+        double sum = samples["st_stage_seconds_sum" + stage + "}"] * 1e6;
+        consistent = consistent && inf == count && last <= inf && mn <= avg && avg <= mx && p99 <= mx &&
+                     fabs(sum - avg * count) <= 1e-3 * sum + 1;
+        // Stages on the tracking path all ran; export/history only on demand
+        if (i != METRIC_HISTORY_EXPORT && i != METRIC_HISTORY_WRITE)
+            recorded = recorded && count > 0;
+        printf("  %-16s %9.0f %10.2f %10.2f %10.2f %10.2f\n", metricStageName((MetricStage)i), count, mn, avg, p99, mx);
+    }
+    printf("  METRIC_SCOPE     %.1f ns per timed block\n", scopeNs);
+    check.expect(consistent, "cumulative buckets, +Inf = count, min <= avg <= max, p99 <= max, sum = avg * count");
+    check.expect(recorded, "every tracking stage recorded, including the control task, sampler and /status");
+    check.expect(samples["st_stage_seconds_count{stage=\"loop\"}"] == endMs &&
+                     samples["st_stage_seconds_count{stage=\"http_status\"}"] == endMs / 5000,
+                 "one loop sample per loop(), one http_status per request");
+
+    return check.finish();
+}
+
+#else
+
+int simCheckMetrics(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    printf("Built without ST_METRICS, nothing to check\n");
+    return 0;
+}
+
+#endif
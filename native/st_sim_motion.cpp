@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_history_log.h"
+#include "st_motion.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// MOTION PLANNER
+// =====================================================
+struct ProfileRun
+{
+    uint32_t ticks[2];    // until each axis rests
+    float maxSpeed[2];    // centidegrees/s
+    float maxAccel[2];    // centidegrees/s²
+    float maxDeviation;   // from the straight line, centidegrees
+    bool onTarget;
+    bool overshoot;
+};
+
+// Planner core only: plan from the axes' current state, tick until rest
+static ProfileRun runProfile(MotionAxis &yaw, MotionAxis &tilt, float yawTarget, float tiltTarget)
+{
+    const float dt = MOTION_PERIOD_US / 1e6f;
+    ProfileRun r = {};
+    MotionAxis *axes[2] = {&yaw, &tilt};
+    float start[2] = {yaw.pos, tilt.pos};
+    float target[2] = {yawTarget, tiltTarget};
+    motionPlan(yaw, tilt, yawTarget, tiltTarget);
+    bool moving[2] = {true, true};
+    for (uint32_t t = 1; (moving[0] || moving[1]) && t < 100000; t++)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            float vel = axes[i]->vel;
+            moving[i] = motionAdvance(*axes[i], dt);
+            if (moving[i])
+                r.ticks[i] = t;
+            r.maxSpeed[i] = std::max(r.maxSpeed[i], fabsf(axes[i]->vel));
+            r.maxAccel[i] = std::max(r.maxAccel[i], fabsf(axes[i]->vel - vel) / dt);
+            float beyond = (axes[i]->pos - target[i]) * (target[i] > start[i] ? 1.0f : -1.0f);
+            r.overshoot = r.overshoot || (beyond > 0.5f && start[i] != target[i]);
+        }
+        // Same fraction of the way on both axes
+        float dy = target[0] - start[0];
+        float dtl = target[1] - start[1];
+        if (fabsf(dy) > 0 && fabsf(dtl) > 0)
+        {
+            float fy = (yaw.pos - start[0]) / dy;
+            r.maxDeviation = std::max(r.maxDeviation, fabsf((tilt.pos - start[1]) - fy * dtl));
+        }
+    }
+    r.onTarget = yaw.pos == yawTarget && tilt.pos == tiltTarget && yaw.vel == 0 && tilt.vel == 0;
+    return r;
+}
+
+static MotionAxis axisAt(float pos)
+{
+    return {pos, 0.0f, pos, 0.0f, 0.0f};
+}
+
+struct FirmwareMove
+{
+    uint32_t frames;      // 20 ms frames until both servos rest
+    int32_t maxStep[2];   // largest change per frame (centidegrees)
+    uint32_t lastMove[2]; // frame of the last change per axis
+    int32_t distance[2];
+};
+
+// Watch the servos frame by frame while loop() runs, until the planner
+// is idle
+static FirmwareMove watchServos(uint32_t maxMs)
+{
+    FirmwareMove m = {};
+    int32_t prev[2] = {fakeServoYaw(), fakeServoTilt()};
+    int32_t first[2] = {prev[0], prev[1]};
+    uint32_t framesMs = MOTION_PERIOD_US / 1000;
+    for (uint32_t t = framesMs; t <= maxMs; t += framesMs)
+    {
+        nativeClockAdvance(MOTION_PERIOD_US);
+        loop();
+        int32_t now[2] = {fakeServoYaw(), fakeServoTilt()};
+        for (int i = 0; i < 2; i++)
+        {
+            int32_t step = abs(now[i] - prev[i]);
+            m.maxStep[i] = std::max(m.maxStep[i], step);
+            if (step)
+                m.lastMove[i] = t / framesMs;
+            prev[i] = now[i];
+        }
+        if (motionIdle())
+        {
+            m.frames = t / framesMs;
+            break;
+        }
+    }
+    m.distance[0] = abs(prev[0] - first[0]);
+    m.distance[1] = abs(prev[1] - first[1]);
+    return m;
+}
+
+int simCheckMotion(int argc, char **argv)
+{
+    SimOptions o;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    const float dt = MOTION_PERIOD_US / 1e6f;
+    const float vYaw = MOTION_VMAX_YAW * ANGLE_SCALE;
+    const float aYaw = MOTION_ACCEL_YAW * ANGLE_SCALE;
+    const float vTilt = MOTION_VMAX_TILT * ANGLE_SCALE;
+    const float aTilt = MOTION_ACCEL_TILT * ANGLE_SCALE;
+    auto withinLimits = [&](const ProfileRun &r) {
+        return r.maxSpeed[0] <= vYaw * 1.001f && r.maxSpeed[1] <= vTilt * 1.001f &&
+               r.maxAccel[0] <= aYaw * 1.001f && r.maxAccel[1] <= aTilt * 1.001f;
+    };
+
+    // Planner core, rest to rest
+    printf("Planner, rest to rest (tick %u ms, %.0f°/s, %.0f°/s²)\n", (unsigned)(MOTION_PERIOD_US / 1000),
+           MOTION_VMAX_YAW, MOTION_ACCEL_YAW);
+    printf("  %-22s %9s %9s %10s %10s %9s\n", "move", "yaw", "tilt", "planned", "max speed", "deviation");
+    struct Case
+    {
+        const char *name;
+        float yaw0, tilt0, yaw1, tilt1;
+    };
+    const Case cases[] = {{"yaw 90° only", 4500, 9000, 13500, 9000},
+                          {"yaw 90°, tilt 10°", 4500, 9000, 13500, 10000},
+                          {"yaw 1°, tilt 40° back", 9000, 13000, 9100, 9000},
+                          {"0.3° (tracking step)", 9000, 9000, 9030, 8990},
+                          {"full range", YAW_MIN * 100.0f, TILT_MIN * 100.0f, YAW_MAX * 100.0f, TILT_MAX * 100.0f}};
+    bool limits = true;
+    bool arrive = true;
+    bool together = true;
+    bool straight = true;
+    bool onTime = true;
+    for (const Case &c : cases)
+    {
+        MotionAxis yaw = axisAt(c.yaw0);
+        MotionAxis tilt = axisAt(c.tilt0);
+        ProfileRun r = runProfile(yaw, tilt, c.yaw1, c.tilt1);
+        float planned = std::max(motionProfileTime(fabsf(c.yaw1 - c.yaw0), vYaw, aYaw),
+                                 motionProfileTime(fabsf(c.tilt1 - c.tilt0), vTilt, aTilt));
+        uint32_t last = std::max(r.ticks[0], r.ticks[1]);
+        printf("  %-22s %6u ms %6u ms %7.0f ms %7.1f°/s %7.2f°\n", c.name, r.ticks[0] * 20, r.ticks[1] * 20,
+               planned * 1000, std::max(r.maxSpeed[0], r.maxSpeed[1]) / ANGLE_SCALE, r.maxDeviation / ANGLE_SCALE);
+        limits = limits && withinLimits(r);
+        arrive = arrive && r.onTarget && !r.overshoot;
+        if (c.yaw0 != c.yaw1 && c.tilt0 != c.tilt1)
+        {
+            together = together && (r.ticks[0] > r.ticks[1] ? r.ticks[0] - r.ticks[1] : r.ticks[1] - r.ticks[0]) <= 1;
+            straight = straight && r.maxDeviation <= 0.02f * std::max(fabsf(c.tilt1 - c.tilt0), fabsf(c.yaw1 - c.yaw0));
+        }
+        onTime = onTime && last * dt <= planned + 3 * dt && last * dt >= planned - 3 * dt;
+    }
+
+    // Re-planned mid-move: turn around, and a target that moves on every
+    // READ_INTERVAL like the tracking step
+    MotionAxis yaw = axisAt(4500);
+    MotionAxis tilt = axisAt(9000);
+    motionPlan(yaw, tilt, 13500, 12000);
+    for (int i = 0; i < 40; i++)
+    {
+        motionAdvance(yaw, dt);
+        motionAdvance(tilt, dt);
+    }
+    ProfileRun reverse = runProfile(yaw, tilt, 5000, 8000);
+    limits = limits && withinLimits(reverse);
+    arrive = arrive && reverse.onTarget;
+
+    bool follow = true;
+    yaw = axisAt(9000);
+    tilt = axisAt(9000);
+    float yawTarget = 9000;
+    float tiltTarget = 9000;
+    float lastVel[2] = {0, 0};
+    for (int step = 0; step < 100; step++)
+    {
+        yawTarget += step < 50 ? 120.0f : -40.0f; // a slew, then back slowly
+        tiltTarget += 25.0f;
+        motionPlan(yaw, tilt, yawTarget, tiltTarget);
+        for (uint32_t t = 0; t < READ_INTERVAL * 1000 / MOTION_PERIOD_US; t++)
+        {
+            motionAdvance(yaw, dt);
+            motionAdvance(tilt, dt);
+            follow = follow && fabsf(yaw.vel) <= vYaw * 1.001f && fabsf(yaw.vel - lastVel[0]) <= aYaw * dt * 1.001f &&
+                     fabsf(tilt.vel - lastVel[1]) <= aTilt * dt * 1.001f;
+            lastVel[0] = yaw.vel;
+            lastVel[1] = tilt.vel;
+        }
+    }
+    ProfileRun settle = runProfile(yaw, tilt, yawTarget, tiltTarget);
+    follow = follow && settle.onTarget;
+
+    // Firmware: boot, sleep transition, wake-up, every move planned
+    simBegin(o);
+    LittleFS.remove("/config.bin");
+    historyLogRemove();
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    simSkyAt(start, o);
+    fakeResetServoStats();
+    setup();
+    FirmwareMove boot = watchServos(10000);
+
+    // Tracking: one target per READ_INTERVAL, most of them unchanged
+    MotionStatus before;
+    motionRead(before);
+    FakeServoStats servoBefore = fakeServoStats();
+    for (uint32_t ms = 0; ms < 10 * 60000; ms += READ_INTERVAL)
+    {
+        nativeClockAdvance(READ_INTERVAL * 1000);
+        simSkyMove(DateTime(start.unixtime() + 10 + ms / 1000), o);
+        loop();
+    }
+    MotionStatus tracked;
+    motionRead(tracked);
+    uint32_t planned = tracked.moves - before.moves;
+    uint32_t coalesced = tracked.coalesced - before.coalesced;
+    uint32_t servoWrites = fakeServoStats().yawWrites + fakeServoStats().tiltWrites - servoBefore.yawWrites -
+                           servoBefore.tiltWrites;
+    bool writesCounted = servoWrites == tracked.writes - before.writes;
+
+    // Frame by frame up to the transition, so the move is watched whole
+    weatherSaysStop = true;
+    simRunUntil(STATE_SLEEP, 1000, MOTION_PERIOD_US);
+    FirmwareMove sleep = watchServos(10000);
+    weatherSaysStop = false;
+    simRunUntil(STATE_TRACKING, 1000, MOTION_PERIOD_US);
+    // The wake-up itself returns to the SLEEP pose (last history entry),
+    // the first tracking steps then head back to the sun
+    for (int i = 0; i < 1000 && motionIdle(); i++)
+    {
+        nativeClockAdvance(MOTION_PERIOD_US);
+        loop();
+    }
+    FirmwareMove wake = watchServos(10000);
+
+    // The timer, not loop(), moves the servos
+    motionMoveTo(YAW_MIN * ANGLE_SCALE, TILT_MAX * ANGLE_SCALE);
+    nativeClockAdvance(5000000);
+    bool offLoop = motionIdle() && fakeServoYaw() == servoPulseToCd(servoPulseUs(YAW_MIN * ANGLE_SCALE)) &&
+                   fakeServoTilt() == servoPulseToCd(servoPulseUs(TILT_MAX * ANGLE_SCALE));
+
+    // Same target again: coalesced, nothing written
+    MotionStatus again0;
+    motionRead(again0);
+    uint32_t writes0 = fakeServoStats().yawWrites + fakeServoStats().tiltWrites;
+    for (int i = 0; i < 10; i++)
+    {
+        motionMoveTo(YAW_MIN * ANGLE_SCALE, TILT_MAX * ANGLE_SCALE);
+        nativeClockAdvance(MOTION_PERIOD_US);
+    }
+    MotionStatus again1;
+    motionRead(again1);
+    bool sameTarget = again1.coalesced == again0.coalesced + 10 && again1.moves == again0.moves &&
+                      fakeServoStats().yawWrites + fakeServoStats().tiltWrites == writes0;
+
+    server.request(HTTP_GET, "/status");
+    bool statusMotion = String(server.responseBody()).indexOf("\"motion\":{\"moving\":false") >= 0;
+
+    printf("Firmware, servo pose per %u ms frame (before: the whole distance in one write)\n",
+           (unsigned)(MOTION_PERIOD_US / 1000));
+    printf("  %-16s %15s %15s %8s %14s\n", "move", "distance", "max per frame", "frames", "last change");
+    auto row = [](const char *name, const FirmwareMove &m) {
+        printf("  %-16s %6.1f° %6.1f° %6.2f° %6.2f° %8u %6u / %-6u\n", name, cdToDeg(m.distance[0]),
+               cdToDeg(m.distance[1]), cdToDeg(m.maxStep[0]), cdToDeg(m.maxStep[1]), m.frames, m.lastMove[0],
+               m.lastMove[1]);
+    };
+    row("boot -> sun", boot);
+    row("-> SLEEP", sleep);
+    row("SLEEP -> track", wake);
+    printf("Tracking 10 min: %u targets planned, %u coalesced, %u servo writes\n", planned, coalesced, servoWrites);
+
+    bool bounded = true;
+    for (const FirmwareMove *m : {&boot, &sleep, &wake})
+    {
+        // One pulse step (~0.1°) of quantization on top of the speed limit
+        bounded = bounded && m->frames > 0 && m->maxStep[0] <= vYaw * dt + 15 && m->maxStep[1] <= vTilt * dt + 15;
+    }
+    // Boot and wake-up are re-planned by every tracking step on the way,
+    // the SLEEP move is one plan
+    bool jointly = (sleep.lastMove[0] > sleep.lastMove[1] ? sleep.lastMove[0] - sleep.lastMove[1]
+                                                           : sleep.lastMove[1] - sleep.lastMove[0]) <= 2;
+
+    check.expect(limits, "speed and acceleration within MOTION_VMAX_*/MOTION_ACCEL_* on both axes");
+    check.expect(arrive, "every move ends at rest on its target, no overshoot");
+    check.expect(onTime, "duration as planned by motionProfileTime() (±3 ticks)");
+    check.expect(together && straight, "two-axis moves finish together on a straight line");
+    check.expect(follow, "a target re-planned every READ_INTERVAL stays within the limits and settles");
+    check.expect(bounded && sleep.distance[0] + sleep.distance[1] > 0 && wake.distance[0] + wake.distance[1] > 0,
+                 "boot, SLEEP and wake-up move no faster than the limit");
+    check.expect(jointly, "the SLEEP move ends on both axes in the same frame (±2)");
+    check.expect(coalesced > planned && writesCounted,
+                 "tracking: unchanged targets coalesced, only changed pulses written");
+    check.expect(sameTarget, "the same target ten times: one plan, no write");
+    check.expect(offLoop, "the timer moves the servos without loop()");
+    check.expect(statusMotion, "/status reports the planner");
+
+    LittleFS.remove("/config.bin");
+    return check.finish();
+}
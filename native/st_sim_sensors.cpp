@@ -0,0 +1,76 @@
+#include <chrono>
+#include <Arduino.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_sensors.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// LDR ACQUISITION CHECK
+// =====================================================
+// Equal light on all four LDRs: every |error| above the dead band is a
+// servo step caused by noise alone.
+int simCheckSensors(int argc, char **argv)
+{
+    SimOptions o;
+    o.noise = 60;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    const int level = 1500;
+    const int reads = 20000;
+    fakeSetLdr(level, level, level, level);
+    fakeSetLdrNoise(o.noise);
+
+    auto yawError = [](int tl, int tr, int bl, int br) {
+        return (float)((tl + bl) - (tr + br)) / (tl + tr + bl + br);
+    };
+
+    // Single-shot reads, as loop() did before
+    uint32_t rawDither = 0;
+    double rawSq = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; i++)
+    {
+        int tl, tr, bl, br;
+        halReadLdr(tl, tr, bl, br);
+        float e = yawError(tl, tr, bl, br);
+        rawSq += e * e;
+        if (fabs(e) > DEAD_BAND_YAW)
+            rawDither++;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Background sampler, one averaged frame per READ_INTERVAL
+    sensorsBegin();
+    uint32_t filteredDither = 0;
+    double filteredSq = 0;
+    uint32_t samples = 0;
+    double readNs = 0;
+    uint32_t ticksBefore = fakeLdrReads();
+    for (int i = 0; i < reads; i++)
+    {
+        delay(READ_INTERVAL);
+        LdrFrame f;
+        auto r0 = std::chrono::steady_clock::now();
+        sensorsRead(f);
+        readNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - r0).count();
+        float e = yawError(f.tl, f.tr, f.bl, f.br);
+        filteredSq += e * e;
+        samples = f.samples;
+        if (fabs(e) > DEAD_BAND_YAW)
+            filteredDither++;
+    }
+    uint32_t ticks = fakeLdrReads() - ticksBefore;
+
+    printf("LDR acquisition, equal light %d counts, noise ±%d, dead band %.3f\n", level, o.noise, DEAD_BAND_YAW);
+    printf("  single-shot      error rms %.4f  dead band exceeded %5.1f %%  (%.0f ns/read)\n",
+           sqrt(rawSq / reads), 100.0 * rawDither / reads,
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / reads);
+    printf("  sampler frame    error rms %.4f  dead band exceeded %5.1f %%  (%u samples/frame, %.0f ns/read)\n",
+           sqrt(filteredSq / reads), 100.0 * filteredDither / reads, samples, readNs / reads);
+    printf("  sampler load     %.0f quad samples per virtual second\n", ticks / (reads * READ_INTERVAL / 1000.0));
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <Arduino.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "time_rtc.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// SERVO MAPPING CHECK
+// =====================================================
+// Angle -> pulse mapping and limit clamping, plus the pointing error
+// left by quantization: int map() + Servo::write() vs. centidegrees +
+// writeMicroseconds(). Exit code 1 on any failed check.
+
+int simCheckServo(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    SimCheck check;
+
+    printf("Servo mapping %d..%d° -> %d..%d us\n", SERVO_MIN, SERVO_MAX, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+    check.expect(servoPulseUs(SERVO_MIN * ANGLE_SCALE) == SERVO_PULSE_MIN_US, "SERVO_MIN -> SERVO_PULSE_MIN_US");
+    check.expect(servoPulseUs(SERVO_MAX * ANGLE_SCALE) == SERVO_PULSE_MAX_US, "SERVO_MAX -> SERVO_PULSE_MAX_US");
+    check.expect(servoPulseUs((SERVO_MIN + SERVO_MAX) * ANGLE_SCALE / 2) ==
+                     (SERVO_PULSE_MIN_US + SERVO_PULSE_MAX_US) / 2,
+                 "mid angle -> mid pulse");
+    check.expect(servoPulseUs(SERVO_MIN * ANGLE_SCALE - 5000) == SERVO_PULSE_MIN_US, "below SERVO_MIN clamps");
+    check.expect(servoPulseUs(SERVO_MAX * ANGLE_SCALE + 5000) == SERVO_PULSE_MAX_US, "above SERVO_MAX clamps");
+
+    bool monotonic = true;
+    int32_t maxRoundTrip = 0;
+    for (int32_t cd = SERVO_MIN * ANGLE_SCALE; cd <= SERVO_MAX * ANGLE_SCALE; cd++)
+    {
+        if (cd > SERVO_MIN * ANGLE_SCALE && servoPulseUs(cd) < servoPulseUs(cd - 1))
+            monotonic = false;
+        maxRoundTrip = std::max(maxRoundTrip, abs(servoPulseToCd(servoPulseUs(cd)) - cd));
+    }
+    // Half a microsecond step, in centidegrees
+    int32_t halfStep = ((SERVO_MAX - SERVO_MIN) * ANGLE_SCALE / (SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US) + 1) / 2 + 1;
+    check.expect(monotonic, "pulse width is monotonic in the angle");
+    check.expect(maxRoundTrip <= halfStep, "pulse -> angle round trip within half a step");
+
+    servoWriteYaw(0);
+    check.expect(fakeServoStats().yawPulseUs == servoPulseUs(YAW_MIN * ANGLE_SCALE), "servoWriteYaw clamps to YAW_MIN");
+    servoWriteYaw(SERVO_MAX * ANGLE_SCALE);
+    check.expect(fakeServoStats().yawPulseUs == servoPulseUs(YAW_MAX * ANGLE_SCALE), "servoWriteYaw clamps to YAW_MAX");
+    servoWriteTilt(0);
+    check.expect(fakeServoStats().tiltPulseUs == servoPulseUs(TILT_MIN * ANGLE_SCALE),
+                 "servoWriteTilt clamps to TILT_MIN");
+    servoWriteTilt(SERVO_MAX * ANGLE_SCALE);
+    check.expect(fakeServoStats().tiltPulseUs == servoPulseUs(TILT_MAX * ANGLE_SCALE),
+                 "servoWriteTilt clamps to TILT_MAX");
+
+    sunPositionToServoAngles(0.0f, -10.0f);
+    check.expect(targetYawFromSun == YAW_MIN * ANGLE_SCALE && targetTiltFromSun == TILT_MIN * ANGLE_SCALE,
+                 "sun mapping clamps below the limits");
+    sunPositionToServoAngles(359.9f, 95.0f);
+    check.expect(targetYawFromSun == YAW_MAX * ANGLE_SCALE && targetTiltFromSun == TILT_MAX * ANGLE_SCALE,
+                 "sun mapping clamps above the limits");
+    sunPositionToServoAngles(180.0f, 45.0f);
+    check.expect(targetYawFromSun == 9000 && targetTiltFromSun == (TILT_MIN + TILT_MAX) * ANGLE_SCALE / 2,
+                 "sun mapping hits the middle");
+
+    // Quantization: sun positions inside the mechanical range, pointing
+    // error between the sun and the pose the servo can actually take
+    double oldMax = 0, oldSum = 0, newMax = 0, newSum = 0;
+    uint32_t samples = 0;
+    for (double az = 2.0 * YAW_MIN; az <= 2.0 * YAW_MAX; az += 0.37)
+    {
+        for (double alt = 1.0; alt < 89.0; alt += 2.9)
+        {
+            int oldYaw = map((int)az, 0, 360, 0, 180);
+            int oldTilt = map((int)alt, 0, 90, TILT_MIN, TILT_MAX);
+            double pAz, pAlt;
+            poseToDirection(oldYaw * ANGLE_SCALE, oldTilt * ANGLE_SCALE, pAz, pAlt);
+            double eOld = angleBetween(pAz, pAlt, az, alt);
+
+            sunPositionToServoAngles(az, alt);
+            poseToDirection(servoPulseToCd(servoPulseUs(targetYawFromSun)),
+                            servoPulseToCd(servoPulseUs(targetTiltFromSun)), pAz, pAlt);
+            double eNew = angleBetween(pAz, pAlt, az, alt);
+
+            oldMax = std::max(oldMax, eOld);
+            oldSum += eOld;
+            newMax = std::max(newMax, eNew);
+            newSum += eNew;
+            samples++;
+        }
+    }
+    printf("Quantization pointing error over %u sun positions\n", samples);
+    printf("  int degrees + write()            mean %.3f°  max %.3f°\n", oldSum / samples, oldMax);
+    printf("  centidegrees + writeMicroseconds mean %.3f°  max %.3f°  (x%.1f smaller)\n",
+           newSum / samples, newMax, oldSum / newSum);
+
+    return check.finish();
+}
@@ -0,0 +1,238 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_metrics.h"
+#include "st_supervisor.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// SUPERVISOR CHECK
+// =====================================================
+// Hangs in each subsystem, and hiccups just under the limits, on a
+// tracker with the control task. A hang runs on the virtual clock while
+// the other tasks go on (loop() keeps being called, like on the second
+// core); the supervisor check fires from the clock like its esp_timer.
+// After a restart the driver boots again (setup()) and reads /resets.
+
+static void hangLoopPass()
+{
+    loop();
+}
+
+static uint32_t webHangMs = 0;
+
+// A handler blocking async_tcp while loop() keeps running
+static void handleHang(AsyncWebServerRequest *request)
+{
+    simRun(webHangMs);
+    request->send(200, "text/plain", "ok");
+}
+
+static void supervisorBoot()
+{
+    setup();
+    server.on("/hang", supervised(handleHang));
+    simRunUntil(STATE_TRACKING, 2000);
+}
+
+// Control step stuck before it runs, on the wake-up after one that beat
+// (right after a boot the task may not have run yet)
+static void hangInControl(uint32_t ms)
+{
+    simRun(CONTROL_TASK_PERIOD_MS);
+    fakeControlHang(ms, hangLoopPass);
+    simRun(CONTROL_TASK_PERIOD_MS);
+}
+
+// Motion tick stuck in a servo write; runs until the tracker moves
+static void hangInMotion(uint32_t ms)
+{
+    uint32_t writes = fakeServoStats().yawWrites;
+    fakeServoHang(ms, hangLoopPass);
+    for (int i = 0; i < 1800 && fakeServoStats().yawWrites == writes; i++)
+        simRun(1000);
+}
+
+// loop() itself stuck inside a subsystem, the control task keeps going
+static void hangInLoop(SupervisorSubsystem s, uint32_t ms)
+{
+    SupervisorScope busy(s);
+    nativeClockAdvance((uint64_t)ms * 1000);
+}
+
+struct ResetSeen
+{
+    bool restarted;
+    ResetLogEntry entry; // logged on the next boot
+};
+
+int simCheckSupervisor(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 10; // minutes of healthy tracking
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    simBegin(o);
+    LittleFS.remove("/reset.log");
+    fakeControlTaskEnable(true);
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    simSkyAt(start, o);
+    supervisorBoot();
+
+    // Healthy tracking with slow handlers and a polling dashboard
+    uint32_t restarts0 = fakeRestarts();
+    uint32_t feeds0 = fakeWatchdogFeeds();
+    unsigned long healthyStart = millis();
+#ifdef ST_METRICS
+    metricsReset();
+#endif
+    std::uniform_int_distribution<int> slowMs(20, 400);
+    for (uint32_t ms = 1; ms <= (uint32_t)o.days * 60000; ms++)
+    {
+        nativeClockAdvance(1000);
+        loop();
+        if (ms % 1000 == 0)
+            simSkyMove(DateTime(start.unixtime() + ms / 1000), o);
+        if (ms % 5000 == 0)
+        {
+            webHangMs = slowMs(rng);
+            server.request(HTTP_GET, "/hang");
+        }
+    }
+    uint32_t feeds = fakeWatchdogFeeds() - feeds0;
+    uint32_t seconds = (millis() - healthyStart) / 1000; // handlers add their own time
+    check.expect(fakeRestarts() == restarts0, "healthy tracking with slow handlers: no restart");
+    check.expect(feeds >= 3 * seconds - 3 && feeds <= 3 * seconds + 3,
+                 "task watchdog fed once per second by loop, control and motion task");
+
+#ifdef ST_METRICS
+    MetricStats loopStats;
+    metricRead(METRIC_LOOP, loopStats);
+    double loopAvgNs = (double)loopStats.sumCycles / loopStats.count;
+    double loopP99Ns = metricP99Cycles(loopStats);
+#endif
+    const int calls = 1000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++)
+    {
+        // What loop() adds per pass: one beat, time and storage markers
+        supervisorBeat(SUPERVISOR_LOOP);
+        supervisorBusy(SUPERVISOR_STORAGE);
+        supervisorIdle(SUPERVISOR_STORAGE);
+    }
+    double beatNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / calls;
+
+    // Hiccups just under the limits
+    hangInLoop(SUPERVISOR_TIME, SUPERVISOR_TIME_STALL_MS - 2000);
+    hangInLoop(SUPERVISOR_STORAGE, SUPERVISOR_STORAGE_STALL_MS - 2000);
+    webHangMs = SUPERVISOR_WEB_STALL_MS - 2000;
+    server.request(HTTP_GET, "/hang");
+    hangInControl(SUPERVISOR_CONTROL_STALL_MS - 2000);
+    hangInMotion(SUPERVISOR_MOTION_STALL_MS - 2000);
+    simRun(60000);
+    check.expect(fakeRestarts() == restarts0, "hiccups 2 s under each limit: no restart");
+
+    // One hang per subsystem, each followed by a boot
+    struct Hang
+    {
+        SupervisorSubsystem subsystem;
+        unsigned long limit;
+    };
+    const Hang hangs[] = {
+        {SUPERVISOR_CONTROL, SUPERVISOR_CONTROL_STALL_MS}, {SUPERVISOR_WEB, SUPERVISOR_WEB_STALL_MS},
+        {SUPERVISOR_TIME, SUPERVISOR_TIME_STALL_MS},       {SUPERVISOR_STORAGE, SUPERVISOR_STORAGE_STALL_MS},
+        {SUPERVISOR_LOOP, SUPERVISOR_LOOP_STALL_MS},       {SUPERVISOR_MOTION, SUPERVISOR_MOTION_STALL_MS},
+    };
+    printf("Hangs (limit + 10 s), reset log entry after the next boot\n");
+    bool allNamed = true;
+    for (const Hang &h : hangs)
+    {
+        uint32_t before = fakeRestarts();
+        uint32_t hangMs = h.limit + 10000;
+        switch (h.subsystem)
+        {
+        case SUPERVISOR_CONTROL:
+            hangInControl(hangMs);
+            break;
+        case SUPERVISOR_MOTION:
+            hangInMotion(hangMs);
+            break;
+        case SUPERVISOR_WEB:
+            webHangMs = hangMs;
+            server.request(HTTP_GET, "/hang");
+            break;
+        case SUPERVISOR_LOOP:
+            nativeClockAdvance((uint64_t)hangMs * 1000); // stuck outside any marked operation
+            break;
+        default:
+            hangInLoop(h.subsystem, hangMs);
+            break;
+        }
+        bool restarted = fakeRestarts() == before + 1;
+        supervisorBoot();
+
+        ResetLogEntry log[RESET_LOG_ENTRIES];
+        uint8_t n = resetLogRead(log, RESET_LOG_ENTRIES);
+        const ResetLogEntry &e = log[n - 1];
+        bool named = restarted && e.cause == RESET_STALL && e.subsystem == h.subsystem && e.stalledMs > h.limit &&
+                     e.stalledMs <= h.limit + SUPERVISOR_CHECK_MS + 1;
+        allNamed = allNamed && named;
+        printf("  %-8s restart %-3s  logged %-6s %-8s stalled %5u ms (limit %5lu)\n",
+               supervisorSubsystemName(h.subsystem), restarted ? "yes" : "no", resetCauseName(e.cause),
+               supervisorSubsystemName(e.subsystem), e.stalledMs, h.limit);
+        simRun(10000);
+    }
+    check.expect(allNamed,
+                 "every hang restarts once, the log names the subsystem, stall within one check of its limit");
+
+    // Other reset causes, and the log bound
+    fakeSetResetReason(HAL_RESET_WATCHDOG);
+    supervisorBoot();
+    ResetLogEntry log[RESET_LOG_ENTRIES];
+    uint8_t n = resetLogRead(log, RESET_LOG_ENTRIES);
+    bool twdt = log[n - 1].cause == RESET_TASK_WDT;
+    fakeSetResetReason(HAL_RESET_POWER_ON);
+    memset(halNoinit(), 0xA5, HAL_NOINIT_SIZE); // RTC memory content after power-up is random
+    supervisorBoot();
+    n = resetLogRead(log, RESET_LOG_ENTRIES);
+    check.expect(twdt && log[n - 1].cause == RESET_POWER_ON, "task watchdog and power-on resets logged as such");
+    uint32_t boots = supervisorBootCount();
+    for (int i = 0; i < RESET_LOG_ENTRIES + 4; i++)
+        supervisorBoot();
+    n = resetLogRead(log, RESET_LOG_ENTRIES);
+    check.expect(n == RESET_LOG_ENTRIES && supervisorBootCount() == boots + RESET_LOG_ENTRIES + 4 &&
+                     log[n - 1].boot == supervisorBootCount() &&
+                     log[0].boot == log[n - 1].boot - (RESET_LOG_ENTRIES - 1),
+                 "log keeps the last 16 boots, boot counter survives");
+
+    server.request(HTTP_GET, "/resets");
+    std::string body = server.responseBody();
+    check.expect(server.responseCode() == 200 && body.find("\"boots\":") == 1 &&
+                     body.find("\"resets\":[{") != std::string::npos,
+                 "/resets serves the log as JSON");
+
+    // Stall records on the flash survive a reboot that finds none in RTC memory
+    hangInControl(SUPERVISOR_CONTROL_STALL_MS + 3000);
+    supervisorBoot();
+    server.request(HTTP_GET, "/resets");
+    check.expect(server.responseBody().find("\"cause\":\"stall\",\"subsystem\":\"control\"") != std::string::npos,
+                 "stall entries listed with subsystem and duration");
+
+#ifdef ST_METRICS
+    printf("Overhead: loop() avg %.0f ns, p99 <= %.0f ns on the histogram; supervisor calls %.1f ns per pass (%.1f%%)\n",
+           loopAvgNs, loopP99Ns, beatNs, 100.0 * beatNs / loopAvgNs);
+#else
+    printf("Overhead: supervisor calls %.1f ns per loop() pass\n", beatNs);
+#endif
+
+    return check.finish();
+}
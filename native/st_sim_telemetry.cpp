@@ -0,0 +1,414 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <Arduino.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_status_bin.h"
+#include "st_snapshot.h"
+#include "st_alloc_count.h"
+#include "time_rtc.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// TELEMETRY CHECK
+// =====================================================
+// Three dashboards watching a tracking morning (with a rain stop in the
+// middle): 5 s /status polling vs. the /events stream. Counts JSON
+// serializations, bytes and RTC reads, and how often a viewer shows
+// something other than the control snapshot (sampled every 200 ms).
+
+// Value of "key" in a flat JSON object (number or string), false if absent
+static bool jsonField(const std::string &json, const char *key, std::string &value)
+{
+    std::string k = std::string("\"") + key + "\":";
+    size_t p = json.find(k);
+    if (p == std::string::npos)
+        return false;
+    p += k.size();
+    size_t end;
+    if (json[p] == '"')
+    {
+        end = json.find('"', p + 1);
+        value = json.substr(p + 1, end - p - 1);
+    }
+    else
+    {
+        end = json.find_first_of(",}", p);
+        value = json.substr(p, end - p);
+    }
+    return true;
+}
+
+struct Viewer
+{
+    std::string state;
+    int32_t yaw = -1;
+    int32_t tilt = -1;
+    int32_t sunAz = 0;
+    int32_t sunAlt = 0;
+    bool weather = false;
+    bool synced = false;   // has a full event
+    size_t seen = 0;       // events consumed
+    uint32_t polls = 0;
+};
+
+static void viewerFromStatus(Viewer &v, const std::string &body)
+{
+    std::string s;
+    if (jsonField(body, "state", s))
+        v.state = s;
+    if (jsonField(body, "yaw", s))
+        v.yaw = (int32_t)lround(atof(s.c_str()) * 100);
+    if (jsonField(body, "tilt", s))
+        v.tilt = (int32_t)lround(atof(s.c_str()) * 100);
+    if (jsonField(body, "sunAzimuth", s))
+        v.sunAz = (int32_t)lround(atof(s.c_str()) * 100);
+    if (jsonField(body, "sunAltitude", s))
+        v.sunAlt = (int32_t)lround(atof(s.c_str()) * 100);
+    if (jsonField(body, "weatherStop", s))
+        v.weather = s == "true";
+    v.synced = true;
+}
+
+static void viewerFromEvents(Viewer &v, AsyncEventSourceClient &c)
+{
+    for (; v.seen < c.received.size(); v.seen++)
+    {
+        const AsyncEventMessage &m = c.received[v.seen];
+        if (m.event == "full")
+            v.synced = true;
+        if (!v.synced)
+            continue;
+        std::string s;
+        if (jsonField(m.data, "st", s))
+            v.state = s;
+        if (jsonField(m.data, "y", s))
+            v.yaw = atoi(s.c_str());
+        if (jsonField(m.data, "t", s))
+            v.tilt = atoi(s.c_str());
+        if (jsonField(m.data, "az", s))
+            v.sunAz = atoi(s.c_str());
+        if (jsonField(m.data, "al", s))
+            v.sunAlt = atoi(s.c_str());
+        if (jsonField(m.data, "w", s))
+            v.weather = s == "1";
+    }
+}
+
+// Sun within /status resolution (0.1°) and the stream's deadband
+static bool viewerCurrent(const Viewer &v)
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    return v.synced && v.state == trackerStateName(snap.state) && v.yaw == snap.yaw && v.tilt == snap.tilt &&
+           abs(v.sunAz - degToCd(snap.sunAzimuth)) <= TELEMETRY_SUN_DEADBAND_CD &&
+           abs(v.sunAlt - degToCd(snap.sunAltitude)) <= TELEMETRY_SUN_DEADBAND_CD && v.weather == weatherSaysStop;
+}
+
+struct TelemetryRun
+{
+    uint32_t serializations; // /status builds or event broadcasts
+    size_t bytes;            // all viewers, HTTP headers not counted
+    uint32_t rtcReads;
+    uint32_t samples;
+    uint32_t staleSamples;
+    uint32_t maxStaleMs;
+    bool finalCurrent;
+    bool lateJoinerCurrent;
+    size_t perViewer;        // events each viewer received
+    uint32_t idleBroadcasts; // after every viewer left
+};
+
+static TelemetryRun runTelemetry(bool push, int minutes, const SimOptions &o)
+{
+    const int viewers = 3;
+    fakeControlTaskEnable(true);
+    DateTime start(o.year, o.month, o.day, 9, 0, 0);
+    simSkyAt(start, o);
+    weatherSaysStop = false;
+    events.close();
+    setup();
+    simRunUntil(STATE_TRACKING, 1000);
+
+    std::vector<Viewer> v(viewers + 1);
+    std::vector<size_t> client(viewers + 1);
+    uint32_t broadcasts0 = events.broadcasts;
+    for (int i = 0; i < viewers && push; i++)
+    {
+        server.request(HTTP_GET, "/events");
+        client[i] = events.clientCount() - 1;
+    }
+
+    TelemetryRun r = {};
+    uint32_t rtc0 = fakeRtcReads();
+    std::vector<uint32_t> staleSince(viewers, 0);
+    const uint32_t endMs = minutes * 60000;
+    const uint32_t rainFrom = endMs / 2, rainTo = rainFrom + 60000;
+    for (uint32_t ms = 1; ms <= endMs; ms++)
+    {
+        nativeClockAdvance(1000);
+        loop();
+        if (ms % 1000 == 0)
+            simSkyMove(DateTime(start.unixtime() + ms / 1000), o);
+        if (ms == rainFrom || ms == rainTo)
+            server.request(HTTP_GET, "/weather", {{"rain", ms == rainFrom ? "1" : "0"}, {"k", API_KEY}});
+        if (push && ms == endMs / 4)
+        {
+            server.request(HTTP_GET, "/events");
+            client[viewers] = events.clientCount() - 1;
+        }
+
+        for (int i = 0; i < viewers; i++)
+        {
+            if (push)
+            {
+                viewerFromEvents(v[i], events.client(client[i]));
+            }
+            else if ((ms + i * 1667) % 5000 == 0)
+            {
+                server.request(HTTP_GET, "/status");
+                viewerFromStatus(v[i], server.responseBody());
+                r.bytes += server.responseBody().size();
+                r.serializations++;
+            }
+        }
+        if (ms % READ_INTERVAL == 0)
+        {
+            for (int i = 0; i < viewers; i++)
+            {
+                r.samples++;
+                if (viewerCurrent(v[i]))
+                {
+                    staleSince[i] = 0;
+                    continue;
+                }
+                r.staleSamples++;
+                if (staleSince[i] == 0)
+                    staleSince[i] = ms;
+                r.maxStaleMs = std::max(r.maxStaleMs, (uint32_t)(ms - staleSince[i] + READ_INTERVAL));
+            }
+        }
+    }
+    r.rtcReads = fakeRtcReads() - rtc0;
+
+    // Let the last change go out, then compare
+    simRun(500);
+    r.finalCurrent = true;
+    for (int i = 0; i < viewers; i++)
+    {
+        if (push)
+            viewerFromEvents(v[i], events.client(client[i]));
+        else
+            viewerFromStatus(v[i], (server.request(HTTP_GET, "/status"), server.responseBody()));
+        r.finalCurrent = r.finalCurrent && viewerCurrent(v[i]);
+    }
+
+    if (push)
+    {
+        r.serializations = events.broadcasts - broadcasts0;
+        r.perViewer = events.client(client[0]).received.size();
+        for (int i = 0; i < viewers; i++)
+            r.bytes += events.client(client[i]).bytes;
+        viewerFromEvents(v[viewers], events.client(client[viewers]));
+        r.lateJoinerCurrent = events.client(client[viewers]).received.front().event == "full" &&
+                              viewerCurrent(v[viewers]);
+
+        events.close();
+        uint32_t before = events.broadcasts;
+        simRun(60000);
+        r.idleBroadcasts = events.broadcasts - before;
+    }
+    return r;
+}
+
+int simCheckTelemetry(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 20; // minutes per run
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    simBegin(o);
+
+    TelemetryRun poll = runTelemetry(false, o.days, o);
+    TelemetryRun push = runTelemetry(true, o.days, o);
+
+    printf("Telemetry, 3 viewers, %d min tracking from 09:00 with 1 min rain stop\n", o.days);
+    printf("  %-18s %8s %9s %9s %8s %10s\n", "", "JSON", "bytes", "RTC reads", "stale", "max stale");
+    auto row = [](const char *name, const TelemetryRun &r) {
+        printf("  %-18s %8u %9zu %9u %7.1f%% %7.1f s\n", name, r.serializations, r.bytes, r.rtcReads,
+               100.0 * r.staleSamples / std::max(r.samples, 1u), r.maxStaleMs / 1000.0);
+    };
+    row("/status every 5 s", poll);
+    row("/events", push);
+
+    check.expect(push.finalCurrent && push.lateJoinerCurrent,
+                 "stream viewers (and one joining later, full event first) end on the control snapshot");
+    check.expect(push.serializations < poll.serializations && push.bytes < poll.bytes &&
+                     push.perViewer == push.serializations,
+                 "fewer serializations and bytes than polling, one serialization per update for all viewers");
+    check.expect(push.rtcReads <= poll.rtcReads, "no RTC reads per viewer (only the clock's own syncs)");
+    check.expect(push.staleSamples * 10 < poll.staleSamples && push.maxStaleMs <= 2 * READ_INTERVAL,
+                 "viewers are current within one event interval");
+    check.expect(push.idleBroadcasts == 0, "no viewers, no events");
+
+    return check.finish();
+}
+
+// =====================================================
+// BINARY STATUS CHECK
+// =====================================================
+// /status.bin against /status: same values, fewer bytes, and what a
+// collector pays to decode one scrape. The batch variant after 20 min of
+// tracking, and a reader that only knows the header contract.
+
+// Collector side: walk the records by header.sampleSize, read the v1 prefix
+static bool decodeStatusBin(const std::string &body, std::vector<StatusSample> &out)
+{
+    StatusBinHeader h;
+    if (body.size() < sizeof(h))
+        return false;
+    memcpy(&h, body.data(), sizeof(h));
+    if (h.magic != STATUS_BIN_MAGIC || h.version < 1 || h.sampleSize < sizeof(StatusSample) ||
+        body.size() != h.headerSize + (size_t)h.count * h.sampleSize)
+        return false;
+    out.resize(h.count);
+    for (uint16_t i = 0; i < h.count; i++)
+        memcpy(&out[i], body.data() + h.headerSize + (size_t)i * h.sampleSize, sizeof(StatusSample));
+    return true;
+}
+
+int simCheckStatusBin(int argc, char **argv)
+{
+    SimOptions o;
+    o.days = 20; // minutes of tracking
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    simBegin(o);
+    fakeControlTaskEnable(true);
+    DateTime start(o.year, o.month, o.day, 10, 0, 0);
+    simSkyAt(start, o);
+    setup();
+
+    const uint32_t endMs = o.days * 60000;
+    for (uint32_t ms = 1; ms <= endMs; ms++)
+    {
+        nativeClockAdvance(1000);
+        loop();
+        if (ms % 1000 == 0)
+            simSkyMove(DateTime(start.unixtime() + ms / 1000), o);
+    }
+
+    // Live sample vs. JSON, in the same millisecond
+    server.request(HTTP_GET, "/status");
+    std::string json = server.responseBody();
+    server.request(HTTP_GET, "/status.bin");
+    std::string bin = server.responseBody();
+    std::vector<StatusSample> live;
+    bool decoded = server.responseCode() == 200 && server.responseType() == STATUS_BIN_CONTENT_TYPE &&
+                   decodeStatusBin(bin, live) && live.size() == 1;
+    check.expect(decoded, "/status.bin: one v1 sample behind a valid header");
+
+    Viewer fromJson;
+    viewerFromStatus(fromJson, json);
+    if (decoded)
+    {
+        const StatusSample &s = live[0];
+        bool same = fromJson.state == trackerStateName(s.state) && fromJson.yaw == s.yaw &&
+                    fromJson.tilt == s.tilt && abs(fromJson.sunAz - s.sunAz) <= 5 &&
+                    abs(fromJson.sunAlt - s.sunAlt) <= 5 && (s.flags & STATUS_FLAG_TIME) &&
+                    (s.flags & STATUS_FLAG_TASK) && s.epoch == getCurrentTime().unixtime() && s.uptimeMs == millis();
+        check.expect(same, "same state, angles, sun position and time as /status");
+        check.expect(s.ldr[0] > 0 && s.ldr[3] > 0 && s.periods > 0 && s.freeHeap > 0,
+                     "raw LDRs, control timing and free heap filled in");
+    }
+
+    StatusSample probe;
+    allocCountStart();
+    statusSampleNow(probe);
+    AllocStats alloc = allocCountStop();
+    check.expect(alloc.allocations == 0, "sample built without heap allocations");
+
+    // Batch from the ring
+    server.request(HTTP_GET, "/status.bin", {{"n", "12"}});
+    std::vector<StatusSample> batch;
+    bool batchOk = server.responseCode() == 200 && decodeStatusBin(server.responseBody(), batch) &&
+                   batch.size() == 12 && millis() - batch.back().uptimeMs < STATUS_BIN_SAMPLE_MS;
+    for (size_t i = 1; batchOk && i < batch.size(); i++)
+        batchOk = batch[i].uptimeMs - batch[i - 1].uptimeMs == STATUS_BIN_SAMPLE_MS &&
+                  batch[i].epoch - batch[i - 1].epoch == STATUS_BIN_SAMPLE_MS / 1000;
+    check.expect(batchOk, "?n=12: the last 12 ring samples, oldest first, one interval apart");
+    size_t batchBytes = server.responseBody().size();
+
+    server.request(HTTP_GET, "/status.bin", {{"n", std::to_string(STATUS_RING_SIZE - 1)}});
+    check.expect(decodeStatusBin(server.responseBody(), batch) && batch.size() == STATUS_RING_SIZE - 1,
+                 "largest batch is the whole ring");
+    bool badOk = true;
+    for (const char *bad : {"0", "64", "-1", "12x", ""})
+    {
+        server.request(HTTP_GET, "/status.bin", {{"n", bad}});
+        badOk = badOk && server.responseCode() == 400;
+    }
+    check.expect(badOk, "n outside 1..63 or not a number: 400");
+
+    uint16_t count;
+    uint32_t first = statusRingFirst(STATUS_RING_SIZE - 1, count);
+    StatusSample lapped;
+    check.expect(!statusRingRead(first - 1, lapped) && statusRingRead(first, lapped),
+                 "a sample the ring has lapped is refused");
+
+    // A v2 firmware appends fields: an old reader still finds v1 in place
+    std::string v2(sizeof(StatusBinHeader), '\0');
+    StatusBinHeader h2;
+    statusBinHeader(h2, 2);
+    h2.version = 2;
+    h2.sampleSize = sizeof(StatusSample) + 8;
+    memcpy(&v2[0], &h2, sizeof(h2));
+    for (int i = 0; i < 2; i++)
+    {
+        v2.append((const char *)&live[0], sizeof(StatusSample));
+        v2.append(8, (char)0xAB);
+    }
+    std::vector<StatusSample> fromV2;
+    check.expect(decodeStatusBin(v2, fromV2) && fromV2.size() == 2 && fromV2[1].yaw == live[0].yaw &&
+                     fromV2[1].late == live[0].late,
+                 "longer samples of a newer version decode by sampleSize");
+
+    // Collector cost per scrape
+    const int iterations = 200000;
+    volatile int64_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        Viewer v;
+        viewerFromStatus(v, json);
+        sink = sink + v.yaw;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        std::vector<StatusSample> s;
+        decodeStatusBin(bin, s);
+        sink = sink + s[0].yaw;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double jsonNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    double binNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+
+    printf("Status per scrape after %d min tracking\n", o.days);
+    printf("  /status          %4zu bytes, collector decode %7.0f ns (6 fields)\n", json.size(), jsonNs);
+    printf("  /status.bin      %4zu bytes, collector decode %7.0f ns (all fields)\n", bin.size(), binNs);
+    printf("  /status.bin?n=12 %4zu bytes (%.1f per sample)\n", batchBytes, (batchBytes - 8) / 12.0);
+    check.expect(bin.size() * 4 < json.size(), "binary status under a quarter of the JSON bytes");
+
+    return check.finish();
+}
@@ -0,0 +1,425 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_wifi.h"
+#include "st_ntp.h"
+#include "st_clock.h"
+#include "st_snapshot.h"
+#include "time_rtc.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// NTP / WLAN CHECK
+// =====================================================
+// A tracker without RTC against a local NTP server stand-in behind the
+// WiFiUDP stand-in: the station link comes up late, then the server
+// answers, goes silent, answers too late, sends kiss-o'-death, and the
+// link drops. Nothing in loop() may wait - the virtual time spent inside
+// loop() must stay 0 - and the control task keeps its period.
+
+#define NTP_STANDIN_UNIX_OFFSET 2208988800UL
+
+class NtpStandIn : public UdpPeer
+{
+public:
+    uint64_t utcMsAtZero = 0; // true UTC at millis() == 0
+    uint32_t oneWayMs = 20;
+    bool answer = true;
+    bool kissOfDeath = false;
+    bool wrongOrigin = false;
+    std::vector<unsigned long> requests; // millis() of each request seen
+
+    uint64_t utcMs() const { return utcMsAtZero + millis(); }
+
+    void receive(WiFiUDP &from, const IPAddress &to, uint16_t port, const uint8_t *data, size_t len) override
+    {
+        requests.push_back(millis());
+        if (!answer || len < 48 || port != 123 || (uint32_t)to != (uint32_t)FAKE_DNS_ADDR)
+            return;
+        uint8_t p[48] = {};
+        p[0] = 0x24; // LI 0, version 4, mode 4 (server)
+        p[1] = kissOfDeath ? 0 : 2;
+        if (kissOfDeath)
+            memcpy(p + 12, "RATE", 4);
+        memcpy(p + 24, data + 40, 8); // origin = client transmit
+        if (wrongOrigin)
+            p[31] ^= 0x01;
+        // Stamped when the request arrives, answered right away
+        uint64_t t = utcMs() + oneWayMs;
+        uint32_t secs = (uint32_t)(t / 1000) + NTP_STANDIN_UNIX_OFFSET;
+        uint32_t frac = (uint32_t)(((t % 1000) << 32) / 1000);
+        for (int i = 0; i < 4; i++)
+        {
+            p[40 + i] = secs >> (24 - 8 * i);
+            p[44 + i] = frac >> (24 - 8 * i);
+        }
+        from.reply(p, sizeof(p), millis() + 2 * oneWayMs);
+    }
+};
+
+static NtpStandIn ntpServer;
+static uint64_t ntpMaxLoopUs = 0; // virtual time spent inside one loop()
+
+static void ntpDrive(uint32_t ms, uint32_t stepMs, std::function<bool()> until = nullptr)
+{
+    for (uint32_t t = 0; t < ms; t += stepMs)
+    {
+        nativeClockAdvance((uint64_t)stepMs * 1000);
+        uint64_t t0 = nativeClockMicros();
+        loop();
+        ntpMaxLoopUs = std::max(ntpMaxLoopUs, nativeClockMicros() - t0);
+        if (until && until())
+            return;
+    }
+}
+
+// Software clock vs. the stand-in's true time (local = UTC+2 in June)
+static long ntpClockError()
+{
+    return (long)getCurrentTime().unixtime() - (long)(ntpServer.utcMs() / 1000 + 7200);
+}
+
+int simCheckNtp(int argc, char **argv)
+{
+    SimOptions o;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+    auto ntp = []() {
+        NtpStatus s;
+        ntpRead(s);
+        return s;
+    };
+    auto link = []() {
+        WifiLinkStatus s;
+        wifiRead(s);
+        return s;
+    };
+
+    simBegin(o);
+    fakeControlTaskEnable(true);
+    fakeRtcRemove();
+    DateTime start(o.year, o.month, o.day, 10, 0, 0); // local
+    ntpServer.utcMsAtZero = (uint64_t)(start.unixtime() - 7200) * 1000;
+    simSkyMove(start, o);
+    WiFiUDP::setPeer(&ntpServer);
+    WiFi.setNetwork(true, 3000);
+    fakeSetDns(true, 30);
+
+    // Boot: setup() no longer waits for the link or the server
+    unsigned long t0 = millis();
+    setup();
+    unsigned long setupMs = millis() - t0;
+    ntpDrive(20000, 1, [&]() { return link().state == WIFI_LINK_UP; });
+    WifiLinkStatus l = link();
+    ntpDrive(5000, 1, [&]() { return ntp().synced; });
+    NtpStatus s = ntp();
+    unsigned long firstSyncMs = s.lastSync - t0;
+    printf("Boot without RTC: setup() %lu ms, link up after %lu ms, first sync at %lu ms (rtt %lu ms)\n",
+           setupMs, (unsigned long)l.connectMs, firstSyncMs, (unsigned long)s.rttMs);
+    check.expect(setupMs <= 600, "setup() returns without waiting for WLAN or NTP");
+    check.expect(l.state == WIFI_LINK_UP && l.connectMs >= 3000 && l.connectMs <= 3001 && l.attempts == 1,
+                 "station link up once the network associates, connect latency reported");
+    check.expect(s.synced && s.lastResult == NTP_RESULT_OK && s.rttMs == 2 * ntpServer.oneWayMs && timeInitialized &&
+                     abs(ntpClockError()) <= 1,
+                 "first sync right after link up, rtt reported, clock within 1 s");
+
+    uint32_t sent = WiFiUDP::sent();
+    uint32_t lookups = fakeDnsLookups();
+    for (int i = 0; i < 10000; i++)
+        calculateSunPosition();
+    check.expect(WiFiUDP::sent() == sent && fakeDnsLookups() == lookups && currentSunAltitude > 0,
+                 "sun calculations without RTC never touch the network");
+
+    // Server silent from the next scheduled sync on
+    ntpServer.answer = false;
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    uint32_t periods0 = snap.timing.periods;
+    unsigned long outageStart = millis();
+    size_t firstLost = ntpServer.requests.size();
+    ntpDrive(NTP_UPDATE_INTERVAL + 2400000, 5);
+    snapshotRead(snap);
+    uint32_t expectedPeriods = (millis() - outageStart) / READ_INTERVAL;
+    s = ntp();
+    printf("Server silent for 40 min after the hourly sync: %u requests, gaps (s):",
+           (unsigned)(ntpServer.requests.size() - firstLost));
+    bool backoffOk = ntpServer.requests.size() - firstLost >= 9;
+    uint32_t retry = NTP_RETRY_MIN_MS;
+    for (size_t i = firstLost + 1; i < ntpServer.requests.size(); i++)
+    {
+        unsigned long gap = ntpServer.requests[i] - ntpServer.requests[i - 1];
+        printf(" %lu", gap / 1000);
+        long expected = (long)(NTP_TIMEOUT_MS + retry);
+        backoffOk = backoffOk && abs((long)gap - expected) <= 50; // DNS lookup included
+        retry = std::min(retry * 2, (uint32_t)NTP_RETRY_MAX_MS);
+    }
+    printf("\n");
+    check.expect(backoffOk, "timeouts back off exponentially up to NTP_RETRY_MAX_MS");
+    check.expect(s.state == NTP_BACKOFF && s.lastResult == NTP_RESULT_TIMEOUT &&
+                     s.timeouts == ntpServer.requests.size() - firstLost && s.failures == s.timeouts,
+                 "status reports backoff, last result and timeouts");
+    check.expect(snap.timing.periods - periods0 >= expectedPeriods - 1 && abs(ntpClockError()) <= 1,
+                 "tracking and the software clock keep running during the outage");
+
+    // Server back: the next retry syncs and the backoff resets
+    ntpServer.answer = true;
+    ntpDrive(NTP_RETRY_MAX_MS + NTP_TIMEOUT_MS, 5, [&]() { return ntp().failures == 0; });
+    s = ntp();
+    check.expect(s.lastResult == NTP_RESULT_OK && s.retryMs == 0 && abs(ntpClockError()) <= 1,
+                 "server back: synced at the next retry, backoff reset");
+
+    // A reply slower than the timeout must not answer the next request
+    size_t before = ntpServer.requests.size();
+    ntpServer.oneWayMs = 1500;
+    ntpDrive(NTP_UPDATE_INTERVAL + 1000, 5, [&]() { return ntpServer.requests.size() > before; });
+    ntpServer.oneWayMs = 20;
+    uint32_t timeouts = ntp().timeouts;
+    ntpDrive(NTP_TIMEOUT_MS + 100, 1, [&]() { return ntp().lastResult == NTP_RESULT_TIMEOUT; });
+    ntpDrive(60000, 1, [&]() { return ntp().lastResult == NTP_RESULT_OK; });
+    s = ntp();
+    check.expect(s.timeouts == timeouts + 1 && s.lastResult == NTP_RESULT_OK && s.rttMs == 40 &&
+                     abs(ntpClockError()) <= 1,
+                 "late reply to a timed-out request dropped, next request synced");
+
+    ntpServer.wrongOrigin = true;
+    uint32_t rejected = ntp().rejected;
+
+    ntpDrive(NTP_UPDATE_INTERVAL + NTP_TIMEOUT_MS + 100, 5, [&]() { return ntp().lastResult == NTP_RESULT_TIMEOUT; });
+    ntpServer.wrongOrigin = false;
+    s = ntp();
+    check.expect(s.rejected == rejected + 1 && s.lastResult == NTP_RESULT_TIMEOUT,
+                 "reply with a foreign origin timestamp rejected");
+    ntpDrive(NTP_RETRY_MIN_MS + 1000, 5);
+
+    ntpServer.kissOfDeath = true;
+    ntpDrive(NTP_UPDATE_INTERVAL + 1000, 5, [&]() { return ntp().lastResult == NTP_RESULT_KOD; });
+    before = ntpServer.requests.size();
+    ntpDrive(NTP_RETRY_MAX_MS - 1000, 5);
+    s = ntp();
+    check.expect(s.lastResult == NTP_RESULT_KOD && s.retryMs == NTP_RETRY_MAX_MS && ntpServer.requests.size() == before,
+                 "kiss-o'-death backs off to the maximum at once");
+    ntpServer.kissOfDeath = false;
+
+    // Link lost, network gone for 10 min, then back
+    WiFi.setNetwork(false);
+    WiFi.setConnected(false);
+    sent = WiFiUDP::sent();
+    uint32_t begins = WiFi.begins();
+    std::vector<unsigned long> beginTimes;
+    for (uint32_t ms = 0; ms < 600000; ms += 5)
+    {
+        ntpDrive(5, 5);
+        if (WiFi.begins() != begins)
+        {
+            beginTimes.push_back(millis());
+            begins = WiFi.begins();
+        }
+    }
+    l = link();
+    printf("Network gone for 10 min: %u connection attempts, gaps (s):", (unsigned)beginTimes.size());
+    bool wifiBackoffOk = beginTimes.size() >= 6;
+    retry = WIFI_RETRY_MIN_MS;
+    for (size_t i = 1; i < beginTimes.size(); i++)
+    {
+        unsigned long gap = beginTimes[i] - beginTimes[i - 1];
+        printf(" %lu", gap / 1000);
+        wifiBackoffOk = wifiBackoffOk && abs((long)gap - (long)(WIFI_CONNECT_TIMEOUT_MS + retry)) <= 10;
+        retry = std::min(retry * 2, (uint32_t)WIFI_RETRY_MAX_MS);
+    }
+    printf("\n");
+    check.expect(l.drops == 1 && wifiBackoffOk, "link loss detected, reconnects back off exponentially");
+    check.expect(WiFiUDP::sent() == sent, "no NTP traffic without a link");
+
+    WiFi.setNetwork(true, 2000);
+    ntpDrive(WIFI_RETRY_MAX_MS + WIFI_CONNECT_TIMEOUT_MS, 5, [&]() { return link().state == WIFI_LINK_UP; });
+    l = link();
+    check.expect(l.state == WIFI_LINK_UP && l.connects == 2 && l.connectMs >= 2000 && l.connectMs <= 2005,
+                 "network back: reconnected at the next attempt");
+
+    // New credentials: reconnect from loop() without delay()
+    begins = WiFi.begins();
+    server.request(HTTP_POST, "/wifi/save", {{"ssid", "Hofer"}, {"pass", "MTLia21.01.21g"}});
+    ntpDrive(1500, 1);
+    bool connecting = link().state == WIFI_LINK_CONNECTING;
+    ntpDrive(5000, 1, [&]() { return link().state == WIFI_LINK_UP; });
+    check.expect(server.responseCode() == 200 && connecting && link().state == WIFI_LINK_UP &&
+                     WiFi.begins() == begins + 1,
+                 "/wifi/save reconnects after the response");
+
+    s = ntp();
+    printf("NTP: %u requests, %u replies, %u timeouts, %u rejected; WLAN: %u attempts, %u drops\n",
+           (unsigned)s.requests, (unsigned)s.replies, (unsigned)s.timeouts, (unsigned)s.rejected,
+           (unsigned)link().attempts, (unsigned)link().drops);
+    printf("Longest wait inside loop(): %llu us (virtual)\n", (unsigned long long)ntpMaxLoopUs);
+    check.expect(ntpMaxLoopUs == 0, "loop() never waits on WLAN, DNS or NTP");
+
+    server.request(HTTP_GET, "/status");
+    std::string body = server.responseBody();
+    check.expect(server.responseCode() == 200 && body.find("\"wifi\":{\"state\":\"up\"") != std::string::npos &&
+                     body.find("\"ntp\":{\"state\":") != std::string::npos &&
+                     body.find("\"rttMs\":40") != std::string::npos,
+                 "/status reports link and sync state with latency");
+
+    WiFiUDP::setPeer(nullptr);
+    return check.finish();
+}
+
+// =====================================================
+// SOFTWARE CLOCK CHECK
+// =====================================================
+// A week per scenario with the time base (esp_timer) running 35 ppm
+// fast and the DS3231 2 ppm fast: no reference at all (what millis()
+// extrapolation gave), RTC only, NTP every hour, and a day without NTP
+// after six days with it. Only the time path runs, a pass every 5 ms
+// like a loaded loop(); the tracker itself has no part in it.
+
+#define CLOCK_SIM_TIMEBASE_PPB 35000
+#define CLOCK_SIM_RTC_PPB 2000
+#define CLOCK_SIM_STEP_US 5000
+#define CLOCK_SIM_SETTLE_US (3 * 3600000000ULL)
+
+struct ClockRun
+{
+    double maxErrUs;    // against UTC, once settled
+    double maxRtcErrUs; // against the RTC's own time, once settled
+    double finalErrUs;
+    double rtcReadsPerHour;
+    bool monotonic;
+    ClockStatus status;
+};
+
+static ClockRun runClock(bool rtc, bool network, uint32_t days, uint32_t ntpUntilS, const DateTime &startLocal)
+{
+    ClockRun r = {};
+    r.monotonic = true;
+    const uint64_t startUtcUs = (uint64_t)(startLocal.unixtime() - 7200) * 1000000ULL;
+    const uint64_t clock0 = nativeClockMicros();
+    auto trueUtc = [&]() { return startUtcUs + (nativeClockMicros() - clock0); };
+
+    if (rtc)
+        fakeRtcSet(startLocal);
+    else
+        fakeRtcRemove();
+    ntpServer.utcMsAtZero = startUtcUs / 1000 - millis();
+    ntpServer.answer = true;
+    WiFi.setNetwork(network, 3000);
+    initRTC();
+    wifiBegin();
+    ntpBegin();
+    if (!rtc && !network)
+    {
+        // Set once from a perfect reference, then left alone
+        clockDiscipline(CLOCK_SOURCE_NTP, trueUtc(), halMonotonicUs(), 0);
+    }
+
+    uint32_t rtcReads0 = 0;
+    uint64_t last = 0;
+    const uint64_t endUs = (uint64_t)days * 86400000000ULL;
+    for (uint64_t t = 0; t < endUs; t += CLOCK_SIM_STEP_US)
+    {
+        nativeClockAdvance(CLOCK_SIM_STEP_US);
+        if (t / 1000000 == ntpUntilS)
+            ntpServer.answer = false;
+        wifiService();
+        updateTime();
+
+        uint64_t now = clockUtcUs();
+        if (now < last)
+            r.monotonic = false;
+        last = now;
+        // Settled: the hourly NTP replies need two hours for a rate
+        if (t == CLOCK_SIM_SETTLE_US)
+            rtcReads0 = fakeRtcReads();
+        if (t >= CLOCK_SIM_SETTLE_US)
+        {
+            uint64_t elapsed = nativeClockMicros() - clock0;
+            double err = (double)(int64_t)(now - trueUtc());
+            double rtcErr = err - elapsed * (CLOCK_SIM_RTC_PPB / 1e9);
+            r.maxErrUs = std::max(r.maxErrUs, fabs(err));
+            r.maxRtcErrUs = std::max(r.maxRtcErrUs, fabs(rtcErr));
+            r.finalErrUs = err;
+        }
+    }
+    r.rtcReadsPerHour = (fakeRtcReads() - rtcReads0) / ((endUs - CLOCK_SIM_SETTLE_US) / 3600e6);
+    clockRead(r.status);
+    return r;
+}
+
+int simCheckClock(int argc, char **argv)
+{
+    SimOptions o;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    SimCheck check;
+
+    DateTime start(o.year, o.month, o.day, 10, 0, 0); // local, UTC+2
+    fakeSetTimebaseDrift(CLOCK_SIM_TIMEBASE_PPB);
+    fakeSetRtcDrift(CLOCK_SIM_RTC_PPB);
+    WiFiUDP::setPeer(&ntpServer);
+    fakeSetDns(true, 30);
+    halFsBegin();
+
+    const uint32_t week = 7;
+    ClockRun free = runClock(false, false, week, UINT32_MAX, start);
+    ClockRun rtcOnly = runClock(true, false, week, UINT32_MAX, start);
+    ClockRun ntp = runClock(true, true, week, UINT32_MAX, start);
+    ClockRun holdover = runClock(false, true, week, 6 * 86400, start);
+
+    printf("Software clock, one week, time base %+.0f ppm, RTC %+.0f ppm, a pass every %u ms\n",
+           CLOCK_SIM_TIMEBASE_PPB / 1000.0, CLOCK_SIM_RTC_PPB / 1000.0, CLOCK_SIM_STEP_US / 1000);
+    printf("  %-22s %12s %12s %10s %9s %8s %6s\n", "", "max error", "end error", "rate ppm", "RTC rd/h", "syncs", "steps");
+    auto row = [](const char *name, const ClockRun &r) {
+        printf("  %-22s %9.1f ms %9.1f ms %+10.3f %9.1f %8u %6u\n", name, r.maxErrUs / 1e3, r.finalErrUs / 1e3,
+               r.status.ratePpb / 1000.0, r.rtcReadsPerHour, (unsigned)(r.status.ntpSyncs + r.status.rtcSyncs),
+               (unsigned)r.status.steps);
+    };
+    row("free running", free);
+    row("RTC only", rtcOnly);
+    row("NTP hourly", ntp);
+    row("NTP lost on day 7", holdover);
+    double unlearnedUs = CLOCK_SIM_TIMEBASE_PPB / 1e9 * 86400e6;
+    printf("  (errors from hour 3 on; before that NTP hourly has no rate yet: up to %.0f ms)\n",
+           CLOCK_SIM_TIMEBASE_PPB / 1e9 * 3600e3);
+    printf("  RTC only against the RTC itself: max %.1f ms\n", rtcOnly.maxRtcErrUs / 1000.0);
+    printf("  day without NTP: %.1f ms off, %.0f ms without the learned rate\n", fabs(holdover.finalErrUs) / 1000.0,
+           unlearnedUs / 1000.0);
+
+    check.expect(fabs(free.finalErrUs) > 0.9 * CLOCK_SIM_TIMEBASE_PPB / 1e9 * week * 86400e6,
+                 "free running drifts by the time base error (baseline)");
+    check.expect(rtcOnly.maxRtcErrUs < 20000 && rtcOnly.rtcReadsPerHour < 120,
+                 "RTC only: follows the RTC within 20 ms, a few edge polls per sync instead of a read per call");
+    check.expect(ntp.maxErrUs < 10000 && fabs(ntp.status.ratePpb + CLOCK_SIM_TIMEBASE_PPB) < 1000,
+                 "NTP hourly: within 10 ms of UTC all week, time base rate learned");
+    check.expect(fabs(holdover.finalErrUs) < unlearnedUs / 10,
+                 "a day without NTP: learned rate keeps 10x better than none");
+    check.expect(free.monotonic && rtcOnly.monotonic && ntp.monotonic && holdover.monotonic,
+                 "never runs backwards (offsets ahead are slewed)");
+    check.expect(ntp.status.steps <= 2 && rtcOnly.status.steps <= 1, "steps only at boot");
+
+    // Readers: no bus access
+    const int calls = 100000;
+    uint32_t reads0 = fakeRtcReads();
+    auto t0 = std::chrono::steady_clock::now();
+    uint32_t sink = 0;
+    for (int i = 0; i < calls; i++)
+        sink += getCurrentTime().second();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / calls;
+    printf("getCurrentTime(): %.0f ns per call (host), %u RTC reads in %d calls (%u)\n", ns,
+           (unsigned)(fakeRtcReads() - reads0), calls, (unsigned)(sink & 1));
+    check.expect(fakeRtcReads() == reads0, "getCurrentTime() never reads the RTC");
+
+    WiFiUDP::setPeer(nullptr);
+    return check.finish();
+}
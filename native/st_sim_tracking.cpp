@@ -0,0 +1,211 @@
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_history_log.h"
+#include "st_strategy.h"
+#include "st_config.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// TRACKING SIMULATION
+// =====================================================
+struct DayStats
+{
+    double errorSum = 0;
+    uint32_t errorSamples = 0;
+    double energy = 0;
+    double ideal = 0;
+};
+
+TrackingRun runTracking(const SimOptions &o)
+{
+    rng.seed(o.seed);
+    std::bernoulli_distribution cloudStart(o.clouds * 0.05);
+    std::bernoulli_distribution cloudEnd((1.0 - o.clouds) * 0.05);
+    bool cloudy = false;
+
+    settings.latitude = o.latitude;
+    settings.longitude = o.longitude;
+
+    DateTime start(o.year, o.month, o.day, 0, 0, 0);
+    fakeRtcSet(start);
+    fakeSetLdrModel(ldrModel);
+    fakeSetLdrNoise(o.noise);
+    uint64_t clockStart = nativeClockMicros();
+
+    // Fresh history for comparable runs; geo is forced above, so no stored config
+    halFsBegin();
+    historyLogRemove();
+    LittleFS.remove("/config.bin");
+    updateSky(start, o.latitude, o.longitude, false);
+
+    setup();
+    settings.latitude = o.latitude;
+    settings.longitude = o.longitude;
+    settings.rowPitch = o.backtrack ? o.rowPitch : 0.0f;
+    settings.panelWidth = o.panelWidth;
+    settings.rowAzimuth = o.rowAzimuth;
+
+    fakeResetServoStats();
+    LittleFS.resetStats();
+    uint32_t rowsBefore = historyLogCount();
+
+    TrackingRun r;
+    r.errorHist.assign(1801, 0);
+    TrackerState lastState = trackerState;
+
+    DayStats dayStats;
+    int currentDay = -1;
+    uint64_t lastSkyUpdate = 0;
+    uint64_t lastCloudUpdate = 0;
+    const uint64_t endMicros = (uint64_t)o.days * 86400ULL * 1000000ULL;
+    const double stepHours = o.stepMs / 3600000.0;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    while (nativeClockMicros() - clockStart < endMicros)
+    {
+        uint64_t elapsed = nativeClockMicros() - clockStart;
+        DateTime now(start.unixtime() + (uint32_t)(elapsed / 1000000ULL));
+
+        if (elapsed - lastCloudUpdate >= 60000000ULL)
+        {
+            lastCloudUpdate = elapsed;
+            cloudy = cloudy ? !cloudEnd(rng) : cloudStart(rng);
+        }
+        if (elapsed - lastSkyUpdate >= 5000000ULL || elapsed == 0)
+        {
+            lastSkyUpdate = elapsed;
+            updateSky(now, o.latitude, o.longitude, cloudy);
+            fakeLdrModelChanged();
+        }
+
+        if (now.day() != currentDay)
+        {
+            if (o.daily && currentDay >= 0)
+            {
+                printf("  %04d-%02d-%02d  energy %5.1f %%  mean error %5.2f°\n",
+                       now.year(), now.month(), currentDay,
+                       dayStats.ideal > 0 ? 100.0 * dayStats.energy / dayStats.ideal : 0.0,
+                       dayStats.errorSamples ? dayStats.errorSum / dayStats.errorSamples : 0.0);
+            }
+            dayStats = DayStats();
+            currentDay = now.day();
+        }
+
+        loop();
+
+        if (trackerState != lastState)
+        {
+            r.transitions++;
+            if (trackerState == STATE_TRACKING)
+                r.toTracking++;
+            else if (trackerState == STATE_SLEEP)
+                r.toSleep++;
+            lastState = trackerState;
+        }
+
+        if (sky.altitude > 0.0)
+        {
+            double panelAz, panelAlt;
+            poseToDirection(fakeServoYaw(), fakeServoTilt(), panelAz, panelAlt);
+            double err = angleBetween(panelAz, panelAlt, sky.azimuth, sky.altitude);
+            r.errorHist[std::min((size_t)(err * 10.0), r.errorHist.size() - 1)]++;
+            r.errorSamples++;
+            r.errorSum += err;
+
+            double captured = sky.direct * std::max(0.0, cos(radians(err))) * (1.0 - rowLoss(panelAlt)) * stepHours;
+            r.energy += captured;
+            r.ideal += sky.direct * stepHours;
+            dayStats.errorSum += err;
+            dayStats.errorSamples++;
+            dayStats.energy += captured;
+            dayStats.ideal += sky.direct * stepHours;
+        }
+
+        nativeClockAdvance((uint64_t)o.stepMs * 1000);
+    }
+    r.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    r.historyRows = historyLogCount() - rowsBefore;
+    return r;
+}
+
+// One run in detail, or --strategy all: every strategy on the same sky
+int simRunTracking(int argc, char **argv)
+{
+    SimOptions o;
+    if (!parseOptions(argc, argv, o))
+        return 2;
+
+    std::vector<TrackStrategyId> strategies;
+    if (o.strategy == "all")
+    {
+        for (uint8_t i = 0; i < STRATEGY_COUNT; i++)
+            strategies.push_back((TrackStrategyId)i);
+    }
+    else
+    {
+        TrackStrategyId id = strategySelected();
+        if (o.strategy.length() && !strategyFromName(o.strategy.c_str(), id))
+        {
+            fprintf(stderr, "unknown strategy %s\n", o.strategy.c_str());
+            return 2;
+        }
+        strategies.push_back(id);
+    }
+#ifndef ST_STRATEGY_RUNTIME
+    if (strategies.size() > 1 || strategies[0] != strategySelected())
+    {
+        fprintf(stderr, "built for strategy %s only (-DST_STRATEGY_RUNTIME compiles all)\n",
+                strategyName(strategySelected()));
+        return 2;
+    }
+#endif
+
+    printf("Simulation %04d-%02d-%02d +%d d @ %.4f, %.4f (clouds %.2f, noise ±%d, seed %u, step %lu ms)\n",
+           o.year, o.month, o.day, o.days, o.latitude, o.longitude, o.clouds, o.noise, o.seed, o.stepMs);
+    if (strategies.size() > 1)
+    {
+        printf("  mount off by az %+.1f° alt %+.1f°\n", o.mountAz, o.mountAlt);
+        printf("  %-10s %8s %9s %6s %13s %15s\n", "strategy", "energy", "mean err", "p95", "servo writes",
+               "servo travel");
+    }
+
+    for (TrackStrategyId id : strategies)
+    {
+#ifdef ST_STRATEGY_RUNTIME
+        strategySelect(id);
+#endif
+        TrackingRun r = runTracking(o);
+        const FakeServoStats &servo = fakeServoStats();
+        if (strategies.size() > 1)
+        {
+            printf("  %-10s %7.1f%% %8.2f° %5.1f° %13u %14.0f°\n", strategyName(id), r.capture(), r.meanError(),
+                   r.percentile(0.95), servo.yawWrites + servo.tiltWrites,
+                   (servo.yawTravel + servo.tiltTravel) / (double)ANGLE_SCALE);
+            continue;
+        }
+
+        double virtualHours = o.days * 24.0;
+        printf("  strategy         %s\n", strategyName(id));
+        printf("  virtual time     %.1f h in %.2f s wall (x%.0f)\n",
+               virtualHours, r.wall, virtualHours * 3600.0 / r.wall);
+        printf("  pointing error   mean %.2f°  p50 %.1f°  p95 %.1f°  max %.1f°  (sun above horizon)\n",
+               r.meanError(), r.percentile(0.50), r.percentile(0.95), r.maxError());
+        printf("  energy capture   %.1f %% of ideal two-axis tracking (%.2f kWh/m² beam)\n",
+               r.capture(), r.energy / 1000.0);
+        printf("  servo travel     yaw %.0f°  tilt %.0f°  (writes %u / %u)\n",
+               servo.yawTravel / (double)ANGLE_SCALE, servo.tiltTravel / (double)ANGLE_SCALE,
+               servo.yawWrites, servo.tiltWrites);
+        printf("  state changes    %u  (->TRACKING %u, ->SLEEP %u)\n", r.transitions, r.toTracking, r.toSleep);
+        printf("  history writes   %u rows, %llu bytes to flash\n",
+               r.historyRows, (unsigned long long)LittleFS.stats().bytesWritten);
+    }
+    return 0;
+}
@@ -0,0 +1,299 @@
+#include <chrono>
+#include <string>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include "config.h"
+#include "st_hal_fake.h"
+#include "st_servo.h"
+#include "st_webserver.h"
+#include "st_web_assets.h"
+#include "st_wifi.h"
+#include "st_ntp.h"
+#include "st_clock.h"
+#include "st_init.h"
+#include "st_strategy.h"
+#include "st_motion.h"
+#include "st_control.h"
+#include "st_snapshot.h"
+#include "st_alloc_count.h"
+#include "time_rtc.h"
+#include "st_config.h"
+#include "st_hal.h"
+#include "st_sim_common.h"
+#include "st_sim.h"
+
+// =====================================================
+// JSON BENCHMARK
+// =====================================================
+// /status body: String concatenation as handleStatus() built it before
+// st_json vs. buildStatusJson(). Host String is std::string (with small
+// string optimization), so the ESP32 core allocates at least as often.
+
+static String legacyStatusJson()
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    const ControlTiming &timing = snap.timing;
+
+    String json = "{";
+    json += "\"state\":\"";
+    switch (trackerState)
+    {
+    case STATE_INIT:
+        json += "INIT";
+        break;
+    case STATE_TRACKING:
+        json += "TRACKING";
+        break;
+    case STATE_SLEEP:
+        json += "SLEEP";
+        break;
+    case STATE_CALIBRATING:
+        json += "CALIBRATING";
+        break;
+    }
+    json += "\",\"yaw\":" + String(cdToDeg(yawAngle), 2);
+    json += ",\"tilt\":" + String(cdToDeg(tiltAngle), 2);
+    json += ",\"weatherStop\":" + String(weatherSaysStop ? "true" : "false");
+    json += ",\"timeInitialized\":" + String(timeInitialized ? "true" : "false");
+    json += ",\"rtcAvailable\":" + String(rtcAvailable ? "true" : "false");
+    json += ",\"wifiConnected\":" + String(WiFi.status() == WL_CONNECTED ? "true" : "false");
+    json += ",\"lastNTPUpdate\":" + String(millis() - lastNTPUpdate);
+    json += ",\"latitude\":" + String(settings.latitude, 6);
+    json += ",\"longitude\":" + String(settings.longitude, 6);
+    json += ",\"useAutoDST\":" + String(settings.autoDst ? "true" : "false");
+    json += ",\"timezoneOffset\":" + String(getCurrentTimezoneOffset() / 3600.0, 1);
+    if (timeInitialized)
+    {
+        DateTime now = getCurrentTime();
+        char timeBuffer[30];
+        sprintf(timeBuffer, "%04d-%02d-%02d %02d:%02d:%02d",
+                now.year(), now.month(), now.day(),
+                now.hour(), now.minute(), now.second());
+        json += ",\"time\":\"" + String(timeBuffer) + "\"";
+    }
+    if (timeInitialized)
+    {
+        json += ",\"sunAzimuth\":" + String(currentSunAzimuth, 1);
+        json += ",\"sunAltitude\":" + String(currentSunAltitude, 1);
+        json += ",\"backtracking\":" + String(sunBacktracking ? "true" : "false");
+    }
+    json += ",\"control\":{\"task\":" + String(controlTaskRunning() ? "true" : "false");
+    json += ",\"strategy\":\"" + String(strategyName(strategySelected())) + "\"";
+    json += ",\"periods\":" + String(timing.periods);
+    json += ",\"lastPeriodUs\":" + String(timing.lastPeriodUs);
+    json += ",\"jitterMeanUs\":" + String(timing.meanJitterUs);
+    json += ",\"jitterMaxUs\":" + String(timing.maxJitterUs);
+    json += ",\"late\":" + String(timing.late) + "}";
+    MotionStatus motion;
+    motionRead(motion);
+    json += ",\"motion\":{\"moving\":" + String(motion.moving ? "true" : "false");
+    json += ",\"yaw\":" + String(cdToDeg(motion.yaw), 2);
+    json += ",\"tilt\":" + String(cdToDeg(motion.tilt), 2);
+    json += ",\"moves\":" + String(motion.moves);
+    json += ",\"coalesced\":" + String(motion.coalesced);
+    json += ",\"writes\":" + String(motion.writes) + "}";
+    WifiLinkStatus link;
+    wifiRead(link);
+    json += ",\"wifi\":{\"state\":\"" + String(wifiLinkStateName(link.state)) + "\"";
+    json += ",\"rssi\":" + String(WiFi.RSSI());
+    json += ",\"attempts\":" + String(link.attempts);
+    json += ",\"drops\":" + String(link.drops);
+    json += ",\"connectMs\":" + String(link.connectMs);
+    json += ",\"retryMs\":" + String(link.retryMs) + "}";
+    NtpStatus ntp;
+    ntpRead(ntp);
+    json += ",\"ntp\":{\"state\":\"" + String(ntpStateName(ntp.state)) + "\"";
+    json += ",\"result\":\"" + String(ntpResultName(ntp.lastResult)) + "\"";
+    json += ",\"synced\":" + String(ntp.synced ? "true" : "false");
+    json += ",\"rttMs\":" + String(ntp.rttMs);
+    json += ",\"requests\":" + String(ntp.requests);
+    json += ",\"timeouts\":" + String(ntp.timeouts);
+    json += ",\"rejected\":" + String(ntp.rejected);
+    json += ",\"retryMs\":" + String(ntp.retryMs) + "}";
+    ClockStatus clk;
+    clockRead(clk);
+    json += ",\"clock\":{\"source\":\"" + String(clockSourceName(clk.source)) + "\"";
+    json += ",\"ratePpb\":" + String(clk.ratePpb);
+    json += ",\"rateBaselineS\":" + String(clk.rateBaselineS);
+    json += ",\"offsetUs\":" + String(clk.lastOffsetUs);
+    json += ",\"uncertaintyUs\":" + String(clk.uncertaintyUs);
+    json += ",\"steps\":" + String(clk.steps);
+    json += ",\"rtcReads\":" + String(clk.rtcReads) + "}";
+    BootInfo boot;
+    bootRead(boot);
+    json += ",\"boot\":{\"tracking\":" + String(boot.tracking ? "true" : "false");
+    json += ",\"firstTrackMs\":" + String(boot.firstTrackMs);
+    json += ",\"pointing\":\"" + String(bootPointingName(boot.pointing)) + "\"";
+    json += ",\"recordAgeS\":" + String(boot.recordAgeS) + "}";
+    json += "}";
+    return json;
+}
+
+int simBenchJson(int argc, char **argv)
+{
+    int iterations = 100000;
+    if (argc >= 2 && String(argv[0]) == "--iterations")
+        iterations = atoi(argv[1]);
+
+    fakeRtcSet(DateTime(2025, 6, 21, 12, 34, 56));
+    fakeSetLdr(2400, 2400, 2400, 2400);
+    halFsBegin();
+    setup();
+    simRun(50, READ_INTERVAL * 1000);
+    yawAngle = 12345;
+    tiltAngle = 6789;
+    controlPublish();
+
+    SimCheck check;
+    String legacy = legacyStatusJson();
+    char buf[STATUS_JSON_MAX];
+    size_t len = buildStatusJson(buf, sizeof(buf));
+    bool same = len > 0 && legacy == String(std::string(buf, len));
+    if (!same)
+        printf("  old: %s\n  new: %.*s\n", legacy.c_str(), (int)len, buf);
+
+    struct Result
+    {
+        AllocStats alloc;
+        double nsPerCall;
+        double rtcReadsPerCall;
+    };
+    auto measure = [&](bool useLegacy) {
+        Result r;
+        uint32_t rtcBefore = fakeRtcReads();
+        volatile size_t sink = 0;
+        allocCountStart();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            if (useLegacy)
+                sink = sink + legacyStatusJson().length();
+            else
+                sink = sink + buildStatusJson(buf, sizeof(buf));
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        r.alloc = allocCountStop();
+        r.nsPerCall = ns / iterations;
+        r.rtcReadsPerCall = (double)(fakeRtcReads() - rtcBefore) / iterations;
+        return r;
+    };
+    Result oldR = measure(true);
+    Result newR = measure(false);
+
+    // A handler only ever needs the one stack buffer; overflow is reported
+    char small[64];
+    bool overflowOk = buildStatusJson(small, sizeof(small)) == 0;
+
+    printf("/status JSON, %zu bytes, %d builds (%s output)\n", len, iterations, same ? "identical" : "DIFFERENT");
+    printf("  String +=    %6.2f allocs  %6.0f heap bytes  %6.0f ns  %.1f RTC reads per request\n",
+           (double)oldR.alloc.allocations / iterations, (double)oldR.alloc.bytes / iterations,
+           oldR.nsPerCall, oldR.rtcReadsPerCall);
+    printf("  st_json      %6.2f allocs  %6.0f heap bytes  %6.0f ns  %.1f RTC reads per request\n",
+           (double)newR.alloc.allocations / iterations, (double)newR.alloc.bytes / iterations,
+           newR.nsPerCall, newR.rtcReadsPerCall);
+    printf("  overflow     %s\n", overflowOk ? "64 byte buffer -> rejected, no partial JSON sent" : "NOT DETECTED");
+    check.expect(same, "st_json output identical to the String version");
+    check.expect(newR.alloc.allocations == 0, "st_json builds without heap allocations");
+    check.expect(overflowOk, "overflow rejected, no partial JSON");
+    return check.finish();
+}
+
+// =====================================================
+// WEB UI CHECK
+// =====================================================
+// Body bytes per page load from the gzip assets: first visit (page,
+// stylesheet, JSON values) vs. a revisit with the ETags the browser
+// kept (304s, stylesheet cached as immutable). "raw" is the same visit
+// uncompressed. Also checks the caching headers and that the JSON
+// endpoints and form posts behind the static pages still work.
+
+struct WebPage
+{
+    const char *uri;
+    const char *json; // values fetched by the page
+    bool styled;      // links /style.css
+};
+
+int simCheckWeb(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    SimCheck check;
+
+    fakeRtcSet(DateTime(2025, 6, 21, 12, 0, 0));
+    fakeSetLdr(2400, 2400, 2400, 2400);
+    setup();
+
+    bool headersOk = true;
+    bool revalidateOk = true;
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++)
+    {
+        const WebAsset &a = WEB_ASSETS[i];
+        server.request(HTTP_GET, a.uri);
+        const std::string &body = server.responseBody();
+        headersOk = headersOk && server.responseCode() == 200 && body.size() == a.gzLen && body.size() > 2 &&
+                    (uint8_t)body[0] == 0x1f && (uint8_t)body[1] == 0x8b &&
+                    server.responseHeader("Content-Encoding") == "gzip" && server.responseHeader("ETag") == a.etag &&
+                    server.responseHeader("Cache-Control") == a.cacheControl;
+        revalidateOk = revalidateOk && server.request(HTTP_GET, a.uri, {}, {{"If-None-Match", a.etag}}) == 304 &&
+                       server.responseBody().empty() && server.responseHeader("ETag") == a.etag &&
+                       server.request(HTTP_GET, a.uri, {}, {{"If-None-Match", "\"0000000000000000\""}}) == 200;
+    }
+    check.expect(headersOk, "assets: 200, gzip body as stored, Content-Encoding, strong ETag, Cache-Control");
+    check.expect(revalidateOk, "If-None-Match: 304 without body on a match, 200 on a stale tag");
+
+    const WebAsset *css = nullptr;
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++)
+    {
+        if (String(WEB_ASSETS[i].uri) == "/style.css")
+            css = &WEB_ASSETS[i];
+    }
+    check.expect(css && strstr(css->cacheControl, "immutable"), "/style.css is versioned and cached as immutable");
+
+    const WebPage pages[] = {
+        {"/", "/status", false},
+        {"/geo", "/geo.json", true},
+        {"/wifi", "/wifi.json", true},
+        {"/calibrate", "/calibrate.json", true},
+        {"/debug", "/debug.json", true},
+    };
+    printf("Web UI, body bytes per page load (headers not counted)\n");
+    printf("  %-11s %8s %8s %8s\n", "page", "raw", "gzip", "revisit");
+    bool jsonOk = true;
+    size_t rawSum = 0, gzSum = 0, revisitSum = 0;
+    for (const WebPage &p : pages)
+    {
+        const WebAsset *page = nullptr;
+        for (size_t i = 0; i < WEB_ASSET_COUNT; i++)
+        {
+            if (String(WEB_ASSETS[i].uri) == p.uri)
+                page = &WEB_ASSETS[i];
+        }
+        jsonOk = jsonOk && server.request(HTTP_GET, p.json) == 200 && server.responseType() == "application/json";
+        size_t json = server.responseBody().size();
+        size_t raw = page->rawLen + (p.styled ? css->rawLen : 0) + json;
+        size_t gz = page->gzLen + (p.styled ? css->gzLen : 0) + json;
+        printf("  %-11s %8zu %8zu %8zu\n", p.uri, raw, gz, json);
+        rawSum += raw;
+        gzSum += gz;
+        revisitSum += json;
+    }
+    printf("  %-11s %8zu %8zu %8zu\n", "all", rawSum, gzSum, revisitSum);
+    check.expect(jsonOk, "JSON values for every page");
+
+    // The control task applies the posted values at its next step
+    bool geoPosted = server.request(HTTP_POST, "/geo/save",
+                                    {{"lat", "47.5"}, {"lon", "9.75"}, {"autodst", "0"}, {"tzoffset", "2"}}) == 200;
+    controlStep();
+    check.expect(geoPosted && server.request(HTTP_GET, "/geo.json") == 200 &&
+                     server.responseBody() ==
+                         "{\"latitude\":47.500000,\"longitude\":9.750000,\"useAutoDST\":false,\"manualTimezoneOffset\":2.0,"
+                         "\"rowPitch\":0.00,\"panelWidth\":0.00,\"rowAzimuth\":90.0,\"gcr\":0.000}",
+                 "POST /geo/save reaches its handler, /geo.json returns the saved values");
+    check.expect(server.request(HTTP_POST, "/geo") == 404, "pages answer GET only");
+    LittleFS.remove("/config.bin");
+
+    return check.finish();
+}
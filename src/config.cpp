@@ -6,26 +6,55 @@
 const char *AP_SSID = "SolarTracker_AP";
 const char *AP_PASS = "SolarTracker";
 const char *API_KEY = "key-123";
-char staSsid[64] = "Hofer";
-char staPass[64] = "MTLia21.01.21g";
 
-// WiFi connection parameters
-const int WIFI_CONNECT_RETRIES = 20;            // Number of retry attempts for WiFi connection
-const unsigned long WIFI_RETRY_DELAY_MS = 500;  // Delay between WiFi connection retries (ms)
+// WiFi connection parameters (st_wifi)
+const unsigned long WIFI_CONNECT_TIMEOUT_MS = 10000; // One connection attempt (ms)
+const unsigned long WIFI_RETRY_MIN_MS = 5000;        // Backoff after the first failed attempt (ms)
+const unsigned long WIFI_RETRY_MAX_MS = 300000;      // Backoff cap, doubled per failure (5 min)
 
 // =====================================================
 // GEO CONFIG (Definitions)
 // =====================================================
 const double DEFAULT_LATITUDE = 52.5200;
 const double DEFAULT_LONGITUDE = 13.4050;
-double currentLatitude = 52.5200;
-double currentLongitude = 13.4050;
 
-// Timezone configuration
-bool useAutoDST = true;                // Automatic EU DST calculation enabled by default
-int manualTimezoneOffset = 3600;       // Manual offset: UTC+1 (3600 sec) - used when useAutoDST is false
+// Persistent settings (st_config): defaults until /config.bin is loaded
+const Settings SETTINGS_DEFAULTS = {
+    DEFAULT_LATITUDE,
+    DEFAULT_LONGITUDE,
+    3600,             // Manual offset: UTC+1 (3600 sec) - used when autoDst is false
+    true,             // Automatic EU DST calculation enabled by default
+    true,             // Debug output enabled by default
+    {0, 0},
+    9000,             // calibYaw: 90.00°
+    9000,             // calibTilt
+    "Hofer",          // staSsid
+    "MTLia21.01.21g", // staPass
+    0.0f,             // rowPitch: no rows, no backtracking
+    0.0f,             // panelWidth: 0 with rowPitch 0
+    90.0f,            // rowAzimuth: neighbours east and west
+};
+Settings settings = SETTINGS_DEFAULTS;
+
 const unsigned long NTP_UPDATE_INTERVAL = 3600000;  // Interval for NTP time sync (1 hour)
 
+// NTP client (st_ntp)
+const char *NTP_SERVER = "pool.ntp.org";
+const uint16_t NTP_LOCAL_PORT = 2390;            // Local UDP port for the replies
+const unsigned long NTP_TIMEOUT_MS = 2000;       // DNS lookup, then reply (ms each)
+const unsigned long NTP_RETRY_MIN_MS = 4000;     // Backoff after the first failure (ms)
+const unsigned long NTP_RETRY_MAX_MS = 900000;   // Backoff cap, also after kiss-o'-death (15 min)
+
+// Software clock (st_clock)
+const unsigned long CLOCK_RTC_SYNC_MS = 600000;      // RTC edge sync while NTP is silent (10 min)
+const unsigned long CLOCK_NTP_HOLD_MS = 7200000;     // NTP counts as silent after two missed syncs
+const uint32_t CLOCK_RTC_POLL_US = 2000;             // RTC reads while waiting for its seconds edge
+const uint32_t CLOCK_RTC_GUARD_US = 20000;           // Start polling this early before the predicted edge
+const uint32_t CLOCK_STEP_US = 1000000;              // Larger offsets step, smaller ones slew or step forward
+const uint32_t CLOCK_SLEW_PPM = 500;                 // Slew rate for offsets ahead of the reference
+const unsigned long CLOCK_RATE_MIN_MS = 600000;      // Shortest baseline for a rate estimate (10 min)
+const unsigned long CLOCK_RATE_WINDOW_MS = 21600000; // Baseline restarts after 6 h (temperature)
+
 // =====================================================
 // STARTUP & TIMING (Definitions)
 // =====================================================
@@ -47,6 +76,8 @@ const int SERVO_TILT_PIN = 26;
 
 const int SERVO_MIN = 0;
 const int SERVO_MAX = 180;
+const int SERVO_PULSE_MIN_US = 544;   // ESP32Servo defaults for 0..180°
+const int SERVO_PULSE_MAX_US = 2400;
 
 const int YAW_MIN = 5;
 const int YAW_MAX = 175;
@@ -61,21 +92,66 @@ const int TILT_DIR = 1;
 // =====================================================
 const float DEAD_BAND_YAW = 0.01;
 const float DEAD_BAND_TILT = 0.01;
-const int STEP_YAW = 1;
-const int STEP_TILT = 1;
 const int MIN_LIGHT_SUM = 100;
 
+const float CTRL_KP_YAW = 4.0f;
+const float CTRL_KI_YAW = 8.0f;
+const float CTRL_KP_TILT = 4.0f;
+const float CTRL_KI_TILT = 8.0f;
+const float CTRL_OFFSET_LIMIT = 10.0f;
+const int CTRL_MAX_STEP_YAW = 10;   // 60° slew in ~1.2 s instead of 12 s
+const int CTRL_MAX_STEP_TILT = 10;
+
 const unsigned long READ_INTERVAL = 200;
+
+const uint32_t CONTROL_TASK_PERIOD_MS = 10;  // READ_INTERVAL and settle times are multiples
+const int CONTROL_TASK_CORE = 0;             // Arduino loop() runs on core 1
+const int CONTROL_TASK_PRIORITY = 5;         // above loop() (1), below WiFi/lwIP
+const uint32_t CONTROL_TASK_STACK = 8192;
 const unsigned long SERIAL_LOG_INTERVAL = 5000;
 
+const uint32_t SENSOR_SAMPLE_PERIOD_US = 1000;  // 1 kHz quad sampling
+const uint16_t SENSOR_DECIMATION = 16;         // 16 samples -> one frame every 16 ms, ring covers 128 ms
+
+const uint32_t MOTION_PERIOD_US = 20000;  // 50 Hz, the servo frame rate
+const float MOTION_VMAX_YAW = 60.0f;      // 60° slew in ~1.5 s
+const float MOTION_VMAX_TILT = 60.0f;
+const float MOTION_ACCEL_YAW = 120.0f;    // full speed after 0.5 s
+const float MOTION_ACCEL_TILT = 120.0f;
+const int MOTION_TASK_PRIORITY = 6;       // above the control task, a tick is a few us
+const uint32_t MOTION_TASK_STACK = 4096;
+
 const int NIGHT_THRESHOLD = 200;
 const int CLOUD_THRESHOLD = 600;
 
-const unsigned long WATCHDOG_TIMEOUT = 5000;              // Max time without main loop activity (ms)
-const unsigned long WATCHDOG_RESET_WINDOW_MS = 600000;  // Time window for counting watchdog hits (10 min)
-const uint8_t WATCHDOG_MAX_HITS = 3;                    // Max consecutive watchdog hits before restart
+const unsigned long SUPERVISOR_CHECK_MS = 1000;
+const unsigned long SUPERVISOR_TWDT_MS = 30000;          // above every stall limit, so the log names the subsystem
+const unsigned long SUPERVISOR_CONTROL_STALL_MS = 5000;  // the step runs every 10 ms
+const unsigned long SUPERVISOR_LOOP_STALL_MS = 5000;
+const unsigned long SUPERVISOR_WEB_STALL_MS = 10000;
+const unsigned long SUPERVISOR_TIME_STALL_MS = 5000;     // RTC read, WLAN/NTP steps never wait
+const unsigned long SUPERVISOR_STORAGE_STALL_MS = 5000;
+const unsigned long SUPERVISOR_MOTION_STALL_MS = 5000;   // the planner ticks every 20 ms
+
+const int CALIBRATION_STEP = 10;
+const int CALIBRATION_COARSE_STEP = 30;        // 7x6 cells
+const int CALIBRATION_SEED_STEP = 8;           // covers mounting errors up to ~CTRL_OFFSET_LIMIT
+const int CALIBRATION_FINE_STEP = 1;
+const uint16_t CALIBRATION_MAX_POINTS = 120;
+const unsigned long CALIBRATION_SETTLE_MS = 300;
 
 const uint8_t STATE_CHANGE_THRESHOLD = 3;
 
 // POS_HISTORY_SIZE is now a #define in config.h (needed for compile-time array sizing)
-const unsigned long HISTORY_WRITE_MIN_MS = 10000;  // Min time between history writes to protect flash (10 sec)
+const unsigned long HISTORY_WRITE_MIN_MS = 5 * 60 * 1000;  // Min time between history writes to protect flash (5 min)
+// 40 sector files = 160 KiB, ~10000 records = ~35 days at one row per 5 min.
+// Appends only touch the head file, so the ring size costs space, not writes.
+const uint32_t HISTORY_LOG_SECTORS = 40;
+const uint16_t HISTORY_EXPORT_RECORDS_PER_POLL = 32;
+const uint32_t BOOT_RESUME_MAX_AGE_S = 3600;       // the learned offset drifts with the sun's path
+
+const unsigned long TELEMETRY_MIN_INTERVAL_MS = 200;  // one READ_INTERVAL
+const unsigned long TELEMETRY_KEEPALIVE_MS = 30000;
+const int32_t TELEMETRY_SUN_DEADBAND_CD = 10;         // 0.1°, the resolution /status reports
+
+const unsigned long STATUS_BIN_SAMPLE_MS = 5000; // 64 samples = 5 min 15 s
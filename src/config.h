@@ -3,17 +3,17 @@
 
 #include <WiFi.h>
 #include <WiFiClient.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ESP32Servo.h>
 #include <LittleFS.h>
 #include <WiFiUdp.h>
-#include <NTPClient.h>
 #include <time.h>
 #include <SolarCalculator.h>
 #include <RTClib.h>
 #include <Wire.h>
 
 #include "tracker_state.h"
+#include "st_config.h"
 
 // =====================================================
 // WLAN AP KONFIG
@@ -22,27 +22,38 @@ extern const char *AP_SSID;
 extern const char *AP_PASS;
 extern const char *API_KEY;
 
-// WLAN Station Konfig (für Internet/NTP)
-extern char staSsid[64];
-extern char staPass[64];
+// WLAN Station Konfig (für Internet/NTP): settings.staSsid/staPass (st_config)
 
-// WiFi connection parameters
-extern const int WIFI_CONNECT_RETRIES;         // Number of retry attempts for WiFi connection
-extern const unsigned long WIFI_RETRY_DELAY_MS; // Delay between WiFi connection retries (ms)
+// WiFi connection parameters (st_wifi)
+extern const unsigned long WIFI_CONNECT_TIMEOUT_MS; // One connection attempt (ms)
+extern const unsigned long WIFI_RETRY_MIN_MS;       // Backoff after the first failed attempt (ms)
+extern const unsigned long WIFI_RETRY_MAX_MS;       // Backoff cap, doubled per failure (ms)
 
 // =====================================================
 // ZEIT & GEO KONFIG
 // =====================================================
 extern const double DEFAULT_LATITUDE;
 extern const double DEFAULT_LONGITUDE;
-extern double currentLatitude;
-extern double currentLongitude;
-
-// Timezone configuration
-extern bool useAutoDST;                          // Automatic DST calculation (EU rules)
-extern int manualTimezoneOffset;                 // Manual timezone offset in seconds (UTC+1 = 3600)
+// Position and timezone: settings.latitude/longitude/autoDst/timezoneOffset (st_config)
 extern const unsigned long NTP_UPDATE_INTERVAL; // Interval for NTP time synchronization (ms)
 
+// NTP client (st_ntp)
+extern const char *NTP_SERVER;
+extern const uint16_t NTP_LOCAL_PORT;           // Local UDP port for the replies
+extern const unsigned long NTP_TIMEOUT_MS;      // DNS lookup, then reply (ms each)
+extern const unsigned long NTP_RETRY_MIN_MS;    // Backoff after the first failure (ms)
+extern const unsigned long NTP_RETRY_MAX_MS;    // Backoff cap, also after kiss-o'-death (ms)
+
+// Software clock (st_clock)
+extern const unsigned long CLOCK_RTC_SYNC_MS;    // RTC edge sync while NTP is silent (ms)
+extern const unsigned long CLOCK_NTP_HOLD_MS;    // NTP counts as silent after this (ms)
+extern const uint32_t CLOCK_RTC_POLL_US;         // RTC reads while waiting for its seconds edge (us)
+extern const uint32_t CLOCK_RTC_GUARD_US;        // Start polling this early before the predicted edge (us)
+extern const uint32_t CLOCK_STEP_US;             // Larger offsets step, smaller ones slew or step forward (us)
+extern const uint32_t CLOCK_SLEW_PPM;            // Slew rate for offsets ahead of the reference
+extern const unsigned long CLOCK_RATE_MIN_MS;    // Shortest baseline for a rate estimate (ms)
+extern const unsigned long CLOCK_RATE_WINDOW_MS; // Baseline restarts after this (ms)
+
 // =====================================================
 // STARTUP & TIMING
 // =====================================================
@@ -64,6 +75,8 @@ extern const int SERVO_TILT_PIN;
 
 extern const int SERVO_MIN;
 extern const int SERVO_MAX;
+extern const int SERVO_PULSE_MIN_US; // Pulse width at SERVO_MIN (us)
+extern const int SERVO_PULSE_MAX_US; // Pulse width at SERVO_MAX (us)
 
 // Mechanische Limits (zum Schutz der Hardware)
 extern const int YAW_MIN;
@@ -80,21 +93,61 @@ extern const int TILT_DIR;
 // =====================================================
 extern const float DEAD_BAND_YAW;
 extern const float DEAD_BAND_TILT;
-extern const int STEP_YAW;
-extern const int STEP_TILT;
 extern const int MIN_LIGHT_SUM;
 
+// Regler (st_controller): Vorsteuerung aus Sonnenposition + PI auf LDR-Fehler
+extern const float CTRL_KP_YAW;          // Degrees per unit change of normalized LDR error
+extern const float CTRL_KI_YAW;          // Degrees per unit normalized LDR error and step
+extern const float CTRL_KP_TILT;
+extern const float CTRL_KI_TILT;
+extern const float CTRL_OFFSET_LIMIT;    // Max learned offset to the astronomical target (degrees)
+extern const int CTRL_MAX_STEP_YAW;      // Max move per READ_INTERVAL (degrees)
+extern const int CTRL_MAX_STEP_TILT;
+
 extern const unsigned long READ_INTERVAL;
+
+// Regel-Task (st_control), FreeRTOS auf dem ESP32
+extern const uint32_t CONTROL_TASK_PERIOD_MS; // Wake-up period of the control task (ms)
+extern const int CONTROL_TASK_CORE;           // Core for the control task, loop()/async_tcp run on the other
+extern const int CONTROL_TASK_PRIORITY;
+extern const uint32_t CONTROL_TASK_STACK;     // Stack size (bytes)
 extern const unsigned long SERIAL_LOG_INTERVAL;
 
+// LDR-Abtastung im Hintergrund (st_sensors)
+#define SENSOR_RING_FRAMES 8                 // Decimated frames averaged per reading, #define for array sizing
+extern const uint32_t SENSOR_SAMPLE_PERIOD_US; // Sampler period for one quad sample (us)
+extern const uint16_t SENSOR_DECIMATION;       // Quad samples per decimated frame
+
+// Servo-Bewegung (st_motion): Trapezprofil auf einem Hardware-Timer
+extern const uint32_t MOTION_PERIOD_US;  // Planner tick, one servo frame (us)
+extern const float MOTION_VMAX_YAW;      // Max servo speed (degrees/s)
+extern const float MOTION_VMAX_TILT;
+extern const float MOTION_ACCEL_YAW;     // Max servo acceleration (degrees/s²)
+extern const float MOTION_ACCEL_TILT;
+extern const int MOTION_TASK_PRIORITY;   // Woken by the timer interrupt, on CONTROL_TASK_CORE
+extern const uint32_t MOTION_TASK_STACK; // Stack size (bytes)
+
 // Licht-/Wetterlogik
 extern const int NIGHT_THRESHOLD;
 extern const int CLOUD_THRESHOLD;
 
-// Watchdog
-extern const unsigned long WATCHDOG_TIMEOUT;         // Max time without main loop activity (ms)
-extern const unsigned long WATCHDOG_RESET_WINDOW_MS; // Time window for counting watchdog hits (ms)
-extern const uint8_t WATCHDOG_MAX_HITS;              // Max consecutive watchdog hits before restart
+// Watchdog (st_supervisor)
+extern const unsigned long SUPERVISOR_CHECK_MS;         // Heartbeat check period (ms)
+extern const unsigned long SUPERVISOR_TWDT_MS;          // ESP32 task watchdog, backstop behind the check (ms)
+extern const unsigned long SUPERVISOR_CONTROL_STALL_MS; // Max time between two control steps (ms)
+extern const unsigned long SUPERVISOR_LOOP_STALL_MS;    // Max time between two loop() passes (ms)
+extern const unsigned long SUPERVISOR_WEB_STALL_MS;     // Max time in one web handler (ms)
+extern const unsigned long SUPERVISOR_TIME_STALL_MS;    // Max time in one WLAN/NTP/RTC step (ms)
+extern const unsigned long SUPERVISOR_STORAGE_STALL_MS; // Max time in one flash write pass (ms)
+extern const unsigned long SUPERVISOR_MOTION_STALL_MS;  // Max time between two motion ticks (ms)
+
+// Kalibrierung (Sweep im Hintergrund, st_calibration)
+extern const int CALIBRATION_STEP;                 // Grid spacing for yaw and tilt (degrees)
+extern const int CALIBRATION_COARSE_STEP;          // Adaptive: grid spacing without a sun seed (degrees)
+extern const int CALIBRATION_SEED_STEP;            // Adaptive: first refine step around the sun seed (degrees)
+extern const int CALIBRATION_FINE_STEP;            // Adaptive: final resolution (degrees)
+extern const uint16_t CALIBRATION_MAX_POINTS;      // Adaptive: measurement budget
+extern const unsigned long CALIBRATION_SETTLE_MS;  // Wait after each move before measuring (ms)
 
 // Hysterese für Zustandswechsel
 extern const uint8_t STATE_CHANGE_THRESHOLD;
@@ -102,11 +155,16 @@ extern const uint8_t STATE_CHANGE_THRESHOLD;
 // History
 #define POS_HISTORY_SIZE 10  // Must be #define for compile-time array sizing
 extern const unsigned long HISTORY_WRITE_MIN_MS; // Minimum time between history writes to protect flash (ms)
+extern const uint32_t HISTORY_LOG_SECTORS;       // 4 KiB sector files /history_NN.bin (255 records each)
+extern const uint16_t HISTORY_EXPORT_RECORDS_PER_POLL; // Log records read per loop() pass during /history export
+extern const uint32_t BOOT_RESUME_MAX_AGE_S;     // Fast boot: newest history record older than this is not resumed (s)
+
+// Live-Telemetrie (SSE /events, st_telemetry)
+extern const unsigned long TELEMETRY_MIN_INTERVAL_MS; // Minimum time between two events (ms)
+extern const unsigned long TELEMETRY_KEEPALIVE_MS;    // Empty delta after this long without changes (ms)
+extern const int32_t TELEMETRY_SUN_DEADBAND_CD;       // Sun moves less than this: no event (centidegrees)
 
-// Module function declarations
-void loadGeoConfig(void);
-void saveGeoConfig(void);
-void loadWifiConfig(void);
-void saveWifiConfig(void);
+// Binärstatus (/status.bin, st_status_bin)
+extern const unsigned long STATUS_BIN_SAMPLE_MS; // RAM ring sample interval for /status.bin?n= (ms)
 
 #endif
@@ -6,49 +6,51 @@
    - Handy/Tablet verbindet sich darauf
    - über HTTP-API kann Regen/Wetter gesetzt werden
    - 4 LDRs, 2 Servos (Yaw unten, Tilt oben)
-   - Start-Einrichtung
+   - Start-Einrichtung (Schnellstart aus letzter Ausrichtung/RTC, vor dem WLAN)
+   - Servos nur über den Bewegungsplaner (Trapezprofil, Hardware-Timer)
    - Sleep bei Nacht/Wolken/Regen
-   - einfacher Software-Watchdog
+   - Supervisor: Heartbeats je Subsystem, Task-Watchdog, Reset-Log
+   - WLAN und NTP als Zustandsautomaten, setup()/loop() warten nie auf das Netz
+   - Regelung in eigenem Task (st_control), asynchroner Webserver (AsyncTCP)
 */
 
+#include <atomic>
 #include "st_debug.h"
 #include "config.h"
+#include "st_hal.h"
+#include "st_sensors.h"
+#include "st_history_log.h"
+#include "st_history_export.h"
 #include "time_rtc.h"
 #include "st_config.h"
 #include "st_helpers.h"
 #include "st_calibration.h"
-#include "st_init.h"
 #include "st_webserver.h"
+#include "st_control.h"
+#include "st_telemetry.h"
+#include "st_status_bin.h"
+#include "st_metrics.h"
+#include "st_supervisor.h"
+#include "st_wifi.h"
+#include "st_init.h"
+#include "st_motion.h"
 
 // =====================================================
-// SERVO OBJECTS
-// =====================================================
-Servo servoYaw;
-Servo servoTilt;
-
-// =====================================================
-// RUNTIME STATE - Current Positions
+// RUNTIME STATE - Current Positions (centidegrees, st_servo.h)
 // =====================================================
-int yawAngle = 90;
-int tiltAngle = 90;
+int32_t yawAngle = 9000;
+int32_t tiltAngle = 9000;
 
 // =====================================================
 // RUNTIME STATE - Timing
 // =====================================================
 unsigned long lastRead = 0;
 unsigned long lastSerialLog = 0;
-unsigned long lastAlive = 0;
-
-// =====================================================
-// RUNTIME STATE - Watchdog
-// =====================================================
-uint8_t watchdogHits = 0;
-unsigned long lastWatchdogReset = 0;
 
 // =====================================================
 // RUNTIME STATE - Weather & Tracking
 // =====================================================
-bool weatherSaysStop = false;
+std::atomic<bool> weatherSaysStop(false); // Written by the web server (async_tcp)
 TrackerState trackerState = STATE_INIT;
 TrackerState lastLoggedState = STATE_INIT;
 
@@ -61,8 +63,8 @@ uint8_t lightCount = 0;
 // =====================================================
 // RUNTIME STATE - Position History
 // =====================================================
-int historyYaw[POS_HISTORY_SIZE];
-int historyTilt[POS_HISTORY_SIZE];
+int32_t historyYaw[POS_HISTORY_SIZE];
+int32_t historyTilt[POS_HISTORY_SIZE];
 int historyIndex = 0;
 bool haveHistory = false;
 
@@ -77,11 +79,11 @@ unsigned long lastHistoryWrite = 0;
 // =====================================================
 void setup()
 {
+    bootBegin();
     DEBUG_INIT(115200);
-    delay(500);
     DEBUG_PRINTLN("Smart Solartracker (AP-Modus) startet...");
 
-    littlefsAvailable = LittleFS.begin(true);
+    littlefsAvailable = halFsBegin();
     if (!littlefsAvailable)
     {
         DEBUG_PRINTLN("⚠ LittleFS Mount fehlgeschlagen!");
@@ -89,98 +91,71 @@ void setup()
     else
     {
         DEBUG_PRINTLN("✓ LittleFS erfolgreich gemountet");
-        loadDebugConfig();
-        loadGeoConfig();
-        loadWifiConfig();
-        if (!LittleFS.exists("/history.csv"))
-        {
-            File file = LittleFS.open("/history.csv", "w");
-            if (file)
-            {
-                file.println("Timestamp,Yaw,Tilt,SunAzimuth,SunAltitude");
-                file.close();
-                DEBUG_PRINTLN("history.csv erstellt.");
-            }
-        }
+        configLoad();
+    }
+    supervisorBegin();
+    if (littlefsAvailable)
+    {
+        SupervisorScope storage(SUPERVISOR_STORAGE);
+        historyLogBegin();
     }
 
     initRTC();
 
-    servoYaw.attach(SERVO_YAW_PIN);
-    servoTilt.attach(SERVO_TILT_PIN);
+    halServoAttach();
+    motionBegin();
+    sensorsBegin();
 
-    DEBUG_PRINTLN("Starte WLAN im AP+Station Modus...");
-    WiFi.mode(WIFI_AP_STA);
-
-    DEBUG_PRINT("Starte AP: ");
-    DEBUG_PRINTLN(AP_SSID);
-    bool apOk = WiFi.softAP(AP_SSID, AP_PASS);
-    if (apOk)
+    // Fast boot: tracking starts from flash and the RTC (st_init.h)
+    // before the network is touched
+    trackerState = STATE_INIT;
+    if (calibrationResume())
     {
-        DEBUG_PRINT("AP gestartet. IP: ");
-        DEBUG_PRINTLN(WiFi.softAPIP());
+        bootAssumePose();
     }
     else
     {
-        DEBUG_PRINTLN("AP konnte nicht gestartet werden!");
-    }
-
-    DEBUG_PRINT("Verbinde mit WLAN: ");
-    DEBUG_PRINTLN(staSsid);
-    WiFi.begin(staSsid, staPass);
-
-    int wifiTimeout = 0;
-    while (WiFi.status() != WL_CONNECTED && wifiTimeout < 20)
-    {
-        delay(500);
-        DEBUG_PRINT(".");
-        wifiTimeout++;
+        doStartInit();
     }
-    DEBUG_PRINTLN();
+    controlPublish();
+    controlBegin();
 
-    if (WiFi.status() == WL_CONNECTED)
+    // Station link and NTP come up from loop() in the background
+    wifiBegin();
+    ntpBegin();
+    if (rtcAvailable)
     {
-        DEBUG_PRINT("WLAN verbunden! IP: ");
-        DEBUG_PRINTLN(WiFi.localIP());
-
-        // Prefer internet time when available
-        DEBUG_PRINTLN("Synchronisiere RTC mit NTP...");
-        if (!syncRTCFromNTP())
-        {
-            DEBUG_PRINTLN("⚠ NTP-Sync fehlgeschlagen, nutze RTC falls verfügbar.");
-        }
+        DEBUG_PRINTLN("Tracker laeuft mit RTC-Zeit bis zum NTP-Abgleich.");
     }
     else
     {
-        DEBUG_PRINTLN("WLAN-Verbindung fehlgeschlagen!");
-        if (rtcAvailable)
-        {
-            DEBUG_PRINTLN("Tracker laeuft mit RTC-Zeit.");
-        }
-        else
-        {
-            DEBUG_PRINTLN("Tracker laeuft OHNE Zeit/Smart-Tracking.");
-        }
+        DEBUG_PRINTLN("Tracker laeuft OHNE Zeit/Smart-Tracking bis zum NTP-Abgleich.");
     }
 
-    server.on("/", handleRoot);
-    server.on("/status", handleStatus);
-    server.on("/weather", handleWeather);
-    server.on("/history", handleHistory);
-    server.on("/geo", handleGeoConfig);
-    server.on("/geo/save", HTTP_POST, handleGeoSave);
-    server.on("/wifi", handleWifiConfig);
-    server.on("/wifi/save", HTTP_POST, handleWifiSave);
-    server.on("/calibrate", handleCalibrate);
-    server.on("/calibrate/start", handleCalibrateStart);
-    server.on("/debug", handleDebug);
-    server.on("/debug/set", handleDebugSet);
+    // /, /geo, /wifi, /calibrate, /debug und /style.css (web/, gzip)
+    server.addHandler(&webAssets);
+    server.on("/status", supervised(handleStatus));
+    server.on("/status.bin", HTTP_GET, supervised(handleStatusBin));
+    server.on("/resets", HTTP_GET, supervised(handleResets));
+    server.on("/weather", supervised(handleWeather));
+    server.on("/history", supervised(handleHistory));
+    server.on("/geo.json", HTTP_GET, supervised(handleGeoJson));
+    server.on("/geo/save", HTTP_POST, supervised(handleGeoSave));
+    server.on("/wifi.json", HTTP_GET, supervised(handleWifiJson));
+    server.on("/wifi/save", HTTP_POST, supervised(handleWifiSave));
+    server.on("/calibrate.json", HTTP_GET, supervised(handleCalibrateJson));
+    server.on("/calibrate/start", supervised(handleCalibrateStart));
+    server.on("/calibrate/status", supervised(handleCalibrateStatus));
+    server.on("/calibrate/cancel", supervised(handleCalibrateCancel));
+    server.on("/debug.json", HTTP_GET, supervised(handleDebugJson));
+    server.on("/debug/set", supervised(handleDebugSet));
+    telemetryBegin();
+#ifdef ST_METRICS
+    metricsBegin();
+#endif
     server.onNotFound(handleNotFound);
     server.begin();
     DEBUG_PRINTLN("HTTP-Server laeuft.");
-
-    trackerState = STATE_INIT;
-    lastAlive = millis();
 }
 
 // =====================================================
@@ -188,199 +163,46 @@ void setup()
 // =====================================================
 void loop()
 {
-    server.handleClient();
-    lastAlive = millis();
-
-    checkWatchdog();
-
-    unsigned long now = millis();
-
-    switch (trackerState)
+    METRIC_SCOPE_LONG(METRIC_LOOP);
+    supervisorBeat(SUPERVISOR_LOOP);
     {
-
-    case STATE_INIT:
-        doStartInit();
-        break;
-
-    case STATE_TRACKING:
+        METRIC_SCOPE_LONG(METRIC_WEB_SERVICE);
+        webserverService();
+    }
     {
-        updateTime();
-        if (timeInitialized)
-        {
-            calculateSunPosition();
-        }
+        METRIC_SCOPE_LONG(METRIC_HISTORY_EXPORT);
+        historyExportPoll();
+    }
+    {
+        METRIC_SCOPE_LONG(METRIC_TELEMETRY);
+        telemetryService();
+    }
+    {
+        METRIC_SCOPE_LONG(METRIC_STATUS_RING);
+        statusRingService();
+    }
 
-        if (now - lastRead >= READ_INTERVAL)
+    // WLAN and NTP/RTC sync here, never in the control step; both only
+    // poll their state machines
+    {
+        SupervisorScope time(SUPERVISOR_TIME);
         {
-            lastRead = now;
-
-            int tl = analogRead(LDR_TL_PIN);
-            int tr = analogRead(LDR_TR_PIN);
-            int bl = analogRead(LDR_BL_PIN);
-            int br = analogRead(LDR_BR_PIN);
-
-            bool dark = isDark(tl, tr, bl, br);
-            bool cloudy = isCloudy(tl, tr, bl, br);
-
-            if (dark || cloudy || weatherSaysStop)
-            {
-                darkCount++;
-                lightCount = 0;
-                if (darkCount >= STATE_CHANGE_THRESHOLD)
-                {
-                    DEBUG_PRINTLN("-> Zu dunkel / Wolken / Web-Stop -> SLEEP");
-                    yawAngle = 90;
-                    tiltAngle = 70;
-                    servoYaw.write(yawAngle);
-                    servoTilt.write(tiltAngle);
-                    pushHistory(yawAngle, tiltAngle, true);
-                    trackerState = STATE_SLEEP;
-                    lastLoggedState = STATE_SLEEP;
-                    darkCount = 0;
-                    break;
-                }
-            }
-            else
-            {
-                darkCount = 0;
-            }
-
-            int targetYaw = yawAngle;
-            int targetTilt = tiltAngle;
-
-            if (timeInitialized && currentSunAltitude > 0)
-            {
-                targetYaw = targetYawFromSun;
-                targetTilt = targetTiltFromSun;
-            }
-
-            int topSum = tl + tr;
-            int bottomSum = bl + br;
-            int leftSum = tl + bl;
-            int rightSum = tr + br;
-
-            int diffYaw = leftSum - rightSum;
-            int diffTilt = topSum - bottomSum;
-            int totalSum = topSum + bottomSum;
-
-            if (totalSum < MIN_LIGHT_SUM)
-            {
-                DEBUG_PRINTLN("TRACK: Zu wenig Licht für LDR-Tracking, verwende nur Sonnenposition.");
-                if (timeInitialized && currentSunAltitude > 0)
-                {
-                    yawAngle = targetYaw;
-                    tiltAngle = targetTilt;
-                    servoYaw.write(yawAngle);
-                    servoTilt.write(tiltAngle);
-                }
-                break;
-            }
-
-            float errorYaw = (float)diffYaw / totalSum;
-            float errorTilt = (float)diffTilt / totalSum;
-
-            int prevYaw = yawAngle;
-            int prevTilt = tiltAngle;
-
-            if (timeInitialized && currentSunAltitude > 0)
-            {
-                if (yawAngle < targetYaw)
-                    yawAngle++;
-                else if (yawAngle > targetYaw)
-                    yawAngle--;
-
-                if (tiltAngle < targetTilt)
-                    tiltAngle++;
-                else if (tiltAngle > targetTilt)
-                    tiltAngle--;
-            }
-
-            if (abs(errorYaw) > DEAD_BAND_YAW)
-            {
-                yawAngle += (errorYaw > 0 ? 1 : -1) * YAW_DIR * STEP_YAW;
-            }
-
-            if (abs(errorTilt) > DEAD_BAND_TILT)
-            {
-                tiltAngle += (errorTilt > 0 ? 1 : -1) * TILT_DIR * STEP_TILT;
-            }
-
-            yawAngle = constrain(yawAngle, YAW_MIN, YAW_MAX);
-            tiltAngle = constrain(tiltAngle, TILT_MIN, TILT_MAX);
-
-            if (prevYaw != yawAngle)
-            {
-                servoYaw.write(yawAngle);
-            }
-            if (prevTilt != tiltAngle)
-            {
-                servoTilt.write(tiltAngle);
-            }
-
-            pushHistory(yawAngle, tiltAngle);
-            lastAlive = millis();
-
-            if (now - lastSerialLog >= SERIAL_LOG_INTERVAL)
-            {
-                lastSerialLog = now;
-                DEBUG_PRINT("TRACK Yaw: ");
-                DEBUG_PRINT(yawAngle);
-                DEBUG_PRINT("  Tilt: ");
-                DEBUG_PRINT(tiltAngle);
-                DEBUG_PRINT("  Target: ");
-                DEBUG_PRINT(targetYaw);
-                DEBUG_PRINT("/");
-                DEBUG_PRINT(targetTilt);
-                DEBUG_PRINT("  LuxSum: ");
-                DEBUG_PRINTLN(topSum + bottomSum);
-            }
+            METRIC_SCOPE_LONG(METRIC_WIFI);
+            wifiService();
         }
-        break;
+        METRIC_SCOPE_LONG(METRIC_TIME_UPDATE);
+        updateTime();
     }
 
-    case STATE_SLEEP:
+    if (!controlTaskRunning())
     {
-        if (now - lastRead >= READ_INTERVAL)
-        {
-            lastRead = now;
-
-            int tl = analogRead(LDR_TL_PIN);
-            int tr = analogRead(LDR_TR_PIN);
-            int bl = analogRead(LDR_BL_PIN);
-            int br = analogRead(LDR_BR_PIN);
-
-            bool dark = isDark(tl, tr, bl, br);
-            bool cloudy = isCloudy(tl, tr, bl, br);
-
-            if (!dark && !cloudy && !weatherSaysStop)
-            {
-                lightCount++;
-                darkCount = 0;
-                if (lightCount >= STATE_CHANGE_THRESHOLD)
-                {
-                    DEBUG_PRINTLN("-> Licht wieder ok, zurück zu TRACKING");
-                    if (haveHistory)
-                    {
-                        int lastIdx = (historyIndex - 1 + POS_HISTORY_SIZE) % POS_HISTORY_SIZE;
-                        yawAngle = historyYaw[lastIdx];
-                        tiltAngle = historyTilt[lastIdx];
-                        servoYaw.write(yawAngle);
-                        servoTilt.write(tiltAngle);
-                    }
-                    pushHistory(yawAngle, tiltAngle, true);
-                    trackerState = STATE_TRACKING;
-                    lastLoggedState = STATE_TRACKING;
-                    lightCount = 0;
-                }
-            }
-            else
-            {
-                lightCount = 0;
-            }
-        }
-        break;
+        controlStep();
     }
+    {
+        METRIC_SCOPE_LONG(METRIC_HISTORY_WRITE);
+        SupervisorScope storage(SUPERVISOR_STORAGE);
+        historyLogService();
+        configService();
+        calibrationService();
     }
-
-    lastAlive = millis();
 }
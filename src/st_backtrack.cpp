@@ -0,0 +1,28 @@
+#include "st_backtrack.h"
+#include "st_config.h"
+
+float backtrackGcr()
+{
+    if (settings.rowPitch <= 0.0f || settings.panelWidth <= 0.0f)
+        return 0.0f;
+    return settings.panelWidth / settings.rowPitch;
+}
+
+bool backtrackAim(float azimuth, float altitude, float &aim)
+{
+    aim = altitude;
+    float gcr = backtrackGcr();
+    if (gcr <= 0.0f || altitude <= 0.0f || altitude >= 90.0f)
+        return false;
+
+    // Effective ratio along the sun's azimuth; rows parallel to the
+    // sun's direction never shade each other
+    float g = gcr * fabsf(cosf((azimuth - settings.rowAzimuth) * DEG_TO_RAD));
+    float s = sinf(altitude * DEG_TO_RAD);
+    if (s >= g)
+        return false;
+
+    float theta = asinf(s / g) * RAD_TO_DEG - altitude;
+    aim = 90.0f - theta;
+    return true;
+}
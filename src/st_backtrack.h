@@ -0,0 +1,32 @@
+#ifndef ST_BACKTRACK_H
+#define ST_BACKTRACK_H
+
+#include <Arduino.h>
+
+// =====================================================
+// ROW BACKTRACKING
+// =====================================================
+// In a row installation a panel that points straight at a low sun
+// shades its neighbour. Rows are settings.rowPitch apart (m, pivot to
+// pivot) towards settings.rowAzimuth and the opposite direction, panels
+// settings.panelWidth wide: ground cover ratio GCR = width / pitch.
+// rowPitch 0 = a single tracker, no backtracking.
+//
+// 2-D model in the vertical plane through the sun: along the sun's
+// azimuth the neighbour is pitch / |cos(sunAz - rowAz)| away, so the
+// effective ratio is g = GCR * |cos(sunAz - rowAz)|. A panel tilted
+// theta from horizontal towards the sun at elevation alpha shades
+// nothing while
+//     sin(alpha + theta) <= sin(alpha) / g
+// Pointing at the sun (theta = 90° - alpha) that holds down to
+// sin(alpha) = g. Below, the panel is flattened to the steepest
+// shade-free tilt, theta = asin(sin(alpha) / g) - alpha, i.e. aimed at
+// altitude 90° - theta instead of alpha. Yaw keeps following the sun.
+
+float backtrackGcr(); // from settings, 0 = off
+
+// Altitude the panel should aim at for the sun at azimuth/altitude
+// (degrees). false (aim = altitude) when nothing needs backtracking.
+bool backtrackAim(float azimuth, float altitude, float &aim);
+
+#endif
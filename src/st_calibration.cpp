@@ -1,135 +1,485 @@
+#include <atomic>
 #include "st_debug.h"
 #include "st_calibration.h"
 #include "config.h"
+#include "st_hal.h"
+#include "st_servo.h"
+#include "st_motion.h"
+#include "st_sensors.h"
+#include "st_controller.h"
+#include "time_rtc.h"
 
 // External references from main.cpp
-extern Servo servoYaw;
-extern Servo servoTilt;
-extern int yawAngle;
-extern int tiltAngle;
+extern int32_t yawAngle;
+extern int32_t tiltAngle;
 extern bool littlefsAvailable;
-extern WebServer server;
-extern void pushHistory(int y, int t, bool forceWrite);
+extern TrackerState trackerState;
+extern void pushHistory(int32_t y, int32_t t, bool forceWrite);
 
-void saveCalibrationData(int yaw, int tilt)
+// Part of the config record (st_config), saved by loop(); loading is a
+// copy, no flash read
+void saveCalibrationData(int32_t yaw, int32_t tilt)
 {
-    if (!littlefsAvailable)
-        return;
+    // Runs in the control task, which owns `settings`; the lock is for
+    // readers in other tasks (settingsRead)
+    halCriticalEnter();
+    settings.calibYaw = yaw;
+    settings.calibTilt = tilt;
+    halCriticalExit();
+    configRequestSave();
+    DEBUG_PRINT("✓ Kalibrierung: Yaw=");
+    DEBUG_PRINT(cdToDeg(yaw));
+    DEBUG_PRINT("° Tilt=");
+    DEBUG_PRINT(cdToDeg(tilt));
+    DEBUG_PRINTLN("°");
+}
 
-    File f = LittleFS.open("/calibration.txt", "w");
-    if (f)
-    {
-        f.print(yaw);
-        f.print(",");
-        f.println(tilt);
-        f.close();
-        DEBUG_PRINT("✓ Kalibrierung gespeichert: Yaw=");
-        DEBUG_PRINT(yaw);
-        DEBUG_PRINT("° Tilt=");
-        DEBUG_PRINT(tilt);
-        DEBUG_PRINTLN("°");
-    }
+void loadCalibrationData(int32_t &yaw, int32_t &tilt)
+{
+    yaw = clampYawCd(settings.calibYaw);
+    tilt = clampTiltCd(settings.calibTilt);
 }
 
-void loadCalibrationData(int &yaw, int &tilt)
+// =====================================================
+// CALIBRATION SEARCH (STATE_CALIBRATING)
+// =====================================================
+// One measurement per point, spread over calibrationTick() calls: move +
+// flush, then measure once the planner has arrived and
+// CALIBRATION_SETTLE_MS have passed.
+//
+// CAL_MODE_GRID: every cell of a CALIBRATION_STEP grid, yaw-major like
+// the old nested loop.
+// CAL_MODE_ADAPTIVE: start at the sun position when time is valid,
+// otherwise at the best cell of a CALIBRATION_COARSE_STEP grid. Then
+// compass search: probe ±step on each axis, move on any gain and keep
+// going in that direction, halve the step once all four directions fail,
+// stop after a failed round at CALIBRATION_FINE_STEP.
+//
+// The cursor is written to flash after every point, by loop()
+// (calibrationService()): the search runs in the control task, which
+// never touches the file system.
+
+enum CalibrationPhase
 {
-    yaw = 90;
-    tilt = 90;
+    CAL_PHASE_GRID,
+    CAL_PHASE_SEED,
+    CAL_PHASE_REFINE
+};
 
-    if (!littlefsAvailable)
-        return;
+struct CalibrationCursor
+{
+    uint8_t mode;
+    uint8_t phase;
+    uint16_t index;    // next grid cell
+    uint16_t measured; // points measured so far
+    int32_t bestYaw;
+    int32_t bestTilt;
+    int bestSum;
+    int32_t step;      // refine step (centidegrees)
+    uint8_t dir;       // refine: direction probed next
+    uint8_t fails;     // refine: failed probes since the last gain
+    uint8_t back;      // refine: direction back to an already measured point
+};
+
+static const char *CALIBRATION_RUN_PATH = "/calibration.run";
+static const uint8_t NO_DIR = 0xFF;
 
-    if (LittleFS.exists("/calibration.txt"))
+// Pending file operation for calibrationService(); the latest request wins
+enum CursorRequest
+{
+    CURSOR_CLEAN,
+    CURSOR_WRITE,
+    CURSOR_REMOVE
+};
+
+static CalibrationCursor cal;
+static int32_t calYaw = 9000; // point being measured
+static int32_t calTilt = 9000;
+static bool calMoved = false;
+static unsigned long calMovedAt = 0;
+static bool calResumed = false;
+static CalibrationResult calResult = CAL_RESULT_NONE;
+static CalibrationCursor cursorToWrite; // copy of `cal` for loop(), under the critical section
+static std::atomic<uint8_t> cursorRequest(CURSOR_CLEAN);
+
+static int32_t gridStep(uint8_t mode)
+{
+    return (mode == CAL_MODE_GRID ? CALIBRATION_STEP : CALIBRATION_COARSE_STEP) * ANGLE_SCALE;
+}
+
+static uint16_t tiltSteps(uint8_t mode)
+{
+    return (TILT_MAX - TILT_MIN) * ANGLE_SCALE / gridStep(mode) + 1;
+}
+
+static uint16_t gridPoints(uint8_t mode)
+{
+    return ((YAW_MAX - YAW_MIN) * ANGLE_SCALE / gridStep(mode) + 1) * tiltSteps(mode);
+}
+
+static uint16_t plannedPoints()
+{
+    return cal.mode == CAL_MODE_GRID ? gridPoints(cal.mode) : CALIBRATION_MAX_POINTS;
+}
+
+// Next point to measure; false once the search is over
+static bool planPoint()
+{
+    switch (cal.phase)
     {
-        File f = LittleFS.open("/calibration.txt", "r");
-        if (f)
+    case CAL_PHASE_GRID:
+        if (cal.index >= gridPoints(cal.mode))
+            return false;
+        calYaw = YAW_MIN * ANGLE_SCALE + (cal.index / tiltSteps(cal.mode)) * gridStep(cal.mode);
+        calTilt = TILT_MIN * ANGLE_SCALE + (cal.index % tiltSteps(cal.mode)) * gridStep(cal.mode);
+        return true;
+
+    case CAL_PHASE_SEED:
+        calYaw = cal.bestYaw;
+        calTilt = cal.bestTilt;
+        return true;
+
+    case CAL_PHASE_REFINE:
+        if (cal.measured >= CALIBRATION_MAX_POINTS)
+            return false;
+        while (true)
         {
-            String data = f.readString();
-            f.close();
+            if (cal.fails >= 4)
+            {
+                if (cal.step <= CALIBRATION_FINE_STEP * ANGLE_SCALE)
+                    return false;
+                cal.step = max(cal.step / 2, (int32_t)(CALIBRATION_FINE_STEP * ANGLE_SCALE));
+                cal.fails = 0;
+                cal.back = NO_DIR;
+            }
 
-            int commaIndex = data.indexOf(',');
-            if (commaIndex > 0)
+            int32_t d = (cal.dir & 1) ? -cal.step : cal.step;
+            calYaw = cal.dir < 2 ? clampYawCd(cal.bestYaw + d) : cal.bestYaw;
+            calTilt = cal.dir < 2 ? cal.bestTilt : clampTiltCd(cal.bestTilt + d);
+
+            // At a limit or back where we came from: nothing new to learn
+            if (cal.dir == cal.back || (calYaw == cal.bestYaw && calTilt == cal.bestTilt))
             {
-                yaw = data.substring(0, commaIndex).toInt();
-                tilt = data.substring(commaIndex + 1).toInt();
-                DEBUG_PRINT("✓ Kalibrierung geladen: Yaw=");
-                DEBUG_PRINT(yaw);
-                DEBUG_PRINT("° Tilt=");
-                DEBUG_PRINT(tilt);
-                DEBUG_PRINTLN("°");
+                cal.fails++;
+                cal.dir = (cal.dir + 1) % 4;
+                continue;
             }
+            return true;
         }
     }
+    return false;
 }
 
-void startCalibration()
+// Result of the point just measured
+static void takeMeasurement(int lightSum)
 {
-    DEBUG_PRINTLN("========================================");
-    DEBUG_PRINTLN("Starte automatische Kalibrierung...");
-    DEBUG_PRINTLN("========================================");
-
-    int bestYaw = 90;
-    int bestTilt = 90;
-    int maxLightSum = 0;
+    cal.measured++;
 
-    const int YAW_STEP = 10;
-    const int TILT_STEP = 10;
-    const int MEASUREMENT_DELAY = 300;
-
-    for (int y = YAW_MIN; y <= YAW_MAX; y += YAW_STEP)
+    switch (cal.phase)
     {
-        for (int t = TILT_MIN; t <= TILT_MAX; t += TILT_STEP)
+    case CAL_PHASE_GRID:
+        if (lightSum > cal.bestSum)
         {
-            servoYaw.write(y);
-            servoTilt.write(t);
-            delay(MEASUREMENT_DELAY);
-
-            int tl = analogRead(LDR_TL_PIN);
-            int tr = analogRead(LDR_TR_PIN);
-            int bl = analogRead(LDR_BL_PIN);
-            int br = analogRead(LDR_BR_PIN);
-            int lightSum = tl + tr + bl + br;
-
-            DEBUG_PRINT("Test Yaw=");
-            DEBUG_PRINT(y);
-            DEBUG_PRINT("° Tilt=");
-            DEBUG_PRINT(t);
-            DEBUG_PRINT("° -> LichtSum=");
-            DEBUG_PRINTLN(lightSum);
+            cal.bestSum = lightSum;
+            cal.bestYaw = calYaw;
+            cal.bestTilt = calTilt;
+        }
+        cal.index++;
+        if (cal.index >= gridPoints(cal.mode) && cal.mode == CAL_MODE_ADAPTIVE)
+        {
+            cal.phase = CAL_PHASE_REFINE;
+            cal.step = CALIBRATION_COARSE_STEP * ANGLE_SCALE / 2;
+        }
+        break;
 
-            if (lightSum > maxLightSum)
-            {
-                maxLightSum = lightSum;
-                bestYaw = y;
-                bestTilt = t;
-                DEBUG_PRINT("  ✓ Neues Maximum gefunden! Yaw=");
-                DEBUG_PRINT(bestYaw);
-                DEBUG_PRINT("° Tilt=");
-                DEBUG_PRINT(bestTilt);
-                DEBUG_PRINT("° Sum=");
-                DEBUG_PRINTLN(maxLightSum);
-            }
+    case CAL_PHASE_SEED:
+        cal.bestSum = lightSum;
+        cal.phase = CAL_PHASE_REFINE;
+        cal.step = CALIBRATION_SEED_STEP * ANGLE_SCALE;
+        break;
 
-            server.handleClient();
+    case CAL_PHASE_REFINE:
+        if (lightSum > cal.bestSum)
+        {
+            cal.bestSum = lightSum;
+            cal.bestYaw = calYaw;
+            cal.bestTilt = calTilt;
+            cal.fails = 0;
+            cal.back = cal.dir ^ 1;
         }
+        else
+        {
+            cal.fails++;
+            cal.dir = (cal.dir + 1) % 4;
+        }
+        break;
+    }
+}
+
+static void writeCursorFile(const CalibrationCursor &c)
+{
+    File f = LittleFS.open(CALIBRATION_RUN_PATH, "w");
+    if (f)
+    {
+        char line[96];
+        snprintf(line, sizeof(line), "2,%u,%u,%u,%u,%ld,%ld,%d,%ld,%u,%u,%u\n",
+                 (unsigned)c.mode, (unsigned)c.phase, (unsigned)c.index, (unsigned)c.measured,
+                 (long)c.bestYaw, (long)c.bestTilt, c.bestSum, (long)c.step,
+                 (unsigned)c.dir, (unsigned)c.fails, (unsigned)c.back);
+        f.print(line);
+        f.close();
     }
+}
+
+static void removeCursorFile()
+{
+    if (littlefsAvailable && LittleFS.exists(CALIBRATION_RUN_PATH))
+        LittleFS.remove(CALIBRATION_RUN_PATH);
+}
+
+// Control task: hand the cursor to the next calibrationService()
+static void saveCursor()
+{
+    halCriticalEnter();
+    cursorToWrite = cal;
+    halCriticalExit();
+    cursorRequest = CURSOR_WRITE;
+}
+
+static void removeCursor()
+{
+    cursorRequest = CURSOR_REMOVE;
+}
+
+// Back to tracking from wherever the search left the servos
+static void leaveCalibration(CalibrationResult result)
+{
+    removeCursor();
+    calResult = result;
+    calMoved = false;
+    controllerReset();
+    trackerState = STATE_TRACKING;
+}
 
+static void finishCalibration()
+{
     DEBUG_PRINTLN("========================================");
     DEBUG_PRINT("Kalibrierung abgeschlossen! Optimale Position: Yaw=");
-    DEBUG_PRINT(bestYaw);
+    DEBUG_PRINT(cdToDeg(cal.bestYaw));
     DEBUG_PRINT("° Tilt=");
-    DEBUG_PRINT(bestTilt);
+    DEBUG_PRINT(cdToDeg(cal.bestTilt));
     DEBUG_PRINT("° (Max Light=");
-    DEBUG_PRINT(maxLightSum);
-    DEBUG_PRINTLN(")");
+    DEBUG_PRINT(cal.bestSum);
+    DEBUG_PRINT(", ");
+    DEBUG_PRINT(cal.measured);
+    DEBUG_PRINTLN(" Messpunkte)");
     DEBUG_PRINTLN("========================================");
 
-    saveCalibrationData(bestYaw, bestTilt);
+    saveCalibrationData(cal.bestYaw, cal.bestTilt);
 
-    yawAngle = bestYaw;
-    tiltAngle = bestTilt;
-    servoYaw.write(yawAngle);
-    servoTilt.write(tiltAngle);
+    yawAngle = cal.bestYaw;
+    tiltAngle = cal.bestTilt;
+    motionMoveTo(yawAngle, tiltAngle);
 
+    leaveCalibration(CAL_RESULT_DONE);
     pushHistory(yawAngle, tiltAngle, true);
 }
+
+bool calibrationStart(CalibrationMode mode)
+{
+    if (trackerState == STATE_CALIBRATING)
+        return false;
+
+    DEBUG_PRINTLN("========================================");
+    DEBUG_PRINT("Starte automatische Kalibrierung (");
+    DEBUG_PRINT(mode == CAL_MODE_GRID ? "Raster" : "adaptiv");
+    DEBUG_PRINTLN(")...");
+    DEBUG_PRINTLN("========================================");
+
+    cal = CalibrationCursor();
+    cal.mode = mode;
+    cal.phase = CAL_PHASE_GRID;
+    cal.bestYaw = 9000;
+    cal.bestTilt = 9000;
+    cal.dir = 0;
+    cal.back = NO_DIR;
+
+    if (mode == CAL_MODE_ADAPTIVE && timeInitialized)
+    {
+        calculateSunPosition();
+        if (currentSunAltitude > 0)
+        {
+            // The sun itself, not the backtracked target
+            sunPositionToServoAngles(currentSunAzimuth, currentSunAltitude);
+            cal.phase = CAL_PHASE_SEED;
+            cal.bestYaw = targetYawFromSun;
+            cal.bestTilt = targetTiltFromSun;
+            DEBUG_PRINT("Startpunkt aus Sonnenposition: Yaw=");
+            DEBUG_PRINT(cdToDeg(cal.bestYaw));
+            DEBUG_PRINT("° Tilt=");
+            DEBUG_PRINTLN(cdToDeg(cal.bestTilt));
+        }
+    }
+
+    calMoved = false;
+    calResumed = false;
+    calResult = CAL_RESULT_NONE;
+    saveCursor();
+    trackerState = STATE_CALIBRATING;
+    return true;
+}
+
+bool calibrationResume()
+{
+    cursorRequest = CURSOR_CLEAN;
+    if (!littlefsAvailable || !LittleFS.exists(CALIBRATION_RUN_PATH))
+        return false;
+
+    File f = LittleFS.open(CALIBRATION_RUN_PATH, "r");
+    if (!f)
+        return false;
+    String data = f.readString();
+    f.close();
+
+    unsigned version, mode, phase, index, measured, dir, fails, back;
+    long bestYaw, bestTilt, step;
+    int bestSum;
+    int n = sscanf(data.c_str(), "%u,%u,%u,%u,%u,%ld,%ld,%d,%ld,%u,%u,%u", &version, &mode, &phase, &index,
+                   &measured, &bestYaw, &bestTilt, &bestSum, &step, &dir, &fails, &back);
+    // Mode first: the grid size it implies bounds index and measured
+    bool valid = n == 12 && version == 2 && mode <= CAL_MODE_GRID && phase <= CAL_PHASE_REFINE &&
+                 index <= gridPoints(mode) &&
+                 measured <= max(gridPoints(mode), CALIBRATION_MAX_POINTS) && dir < 4 && fails <= 4 &&
+                 (back < 4 || back == NO_DIR) && step >= 0;
+    if (!valid)
+    {
+        DEBUG_PRINTLN("⚠ calibration.run ungültig -> verworfen");
+        removeCursorFile();
+        return false;
+    }
+
+    cal.mode = mode;
+    cal.phase = phase;
+    cal.index = index;
+    cal.measured = measured;
+    cal.bestYaw = bestYaw;
+    cal.bestTilt = bestTilt;
+    cal.bestSum = bestSum;
+    cal.step = step;
+    cal.dir = dir;
+    cal.fails = fails;
+    cal.back = back;
+    calMoved = false;
+    calResumed = true;
+    calResult = CAL_RESULT_NONE;
+    trackerState = STATE_CALIBRATING;
+
+    DEBUG_PRINT("Setze Kalibrierung fort nach ");
+    DEBUG_PRINT(cal.measured);
+    DEBUG_PRINTLN(" Messpunkten");
+    return true;
+}
+
+bool calibrationCancel()
+{
+    if (trackerState != STATE_CALIBRATING)
+        return false;
+
+    DEBUG_PRINTLN("Kalibrierung abgebrochen.");
+    leaveCalibration(CAL_RESULT_CANCELLED);
+    return true;
+}
+
+void calibrationTick()
+{
+    unsigned long now = millis();
+
+    if (!calMoved)
+    {
+        if (!planPoint())
+        {
+            finishCalibration();
+            return;
+        }
+        yawAngle = calYaw;
+        tiltAngle = calTilt;
+        motionMoveTo(yawAngle, tiltAngle);
+        sensorsFlush();
+        calMoved = true;
+        calMovedAt = now;
+        return;
+    }
+
+    // Settling starts on arrival, frames taken on the way are dropped
+    if (!motionIdle())
+    {
+        sensorsFlush();
+        calMovedAt = now;
+        return;
+    }
+    if (now - calMovedAt < CALIBRATION_SETTLE_MS)
+        return;
+
+    LdrFrame ldr;
+    sensorsRead(ldr);
+    int lightSum = ldr.tl + ldr.tr + ldr.bl + ldr.br;
+
+    DEBUG_PRINT("Test Yaw=");
+    DEBUG_PRINT(cdToDeg(calYaw));
+    DEBUG_PRINT("° Tilt=");
+    DEBUG_PRINT(cdToDeg(calTilt));
+    DEBUG_PRINT("° -> LichtSum=");
+    DEBUG_PRINTLN(lightSum);
+
+    int previousBest = cal.bestSum;
+    takeMeasurement(lightSum);
+    if (cal.bestSum > previousBest)
+    {
+        DEBUG_PRINT("  ✓ Neues Maximum gefunden! Yaw=");
+        DEBUG_PRINT(cdToDeg(cal.bestYaw));
+        DEBUG_PRINT("° Tilt=");
+        DEBUG_PRINT(cdToDeg(cal.bestTilt));
+        DEBUG_PRINT("° Sum=");
+        DEBUG_PRINTLN(cal.bestSum);
+    }
+
+    calMoved = false;
+    if (!planPoint())
+    {
+        finishCalibration();
+        return;
+    }
+    saveCursor();
+}
+
+void calibrationService()
+{
+    uint8_t request = cursorRequest.exchange(CURSOR_CLEAN);
+    if (request == CURSOR_CLEAN || !littlefsAvailable)
+        return;
+    if (request == CURSOR_REMOVE)
+    {
+        removeCursorFile();
+        return;
+    }
+    CalibrationCursor c;
+    halCriticalEnter();
+    c = cursorToWrite;
+    halCriticalExit();
+    writeCursorFile(c);
+}
+
+void calibrationGetStatus(CalibrationStatus &s)
+{
+    s.active = trackerState == STATE_CALIBRATING;
+    s.resumed = calResumed;
+    s.result = calResult;
+    s.mode = (CalibrationMode)cal.mode;
+    s.done = cal.measured;
+    s.total = max(plannedPoints(), cal.measured);
+    s.step = cal.phase == CAL_PHASE_REFINE ? cal.step : gridStep(cal.mode);
+    s.bestYaw = cal.bestYaw;
+    s.bestTilt = cal.bestTilt;
+    s.bestSum = cal.bestSum;
+    s.remainingMs = s.active ? (unsigned long)(s.total - s.done) * CALIBRATION_SETTLE_MS : 0;
+}
@@ -1,9 +1,50 @@
 #ifndef ST_CALIBRATION_H
 #define ST_CALIBRATION_H
 
-// Calibration functions
-void saveCalibrationData(int yaw, int tilt);
-void loadCalibrationData(int &yaw, int &tilt);
-void startCalibration();
+#include <Arduino.h>
+
+// Calibration functions (positions in centidegrees)
+void saveCalibrationData(int32_t yaw, int32_t tilt);
+void loadCalibrationData(int32_t &yaw, int32_t &tilt);
+
+// Search for the brightest pose as tracker state STATE_CALIBRATING:
+// the control step calls calibrationTick(), which never blocks. The
+// cursor is persisted by calibrationService() in loop(), so setup()
+// resumes an interrupted search via calibrationResume(). Finishing or
+// cancelling returns to TRACKING.
+enum CalibrationMode
+{
+    CAL_MODE_ADAPTIVE, // sun seed or coarse grid, then refine to CALIBRATION_FINE_STEP
+    CAL_MODE_GRID      // every cell of the CALIBRATION_STEP grid
+};
+
+enum CalibrationResult
+{
+    CAL_RESULT_NONE,
+    CAL_RESULT_DONE,
+    CAL_RESULT_CANCELLED
+};
+
+struct CalibrationStatus
+{
+    bool active;
+    bool resumed; // continued after a reboot
+    CalibrationResult result; // outcome of the last search
+    CalibrationMode mode;
+    uint16_t done;  // points measured
+    uint16_t total; // grid size, or CALIBRATION_MAX_POINTS for adaptive
+    int32_t step;   // current resolution (centidegrees)
+    int32_t bestYaw;
+    int32_t bestTilt;
+    int bestSum;
+    unsigned long remainingMs;
+};
+
+bool calibrationStart(CalibrationMode mode); // false if a search is already running
+bool calibrationResume(); // true if a persisted search was picked up
+bool calibrationCancel(); // false if none is running
+void calibrationTick();
+void calibrationService(); // loop(): writes or removes /calibration.run
+void calibrationGetStatus(CalibrationStatus &s);
 
 #endif
@@ -0,0 +1,377 @@
+#include <atomic>
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_clock.h"
+#include "time_rtc.h"
+
+#define CLOCK_RATE_LIMIT_PPB 500000     // crystals stay within 100 ppm, beyond is a bad reference
+#define CLOCK_ANCHOR_MAX_UNC_US 50000   // references good enough for a rate baseline
+#define CLOCK_REBASE_US 3600000000ULL   // keeps the extrapolated interval short
+#define CLOCK_RTC_EDGE_TIMEOUT_US 1500000
+
+// Extrapolation: utc = baseUtc + dt * (1 + rate) [+ dt' * slew until slewEnd]
+struct ClockModel
+{
+    bool valid;
+    int32_t ratePpb;
+    int32_t slewPpb;
+    uint64_t baseMono;
+    uint64_t baseUtc;
+    uint64_t slewEnd;
+};
+
+enum RtcSyncState : uint8_t
+{
+    RTC_SYNC_OFF,  // no RTC, or it holds no valid time yet
+    RTC_SYNC_IDLE, // next edge sync at rtcNextSync
+    RTC_SYNC_WAIT, // until just before the predicted edge
+    RTC_SYNC_POLL  // reading until the second changes
+};
+
+static const char *const sourceNames[] = {"none", "rtc", "ntp"};
+
+// Written by loop() only, readers get `model` through the sequence counter
+static std::atomic<uint32_t> modelSeq(0);
+static ClockModel model = {};
+static ClockModel work = {};
+static ClockStatus status = {};
+static ClockStatus published = {};
+
+// Rate baseline: first usable reference of the current source
+static ClockSource anchorSource = CLOCK_SOURCE_NONE;
+static uint64_t anchorMono = 0;
+static uint64_t anchorUtc = 0;
+static uint64_t rateBaselineUs = 0;
+
+static bool rtcPresent = false;
+static RtcSyncState rtcState = RTC_SYNC_OFF;
+static bool rtcPhaseKnown = false; // RTC edges on our second boundaries
+static int32_t rtcOffsetS = 0;     // local - UTC of the time in the RTC
+static bool rtcWritePending = false;
+static uint64_t rtcNextSync = 0;
+static uint64_t rtcWaitUntil = 0;
+static uint64_t rtcPollStart = 0;
+static uint64_t rtcLastPoll = 0;
+static uint64_t rtcPrevAt = 0;
+static uint32_t rtcPrevSecond = 0;
+static bool rtcHavePrev = false;
+static uint32_t lastSecond = 0;
+static bool haveNtp = false;
+static uint64_t lastNtpMono = 0;
+
+static int64_t scaled(int64_t us, int32_t ppb)
+{
+    return us * ppb / 1000000000LL;
+}
+
+static uint64_t utcAt(const ClockModel &m, uint64_t mono)
+{
+    int64_t dt = (int64_t)(mono - m.baseMono);
+    int64_t utc = (int64_t)m.baseUtc + dt + scaled(dt, m.ratePpb);
+    if (m.slewPpb)
+        utc += scaled((int64_t)(min(mono, m.slewEnd) - m.baseMono), m.slewPpb);
+    return (uint64_t)utc;
+}
+
+static void publish()
+{
+    uint32_t seq = modelSeq.load(std::memory_order_relaxed);
+    modelSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    model = work;
+    modelSeq.store(seq + 2, std::memory_order_release);
+
+    halCriticalEnter();
+    published = status;
+    halCriticalExit();
+}
+
+static void readModel(ClockModel &m)
+{
+    uint32_t before, after;
+    do
+    {
+        before = modelSeq.load(std::memory_order_acquire);
+        m = model;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = modelSeq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+}
+
+// New base at mono; a slew still running carries over
+static void rebase(uint64_t mono, uint64_t utc)
+{
+    if (work.slewPpb && work.slewEnd <= mono)
+        work.slewPpb = 0;
+    work.baseMono = mono;
+    work.baseUtc = utc;
+}
+
+static void setClock(uint64_t mono, uint64_t utc)
+{
+    work.valid = true;
+    work.slewPpb = 0;
+    rebase(mono, utc);
+    anchorSource = CLOCK_SOURCE_NONE;
+    status.valid = true;
+    status.steps++;
+}
+
+static void updateRate(ClockSource source, uint64_t refUtc, uint64_t atMono, uint32_t uncertaintyUs)
+{
+    if (uncertaintyUs > CLOCK_ANCHOR_MAX_UNC_US)
+        return;
+    if (source != anchorSource)
+    {
+        anchorSource = source;
+        anchorMono = atMono;
+        anchorUtc = refUtc;
+        return;
+    }
+
+    int64_t baseline = (int64_t)(atMono - anchorMono);
+    if (baseline < (int64_t)CLOCK_RATE_MIN_MS * 1000)
+        return;
+    int64_t ppb = ((int64_t)(refUtc - anchorUtc) - baseline) * 1000000000LL / baseline;
+    // A fresh baseline replaces a long one only once it is half as long
+    if (ppb > -CLOCK_RATE_LIMIT_PPB && ppb < CLOCK_RATE_LIMIT_PPB && (uint64_t)baseline >= rateBaselineUs / 2)
+    {
+        work.ratePpb = (int32_t)ppb;
+        rateBaselineUs = baseline;
+        status.ratePpb = work.ratePpb;
+        status.rateBaselineS = (uint32_t)(baseline / 1000000);
+    }
+    if (baseline >= (int64_t)CLOCK_RATE_WINDOW_MS * 1000)
+    {
+        anchorMono = atMono;
+        anchorUtc = refUtc;
+    }
+}
+
+void clockBegin()
+{
+    work = ClockModel();
+    status = ClockStatus();
+    anchorSource = CLOCK_SOURCE_NONE;
+    rateBaselineUs = 0;
+    rtcPresent = false;
+    rtcState = RTC_SYNC_OFF;
+    rtcPhaseKnown = false;
+    rtcWritePending = false;
+    lastSecond = 0;
+    haveNtp = false;
+    publish();
+}
+
+static uint32_t readRtc()
+{
+    status.rtcReads++;
+    return halRtcNow().unixtime();
+}
+
+void clockSeedFromRtc()
+{
+    uint32_t local = readRtc();
+    uint64_t mono = halMonotonicUs();
+    rtcOffsetS = timezoneOffsetForLocal(local);
+    // Somewhere in this second: its start keeps the edge sync a step forward
+    setClock(mono, (uint64_t)(local - rtcOffsetS) * 1000000ULL);
+    status.source = CLOCK_SOURCE_RTC;
+    status.uncertaintyUs = 1000000;
+    status.lastSyncMs = millis();
+    rtcPresent = true;
+    rtcPhaseKnown = false;
+    rtcState = RTC_SYNC_IDLE;
+    rtcNextSync = mono;
+    publish();
+}
+
+void clockDiscipline(ClockSource source, uint64_t refUtcUs, uint64_t atMonoUs, uint32_t uncertaintyUs)
+{
+    uint64_t mono = halMonotonicUs();
+    int64_t since = (int64_t)(mono - atMonoUs);
+    uint64_t refNow = refUtcUs + since + scaled(since, work.ratePpb);
+
+    if (!work.valid)
+    {
+        setClock(mono, refNow);
+        status.lastOffsetUs = 0;
+    }
+    else
+    {
+        uint64_t clockNow = utcAt(work, mono);
+        int64_t off = (int64_t)(refNow - clockNow);
+        status.lastOffsetUs = (int32_t)constrain(off, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+        if (off > (int64_t)CLOCK_STEP_US || off < -(int64_t)CLOCK_STEP_US)
+        {
+            setClock(mono, refNow);
+        }
+        else
+        {
+            updateRate(source, refUtcUs, atMonoUs, uncertaintyUs);
+            if (off >= 0)
+            {
+                // Behind: forward is always allowed
+                work.slewPpb = 0;
+                rebase(mono, refNow);
+            }
+            else
+            {
+                // Ahead: run slower until the offset is gone
+                rebase(mono, clockNow);
+                work.slewPpb = -(int32_t)CLOCK_SLEW_PPM * 1000;
+                work.slewEnd = mono + (uint64_t)(-off) * 1000000ULL / CLOCK_SLEW_PPM;
+            }
+        }
+    }
+
+    status.source = source;
+    status.uncertaintyUs = uncertaintyUs;
+    status.lastSyncMs = millis();
+    if (source == CLOCK_SOURCE_NTP)
+    {
+        status.ntpSyncs++;
+        haveNtp = true;
+        lastNtpMono = mono;
+    }
+    else if (source == CLOCK_SOURCE_RTC)
+    {
+        status.rtcSyncs++;
+    }
+    publish();
+}
+
+void clockWriteRtc()
+{
+    rtcWritePending = true;
+}
+
+static void startPolling(uint64_t mono);
+
+static void pollRtc(uint64_t mono)
+{
+    uint32_t second = readRtc();
+    uint64_t at = mono + (halMonotonicUs() - mono) / 2; // somewhere in the transfer
+    rtcLastPoll = mono;
+
+    if (rtcHavePrev && second != rtcPrevSecond)
+    {
+        uint64_t edge = rtcPrevAt + (at - rtcPrevAt) / 2;
+        rtcState = RTC_SYNC_IDLE;
+        rtcNextSync = mono + CLOCK_RTC_SYNC_MS * 1000ULL;
+        rtcPhaseKnown = true;
+        clockDiscipline(CLOCK_SOURCE_RTC, (uint64_t)(second - rtcOffsetS) * 1000000ULL, edge,
+                        (uint32_t)((at - rtcPrevAt) / 2));
+        return;
+    }
+    if (mono - rtcPollStart > CLOCK_RTC_EDGE_TIMEOUT_US)
+    {
+        DEBUG_PRINTLN("⚠ RTC-Sekunde springt nicht weiter, naechster Versuch spaeter");
+        rtcState = RTC_SYNC_IDLE;
+        rtcNextSync = mono + CLOCK_RTC_SYNC_MS * 1000ULL;
+        return;
+    }
+    rtcHavePrev = true;
+    rtcPrevSecond = second;
+    rtcPrevAt = at;
+}
+
+static void startPolling(uint64_t mono)
+{
+    rtcState = RTC_SYNC_POLL;
+    rtcPollStart = mono;
+    rtcHavePrev = false;
+    pollRtc(mono);
+}
+
+void clockService()
+{
+    if (!work.valid)
+        return;
+    uint64_t mono = halMonotonicUs();
+    if (mono - work.baseMono > CLOCK_REBASE_US)
+    {
+        rebase(mono, utcAt(work, mono));
+        publish();
+    }
+
+    // First pass in a new second: the write restarts the RTC's divider,
+    // so its edges line up with ours
+    uint64_t utc = utcAt(work, mono);
+    uint32_t second = (uint32_t)(utc / 1000000ULL);
+    if (rtcWritePending && lastSecond != 0 && second != lastSecond)
+    {
+        rtcWritePending = false;
+        rtcOffsetS = timezoneOffsetForUtc(second);
+        halRtcAdjust(DateTime(second + rtcOffsetS));
+        rtcPresent = true;
+        rtcPhaseKnown = true;
+        if (rtcState == RTC_SYNC_OFF)
+            rtcState = RTC_SYNC_IDLE;
+        rtcNextSync = mono + CLOCK_RTC_SYNC_MS * 1000ULL;
+    }
+    lastSecond = second;
+
+    switch (rtcState)
+    {
+    case RTC_SYNC_OFF:
+        break;
+    case RTC_SYNC_IDLE:
+        if (mono < rtcNextSync)
+            break;
+        if (haveNtp && mono - lastNtpMono < CLOCK_NTP_HOLD_MS * 1000ULL)
+        {
+            rtcNextSync = mono + CLOCK_RTC_SYNC_MS * 1000ULL;
+            break;
+        }
+        if (rtcPhaseKnown)
+        {
+            uint32_t toEdge = 1000000 - (uint32_t)(utc % 1000000ULL);
+            rtcWaitUntil = mono + (toEdge > CLOCK_RTC_GUARD_US ? toEdge : toEdge + 1000000) - CLOCK_RTC_GUARD_US;
+            rtcState = RTC_SYNC_WAIT;
+            break;
+        }
+        startPolling(mono);
+        break;
+    case RTC_SYNC_WAIT:
+        if (mono >= rtcWaitUntil)
+            startPolling(mono);
+        break;
+    case RTC_SYNC_POLL:
+        if (mono - rtcLastPoll >= CLOCK_RTC_POLL_US)
+            pollRtc(mono);
+        break;
+    }
+}
+
+bool clockValid()
+{
+    ClockModel m;
+    readModel(m);
+    return m.valid;
+}
+
+uint64_t clockUtcUs()
+{
+    ClockModel m;
+    readModel(m);
+    return m.valid ? utcAt(m, halMonotonicUs()) : 0;
+}
+
+uint32_t clockUtc()
+{
+    return (uint32_t)(clockUtcUs() / 1000000ULL);
+}
+
+void clockRead(ClockStatus &out)
+{
+    halCriticalEnter();
+    out = published;
+    halCriticalExit();
+}
+
+const char *clockSourceName(ClockSource s)
+{
+    return s < sizeof(sourceNames) / sizeof(sourceNames[0]) ? sourceNames[s] : "?";
+}
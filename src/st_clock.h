@@ -0,0 +1,71 @@
+#ifndef ST_CLOCK_H
+#define ST_CLOCK_H
+
+#include <Arduino.h>
+
+// =====================================================
+// SOFTWARE CLOCK (UTC in microseconds, no bus access per read)
+// =====================================================
+// getCurrentTime() used to read the DS3231 over I2C on every call - from
+// the sun calculation, the timezone offset, /status and the history.
+// Now UTC is extrapolated from halMonotonicUs() (esp_timer) and the
+// references only discipline it:
+//
+//   NTP  every good reply (st_ntp), uncertainty half the round trip
+//   RTC  once at boot, then every CLOCK_RTC_SYNC_MS while NTP has been
+//        silent for CLOCK_NTP_HOLD_MS: clockService() polls the DS3231
+//        around its predicted seconds edge, a few reads, and the edge
+//        gives the phase to one poll interval (CLOCK_RTC_POLL_US)
+//
+// Each reference gives an offset. An offset ahead of the reference is
+// slewed out at CLOCK_SLEW_PPM, one behind is stepped forward, so the
+// clock never runs backwards; only offsets over CLOCK_STEP_US step
+// either way (counted). The crystal's rate against the reference comes
+// from the longest baseline between references (CLOCK_RATE_MIN_MS ..
+// CLOCK_RATE_WINDOW_MS), so the clock keeps time between references and
+// through NTP outages. After an NTP reply the RTC is written at the next
+// seconds edge, which also restarts its divider in phase.
+//
+// Readers on any task go through a sequence counter: no lock, no I2C.
+
+enum ClockSource : uint8_t
+{
+    CLOCK_SOURCE_NONE,
+    CLOCK_SOURCE_RTC,
+    CLOCK_SOURCE_NTP
+};
+
+struct ClockStatus
+{
+    bool valid;
+    ClockSource source;     // last reference
+    int32_t ratePpb;        // reference rate against the time base, minus 1
+    uint32_t rateBaselineS; // baseline of that estimate
+    int32_t lastOffsetUs;   // reference - clock at the last reference (clamped)
+    uint32_t uncertaintyUs; // of the last reference
+    uint32_t ntpSyncs;
+    uint32_t rtcSyncs;
+    uint32_t steps;         // offsets over CLOCK_STEP_US, first set included
+    uint32_t rtcReads;      // I2C reads of the clock since boot
+    uint32_t lastSyncMs;    // millis() of the last reference
+};
+
+void clockBegin();
+// One RTC read: coarse set (start of the current RTC second), the edge
+// sync follows in clockService(). Also after the RTC was set elsewhere.
+void clockSeedFromRtc();
+// A reference: UTC refUtcUs at halMonotonicUs() == atMonoUs
+void clockDiscipline(ClockSource source, uint64_t refUtcUs, uint64_t atMonoUs, uint32_t uncertaintyUs);
+// The RTC takes the clock's local time at the next seconds edge
+void clockWriteRtc();
+// loop() only: RTC edge sync and RTC writes, never waits
+void clockService();
+
+// Any task
+bool clockValid();
+uint64_t clockUtcUs(); // 0 while not valid
+uint32_t clockUtc();   // unix seconds
+void clockRead(ClockStatus &out);
+const char *clockSourceName(ClockSource s);
+
+#endif
@@ -1,135 +1,361 @@
+#include <atomic>
+#include <stddef.h>
 #include "st_debug.h"
 #include "config.h"
 #include "st_config.h"
+#include "st_hal.h"
+#include "st_helpers.h"
+#include "st_servo.h"
 
 // External references from main.cpp
 extern bool littlefsAvailable;
 
-// External references from config.cpp
-extern double currentLatitude;
-extern double currentLongitude;
-extern bool useAutoDST;
-extern int manualTimezoneOffset;
-extern char staSsid[];
-extern char staPass[];
+static const char *CONFIG_PATH = "/config.bin";
+static const uint32_t CONFIG_MAGIC = 0x46435453; // "STCF"
 
-void loadGeoConfig()
+struct ConfigSlotHeader
 {
-    if (!littlefsAvailable)
-        return;
+    uint32_t magic;
+    uint32_t seq;     // the higher valid one is current
+    uint16_t version; // CONFIG_VERSION of the writer
+    uint16_t size;    // payload bytes, sizeof(Settings) of the writer
+    uint16_t reserved;
+    uint16_t check;   // CRC-16 of the bytes above and the payload
+};
+
+static_assert(sizeof(ConfigSlotHeader) == 16, "ConfigSlotHeader must be 16 bytes");
+static_assert(sizeof(ConfigSlotHeader) + sizeof(Settings) <= CONFIG_SLOT_SIZE, "Settings outgrew a config slot");
+
+// Written by setup() and then only by configSave() (loop); `store` under
+// the HAL critical section for configStoreRead()
+static Settings stored; // what the current slot holds
+static ConfigStoreStatus store = {};
+static std::atomic<bool> saveRequested(false);
+
+static uint16_t slotCheck(const uint8_t *slot, uint16_t size)
+{
+    uint16_t crc = crc16(slot, offsetof(ConfigSlotHeader, check));
+    return crc16(slot + sizeof(ConfigSlotHeader), size, crc);
+}
+
+// avail: bytes of the slot that were in the file
+static bool slotValid(const uint8_t *slot, size_t avail, ConfigSlotHeader &h)
+{
+    if (avail < sizeof(h))
+        return false;
+    memcpy(&h, slot, sizeof(h));
+    return h.magic == CONFIG_MAGIC && h.seq != 0 && h.size > 0 &&
+           h.size <= min(avail, (size_t)CONFIG_SLOT_SIZE) - sizeof(h) && h.check == slotCheck(slot, h.size);
+}
+
+// Strings end in zeros, so equal settings compare (and store) equal
+static void clearTail(char *s, size_t n)
+{
+    size_t len = strnlen(s, n - 1);
+    memset(s + len, 0, n - len);
+}
+
+// Field by field: padding bytes of Settings are not part of the value
+static bool sameSettings(const Settings &a, const Settings &b)
+{
+    return a.latitude == b.latitude && a.longitude == b.longitude && a.timezoneOffset == b.timezoneOffset &&
+           a.autoDst == b.autoDst && a.debug == b.debug && a.calibYaw == b.calibYaw && a.calibTilt == b.calibTilt &&
+           strncmp(a.staSsid, b.staSsid, sizeof(a.staSsid)) == 0 &&
+           strncmp(a.staPass, b.staPass, sizeof(a.staPass)) == 0 && a.rowPitch == b.rowPitch &&
+           a.panelWidth == b.panelWidth && a.rowAzimuth == b.rowAzimuth;
+}
+
+static bool writeSlot(const Settings &s)
+{
+    uint8_t slot[CONFIG_SLOT_SIZE] = {};
+    ConfigSlotHeader h = {};
+    h.magic = CONFIG_MAGIC;
+    h.seq = store.seq + 1;
+    h.version = CONFIG_VERSION;
+    h.size = sizeof(Settings);
+    memcpy(slot, &h, sizeof(h));
+    memcpy(slot + sizeof(h), &s, sizeof(Settings));
+    h.check = slotCheck(slot, h.size);
+    memcpy(slot, &h, sizeof(h));
+
+    // Never the slot holding the current record
+    uint8_t target = store.seq == 0 ? 0 : store.slot ^ 1;
+    File f = LittleFS.open(CONFIG_PATH, LittleFS.exists(CONFIG_PATH) ? "r+" : "w");
+    if (!f)
+        return false;
+    // Header and payload only, the rest of the slot is never read
+    size_t len = sizeof(ConfigSlotHeader) + sizeof(Settings);
+    bool ok = f.seek(target * CONFIG_SLOT_SIZE) && f.write(slot, len) == len;
+    f.close();
+    if (!ok)
+        return false;
+
+    halCriticalEnter();
+    store.seq = h.seq;
+    store.slot = target;
+    store.writes++;
+    halCriticalExit();
+    stored = s;
+    return true;
+}
+
+// Both slots in one read
+static bool readStore()
+{
+    if (!LittleFS.exists(CONFIG_PATH))
+        return false;
+    File f = LittleFS.open(CONFIG_PATH, "r");
+    if (!f)
+        return false;
+    uint8_t buf[2 * CONFIG_SLOT_SIZE];
+    size_t n = f.read(buf, sizeof(buf));
+    f.close();
 
-    if (LittleFS.exists("/geo.txt"))
+    int best = -1;
+    ConfigSlotHeader bestHeader = {};
+    for (int i = 0; i < 2; i++)
     {
-        File f = LittleFS.open("/geo.txt", "r");
-        if (f)
+        ConfigSlotHeader h;
+        size_t at = i * CONFIG_SLOT_SIZE;
+        if (at < n && slotValid(buf + at, n - at, h) &&
+            (best < 0 || (int32_t)(h.seq - bestHeader.seq) > 0))
         {
-            String data = f.readString();
-            f.close();
-
-            int firstComma = data.indexOf(',');
-            if (firstComma > 0)
-            {
-                currentLatitude = data.substring(0, firstComma).toDouble();
-                int secondComma = data.indexOf(',', firstComma + 1);
-                if (secondComma > 0)
-                {
-                    currentLongitude = data.substring(firstComma + 1, secondComma).toDouble();
-                    int thirdComma = data.indexOf(',', secondComma + 1);
-                    if (thirdComma > 0)
-                    {
-                        useAutoDST = (data.substring(secondComma + 1, thirdComma).toInt() == 1);
-                        manualTimezoneOffset = data.substring(thirdComma + 1).toInt();
-                    }
-                }
-                else
-                {
-                    currentLongitude = data.substring(firstComma + 1).toDouble();
-                }
-                DEBUG_PRINT("✓ Geo-Config geladen: ");
-                DEBUG_PRINT(currentLatitude, 6);
-                DEBUG_PRINT(", ");
-                DEBUG_PRINT(currentLongitude, 6);
-                DEBUG_PRINT(", AutoDST: ");
-                DEBUG_PRINT(useAutoDST ? "AN" : "AUS");
-                DEBUG_PRINT(", TZ: ");
-                DEBUG_PRINTLN(manualTimezoneOffset / 3600.0);
-            }
+            best = i;
+            bestHeader = h;
         }
     }
-    else
+    if (best < 0)
+        return false;
+
+    // An older, shorter schema fills its fields, the rest stay defaults
+    memcpy(&settings, buf + best * CONFIG_SLOT_SIZE + sizeof(ConfigSlotHeader),
+           min((size_t)bestHeader.size, sizeof(Settings)));
+    settings.staSsid[sizeof(settings.staSsid) - 1] = 0;
+    settings.staPass[sizeof(settings.staPass) - 1] = 0;
+    clearTail(settings.staSsid, sizeof(settings.staSsid));
+    clearTail(settings.staPass, sizeof(settings.staPass));
+    stored = settings;
+    store.seq = bestHeader.seq;
+    store.slot = best;
+
+    if (bestHeader.version != CONFIG_VERSION || bestHeader.size != sizeof(Settings))
     {
-        DEBUG_PRINTLN("Nutze Default-Position");
+        DEBUG_PRINT("Konfiguration Version ");
+        DEBUG_PRINT(bestHeader.version);
+        DEBUG_PRINT(" -> ");
+        DEBUG_PRINTLN(CONFIG_VERSION);
+        writeSlot(settings);
     }
+    return true;
 }
 
-void saveGeoConfig()
+// =====================================================
+// MIGRATION FROM THE TEXT FILES
+// =====================================================
+static bool readLegacy(const char *path, String &data)
 {
-    if (!littlefsAvailable)
-        return;
+    if (!LittleFS.exists(path))
+        return false;
+    File f = LittleFS.open(path, "r");
+    if (!f)
+        return false;
+    data = f.readString();
+    f.close();
+    return true;
+}
 
-    File f = LittleFS.open("/geo.txt", "w");
-    if (f)
+// "lat,lon[,autodst,tzoffset]"
+static void migrateGeo(const String &data)
+{
+    int firstComma = data.indexOf(',');
+    if (firstComma <= 0)
+        return;
+    settings.latitude = data.substring(0, firstComma).toDouble();
+    int secondComma = data.indexOf(',', firstComma + 1);
+    if (secondComma < 0)
     {
-        f.print(currentLatitude, 6);
-        f.print(",");
-        f.print(currentLongitude, 6);
-        f.print(",");
-        f.print(useAutoDST ? "1" : "0");
-        f.print(",");
-        f.println(manualTimezoneOffset);
-        f.close();
-        DEBUG_PRINTLN("✓ Geo-Config gespeichert");
+        settings.longitude = data.substring(firstComma + 1).toDouble();
+        return;
+    }
+    settings.longitude = data.substring(firstComma + 1, secondComma).toDouble();
+    int thirdComma = data.indexOf(',', secondComma + 1);
+    if (thirdComma > 0)
+    {
+        settings.autoDst = data.substring(secondComma + 1, thirdComma).toInt() == 1;
+        settings.timezoneOffset = data.substring(thirdComma + 1).toInt();
     }
 }
 
-void loadWifiConfig()
+// "ssid,pass"
+static void migrateWifi(const String &data)
 {
-    if (!littlefsAvailable)
+    int firstComma = data.indexOf(',');
+    if (firstComma <= 0)
         return;
+    String ssid = data.substring(0, firstComma);
+    String pass = data.substring(firstComma + 1);
+    ssid.trim();
+    pass.trim();
+    ssid.toCharArray(settings.staSsid, sizeof(settings.staSsid));
+    pass.toCharArray(settings.staPass, sizeof(settings.staPass));
+}
+
+// "yaw,tilt" in degrees (older files: integers)
+static void migrateCalibration(const String &data)
+{
+    int commaIndex = data.indexOf(',');
+    if (commaIndex <= 0)
+        return;
+    settings.calibYaw = clampYawCd(degToCd(data.substring(0, commaIndex).toFloat()));
+    settings.calibTilt = clampTiltCd(degToCd(data.substring(commaIndex + 1).toFloat()));
+}
 
-    if (LittleFS.exists("/wifi.txt"))
+static bool migrateLegacy()
+{
+    static const char *const paths[] = {"/geo.txt", "/wifi.txt", "/calibration.txt", "/debug.txt"};
+    String data;
+    bool found = false;
+    for (uint8_t i = 0; i < 4; i++)
     {
-        File f = LittleFS.open("/wifi.txt", "r");
-        if (f)
+        if (!readLegacy(paths[i], data))
+            continue;
+        found = true;
+        switch (i)
         {
-            String data = f.readString();
-            f.close();
-
-            int firstComma = data.indexOf(',');
-            if (firstComma > 0)
-            {
-                String ssid = data.substring(0, firstComma);
-                String pass = data.substring(firstComma + 1);
+        case 0:
+            migrateGeo(data);
+            break;
+        case 1:
+            migrateWifi(data);
+            break;
+        case 2:
+            migrateCalibration(data);
+            break;
+        case 3:
+            data.trim();
+            settings.debug = data == "1" || data.equalsIgnoreCase("true");
+            break;
+        }
+    }
+    if (!found || !writeSlot(settings))
+        return found;
 
-                ssid.trim();
-                pass.trim();
+    // Only once the record is stored
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (LittleFS.exists(paths[i]))
+            LittleFS.remove(paths[i]);
+    }
+    return true;
+}
 
-                ssid.toCharArray(staSsid, 64);
-                pass.toCharArray(staPass, 64);
+// =====================================================
+// API
+// =====================================================
+void configLoad()
+{
+    settings = SETTINGS_DEFAULTS;
+    stored = settings;
+    store = ConfigStoreStatus();
+    if (!littlefsAvailable)
+        return;
 
-                DEBUG_PRINT("✓ WiFi-Config geladen: SSID=");
-                DEBUG_PRINTLN(staSsid);
-            }
-        }
+    if (readStore())
+    {
+        DEBUG_PRINT("✓ Konfiguration geladen (#");
+        DEBUG_PRINT(store.seq);
+        DEBUG_PRINT("): ");
+    }
+    else if (migrateLegacy())
+    {
+        store.migrated = true;
+        DEBUG_PRINT("✓ Konfiguration aus Textdateien übernommen: ");
     }
     else
     {
-        DEBUG_PRINTLN("Nutze Default-WiFi-Config");
+        DEBUG_PRINTLN("Nutze Default-Konfiguration");
+        return;
     }
+    DEBUG_PRINT(settings.latitude, 6);
+    DEBUG_PRINT(", ");
+    DEBUG_PRINT(settings.longitude, 6);
+    DEBUG_PRINT(", AutoDST: ");
+    DEBUG_PRINT(settings.autoDst ? "AN" : "AUS");
+    DEBUG_PRINT(", SSID=");
+    DEBUG_PRINTLN(settings.staSsid);
 }
 
-void saveWifiConfig()
+bool configSave()
 {
     if (!littlefsAvailable)
-        return;
+        return false;
 
-    File f = LittleFS.open("/wifi.txt", "w");
-    if (f)
+    Settings s;
+    settingsRead(s);
+    clearTail(s.staSsid, sizeof(s.staSsid));
+    clearTail(s.staPass, sizeof(s.staPass));
+    if (store.seq != 0 && sameSettings(s, stored))
+    {
+        halCriticalEnter();
+        store.skipped++;
+        halCriticalExit();
+        return false;
+    }
+    if (!writeSlot(s))
     {
-        f.print(staSsid);
-        f.print(",");
-        f.println(staPass);
-        f.close();
-        DEBUG_PRINTLN("✓ WiFi-Config gespeichert");
+        DEBUG_PRINTLN("⚠ Konfiguration konnte nicht gespeichert werden");
+        return false;
     }
+    DEBUG_PRINT("✓ Konfiguration gespeichert (#");
+    DEBUG_PRINT(store.seq);
+    DEBUG_PRINTLN(")");
+    return true;
+}
+
+void settingsCopyGroups(Settings &to, const Settings &from, uint8_t groups)
+{
+    if (groups & SETTINGS_GEO)
+    {
+        to.latitude = from.latitude;
+        to.longitude = from.longitude;
+        to.timezoneOffset = from.timezoneOffset;
+        to.autoDst = from.autoDst;
+        to.rowPitch = from.rowPitch;
+        to.panelWidth = from.panelWidth;
+        to.rowAzimuth = from.rowAzimuth;
+    }
+    if (groups & SETTINGS_WIFI)
+    {
+        memcpy(to.staSsid, from.staSsid, sizeof(to.staSsid));
+        memcpy(to.staPass, from.staPass, sizeof(to.staPass));
+    }
+    if (groups & SETTINGS_DEBUG)
+    {
+        to.debug = from.debug;
+    }
+}
+
+void settingsRead(Settings &out)
+{
+    halCriticalEnter();
+    out = settings;
+    halCriticalExit();
+}
+
+void configRequestSave()
+{
+    saveRequested = true;
+}
+
+void configService()
+{
+    if (saveRequested.exchange(false))
+        configSave();
+}
+
+void configStoreRead(ConfigStoreStatus &out)
+{
+    halCriticalEnter();
+    out = store;
+    halCriticalExit();
 }
@@ -1,10 +1,86 @@
-#ifndef ST_CONFIG_H
-#define ST_CONFIG_H
-
-// Configuration file management functions
-void loadGeoConfig(void);
-void saveGeoConfig(void);
-void loadWifiConfig(void);
-void saveWifiConfig(void);
+#ifndef ST_CONFIG_STORE_H
+#define ST_CONFIG_STORE_H
+
+#include <Arduino.h>
+
+// =====================================================
+// CONFIG STORE (/config.bin)
+// =====================================================
+// Everything that used to live in geo.txt, wifi.txt, calibration.txt and
+// debug.txt, as one typed record. setup() reads it once (configLoad(),
+// one open, one read).
+//
+// The control task owns `settings`: it reads it directly and writes it
+// under the HAL critical section. Other tasks take a copy with
+// settingsRead() and change it through controlPostSettings()
+// (st_control.h), one group of fields at a time.
+//
+// loop() is the only writer of the file: other tasks call
+// configRequestSave(), configService() saves a copy of `settings`.
+//
+// The file holds two slots of CONFIG_SLOT_SIZE bytes. A save goes to the
+// slot that does not hold the current record, with the next sequence
+// number, so a power cut mid-write leaves the previous record intact;
+// the newest slot with a valid CRC wins at boot. A save that changes
+// nothing is skipped, no flash write.
+//
+// Versioning: fields are only ever appended to Settings. A record from
+// an older (shorter) schema fills the fields it has, the rest keep their
+// defaults, and the next save writes the current version. Without any
+// valid slot the legacy text files are read once, stored as a record and
+// removed.
+
+#define CONFIG_VERSION 2
+#define CONFIG_SLOT_SIZE 256
+
+struct Settings
+{
+    double latitude;
+    double longitude;
+    int32_t timezoneOffset; // manual offset in seconds (UTC+1 = 3600), without autoDst
+    bool autoDst;           // EU DST rules
+    bool debug;             // DEBUG_PRINT output
+    uint8_t reserved[2];
+    int32_t calibYaw;       // calibrated position, centidegrees
+    int32_t calibTilt;
+    char staSsid[64];       // station link (internet/NTP)
+    char staPass[64];
+    // Version 2: row geometry for backtracking (st_backtrack)
+    float rowPitch;         // pivot to pivot (m), 0 = single tracker
+    float panelWidth;       // (m)
+    float rowAzimuth;       // direction to the neighbouring row (degrees)
+};
+
+extern Settings settings;
+extern const Settings SETTINGS_DEFAULTS; // config.cpp
+
+// Fields that change together
+#define SETTINGS_GEO 0x01   // position, time zone, row geometry
+#define SETTINGS_WIFI 0x02  // station SSID and password
+#define SETTINGS_DEBUG 0x04 // debug output
+
+void settingsCopyGroups(Settings &to, const Settings &from, uint8_t groups);
+// Consistent copy for tasks other than the control task
+void settingsRead(Settings &out);
+
+struct ConfigStoreStatus
+{
+    uint32_t seq;     // of the current record, 0 = none stored
+    uint8_t slot;     // slot holding it
+    bool migrated;    // taken over from the text files at this boot
+    uint32_t writes;  // saves that wrote flash since boot
+    uint32_t skipped; // saves without changes
+};
+
+// setup(), after the file system is mounted: defaults, then the stored
+// record (or the legacy files)
+void configLoad();
+// false when nothing changed (or no file system); setup() and loop() only
+bool configSave();
+// Any task; the next configService() saves
+void configRequestSave();
+// loop(): runs a requested save
+void configService();
+void configStoreRead(ConfigStoreStatus &out);
 
 #endif
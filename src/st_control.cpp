@@ -0,0 +1,330 @@
+#include <atomic>
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_sensors.h"
+#include "st_servo.h"
+#include "st_motion.h"
+#include "st_ephemeris.h"
+#include "st_strategy.h"
+#include "st_calibration.h"
+#include "st_helpers.h"
+#include "st_init.h"
+#include "st_snapshot.h"
+#include "st_metrics.h"
+#include "st_supervisor.h"
+#include "st_control.h"
+#include "time_rtc.h"
+
+// External references from main.cpp
+extern int32_t yawAngle;
+extern int32_t tiltAngle;
+extern unsigned long lastRead;
+extern unsigned long lastSerialLog;
+extern std::atomic<bool> weatherSaysStop;
+extern TrackerState trackerState;
+extern TrackerState lastLoggedState;
+extern uint8_t darkCount;
+extern uint8_t lightCount;
+extern int32_t historyYaw[];
+extern int32_t historyTilt[];
+extern int historyIndex;
+extern bool haveHistory;
+
+static std::atomic<uint8_t> pendingCommand(CONTROL_CMD_NONE);
+// Under the HAL critical section
+static Settings pendingSettings = {};
+static uint8_t pendingGroups = 0;
+static bool taskRunning = false;
+
+// Control task side only; published through the snapshot
+static ControlTiming timing = {};
+static uint64_t jitterSumUs = 0;
+static unsigned long periodStartUs = 0;
+static bool periodStarted = false;
+
+static void notePeriod()
+{
+    unsigned long nowUs = micros();
+    if (periodStarted)
+    {
+        uint32_t period = nowUs - periodStartUs;
+        uint32_t expected = READ_INTERVAL * 1000UL;
+        uint32_t jitter = period > expected ? period - expected : expected - period;
+        timing.periods++;
+        timing.lastPeriodUs = period;
+        timing.maxJitterUs = max(timing.maxJitterUs, jitter);
+        jitterSumUs += jitter;
+        if (period > 2 * expected)
+            timing.late++;
+    }
+    periodStartUs = nowUs;
+    periodStarted = true;
+}
+
+// Last frame of the READ_INTERVAL work, raw values for the snapshot
+static LdrFrame lastLdr = {};
+
+static void readLdr(LdrFrame &ldr)
+{
+    sensorsRead(ldr);
+    lastLdr = ldr;
+}
+
+static void applyCommand(ControlCommand cmd)
+{
+    switch (cmd)
+    {
+    case CONTROL_CMD_CALIBRATE_ADAPTIVE:
+        calibrationStart(CAL_MODE_ADAPTIVE);
+        break;
+    case CONTROL_CMD_CALIBRATE_GRID:
+        calibrationStart(CAL_MODE_GRID);
+        break;
+    case CONTROL_CMD_CALIBRATE_CANCEL:
+        calibrationCancel();
+        break;
+    case CONTROL_CMD_NONE:
+        break;
+    }
+}
+
+void controlBegin()
+{
+    taskRunning = halStartControlTask(controlStep, CONTROL_TASK_PERIOD_MS);
+    if (taskRunning)
+    {
+        DEBUG_PRINTLN("✓ Regel-Task gestartet");
+    }
+    else
+    {
+        DEBUG_PRINTLN("Kein Regel-Task, Regelung laeuft in loop()");
+    }
+}
+
+bool controlTaskRunning()
+{
+    return taskRunning;
+}
+
+bool controlPost(ControlCommand cmd)
+{
+    uint8_t expected = CONTROL_CMD_NONE;
+    return pendingCommand.compare_exchange_strong(expected, (uint8_t)cmd);
+}
+
+void controlPostSettings(uint8_t groups, const Settings &values)
+{
+    halCriticalEnter();
+    settingsCopyGroups(pendingSettings, values, groups);
+    pendingGroups |= groups;
+    halCriticalExit();
+}
+
+static void applySettings()
+{
+    halCriticalEnter();
+    uint8_t groups = pendingGroups;
+    settingsCopyGroups(settings, pendingSettings, groups);
+    pendingGroups = 0;
+    halCriticalExit();
+    if (!groups)
+        return;
+
+    if (groups & SETTINGS_GEO)
+        ephemerisInvalidate();
+    configRequestSave();
+}
+
+void controlPublish()
+{
+    TrackerSnapshot s;
+    s.state = trackerState;
+    s.yaw = yawAngle;
+    s.tilt = tiltAngle;
+    s.sunAzimuth = currentSunAzimuth;
+    s.sunAltitude = currentSunAltitude;
+    s.backtracking = sunBacktracking;
+    s.ldr[0] = lastLdr.tl;
+    s.ldr[1] = lastLdr.tr;
+    s.ldr[2] = lastLdr.bl;
+    s.ldr[3] = lastLdr.br;
+    calibrationGetStatus(s.calibration);
+    s.timing = timing;
+    s.timing.meanJitterUs = timing.periods ? (uint32_t)(jitterSumUs / timing.periods) : 0;
+    snapshotPublish(s);
+}
+
+void controlResetTiming()
+{
+    timing = ControlTiming();
+    jitterSumUs = 0;
+    periodStarted = false;
+}
+
+void controlStep()
+{
+    METRIC_SCOPE_LONG(METRIC_CONTROL_STEP);
+    ControlCommand cmd = (ControlCommand)pendingCommand.exchange(CONTROL_CMD_NONE);
+    applyCommand(cmd);
+    applySettings();
+
+    unsigned long now = millis();
+
+    switch (trackerState)
+    {
+
+    case STATE_INIT:
+        doStartInit();
+        break;
+
+    case STATE_TRACKING:
+    {
+        if (now - lastRead >= READ_INTERVAL)
+        {
+            lastRead = now;
+
+            notePeriod();
+
+            // Sun position is only consumed here, once per READ_INTERVAL;
+            // updateTime() (NTP) runs in loop()
+            if (timeInitialized)
+            {
+                calculateSunPosition();
+            }
+
+            LdrFrame ldr;
+            readLdr(ldr);
+            int tl = ldr.tl;
+            int tr = ldr.tr;
+            int bl = ldr.bl;
+            int br = ldr.br;
+
+            bool dark = isDark(tl, tr, bl, br);
+            bool cloudy = isCloudy(tl, tr, bl, br);
+
+            if (dark || cloudy || weatherSaysStop)
+            {
+                darkCount++;
+                lightCount = 0;
+                if (darkCount >= STATE_CHANGE_THRESHOLD)
+                {
+                    DEBUG_PRINTLN("-> Zu dunkel / Wolken / Web-Stop -> SLEEP");
+                    yawAngle = 9000;
+                    tiltAngle = 7000;
+                    motionMoveTo(yawAngle, tiltAngle);
+                    trackerState = STATE_SLEEP;
+                    lastLoggedState = STATE_SLEEP;
+                    pushHistory(yawAngle, tiltAngle, true);
+                    darkCount = 0;
+                    break;
+                }
+            }
+            else
+            {
+                darkCount = 0;
+            }
+
+            int topSum = tl + tr;
+            int bottomSum = bl + br;
+            int leftSum = tl + bl;
+            int rightSum = tr + br;
+
+            TrackInput in;
+            in.haveSun = timeInitialized && currentSunAltitude > 0;
+            in.backtracking = in.haveSun && sunBacktracking;
+            in.sunYaw = in.haveSun ? targetYawFromSun : yawAngle;
+            in.sunTilt = in.haveSun ? targetTiltFromSun : tiltAngle;
+            in.totalSum = topSum + bottomSum;
+            in.errorYaw = in.totalSum > 0 ? (float)(leftSum - rightSum) / in.totalSum : 0.0f;
+            in.errorTilt = in.totalSum > 0 ? (float)(topSum - bottomSum) / in.totalSum : 0.0f;
+
+            // Mid-move the LDRs see the panel on its way, not at the
+            // target (boot, wake-up): hold until the planner arrives.
+            // Unchanged targets are coalesced by the planner.
+            if (motionIdle())
+            {
+                strategyStep(in, yawAngle, tiltAngle);
+                motionMoveTo(yawAngle, tiltAngle);
+            }
+
+            pushHistory(yawAngle, tiltAngle);
+
+            if (now - lastSerialLog >= SERIAL_LOG_INTERVAL)
+            {
+                lastSerialLog = now;
+                DEBUG_PRINT("TRACK Yaw: ");
+                DEBUG_PRINT(cdToDeg(yawAngle));
+                DEBUG_PRINT("  Tilt: ");
+                DEBUG_PRINT(cdToDeg(tiltAngle));
+                DEBUG_PRINT("  Target: ");
+                DEBUG_PRINT(cdToDeg(in.sunYaw));
+                DEBUG_PRINT("/");
+                DEBUG_PRINT(cdToDeg(in.sunTilt));
+                DEBUG_PRINT("  LuxSum: ");
+                DEBUG_PRINT(in.totalSum);
+                DEBUG_PRINT("  ");
+                DEBUG_PRINTLN(strategyName(strategySelected()));
+            }
+        }
+        break;
+    }
+
+    case STATE_CALIBRATING:
+        calibrationTick();
+        break;
+
+    case STATE_SLEEP:
+    {
+        if (now - lastRead >= READ_INTERVAL)
+        {
+            lastRead = now;
+            notePeriod();
+
+            LdrFrame ldr;
+            readLdr(ldr);
+            int tl = ldr.tl;
+            int tr = ldr.tr;
+            int bl = ldr.bl;
+            int br = ldr.br;
+
+            bool dark = isDark(tl, tr, bl, br);
+            bool cloudy = isCloudy(tl, tr, bl, br);
+
+            if (!dark && !cloudy && !weatherSaysStop)
+            {
+                lightCount++;
+                darkCount = 0;
+                if (lightCount >= STATE_CHANGE_THRESHOLD)
+                {
+                    DEBUG_PRINTLN("-> Licht wieder ok, zurück zu TRACKING");
+                    if (haveHistory)
+                    {
+                        int lastIdx = (historyIndex - 1 + POS_HISTORY_SIZE) % POS_HISTORY_SIZE;
+                        yawAngle = historyYaw[lastIdx];
+                        tiltAngle = historyTilt[lastIdx];
+                        motionMoveTo(yawAngle, tiltAngle);
+                    }
+                    trackerState = STATE_TRACKING;
+                    lastLoggedState = STATE_TRACKING;
+                    pushHistory(yawAngle, tiltAngle, true);
+                    lightCount = 0;
+                }
+            }
+            else
+            {
+                lightCount = 0;
+            }
+        }
+        break;
+    }
+    }
+
+
+    // Periods are only measured back to back
+    if (trackerState == STATE_INIT || trackerState == STATE_CALIBRATING)
+        periodStarted = false;
+
+    supervisorBeat(SUPERVISOR_CONTROL);
+    controlPublish();
+}
@@ -0,0 +1,50 @@
+#ifndef ST_CONTROL_H
+#define ST_CONTROL_H
+
+#include <Arduino.h>
+#include "st_config.h"
+
+// =====================================================
+// CONTROL TASK
+// =====================================================
+// controlStep() is the tracker state machine: sensors, controller,
+// servo targets (st_motion moves the servos), calibration. On the board
+// it runs in its own FreeRTOS task on CONTROL_TASK_CORE, woken every
+// CONTROL_TASK_PERIOD_MS. The web server
+// (async_tcp task), NTP and history writes stay on the other core. Without a
+// task (native build) loop() calls controlStep() itself.
+//
+// Other tasks do not write control state. They read the snapshot
+// (st_snapshot.h) and post commands and settings edits, which the next
+// step applies.
+
+enum ControlCommand
+{
+    CONTROL_CMD_NONE,
+    CONTROL_CMD_CALIBRATE_ADAPTIVE,
+    CONTROL_CMD_CALIBRATE_GRID,
+    CONTROL_CMD_CALIBRATE_CANCEL
+};
+
+// Period of the READ_INTERVAL work (TRACKING/SLEEP), taken at its start
+struct ControlTiming
+{
+    uint32_t periods;
+    uint32_t lastPeriodUs;
+    uint32_t maxJitterUs;  // max |period - READ_INTERVAL|
+    uint32_t meanJitterUs;
+    uint32_t late;         // periods longer than 2x READ_INTERVAL
+};
+
+void controlBegin(); // starts the task if the HAL has one
+bool controlTaskRunning();
+void controlStep();
+bool controlPost(ControlCommand cmd); // false while another command is pending
+// The SETTINGS_* groups of values (st_config.h) replace those of
+// `settings` on the next step, which then saves them; later edits of the
+// same group win
+void controlPostSettings(uint8_t groups, const Settings &values);
+void controlPublish();                // refresh the snapshot, done after every step
+void controlResetTiming();
+
+#endif
@@ -0,0 +1,90 @@
+#include "config.h"
+#include "st_controller.h"
+#include "st_servo.h"
+
+static AxisController yawAxis = {0.0f, 0.0f};
+static AxisController tiltAxis = {0.0f, 0.0f};
+
+struct AxisParams
+{
+    float kp;
+    float ki;
+    float offsetLimit;
+    float deadBand;
+    int maxStep;
+    int dir;
+    int minPos;
+    int maxPos;
+};
+
+static int32_t stepAxis(AxisController &axis, const AxisParams &p,
+                        bool haveTarget, int32_t targetCd, float error, int32_t positionCd)
+{
+    float target = cdToDeg(targetCd);
+    float position = cdToDeg(positionCd);
+
+    // Sign so that a positive error always asks for a larger servo angle
+    float e = fabsf(error) > p.deadBand ? error * p.dir : 0.0f;
+    float correction = p.kp * (e - axis.lastError) + p.ki * e;
+    axis.lastError = e;
+
+    float desired;
+    if (haveTarget)
+    {
+        float base = target + axis.offset;
+        bool slewing = fabsf(base - position) > p.maxStep;
+        float next = base + correction;
+        bool pushingLimit = (next < p.minPos && correction < 0.0f) || (next > p.maxPos && correction > 0.0f);
+
+        // LDR error is meaningless mid-slew; at the limits it only winds up
+        if (!slewing && !pushingLimit)
+        {
+            axis.offset = constrain(axis.offset + correction, -p.offsetLimit, p.offsetLimit);
+        }
+        desired = target + axis.offset;
+    }
+    else
+    {
+        desired = position + correction;
+    }
+
+    float delta = constrain(desired, (float)p.minPos, (float)p.maxPos) - position;
+    int32_t stepCd = degToCd(constrain(delta, (float)-p.maxStep, (float)p.maxStep));
+    return constrain(positionCd + stepCd, (int32_t)p.minPos * ANGLE_SCALE, (int32_t)p.maxPos * ANGLE_SCALE);
+}
+
+void controllerReset()
+{
+    yawAxis = {0.0f, 0.0f};
+    tiltAxis = {0.0f, 0.0f};
+}
+
+void controllerSeed(float offsetYaw, float offsetTilt)
+{
+    controllerReset();
+    yawAxis.offset = constrain(offsetYaw, -CTRL_OFFSET_LIMIT, CTRL_OFFSET_LIMIT);
+    tiltAxis.offset = constrain(offsetTilt, -CTRL_OFFSET_LIMIT, CTRL_OFFSET_LIMIT);
+}
+
+void controllerStep(bool haveTarget, int32_t targetYaw, int32_t targetTilt,
+                    float errorYaw, float errorTilt,
+                    int32_t &yaw, int32_t &tilt)
+{
+    const AxisParams yawParams = {CTRL_KP_YAW, CTRL_KI_YAW, CTRL_OFFSET_LIMIT, DEAD_BAND_YAW,
+                                  CTRL_MAX_STEP_YAW, YAW_DIR, YAW_MIN, YAW_MAX};
+    const AxisParams tiltParams = {CTRL_KP_TILT, CTRL_KI_TILT, CTRL_OFFSET_LIMIT, DEAD_BAND_TILT,
+                                   CTRL_MAX_STEP_TILT, TILT_DIR, TILT_MIN, TILT_MAX};
+
+    yaw = stepAxis(yawAxis, yawParams, haveTarget, targetYaw, errorYaw, yaw);
+    tilt = stepAxis(tiltAxis, tiltParams, haveTarget, targetTilt, errorTilt, tilt);
+}
+
+const AxisController &controllerYaw()
+{
+    return yawAxis;
+}
+
+const AxisController &controllerTilt()
+{
+    return tiltAxis;
+}
@@ -0,0 +1,37 @@
+#ifndef ST_CONTROLLER_H
+#define ST_CONTROLLER_H
+
+#include <Arduino.h>
+
+// =====================================================
+// POINTING CONTROLLER
+// =====================================================
+// Per axis: the astronomical target is the feed-forward, the normalized
+// LDR error (errorYaw/errorTilt, -1..1) drives a velocity-form PI that
+// learns the offset between target and the real sun (mounting error,
+// mapping quantization). Moves are rate limited to CTRL_MAX_STEP_* per
+// call; the offset is frozen while slewing and at the mechanical limits
+// (anti-windup). Without a target the PI acts on the position directly.
+
+struct AxisController
+{
+    float offset;    // learned correction to the feed-forward target (degrees)
+    float lastError; // previous normalized error, for the P term
+};
+
+void controllerReset();
+// Starts with a known offset (degrees, e.g. restored at boot), clamped
+// to CTRL_OFFSET_LIMIT
+void controllerSeed(float offsetYaw, float offsetTilt);
+
+// One step per READ_INTERVAL. haveTarget = astronomical target valid.
+// Targets and yaw/tilt are centidegrees; yaw/tilt are updated in place
+// and kept inside YAW_/TILT_MIN..MAX.
+void controllerStep(bool haveTarget, int32_t targetYaw, int32_t targetTilt,
+                    float errorYaw, float errorTilt,
+                    int32_t &yaw, int32_t &tilt);
+
+const AxisController &controllerYaw();
+const AxisController &controllerTilt();
+
+#endif
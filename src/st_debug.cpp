@@ -1,58 +1,18 @@
 #include "st_debug.h"
 #include "config.h"
+#include "st_control.h"
 
-// External references
-extern bool littlefsAvailable;
-
-// Global debug state (default enabled)
-bool debugEnabled = true;
-
-void loadDebugConfig()
-{
-    debugEnabled = true; // Default
-
-    if (!littlefsAvailable)
-        return;
-
-    if (LittleFS.exists("/debug.txt"))
-    {
-        File f = LittleFS.open("/debug.txt", "r");
-        if (f)
-        {
-            String data = f.readString();
-            f.close();
-            data.trim();
-            debugEnabled = (data == "1" || data.equalsIgnoreCase("true"));
-            Serial.print("✓ Debug-Config geladen: ");
-            Serial.println(debugEnabled ? "EIN" : "AUS");
-        }
-    }
-}
-
-void saveDebugConfig()
-{
-    if (!littlefsAvailable)
-        return;
-
-    File f = LittleFS.open("/debug.txt", "w");
-    if (f)
-    {
-        f.println(debugEnabled ? "1" : "0");
-        f.close();
-        Serial.print("✓ Debug-Config gespeichert: ");
-        Serial.println(debugEnabled ? "EIN" : "AUS");
-    }
-}
-
+// Applied and saved by the control task
 void setDebugEnabled(bool enabled)
 {
-    debugEnabled = enabled;
-    saveDebugConfig();
+    Settings v = {};
+    v.debug = enabled;
+    controlPostSettings(SETTINGS_DEBUG, v);
     Serial.print("Debug-Modus: ");
-    Serial.println(debugEnabled ? "AKTIVIERT" : "DEAKTIVIERT");
+    Serial.println(enabled ? "AKTIVIERT" : "DEAKTIVIERT");
 }
 
 bool isDebugEnabled()
 {
-    return debugEnabled;
+    return settings.debug;
 }
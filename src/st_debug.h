@@ -2,20 +2,16 @@
 #define ST_DEBUG_H
 
 #include <Arduino.h>
+#include "st_config.h"
 
-// Runtime debug control - can be changed via API
-extern bool debugEnabled;
-
-// Debug functions
-void loadDebugConfig();
-void saveDebugConfig();
+// Runtime debug control - can be changed via API, stored in settings.debug
 void setDebugEnabled(bool enabled);
 bool isDebugEnabled();
 
 // Debug macros - check runtime flag
 #define DEBUG_INIT(baud) Serial.begin(baud)
-#define DEBUG_PRINT(...) do { if (debugEnabled) Serial.print(__VA_ARGS__); } while(0)
-#define DEBUG_PRINTLN(...) do { if (debugEnabled) Serial.println(__VA_ARGS__); } while(0)
-#define DEBUG_PRINTF(fmt, ...) do { if (debugEnabled) Serial.printf(fmt, __VA_ARGS__); } while(0)
+#define DEBUG_PRINT(...) do { if (settings.debug) Serial.print(__VA_ARGS__); } while(0)
+#define DEBUG_PRINTLN(...) do { if (settings.debug) Serial.println(__VA_ARGS__); } while(0)
+#define DEBUG_PRINTF(fmt, ...) do { if (settings.debug) Serial.printf(fmt, __VA_ARGS__); } while(0)
 
 #endif
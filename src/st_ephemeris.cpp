@@ -0,0 +1,111 @@
+#include "st_debug.h"
+#include "config.h"
+#include "st_ephemeris.h"
+
+// Table storage: 289 slots * 4 bytes
+static uint16_t ephAzimuth[EPHEMERIS_SLOTS];
+static int16_t ephAltitude[EPHEMERIS_SLOTS];
+
+static bool ephValid = false;
+static int ephYear = 0;
+static int ephMonth = 0;
+static int ephDay = 0;
+static double ephLatitude = 0.0;
+static double ephLongitude = 0.0;
+
+static int32_t toCentidegrees(double deg)
+{
+    return (int32_t)lround(deg * 100.0);
+}
+
+void ephemerisBuild(int year, int month, int day, double latitude, double longitude)
+{
+    for (int i = 0; i < EPHEMERIS_SLOTS; i++)
+    {
+        uint32_t t = (uint32_t)i * EPHEMERIS_STEP_S;
+        double az = 0.0;
+        double alt = 0.0;
+
+        // Last slot is 24:00, SolarCalculator handles the day overflow itself
+        calcHorizontalCoordinates(year, month, day,
+                                  t / 3600, (t / 60) % 60, t % 60,
+                                  latitude, longitude, az, alt);
+
+        int32_t azCd = toCentidegrees(az) % 36000;
+        if (azCd < 0)
+            azCd += 36000;
+        ephAzimuth[i] = (uint16_t)azCd;
+        ephAltitude[i] = (int16_t)constrain(toCentidegrees(alt), -9000, 9000);
+    }
+
+    ephYear = year;
+    ephMonth = month;
+    ephDay = day;
+    ephLatitude = latitude;
+    ephLongitude = longitude;
+    ephValid = true;
+
+    DEBUG_PRINTF("Ephemeris fuer %04d-%02d-%02d berechnet\n", year, month, day);
+}
+
+void ephemerisInvalidate()
+{
+    ephValid = false;
+}
+
+bool ephemerisValidFor(int year, int month, int day, double latitude, double longitude)
+{
+    return ephValid &&
+           ephYear == year && ephMonth == month && ephDay == day &&
+           ephLatitude == latitude && ephLongitude == longitude;
+}
+
+bool ephemerisLookup(uint32_t secondsOfDay, int32_t &azimuthCd, int32_t &altitudeCd)
+{
+    if (!ephValid)
+        return false;
+
+    if (secondsOfDay >= 86400)
+        secondsOfDay = 86399;
+
+    uint32_t idx = secondsOfDay / EPHEMERIS_STEP_S;
+    // Q16 fraction between slot idx and idx + 1
+    int32_t frac = (int32_t)(((secondsOfDay % EPHEMERIS_STEP_S) << 16) / EPHEMERIS_STEP_S);
+
+    // Azimuth wraps at 360°, interpolate along the short arc
+    int32_t az0 = ephAzimuth[idx];
+    int32_t dAz = (int32_t)ephAzimuth[idx + 1] - az0;
+    if (dAz > 18000)
+        dAz -= 36000;
+    else if (dAz < -18000)
+        dAz += 36000;
+
+    azimuthCd = az0 + ((dAz * frac) >> 16);
+    if (azimuthCd < 0)
+        azimuthCd += 36000;
+    else if (azimuthCd >= 36000)
+        azimuthCd -= 36000;
+
+    int32_t alt0 = ephAltitude[idx];
+    int32_t dAlt = (int32_t)ephAltitude[idx + 1] - alt0;
+    altitudeCd = alt0 + ((dAlt * frac) >> 16);
+
+    return true;
+}
+
+void ephemerisSunPosition(int year, int month, int day, int hour, int minute, int second,
+                          double latitude, double longitude,
+                          double &azimuth, double &altitude)
+{
+    if (!ephemerisValidFor(year, month, day, latitude, longitude))
+    {
+        ephemerisBuild(year, month, day, latitude, longitude);
+    }
+
+    int32_t azCd = 0;
+    int32_t altCd = 0;
+    ephemerisLookup((uint32_t)hour * 3600 + (uint32_t)minute * 60 + second, azCd, altCd);
+
+    azimuth = azCd / 100.0;
+    altitude = altCd / 100.0;
+}
@@ -0,0 +1,29 @@
+#ifndef ST_EPHEMERIS_H
+#define ST_EPHEMERIS_H
+
+#include <Arduino.h>
+
+// =====================================================
+// DAILY SUN EPHEMERIS
+// =====================================================
+// One table per day with azimuth/altitude in centidegrees at a fixed
+// step. Built once per day (or after a geo change) with the full
+// SolarCalculator solution, lookups interpolate linearly in fixed point.
+#define EPHEMERIS_STEP_S 300
+#define EPHEMERIS_SLOTS (86400 / EPHEMERIS_STEP_S + 1)
+
+void ephemerisBuild(int year, int month, int day, double latitude, double longitude);
+void ephemerisInvalidate();
+bool ephemerisValidFor(int year, int month, int day, double latitude, double longitude);
+
+// Interpolated lookup, returns false if no table has been built yet.
+// Results are centidegrees: azimuth 0..35999, altitude -9000..9000.
+bool ephemerisLookup(uint32_t secondsOfDay, int32_t &azimuthCd, int32_t &altitudeCd);
+
+// Convenience for calculateSunPosition(): (re)builds the table on demand
+// and returns the interpolated position in degrees.
+void ephemerisSunPosition(int year, int month, int day, int hour, int minute, int second,
+                          double latitude, double longitude,
+                          double &azimuth, double &altitude);
+
+#endif
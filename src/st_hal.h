@@ -0,0 +1,91 @@
+#ifndef ST_HAL_H
+#define ST_HAL_H
+
+#include <Arduino.h>
+#include <RTClib.h>
+
+// =====================================================
+// HARDWARE ABSTRACTION LAYER
+// =====================================================
+// The only place that touches the LDR ADC, the servos, the DS3231 and
+// mounts the file store. st_hal_esp32.cpp implements it for the board,
+// native/st_hal_native.cpp with host fakes for [env:native].
+// File access itself keeps using the LittleFS API.
+
+// LDR ADC (raw 12 bit readings)
+void halReadLdr(int &tl, int &tr, int &bl, int &br);
+
+// Periodic callback off the loop task (esp_timer on the board), used by
+// the LDR sampler. Shared data needs the HAL critical section.
+bool halStartSampler(void (*tick)(), uint32_t periodUs);
+void halCriticalEnter();
+void halCriticalExit();
+
+// Periodic callback for the servo planner, MOTION_PERIOD_US: hardware
+// timer interrupt waking a task on CONTROL_TASK_CORE on the board (the
+// servo driver is not interrupt safe)
+bool halStartMotion(void (*tick)(), uint32_t periodUs);
+
+// Periodic task for the control step (FreeRTOS task pinned to
+// CONTROL_TASK_CORE on the board). false: no task, caller runs the step.
+bool halStartControlTask(void (*step)(), uint32_t periodMs);
+
+// CPU cycle counter (wraps, use differences) for st_metrics
+uint32_t halCycles();
+uint32_t halCyclesPerUs();
+
+// Microseconds since boot, 64 bit, never wraps or jumps (esp_timer on
+// the board, from the main crystal). Time base of st_clock.
+uint64_t halMonotonicUs();
+
+// Task watchdog (ESP32 TWDT): subscribed tasks must feed it within
+// timeoutMs or the chip resets. AddTask/Feed act on the calling task.
+bool halWatchdogBegin(uint32_t timeoutMs);
+void halWatchdogAddTask();
+void halWatchdogFeed();
+
+// Periodic check off the watched tasks (esp_timer task on the board)
+bool halStartSupervisor(void (*check)(), uint32_t periodMs);
+
+// Why this boot happened, a few bytes that survive a software reset (RTC
+// slow memory, lost on power-off) and the reset itself
+enum HalResetReason
+{
+    HAL_RESET_POWER_ON,
+    HAL_RESET_SOFTWARE,
+    HAL_RESET_WATCHDOG, // task or interrupt watchdog
+    HAL_RESET_PANIC,
+    HAL_RESET_BROWNOUT,
+    HAL_RESET_OTHER
+};
+#define HAL_NOINIT_SIZE 32
+HalResetReason halResetReason();
+uint8_t *halNoinit();
+void halRestart();
+
+// Servos (pulse width in microseconds, angle mapping lives in st_servo)
+void halServoAttach();
+void halServoWriteYawUs(uint16_t pulseUs);
+void halServoWriteTiltUs(uint16_t pulseUs);
+
+// DS3231 clock
+bool halRtcBegin();
+bool halRtcLostPower();
+DateTime halRtcNow();
+void halRtcAdjust(const DateTime &dt);
+
+// File store
+bool halFsBegin();
+
+// Host name lookup without blocking (lwIP DNS with callback on the board;
+// WiFi.hostByName() waits for the answer). Call again with the same host
+// until the result is no longer PENDING. addr is in network byte order.
+enum HalDnsResult
+{
+    HAL_DNS_PENDING,
+    HAL_DNS_OK,
+    HAL_DNS_FAILED
+};
+HalDnsResult halDnsLookup(const char *host, uint32_t &addr);
+
+#endif
@@ -0,0 +1,298 @@
+#include "config.h"
+#include "st_hal.h"
+#include <esp_timer.h>
+#include <esp_task_wdt.h>
+#include <esp_system.h>
+#include <lwip/dns.h>
+#include <lwip/priv/tcpip_priv.h>
+
+// ESP32 backend of the hardware abstraction layer
+
+static Servo servoYaw;
+static Servo servoTilt;
+static RTC_DS3231 rtc;
+static esp_timer_handle_t samplerTimer = nullptr;
+static esp_timer_handle_t supervisorTimer = nullptr;
+RTC_NOINIT_ATTR static uint8_t noinitArea[HAL_NOINIT_SIZE];
+static portMUX_TYPE halMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t controlTask = nullptr;
+static void (*controlStepFn)() = nullptr;
+static uint32_t controlPeriodMs = 0;
+static TaskHandle_t motionTask = nullptr;
+static void (*motionTickFn)() = nullptr;
+static hw_timer_t *motionTimer = nullptr;
+static const uint8_t MOTION_HW_TIMER = 0; // timer group 0, timer 0 (ESP32Servo uses LEDC)
+// One lookup in flight; the callback runs on the tcpip task
+enum DnsState
+{
+    DNS_IDLE,
+    DNS_BUSY,
+    DNS_DONE
+};
+static volatile uint8_t dnsState = DNS_IDLE;
+static volatile uint32_t dnsAddr = 0;
+
+void halReadLdr(int &tl, int &tr, int &bl, int &br)
+{
+    tl = analogRead(LDR_TL_PIN);
+    tr = analogRead(LDR_TR_PIN);
+    bl = analogRead(LDR_BL_PIN);
+    br = analogRead(LDR_BR_PIN);
+}
+
+uint32_t halCycles()
+{
+    return ESP.getCycleCount();
+}
+
+uint32_t halCyclesPerUs()
+{
+    return getCpuFrequencyMhz();
+}
+
+uint64_t halMonotonicUs()
+{
+    return (uint64_t)esp_timer_get_time();
+}
+
+static void timerCallback(void *arg)
+{
+    ((void (*)())arg)();
+}
+
+bool halStartSampler(void (*tick)(), uint32_t periodUs)
+{
+    if (samplerTimer)
+        return true;
+
+    esp_timer_create_args_t args = {};
+    args.callback = timerCallback;
+    args.arg = (void *)tick;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "ldr_sampler";
+    if (esp_timer_create(&args, &samplerTimer) != ESP_OK)
+        return false;
+    return esp_timer_start_periodic(samplerTimer, periodUs) == ESP_OK;
+}
+
+bool halWatchdogBegin(uint32_t timeoutMs)
+{
+    // The TWDT is already running (idle tasks); init reconfigures it
+    return esp_task_wdt_init((timeoutMs + 999) / 1000, true) == ESP_OK;
+}
+
+void halWatchdogAddTask()
+{
+    esp_task_wdt_add(nullptr);
+}
+
+void halWatchdogFeed()
+{
+    esp_task_wdt_reset();
+}
+
+bool halStartSupervisor(void (*check)(), uint32_t periodMs)
+{
+    if (supervisorTimer)
+        return true;
+
+    esp_timer_create_args_t args = {};
+    args.callback = timerCallback;
+    args.arg = (void *)check;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "supervisor";
+    if (esp_timer_create(&args, &supervisorTimer) != ESP_OK)
+        return false;
+    return esp_timer_start_periodic(supervisorTimer, (uint64_t)periodMs * 1000) == ESP_OK;
+}
+
+HalResetReason halResetReason()
+{
+    switch (esp_reset_reason())
+    {
+    case ESP_RST_POWERON:
+        return HAL_RESET_POWER_ON;
+    case ESP_RST_SW:
+        return HAL_RESET_SOFTWARE;
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_INT_WDT:
+    case ESP_RST_WDT:
+        return HAL_RESET_WATCHDOG;
+    case ESP_RST_PANIC:
+        return HAL_RESET_PANIC;
+    case ESP_RST_BROWNOUT:
+        return HAL_RESET_BROWNOUT;
+    default:
+        return HAL_RESET_OTHER;
+    }
+}
+
+uint8_t *halNoinit()
+{
+    return noinitArea;
+}
+
+void halRestart()
+{
+    esp_restart();
+}
+
+// vTaskDelayUntil keeps the period fixed, however long a step took
+static void controlTaskMain(void *arg)
+{
+    TickType_t wake = xTaskGetTickCount();
+    for (;;)
+    {
+        controlStepFn();
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(controlPeriodMs));
+    }
+}
+
+bool halStartControlTask(void (*step)(), uint32_t periodMs)
+{
+    if (controlTask)
+        return true;
+
+    controlStepFn = step;
+    controlPeriodMs = periodMs;
+    return xTaskCreatePinnedToCore(controlTaskMain, "control", CONTROL_TASK_STACK, nullptr,
+                                   CONTROL_TASK_PRIORITY, &controlTask, CONTROL_TASK_CORE) == pdPASS;
+}
+
+// The interrupt only wakes the task, the tick itself runs there
+static void IRAM_ATTR motionTimerIsr()
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(motionTask, &woken);
+    if (woken)
+        portYIELD_FROM_ISR();
+}
+
+static void motionTaskMain(void *arg)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        motionTickFn();
+    }
+}
+
+bool halStartMotion(void (*tick)(), uint32_t periodUs)
+{
+    if (motionTask)
+        return true;
+
+    motionTickFn = tick;
+    if (xTaskCreatePinnedToCore(motionTaskMain, "motion", MOTION_TASK_STACK, nullptr, MOTION_TASK_PRIORITY,
+                                &motionTask, CONTROL_TASK_CORE) != pdPASS)
+        return false;
+
+    // 80 MHz APB / 80 = 1 us per count
+    motionTimer = timerBegin(MOTION_HW_TIMER, 80, true);
+    if (!motionTimer)
+        return false;
+    timerAttachInterrupt(motionTimer, motionTimerIsr, true);
+    timerAlarmWrite(motionTimer, periodUs, true);
+    timerAlarmEnable(motionTimer);
+    return true;
+}
+
+void halCriticalEnter()
+{
+    portENTER_CRITICAL(&halMux);
+}
+
+void halCriticalExit()
+{
+    portEXIT_CRITICAL(&halMux);
+}
+
+void halServoAttach()
+{
+    servoYaw.attach(SERVO_YAW_PIN, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+    servoTilt.attach(SERVO_TILT_PIN, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+}
+
+void halServoWriteYawUs(uint16_t pulseUs)
+{
+    servoYaw.writeMicroseconds(pulseUs);
+}
+
+void halServoWriteTiltUs(uint16_t pulseUs)
+{
+    servoTilt.writeMicroseconds(pulseUs);
+}
+
+bool halRtcBegin()
+{
+    Wire.begin();
+    return rtc.begin();
+}
+
+bool halRtcLostPower()
+{
+    return rtc.lostPower();
+}
+
+DateTime halRtcNow()
+{
+    return rtc.now();
+}
+
+void halRtcAdjust(const DateTime &dt)
+{
+    rtc.adjust(dt);
+}
+
+bool halFsBegin()
+{
+    return LittleFS.begin(true);
+}
+
+static void dnsFound(const char *name, const ip_addr_t *ip, void *arg)
+{
+    (void)name;
+    (void)arg;
+    dnsAddr = ip ? ip4_addr_get_u32(ip_2_ip4(ip)) : 0;
+    dnsState = DNS_DONE;
+}
+
+// lwIP is not thread-safe: the lookup starts on the tcpip task, which also
+// runs dnsFound(), instead of the calling (loop) task
+struct DnsStart
+{
+    tcpip_api_call_data call;
+    const char *host;
+    ip_addr_t ip;
+};
+
+static err_t dnsStartOnTcpip(tcpip_api_call_data *call)
+{
+    DnsStart *start = (DnsStart *)call;
+    return dns_gethostbyname(start->host, &start->ip, dnsFound, nullptr);
+}
+
+HalDnsResult halDnsLookup(const char *host, uint32_t &addr)
+{
+    if (dnsState == DNS_BUSY)
+        return HAL_DNS_PENDING;
+    if (dnsState == DNS_DONE)
+    {
+        // Answer to the lookup started earlier
+        dnsState = DNS_IDLE;
+        addr = dnsAddr;
+        return addr ? HAL_DNS_OK : HAL_DNS_FAILED;
+    }
+
+    DnsStart start = {};
+    start.host = host;
+    dnsState = DNS_BUSY;
+    err_t err = tcpip_api_call(dnsStartOnTcpip, &start.call);
+    if (err == ERR_INPROGRESS)
+        return HAL_DNS_PENDING;
+    dnsState = DNS_IDLE;
+    if (err != ERR_OK)
+        return HAL_DNS_FAILED;
+    addr = ip4_addr_get_u32(ip_2_ip4(&start.ip));
+    return HAL_DNS_OK;
+}
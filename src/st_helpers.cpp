@@ -1,28 +1,20 @@
 #include "st_debug.h"
 #include "config.h"
+#include "st_servo.h"
 #include "st_helpers.h"
+#include "st_history_log.h"
 #include "time_rtc.h"
 
-#define HISTORY_WRITE_MIN_MS (5 * 60 * 1000)
-
 // External references from main.cpp
-extern int historyYaw[];
-extern int historyTilt[];
+extern int32_t historyYaw[];
+extern int32_t historyTilt[];
 extern int historyIndex;
 extern bool haveHistory;
 extern bool littlefsAvailable;
 extern unsigned long lastHistoryWrite;
-extern Servo servoYaw;
-extern Servo servoTilt;
-extern int yawAngle;
-extern int tiltAngle;
-extern uint8_t watchdogHits;
-extern unsigned long lastWatchdogReset;
-extern unsigned long lastAlive;
-extern unsigned long lastRead;
 extern TrackerState trackerState;
 
-void pushHistory(int y, int t, bool forceWrite)
+void pushHistory(int32_t y, int32_t t, bool forceWrite)
 {
     historyYaw[historyIndex] = y;
     historyTilt[historyIndex] = t;
@@ -38,33 +30,25 @@ void pushHistory(int y, int t, bool forceWrite)
     if (!forceWrite && (now - lastHistoryWrite) < HISTORY_WRITE_MIN_MS)
         return;
 
-    File file = LittleFS.open("/history.csv", "a");
-    if (file)
+    HistoryRecord rec = {};
+    rec.yaw = (int16_t)y;
+    rec.tilt = (int16_t)t;
+    rec.state = (uint8_t)trackerState;
+    rec.flags = forceWrite ? HISTORY_FLAG_FORCED : 0;
+    if (timeInitialized)
+    {
+        rec.time = getCurrentTime().unixtime();
+        rec.sunAz = (uint16_t)(degToCd(currentSunAzimuth) % 36000);
+        rec.sunAlt = (int16_t)degToCd(currentSunAltitude);
+        rec.flags |= HISTORY_FLAG_TIME | HISTORY_FLAG_SUN;
+    }
+    else
+    {
+        rec.time = now;
+    }
+
+    if (historyLogPost(rec))
     {
-        String timestamp;
-        if (timeInitialized)
-        {
-            DateTime now = getCurrentTime();
-            char buffer[30];
-            sprintf(buffer, "%04d-%02d-%02d %02d:%02d:%02d",
-                    now.year(), now.month(), now.day(),
-                    now.hour(), now.minute(), now.second());
-            timestamp = String(buffer);
-        }
-        else
-        {
-            timestamp = String(millis());
-        }
-        file.print(timestamp + "," + String(y) + "," + String(t));
-        if (timeInitialized)
-        {
-            file.println("," + String(currentSunAzimuth, 2) + "," + String(currentSunAltitude, 2));
-        }
-        else
-        {
-            file.println(",,");
-        }
-        file.close();
         lastHistoryWrite = now;
     }
 }
@@ -83,33 +67,14 @@ bool isCloudy(int tl, int tr, int bl, int br)
     return (avg < CLOUD_THRESHOLD);
 }
 
-void checkWatchdog()
+// Bitwise: 16 byte history records and one config record are not worth a table
+uint16_t crc16(const uint8_t *data, size_t len, uint16_t crc)
 {
-    unsigned long now = millis();
-    if (now - lastAlive > WATCHDOG_TIMEOUT)
+    while (len--)
     {
-        watchdogHits++;
-
-        if ((now - lastWatchdogReset) > WATCHDOG_RESET_WINDOW_MS)
-        {
-            watchdogHits = 0;
-            lastWatchdogReset = now;
-        }
-
-        if (watchdogHits >= WATCHDOG_MAX_HITS)
-        {
-            DEBUG_PRINTLN("⚠ Watchdog: mehrfach ausgelöst -> System-Neustart");
-            delay(100);
-            ESP.restart();
-        }
-
-        DEBUG_PRINTLN("⚠ Watchdog: Loop hängt -> Grundstellung & Re-Init");
-        yawAngle = 90;
-        tiltAngle = 90;
-        servoYaw.write(yawAngle);
-        servoTilt.write(tiltAngle);
-        trackerState = STATE_INIT;
-        lastAlive = now;
-        lastRead = now;
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
     }
+    return crc;
 }
@@ -1,10 +1,14 @@
 #ifndef ST_HELPERS_H
 #define ST_HELPERS_H
 
-// Helper functions
-void pushHistory(int y, int t, bool forceWrite = false);
+#include <Arduino.h>
+
+// Helper functions (positions in centidegrees)
+void pushHistory(int32_t y, int32_t t, bool forceWrite = false);
 bool isDark(int tl, int tr, int bl, int br);
 bool isCloudy(int tl, int tr, int bl, int br);
-void checkWatchdog();
+
+// CRC-16/CCITT-FALSE; pass the previous result as crc to continue
+uint16_t crc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF);
 
 #endif
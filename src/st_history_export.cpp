@@ -0,0 +1,317 @@
+#include <atomic>
+#include "st_debug.h"
+#include "config.h"
+#include "st_history_export.h"
+#include "st_history_log.h"
+
+struct ExportBucket
+{
+    uint32_t start;
+    uint32_t count;
+    int32_t yawSum, yawMin, yawMax;
+    int32_t tiltSum, tiltMin, tiltMax;
+    int32_t sunAzSum, sunAltSum;
+    uint8_t state;
+    uint8_t flags;
+};
+
+// IDLE -> STARTING (handler) -> RUNNING (rows from loop()) -> FINISHED
+// (filler drains the rest) -> IDLE. A disconnect while RUNNING marks the
+// export ABORTED; loop() then drops it. Handler, filler and disconnect
+// callback all run on the async_tcp task; only loop() runs beside them.
+enum ExportState : uint8_t
+{
+    EXPORT_IDLE,
+    EXPORT_STARTING,
+    EXPORT_RUNNING,
+    EXPORT_FINISHED,
+    EXPORT_ABORTED
+};
+
+// Longest row appendRow() gets (a bucket row)
+static const size_t EXPORT_ROW_MAX = 160;
+
+static std::atomic<uint8_t> exportState(EXPORT_IDLE);
+static std::atomic<uint32_t> exportGeneration(0);
+static bool exportSeekPending = false;
+static HistoryCursor exportCursor;
+static uint32_t exportFrom = 0;
+static uint32_t exportTo = 0;
+static uint32_t exportStep = 0;
+static ExportBucket bucket;
+
+// Single producer (loop()), single consumer (response filler); head and
+// tail only grow, used bytes = head - tail
+static char exportRing[HISTORY_EXPORT_BUFFER];
+static std::atomic<size_t> ringHead(0);
+static std::atomic<size_t> ringTail(0);
+
+bool historyParseTime(const String &s, uint32_t &epoch)
+{
+    const char *p = s.c_str();
+    if (*p == '\0')
+        return false;
+
+    bool digitsOnly = true;
+    for (const char *c = p; *c; c++)
+    {
+        if (!isdigit((unsigned char)*c))
+            digitsOnly = false;
+    }
+    if (digitsOnly)
+    {
+        epoch = strtoul(p, nullptr, 10);
+        return true;
+    }
+
+    int y, mo, d, h = 0, mi = 0, sec = 0;
+    char sep;
+    int n = sscanf(p, "%d-%d-%d%c%d:%d:%d", &y, &mo, &d, &sep, &h, &mi, &sec);
+    if (n != 3 && n < 6)
+        return false;
+    if (n >= 4 && sep != ' ' && sep != 'T')
+        return false;
+    if (y < 2000 || mo < 1 || mo > 12 || d < 1 || d > 31 || h > 23 || mi > 59 || sec > 59)
+        return false;
+    epoch = DateTime(y, mo, d, h, mi, sec).unixtime();
+    return true;
+}
+
+bool historyParseStep(const String &s, uint32_t &seconds)
+{
+    char *end = nullptr;
+    unsigned long v = strtoul(s.c_str(), &end, 10);
+    if (end == s.c_str())
+        return false;
+    switch (*end)
+    {
+    case '\0':
+    case 's':
+        break;
+    case 'm':
+        v *= 60;
+        break;
+    case 'h':
+        v *= 3600;
+        break;
+    case 'd':
+        v *= 86400;
+        break;
+    default:
+        return false;
+    }
+    seconds = (uint32_t)v;
+    return true;
+}
+
+static size_t ringFree()
+{
+    return sizeof(exportRing) - (ringHead.load() - ringTail.load());
+}
+
+// Callers make sure the row fits (ringFree() >= EXPORT_ROW_MAX)
+static void appendRow(const char *row, size_t len)
+{
+    size_t head = ringHead.load();
+    size_t pos = head % sizeof(exportRing);
+    size_t first = min(len, sizeof(exportRing) - pos);
+    memcpy(exportRing + pos, row, first);
+    memcpy(exportRing, row + first, len - first);
+    ringHead.store(head + len);
+}
+
+static void emitBucket()
+{
+    if (bucket.count == 0)
+        return;
+
+    char timestamp[32];
+    historyFormatTimestamp(bucket.start, bucket.flags, timestamp, sizeof(timestamp));
+
+    char row[EXPORT_ROW_MAX];
+    int n;
+    if (bucket.flags & HISTORY_FLAG_SUN)
+    {
+        n = snprintf(row, sizeof(row), "%s,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%s\n",
+                     timestamp, (unsigned long)bucket.count,
+                     bucket.yawSum / 100.0 / bucket.count, bucket.yawMin / 100.0, bucket.yawMax / 100.0,
+                     bucket.tiltSum / 100.0 / bucket.count, bucket.tiltMin / 100.0, bucket.tiltMax / 100.0,
+                     bucket.sunAzSum / 100.0 / bucket.count, bucket.sunAltSum / 100.0 / bucket.count,
+                     historyStateName(bucket.state));
+    }
+    else
+    {
+        n = snprintf(row, sizeof(row), "%s,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,,,%s\n",
+                     timestamp, (unsigned long)bucket.count,
+                     bucket.yawSum / 100.0 / bucket.count, bucket.yawMin / 100.0, bucket.yawMax / 100.0,
+                     bucket.tiltSum / 100.0 / bucket.count, bucket.tiltMin / 100.0, bucket.tiltMax / 100.0,
+                     historyStateName(bucket.state));
+    }
+    if (n > 0 && (size_t)n < sizeof(row))
+        appendRow(row, n);
+    bucket.count = 0;
+}
+
+static void addToBucket(const HistoryRecord &rec)
+{
+    uint32_t start = rec.time - rec.time % exportStep;
+    if (bucket.count > 0 && start != bucket.start)
+        emitBucket();
+
+    if (bucket.count == 0)
+    {
+        bucket.start = start;
+        bucket.yawSum = bucket.tiltSum = bucket.sunAzSum = bucket.sunAltSum = 0;
+        bucket.yawMin = bucket.yawMax = rec.yaw;
+        bucket.tiltMin = bucket.tiltMax = rec.tilt;
+        bucket.flags = HISTORY_FLAG_TIME | HISTORY_FLAG_SUN;
+    }
+    bucket.count++;
+    bucket.yawSum += rec.yaw;
+    bucket.tiltSum += rec.tilt;
+    bucket.yawMin = min(bucket.yawMin, (int32_t)rec.yaw);
+    bucket.yawMax = max(bucket.yawMax, (int32_t)rec.yaw);
+    bucket.tiltMin = min(bucket.tiltMin, (int32_t)rec.tilt);
+    bucket.tiltMax = max(bucket.tiltMax, (int32_t)rec.tilt);
+    bucket.sunAzSum += rec.sunAz;
+    bucket.sunAltSum += rec.sunAlt;
+    bucket.state = rec.state;
+    if (!(rec.flags & HISTORY_FLAG_SUN))
+        bucket.flags &= ~HISTORY_FLAG_SUN;
+}
+
+static void finishExport()
+{
+    emitBucket();
+    uint8_t running = EXPORT_RUNNING;
+    exportState.compare_exchange_strong(running, EXPORT_FINISHED);
+}
+
+// Response filler (async_tcp task): hands out what loop() has produced.
+// The state is read before the ring so rows written before FINISHED are
+// never cut off.
+static size_t exportFill(uint8_t *buffer, size_t maxLen, size_t index)
+{
+    (void)index;
+    uint8_t state = exportState.load();
+    size_t tail = ringTail.load();
+    size_t avail = ringHead.load() - tail;
+    if (avail == 0)
+    {
+        if (state != EXPORT_FINISHED)
+            return RESPONSE_TRY_AGAIN;
+        exportState.store(EXPORT_IDLE);
+        return 0;
+    }
+
+    size_t n = min(avail, maxLen);
+    size_t pos = tail % sizeof(exportRing);
+    size_t first = min(n, sizeof(exportRing) - pos);
+    memcpy(buffer, exportRing + pos, first);
+    memcpy(buffer + first, exportRing, n - first);
+    ringTail.store(tail + n);
+    return n;
+}
+
+// Also called after a completed response; the generation keeps a late
+// callback from aborting the next export
+static void exportDisconnect(uint32_t generation)
+{
+    if (exportGeneration.load() != generation)
+        return;
+    uint8_t state = EXPORT_RUNNING;
+    if (!exportState.compare_exchange_strong(state, EXPORT_ABORTED) && state == EXPORT_FINISHED)
+        exportState.compare_exchange_strong(state, EXPORT_IDLE);
+}
+
+bool historyExportStart(AsyncWebServerRequest *request, uint32_t from, uint32_t to, uint32_t step)
+{
+    uint8_t idle = EXPORT_IDLE;
+    if (!exportState.compare_exchange_strong(idle, EXPORT_STARTING))
+        return false;
+
+    exportFrom = from;
+    exportTo = to;
+    exportStep = step;
+    exportSeekPending = true;
+    bucket.count = 0;
+    ringHead.store(0);
+    ringTail.store(0);
+
+    const char *header = step > 0
+                             ? "Timestamp,Samples,Yaw,YawMin,YawMax,Tilt,TiltMin,TiltMax,SunAzimuth,SunAltitude,State\n"
+                             : HISTORY_CSV_HEADER;
+    appendRow(header, strlen(header));
+
+    uint32_t generation = exportGeneration.load() + 1;
+    exportGeneration.store(generation);
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/csv", exportFill);
+    response->addHeader("Content-Disposition", "attachment; filename=tracking_history.csv");
+    request->onDisconnect([generation]() { exportDisconnect(generation); });
+    exportState.store(EXPORT_RUNNING);
+    request->send(response);
+    return true;
+}
+
+void historyExportPoll()
+{
+    uint8_t state = exportState.load();
+    if (state == EXPORT_ABORTED)
+    {
+        DEBUG_PRINTLN("History-Export abgebrochen (Client getrennt).");
+        exportState.store(EXPORT_IDLE);
+        return;
+    }
+    if (state != EXPORT_RUNNING)
+        return;
+
+    if (exportSeekPending)
+    {
+        historyLogSeek(exportCursor, exportFrom);
+        exportSeekPending = false;
+    }
+
+    // A window or buckets need RTC time; rows logged without it are skipped
+    bool needTime = exportFrom > 0 || exportTo > 0 || exportStep > 0;
+
+    HistoryRecord rec;
+    for (uint16_t i = 0; i < HISTORY_EXPORT_RECORDS_PER_POLL; i++)
+    {
+        // Slow client: wait until the filler has made room
+        if (ringFree() < EXPORT_ROW_MAX)
+            return;
+
+        if (!historyLogNext(exportCursor, rec))
+        {
+            finishExport();
+            return;
+        }
+
+        if (needTime && !(rec.flags & HISTORY_FLAG_TIME))
+            continue;
+        if (rec.time < exportFrom)
+            continue;
+        if (exportTo > 0 && rec.time > exportTo)
+        {
+            finishExport();
+            return;
+        }
+
+        if (exportStep > 0)
+        {
+            addToBucket(rec);
+        }
+        else
+        {
+            char row[96];
+            size_t n = historyFormatCsv(rec, row, sizeof(row));
+            if (n > 0)
+                appendRow(row, n);
+        }
+    }
+}
+
+bool historyExportBusy()
+{
+    return exportState.load() != EXPORT_IDLE;
+}
@@ -0,0 +1,32 @@
+#ifndef ST_HISTORY_EXPORT_H
+#define ST_HISTORY_EXPORT_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// =====================================================
+// /history EXPORT
+// =====================================================
+// handleHistory() only validates the query; historyExportStart() answers
+// with a chunked response. Rows are produced by historyExportPoll() from
+// loop() - at most HISTORY_EXPORT_RECORDS_PER_POLL log records per pass -
+// into a byte ring that the response filler drains on the async_tcp
+// task. Flash reads stay in loop(), the server never waits on them, and
+// a month-long export does not hold up tracking or the watchdog.
+//
+// from/to select a window (epoch seconds, RTC local time as stored);
+// step > 0 merges each step-long bucket into one row with avg/min/max.
+
+#define HISTORY_EXPORT_BUFFER 2048 // ring between loop() and the response filler
+
+// Accepts epoch seconds, "YYYY-MM-DD" or "YYYY-MM-DD[ T]HH:MM[:SS]"
+bool historyParseTime(const String &s, uint32_t &epoch);
+// Accepts seconds or a number with s/m/h/d suffix ("15m", "1h")
+bool historyParseStep(const String &s, uint32_t &seconds);
+
+// to = 0: open end. Sends the response; fails if an export is already running.
+bool historyExportStart(AsyncWebServerRequest *request, uint32_t from, uint32_t to, uint32_t step);
+void historyExportPoll();
+bool historyExportBusy();
+
+#endif
@@ -0,0 +1,470 @@
+#include <atomic>
+#include <RTClib.h>
+#include "st_debug.h"
+#include "config.h"
+#include "st_history_log.h"
+#include "st_helpers.h"
+#include "st_servo.h"
+#include "st_supervisor.h"
+#include "tracker_state.h"
+
+static_assert(sizeof(HistoryRecord) == HISTORY_LOG_RECORD_SIZE, "HistoryRecord must stay packed to 16 bytes");
+
+// Log of the firmware before the ring, imported once
+static const char *HISTORY_CSV_LEGACY_PATH = "/history.csv";
+static const uint32_t HISTORY_LOG_MAGIC = 0x4C485453; // "STHL"
+
+const char HISTORY_CSV_HEADER[] = "Timestamp,Yaw,Tilt,SunAzimuth,SunAltitude,State\n";
+
+struct SectorHeader
+{
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t recordSize;
+    uint16_t recordsPerSector;
+    uint16_t reserved;
+    uint16_t check;
+};
+
+static_assert(sizeof(SectorHeader) == HISTORY_LOG_HEADER_SIZE, "SectorHeader must be 16 bytes");
+
+static File headFile; // head sector, only ever appended
+static File readFile; // sector being read
+static int32_t readSlot = -1;
+static uint32_t readAppends = 0;
+static uint32_t appends = 0; // head appends, a read handle older than that reopens
+static bool logOpen = false;
+static uint32_t headSeq = 0;
+static uint16_t headCount = 0;
+
+static HistoryRecord queue[HISTORY_QUEUE_SIZE];
+static std::atomic<uint8_t> queueHead(0); // written by the producer
+static std::atomic<uint8_t> queueTail(0); // written by the consumer
+
+static uint16_t recordCheck(const HistoryRecord &rec, uint32_t seq)
+{
+    return crc16((const uint8_t *)&rec, offsetof(HistoryRecord, check)) ^ (uint16_t)seq;
+}
+
+void historyLogPath(uint32_t slot, char *buf, size_t len)
+{
+    snprintf(buf, len, "/history_%02lu.bin", (unsigned long)slot);
+}
+
+static uint32_t recordOffset(uint16_t index)
+{
+    return HISTORY_LOG_HEADER_SIZE + (uint32_t)index * HISTORY_LOG_RECORD_SIZE;
+}
+
+// The head sector is written through its own handle; a read handle only
+// sees what was flushed before it was opened
+static bool readAt(uint32_t slot, uint32_t offset, void *buf, size_t len)
+{
+    bool head = logOpen && slot == headSeq % HISTORY_LOG_SECTORS;
+    if ((int32_t)slot != readSlot || (head && readAppends != appends))
+    {
+        readFile.close();
+        readSlot = -1;
+        char path[24];
+        historyLogPath(slot, path, sizeof(path));
+        if (!LittleFS.exists(path))
+            return false;
+        readFile = LittleFS.open(path, "r");
+        if (!readFile)
+            return false;
+        readSlot = slot;
+        readAppends = appends;
+    }
+    return readFile.seek(offset) && readFile.read((uint8_t *)buf, len) == len;
+}
+
+static bool readHeader(uint32_t slot, SectorHeader &h)
+{
+    if (!readAt(slot, 0, &h, sizeof(h)))
+        return false;
+    return h.magic == HISTORY_LOG_MAGIC &&
+           h.recordSize == HISTORY_LOG_RECORD_SIZE &&
+           h.recordsPerSector == HISTORY_LOG_RECORDS_PER_SECTOR &&
+           h.seq % HISTORY_LOG_SECTORS == slot &&
+           h.check == crc16((const uint8_t *)&h, offsetof(SectorHeader, check));
+}
+
+static bool readRecord(uint32_t seq, uint16_t index, HistoryRecord &rec)
+{
+    return readAt(seq % HISTORY_LOG_SECTORS, recordOffset(index), &rec, sizeof(rec)) &&
+           rec.check == recordCheck(rec, seq);
+}
+
+// Truncates the sector's file (LittleFS frees its blocks, nothing is
+// copied) and writes the header
+static bool startSector(uint32_t seq)
+{
+    headFile.close();
+    if (readSlot == (int32_t)(seq % HISTORY_LOG_SECTORS))
+    {
+        readFile.close();
+        readSlot = -1;
+    }
+
+    char path[24];
+    historyLogPath(seq % HISTORY_LOG_SECTORS, path, sizeof(path));
+    headFile = LittleFS.open(path, "w");
+    if (!headFile)
+        return false;
+
+    SectorHeader h = {HISTORY_LOG_MAGIC, seq, HISTORY_LOG_RECORD_SIZE, HISTORY_LOG_RECORDS_PER_SECTOR, 0, 0};
+    h.check = crc16((const uint8_t *)&h, offsetof(SectorHeader, check));
+    if (headFile.write((const uint8_t *)&h, sizeof(h)) != sizeof(h))
+        return false;
+    headFile.flush();
+    headSeq = seq;
+    headCount = 0;
+    appends++;
+    return true;
+}
+
+static bool append(const HistoryRecord &rec, bool flush)
+{
+    if (headCount >= HISTORY_LOG_RECORDS_PER_SECTOR && !startSector(headSeq + 1))
+        return false;
+
+    HistoryRecord r = rec;
+    r.check = recordCheck(r, headSeq);
+    if (headFile.write((const uint8_t *)&r, sizeof(r)) != sizeof(r))
+        return false;
+    if (flush)
+        headFile.flush();
+    headCount++;
+    appends++;
+    return true;
+}
+
+// One row of the former /history.csv:
+//   YYYY-MM-DD hh:mm:ss,yaw,tilt,az,alt   (degrees)
+//   millis,yaw,tilt,,                     (no valid time yet)
+// The state was not logged.
+static bool parseCsvRow(const char *line, HistoryRecord &rec)
+{
+    rec = HistoryRecord();
+    int year, month, day, hour, minute, second;
+    int used = 0;
+    if (sscanf(line, "%d-%d-%d %d:%d:%d,%n", &year, &month, &day, &hour, &minute, &second, &used) == 6 && used > 0)
+    {
+        rec.time = DateTime(year, month, day, hour, minute, second).unixtime();
+        rec.flags = HISTORY_FLAG_TIME;
+    }
+    else
+    {
+        unsigned long ms;
+        if (sscanf(line, "%lu,%n", &ms, &used) != 1 || used == 0)
+            return false;
+        rec.time = ms;
+    }
+    line += used;
+
+    float yaw, tilt, az, alt;
+    if (sscanf(line, "%f,%f%n", &yaw, &tilt, &used) != 2)
+        return false;
+    rec.yaw = (int16_t)clampYawCd(degToCd(yaw));
+    rec.tilt = (int16_t)clampTiltCd(degToCd(tilt));
+    if (sscanf(line + used, ",%f,%f", &az, &alt) == 2)
+    {
+        rec.sunAz = (uint16_t)((degToCd(az) % 36000 + 36000) % 36000);
+        rec.sunAlt = (int16_t)degToCd(alt);
+        rec.flags |= HISTORY_FLAG_SUN;
+    }
+    rec.state = STATE_TRACKING;
+    return true;
+}
+
+// The newest rows that fit the ring, oldest first, then the CSV goes.
+// Reads the file twice (count, then import); an unbounded CSV may take
+// seconds, so each chunk counts as storage progress for the supervisor.
+static void importCsv()
+{
+    File csv = LittleFS.open(HISTORY_CSV_LEGACY_PATH, "r");
+    if (!csv)
+        return;
+
+    uint8_t chunk[256];
+    size_t n;
+    uint32_t rows = 0;
+    while ((n = csv.read(chunk, sizeof(chunk))) > 0)
+    {
+        supervisorBusy(SUPERVISOR_STORAGE);
+        for (size_t i = 0; i < n; i++)
+            rows += chunk[i] == '\n';
+    }
+    uint32_t skip = rows > historyLogCapacity() ? rows - historyLogCapacity() : 0;
+
+    char line[96];
+    size_t len = 0;
+    uint32_t row = 0;
+    uint32_t moved = 0;
+    csv.seek(0);
+    while ((n = csv.read(chunk, sizeof(chunk))) > 0)
+    {
+        supervisorBusy(SUPERVISOR_STORAGE);
+        for (size_t i = 0; i < n; i++)
+        {
+            if (chunk[i] != '\n')
+            {
+                if (len < sizeof(line) - 1)
+                    line[len++] = chunk[i];
+                continue;
+            }
+            line[len] = '\0';
+            len = 0;
+            HistoryRecord rec;
+            if (row++ >= skip && parseCsvRow(line, rec) && append(rec, false))
+                moved++;
+        }
+    }
+    headFile.flush();
+    csv.close();
+    LittleFS.remove(HISTORY_CSV_LEGACY_PATH);
+    DEBUG_PRINTF("history.csv: %lu Eintraege uebernommen\n", (unsigned long)moved);
+}
+
+bool historyLogBegin()
+{
+    if (logOpen)
+        return true;
+
+    // The CSV goes only once it is imported: sectors next to it are from
+    // an import cut short by a reset, which starts over
+    bool importing = LittleFS.exists(HISTORY_CSV_LEGACY_PATH);
+    if (importing)
+        historyLogRemove();
+
+    // Head = valid sector with the highest sequence number
+    bool found = false;
+    for (uint32_t s = 0; s < HISTORY_LOG_SECTORS; s++)
+    {
+        SectorHeader h;
+        if (readHeader(s, h) && (!found || h.seq > headSeq))
+        {
+            headSeq = h.seq;
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        if (!startSector(0))
+        {
+            DEBUG_PRINTLN("⚠ history_00.bin konnte nicht angelegt werden!");
+            return false;
+        }
+        logOpen = true;
+        if (importing)
+            importCsv();
+        return true;
+    }
+
+    HistoryRecord rec;
+    headCount = 0;
+    while (headCount < HISTORY_LOG_RECORDS_PER_SECTOR && readRecord(headSeq, headCount, rec))
+        headCount++;
+    readFile.close();
+    readSlot = -1;
+
+    // Appends continue at the end of the file; a torn record there would
+    // shift every later one, so the next sector starts instead
+    char path[24];
+    historyLogPath(headSeq % HISTORY_LOG_SECTORS, path, sizeof(path));
+    headFile = LittleFS.open(path, "a");
+    if (!headFile)
+        return false;
+    if (headFile.size() != recordOffset(headCount) && !startSector(headSeq + 1))
+        return false;
+
+    logOpen = true;
+    DEBUG_PRINTF("history: %lu Eintraege\n", (unsigned long)historyLogCount());
+    return true;
+}
+
+void historyLogEnd()
+{
+    headFile.close();
+    readFile.close();
+    readSlot = -1;
+    logOpen = false;
+}
+
+void historyLogRemove()
+{
+    historyLogEnd();
+    char path[24];
+    for (uint32_t s = 0; s < HISTORY_LOG_SECTORS; s++)
+    {
+        historyLogPath(s, path, sizeof(path));
+        LittleFS.remove(path);
+    }
+}
+
+bool historyLogAppend(const HistoryRecord &rec)
+{
+    if (!logOpen)
+        return false;
+    return append(rec, true);
+}
+
+bool historyLogPost(const HistoryRecord &rec)
+{
+    uint8_t head = queueHead.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) % HISTORY_QUEUE_SIZE;
+    if (next == queueTail.load(std::memory_order_acquire))
+        return false;
+    queue[head] = rec;
+    queueHead.store(next, std::memory_order_release);
+    return true;
+}
+
+void historyLogService()
+{
+    uint8_t tail = queueTail.load(std::memory_order_relaxed);
+    while (tail != queueHead.load(std::memory_order_acquire))
+    {
+        historyLogAppend(queue[tail]);
+        tail = (tail + 1) % HISTORY_QUEUE_SIZE;
+        queueTail.store(tail, std::memory_order_release);
+    }
+}
+
+bool historyLogLast(HistoryRecord &rec)
+{
+    if (!logOpen)
+        return false;
+    if (headCount > 0)
+        return readRecord(headSeq, headCount - 1, rec);
+    // Fresh head sector: the newest record ends the previous one (which
+    // may have been closed early after a torn write)
+    for (int i = HISTORY_LOG_RECORDS_PER_SECTOR - 1; headSeq > 0 && i >= 0; i--)
+    {
+        if (readRecord(headSeq - 1, i, rec))
+            return true;
+    }
+    return false;
+}
+
+uint32_t historyLogCount()
+{
+    if (!logOpen)
+        return 0;
+    uint32_t olderSectors = headSeq < HISTORY_LOG_SECTORS - 1 ? headSeq : HISTORY_LOG_SECTORS - 1;
+    return olderSectors * HISTORY_LOG_RECORDS_PER_SECTOR + headCount;
+}
+
+uint32_t historyLogCapacity()
+{
+    return HISTORY_LOG_SECTORS * HISTORY_LOG_RECORDS_PER_SECTOR;
+}
+
+void historyLogRewind(HistoryCursor &cursor)
+{
+    cursor.seq = headSeq >= HISTORY_LOG_SECTORS - 1 ? headSeq - (HISTORY_LOG_SECTORS - 1) : 0;
+    cursor.index = 0;
+    cursor.checkedSeq = UINT32_MAX;
+}
+
+void historyLogSeek(HistoryCursor &cursor, uint32_t from)
+{
+    historyLogRewind(cursor);
+    if (!logOpen)
+        return;
+
+    // Next sector starts at or before `from`: nothing in this one is wanted
+    while (cursor.seq < headSeq)
+    {
+        uint32_t next = cursor.seq + 1;
+        SectorHeader h;
+        HistoryRecord first;
+        if (!readHeader(next % HISTORY_LOG_SECTORS, h) || h.seq != next ||
+            !readRecord(next, 0, first) || !(first.flags & HISTORY_FLAG_TIME) || first.time > from)
+            break;
+        cursor.seq = next;
+    }
+}
+
+bool historyLogNext(HistoryCursor &cursor, HistoryRecord &rec)
+{
+    if (!logOpen)
+        return false;
+
+    // Overwritten since the cursor was positioned: continue at the oldest
+    if (headSeq >= HISTORY_LOG_SECTORS && cursor.seq < headSeq - (HISTORY_LOG_SECTORS - 1))
+    {
+        cursor.seq = headSeq - (HISTORY_LOG_SECTORS - 1);
+        cursor.index = 0;
+    }
+
+    while (cursor.seq <= headSeq)
+    {
+        uint16_t end = cursor.seq == headSeq ? headCount : HISTORY_LOG_RECORDS_PER_SECTOR;
+        if (cursor.index < end)
+        {
+            if (cursor.checkedSeq != cursor.seq)
+            {
+                SectorHeader h;
+                if (!readHeader(cursor.seq % HISTORY_LOG_SECTORS, h) || h.seq != cursor.seq)
+                {
+                    cursor.seq++;
+                    cursor.index = 0;
+                    continue;
+                }
+                cursor.checkedSeq = cursor.seq;
+            }
+
+            if (readRecord(cursor.seq, cursor.index, rec))
+            {
+                cursor.index++;
+                return true;
+            }
+        }
+
+        if (cursor.seq == headSeq)
+            return false;
+        cursor.seq++;
+        cursor.index = 0;
+    }
+    return false;
+}
+
+const char *historyStateName(uint8_t state)
+{
+    return trackerStateName(state);
+}
+
+void historyFormatTimestamp(uint32_t time, uint8_t flags, char *buf, size_t len)
+{
+    if (flags & HISTORY_FLAG_TIME)
+    {
+        DateTime t(time);
+        snprintf(buf, len, "%04d-%02d-%02d %02d:%02d:%02d",
+                 t.year(), t.month(), t.day(), t.hour(), t.minute(), t.second());
+    }
+    else
+    {
+        snprintf(buf, len, "%lu", (unsigned long)time);
+    }
+}
+
+size_t historyFormatCsv(const HistoryRecord &rec, char *buf, size_t len)
+{
+    const char *state = historyStateName(rec.state);
+    char timestamp[32];
+    historyFormatTimestamp(rec.time, rec.flags, timestamp, sizeof(timestamp));
+
+    int n;
+    if (rec.flags & HISTORY_FLAG_SUN)
+    {
+        n = snprintf(buf, len, "%s,%.2f,%.2f,%.2f,%.2f,%s\n", timestamp,
+                     rec.yaw / 100.0, rec.tilt / 100.0, rec.sunAz / 100.0, rec.sunAlt / 100.0, state);
+    }
+    else
+    {
+        n = snprintf(buf, len, "%s,%.2f,%.2f,,,%s\n", timestamp, rec.yaw / 100.0, rec.tilt / 100.0, state);
+    }
+    return (n > 0 && (size_t)n < len) ? (size_t)n : 0;
+}
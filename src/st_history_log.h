@@ -0,0 +1,90 @@
+#ifndef ST_HISTORY_LOG_H
+#define ST_HISTORY_LOG_H
+
+#include <Arduino.h>
+
+// =====================================================
+// BINARY HISTORY LOG
+// =====================================================
+// Ring of HISTORY_LOG_SECTORS sector files /history_NN.bin of at most
+// one LittleFS block (4 KiB) each: a 16 byte header followed by packed
+// 16 byte records. Sectors are reused strictly round robin (file
+// NN = seq % HISTORY_LOG_SECTORS).
+//
+// A file is only ever appended at its end, and reused by truncating it.
+// LittleFS keeps files as CTZ skip-lists: a flushed write in the middle
+// of a file copies every block behind it, an append only the last
+// (partial) block. So one record costs one block program however large
+// the ring is. A record's check word is CRC-16 of its payload XOR the
+// sector sequence.
+//
+// CSV is only produced when /history is requested (historyFormatCsv).
+
+#define HISTORY_LOG_SECTOR_SIZE 4096
+#define HISTORY_LOG_HEADER_SIZE 16
+#define HISTORY_LOG_RECORD_SIZE 16
+#define HISTORY_LOG_RECORDS_PER_SECTOR ((HISTORY_LOG_SECTOR_SIZE - HISTORY_LOG_HEADER_SIZE) / HISTORY_LOG_RECORD_SIZE)
+
+// Record flags
+#define HISTORY_FLAG_TIME 0x01   // time is epoch seconds (RTC), else millis()
+#define HISTORY_FLAG_SUN 0x02    // sun position valid
+#define HISTORY_FLAG_FORCED 0x04 // state change / calibration, not rate limited
+
+struct HistoryRecord
+{
+    uint32_t time;   // epoch seconds (RTC local time) or millis()
+    int16_t yaw;     // centidegrees
+    int16_t tilt;    // centidegrees
+    uint16_t sunAz;  // centidegrees 0..35999
+    int16_t sunAlt;  // centidegrees
+    uint8_t state;   // TrackerState
+    uint8_t flags;   // HISTORY_FLAG_*
+    uint16_t check;  // CRC-16 of the bytes above ^ sector seq
+};
+
+// Read position, stays valid while the log keeps growing: records that
+// get overwritten underneath are skipped.
+struct HistoryCursor
+{
+    uint32_t seq;        // sector sequence number
+    uint16_t index;      // record inside the sector
+    uint32_t checkedSeq; // header already validated for this seq
+};
+
+// Finds the head by scanning the sector headers; starts sector 0 on an
+// empty file system. The /history.csv of earlier firmware is imported
+// into a fresh ring (newest historyLogCapacity() rows), then removed.
+bool historyLogBegin();
+void historyLogEnd();
+// Closes the log and deletes every sector file
+void historyLogRemove();
+void historyLogPath(uint32_t slot, char *buf, size_t len);
+bool historyLogAppend(const HistoryRecord &rec);
+
+// The control task does not write flash: it posts records into a small
+// single-producer/single-consumer queue, loop() appends them.
+#define HISTORY_QUEUE_SIZE 8
+bool historyLogPost(const HistoryRecord &rec); // false if the queue is full
+void historyLogService();
+
+// Newest record on flash (queued ones not yet appended are not seen)
+bool historyLogLast(HistoryRecord &rec);
+
+uint32_t historyLogCount();
+uint32_t historyLogCapacity();
+
+void historyLogRewind(HistoryCursor &cursor);
+// Rewind, then skip whole sectors that end before epoch time `from`
+// (records are appended in time order); O(sectors), not O(records).
+void historyLogSeek(HistoryCursor &cursor, uint32_t from);
+bool historyLogNext(HistoryCursor &cursor, HistoryRecord &rec);
+
+// "Timestamp,Yaw,Tilt,SunAzimuth,SunAltitude,State" row with newline;
+// returns the length written (0 if it does not fit).
+size_t historyFormatCsv(const HistoryRecord &rec, char *buf, size_t len);
+// "YYYY-MM-DD hh:mm:ss" for HISTORY_FLAG_TIME, millis() otherwise
+void historyFormatTimestamp(uint32_t time, uint8_t flags, char *buf, size_t len);
+const char *historyStateName(uint8_t state);
+extern const char HISTORY_CSV_HEADER[];
+
+#endif
@@ -1,80 +1,190 @@
 #include "st_debug.h"
 #include "st_init.h"
 #include "config.h"
+#include "st_hal.h"
+#include "st_servo.h"
+#include "st_motion.h"
+#include "st_sensors.h"
+#include "st_controller.h"
+#include "st_history_log.h"
+#include "st_backtrack.h"
 #include "time_rtc.h"
 #include "st_calibration.h"
 #include "st_helpers.h"
 
 // External references from main.cpp
-extern Servo servoYaw;
-extern Servo servoTilt;
-extern int yawAngle;
-extern int tiltAngle;
+extern int32_t yawAngle;
+extern int32_t tiltAngle;
 extern TrackerState trackerState;
-extern unsigned long lastAlive;
+extern bool littlefsAvailable;
+
+static unsigned long bootStartMs = 0;
+static BootInfo boot = {false, 0, BOOT_POINT_CALIBRATION, 0};
+
+void bootBegin()
+{
+    bootStartMs = millis();
+    halCriticalEnter();
+    boot = {false, 0, BOOT_POINT_CALIBRATION, 0};
+    halCriticalExit();
+}
+
+// Newest record on flash, written while tracking with the sun up; its
+// age needs the RTC (time stamps are local epoch seconds)
+static bool recentWithSun(const HistoryRecord &rec, uint32_t &ageS)
+{
+    const uint8_t need = HISTORY_FLAG_TIME | HISTORY_FLAG_SUN;
+    if ((rec.flags & need) != need || rec.sunAlt <= 0)
+        return false;
+    uint32_t now = getCurrentTime().unixtime();
+    if (now < rec.time || now - rec.time > BOOT_RESUME_MAX_AGE_S)
+        return false;
+    ageS = now - rec.time;
+    return true;
+}
+
+// The planner starts from where the servos were left: the newest record,
+// else the calibration position. False without a record.
+static bool assumeLastPose(HistoryRecord &last)
+{
+    int32_t calibYaw = 9000;
+    int32_t calibTilt = 9000;
+    loadCalibrationData(calibYaw, calibTilt);
+    bool haveLast = littlefsAvailable && historyLogLast(last);
+    motionAssume(haveLast ? last.yaw : calibYaw, haveLast ? last.tilt : calibTilt);
+    return haveLast;
+}
+
+void bootAssumePose()
+{
+    HistoryRecord last;
+    assumeLastPose(last);
+}
 
 void doStartInit()
 {
     DEBUG_PRINTLN("Starte Initialisierung...");
 
-    int calibYaw = 90;
-    int calibTilt = 90;
+    int32_t calibYaw = 9000;
+    int32_t calibTilt = 9000;
     loadCalibrationData(calibYaw, calibTilt);
+    controllerReset();
 
     updateTime();
-
     if (timeInitialized)
     {
         calculateSunPosition();
+    }
+    bool sunUp = timeInitialized && currentSunAltitude > 0;
 
-        if (currentSunAltitude > 0)
-        {
-            yawAngle = targetYawFromSun;
-            tiltAngle = targetTiltFromSun;
-            DEBUG_PRINT("Smart Start -> Sonnenposition: Azimut=");
-            DEBUG_PRINT(currentSunAzimuth);
-            DEBUG_PRINT("° Altitude=");
-            DEBUG_PRINT(currentSunAltitude);
-            DEBUG_PRINT("° -> Yaw=");
-            DEBUG_PRINT(yawAngle);
-            DEBUG_PRINT("° Tilt=");
-            DEBUG_PRINTLN(tiltAngle);
-        }
-        else
-        {
-            yawAngle = calibYaw;
-            tiltAngle = calibTilt;
-            DEBUG_PRINTLN("Sonne unter Horizont -> Verwende kalibrierte Position");
-        }
+    // The newest record is also where the servos were left
+    HistoryRecord last;
+    bool haveLast = assumeLastPose(last);
+    bool haveRecord = haveLast && last.state == STATE_TRACKING;
+    BootPointing pointing;
+    uint32_t ageS = 0;
+
+    if (sunUp && haveRecord && recentWithSun(last, ageS))
+    {
+        // Pointing minus sun target back then is the controller's learned
+        // offset; the sun target is recomputed for the record's sun
+        int32_t sunYaw = targetYawFromSun;
+        int32_t sunTilt = targetTiltFromSun;
+        float aim;
+        backtrackAim(cdToDeg(last.sunAz), cdToDeg(last.sunAlt), aim);
+        sunPositionToServoAngles(cdToDeg(last.sunAz), aim);
+        controllerSeed(cdToDeg(last.yaw - targetYawFromSun), cdToDeg(last.tilt - targetTiltFromSun));
+        targetYawFromSun = sunYaw;
+        targetTiltFromSun = sunTilt;
+
+        yawAngle = clampYawCd(sunYaw + degToCd(controllerYaw().offset));
+        tiltAngle = clampTiltCd(sunTilt + degToCd(controllerTilt().offset));
+        pointing = BOOT_POINT_RESUME_SUN;
+        DEBUG_PRINT("Schnellstart -> letzte Ausrichtung (");
+        DEBUG_PRINT(ageS);
+        DEBUG_PRINT(" s alt) mit Sonne nachgefuehrt, Offset Yaw=");
+        DEBUG_PRINT(controllerYaw().offset);
+        DEBUG_PRINT("° Tilt=");
+        DEBUG_PRINT(controllerTilt().offset);
+        DEBUG_PRINTLN("°");
+    }
+    else if (!timeInitialized && haveRecord)
+    {
+        yawAngle = clampYawCd(last.yaw);
+        tiltAngle = clampTiltCd(last.tilt);
+        pointing = BOOT_POINT_RESUME;
+        DEBUG_PRINTLN("Zeit nicht verfügbar -> Verwende letzte Ausrichtung");
+    }
+    else if (sunUp)
+    {
+        yawAngle = targetYawFromSun;
+        tiltAngle = targetTiltFromSun;
+        pointing = BOOT_POINT_SUN;
+        DEBUG_PRINT("Smart Start -> Sonnenposition: Azimut=");
+        DEBUG_PRINT(currentSunAzimuth);
+        DEBUG_PRINT("° Altitude=");
+        DEBUG_PRINT(currentSunAltitude);
+        DEBUG_PRINT("° -> Yaw=");
+        DEBUG_PRINT(cdToDeg(yawAngle));
+        DEBUG_PRINT("° Tilt=");
+        DEBUG_PRINTLN(cdToDeg(tiltAngle));
     }
     else
     {
         yawAngle = calibYaw;
         tiltAngle = calibTilt;
-        DEBUG_PRINTLN("Zeit nicht verfügbar -> Verwende kalibrierte Position");
+        pointing = BOOT_POINT_CALIBRATION;
+        if (timeInitialized)
+        {
+            DEBUG_PRINTLN("Sonne unter Horizont -> Verwende kalibrierte Position");
+        }
+        else
+        {
+            DEBUG_PRINTLN("Zeit nicht verfügbar -> Verwende kalibrierte Position");
+        }
     }
 
-    servoYaw.write(yawAngle);
-    servoTilt.write(tiltAngle);
-    delay(300);
+    // No settle wait: the planner moves there from the assumed pose, the
+    // LDR averages restart and the first controller steps sit in the dead
+    // band until they are full
+    motionMoveTo(yawAngle, tiltAngle);
+    sensorsFlush();
 
-    int tl = analogRead(LDR_TL_PIN);
-    int tr = analogRead(LDR_TR_PIN);
-    int bl = analogRead(LDR_BL_PIN);
-    int br = analogRead(LDR_BR_PIN);
+    // Recorded as TRACKING, so the next boot can resume from this pose;
+    // forced, the rate limit would drop it this early after boot
+    trackerState = STATE_TRACKING;
+    pushHistory(yawAngle, tiltAngle, true);
 
-    DEBUG_PRINT("Initial LDR: ");
-    DEBUG_PRINT(tl);
-    DEBUG_PRINT(" ");
-    DEBUG_PRINT(tr);
-    DEBUG_PRINT(" ");
-    DEBUG_PRINT(bl);
-    DEBUG_PRINT(" ");
-    DEBUG_PRINTLN(br);
+    halCriticalEnter();
+    if (!boot.tracking)
+    {
+        boot.tracking = true;
+        boot.firstTrackMs = millis() - bootStartMs;
+        boot.pointing = pointing;
+        boot.recordAgeS = ageS;
+    }
+    halCriticalExit();
+    DEBUG_PRINTLN("Init fertig -> TRACKING.");
+}
 
-    pushHistory(yawAngle, tiltAngle);
-    lastAlive = millis();
+void bootRead(BootInfo &info)
+{
+    halCriticalEnter();
+    info = boot;
+    halCriticalExit();
+}
 
-    trackerState = STATE_TRACKING;
-    DEBUG_PRINTLN("Init fertig -> TRACKING.");
+const char *bootPointingName(BootPointing p)
+{
+    switch (p)
+    {
+    case BOOT_POINT_SUN:
+        return "sun";
+    case BOOT_POINT_RESUME:
+        return "resume";
+    case BOOT_POINT_RESUME_SUN:
+        return "resume+sun";
+    default:
+        return "calibration";
+    }
 }
@@ -1,7 +1,43 @@
 #ifndef ST_INIT_H
 #define ST_INIT_H
 
-// Initialization function
+#include <Arduino.h>
+
+// =====================================================
+// START / FAST BOOT
+// =====================================================
+// doStartInit() picks the first pointing from what is already on the
+// board, nothing waits for sensors or the network:
+//   - the newest history record, if it was written while tracking: its
+//     offset to the sun target of that moment (what the controller had
+//     learned) is applied to the sun target now and seeds the controller
+//   - without time the record's pointing as it was
+//   - else the sun target from the RTC, else the calibration position
+// setup() runs it before WLAN, NTP and the web server come up, so the
+// tracker is in STATE_TRACKING a few hundred ms after reset.
+
+enum BootPointing
+{
+    BOOT_POINT_CALIBRATION, // no time, no usable record
+    BOOT_POINT_SUN,         // sun target from the RTC
+    BOOT_POINT_RESUME,      // last record, time unknown: as it was
+    BOOT_POINT_RESUME_SUN   // last record, moved along with the sun
+};
+
+struct BootInfo
+{
+    bool tracking;         // STATE_TRACKING reached since setup()
+    uint32_t firstTrackMs; // setup() start -> STATE_TRACKING
+    BootPointing pointing;
+    uint32_t recordAgeS;   // age of the resumed record (RESUME_SUN)
+};
+
+void bootBegin(); // first thing in setup()
 void doStartInit();
+// Only the pose the servos were left in, for the motion planner; setup()
+// when a calibration search resumes instead of doStartInit()
+void bootAssumePose();
+void bootRead(BootInfo &info);
+const char *bootPointingName(BootPointing p);
 
 #endif
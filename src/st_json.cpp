@@ -0,0 +1,226 @@
+#include "st_json.h"
+
+static void put(JsonWriter &w, char c)
+{
+    // Keep one byte for the terminator
+    if (w.len + 1 >= w.cap)
+    {
+        w.overflow = true;
+        return;
+    }
+    w.buf[w.len++] = c;
+    w.buf[w.len] = '\0';
+}
+
+static void putRaw(JsonWriter &w, const char *s)
+{
+    while (*s && !w.overflow)
+        put(w, *s++);
+}
+
+static void putEscaped(JsonWriter &w, const char *s)
+{
+    static const char hex[] = "0123456789abcdef";
+    put(w, '"');
+    for (; *s && !w.overflow; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+        {
+            put(w, '\\');
+            put(w, (char)c);
+        }
+        else if (c == '\n')
+        {
+            putRaw(w, "\\n");
+        }
+        else if (c < 0x20)
+        {
+            putRaw(w, "\\u00");
+            put(w, hex[c >> 4]);
+            put(w, hex[c & 0x0F]);
+        }
+        else
+        {
+            put(w, (char)c);
+        }
+    }
+    put(w, '"');
+}
+
+static void putUint64(JsonWriter &w, uint64_t v, uint8_t minDigits)
+{
+    char tmp[21];
+    uint8_t n = 0;
+    do
+    {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0 || n < minDigits);
+    while (n > 0)
+        put(w, tmp[--n]);
+}
+
+// Comma if this level already has a member, then "key":
+static void member(JsonWriter &w, const char *key)
+{
+    uint8_t bit = (uint8_t)(1u << w.depth);
+    if (w.needComma & bit)
+        put(w, ',');
+    w.needComma |= bit;
+    if (key)
+    {
+        putEscaped(w, key);
+        put(w, ':');
+    }
+}
+
+static void openLevel(JsonWriter &w, const char *key, bool array)
+{
+    if (w.depth + 1 >= JSON_MAX_DEPTH)
+    {
+        w.overflow = true;
+        return;
+    }
+    member(w, key);
+    put(w, array ? '[' : '{');
+    w.depth++;
+    uint8_t bit = (uint8_t)(1u << w.depth);
+    w.needComma &= (uint8_t)~bit;
+    w.isArray = array ? (uint8_t)(w.isArray | bit) : (uint8_t)(w.isArray & ~bit);
+}
+
+static void closeLevel(JsonWriter &w)
+{
+    if (w.depth == 0)
+        return;
+    put(w, (w.isArray & (1u << w.depth)) ? ']' : '}');
+    w.depth--;
+}
+
+void jsonBegin(JsonWriter &w, char *buf, size_t cap)
+{
+    w.buf = buf;
+    w.cap = cap;
+    w.len = 0;
+    w.depth = 0;
+    w.needComma = 0;
+    w.isArray = 0;
+    w.overflow = cap == 0;
+    if (cap > 0)
+        buf[0] = '\0';
+    put(w, '{');
+    w.depth = 1;
+}
+
+void jsonEnd(JsonWriter &w)
+{
+    while (w.depth > 0)
+        closeLevel(w);
+}
+
+bool jsonOk(const JsonWriter &w)
+{
+    return !w.overflow;
+}
+
+void jsonObjectBegin(JsonWriter &w, const char *key)
+{
+    openLevel(w, key, false);
+}
+
+void jsonObjectEnd(JsonWriter &w)
+{
+    closeLevel(w);
+}
+
+void jsonArrayBegin(JsonWriter &w, const char *key)
+{
+    openLevel(w, key, true);
+}
+
+void jsonArrayEnd(JsonWriter &w)
+{
+    closeLevel(w);
+}
+
+void jsonString(JsonWriter &w, const char *key, const char *value)
+{
+    member(w, key);
+    putEscaped(w, value ? value : "");
+}
+
+void jsonBool(JsonWriter &w, const char *key, bool value)
+{
+    member(w, key);
+    putRaw(w, value ? "true" : "false");
+}
+
+void jsonInt(JsonWriter &w, const char *key, int32_t value)
+{
+    member(w, key);
+    if (value < 0)
+        put(w, '-');
+    putUint64(w, value < 0 ? (uint64_t)(-(int64_t)value) : (uint64_t)value, 1);
+}
+
+void jsonUint(JsonWriter &w, const char *key, uint32_t value)
+{
+    member(w, key);
+    putUint64(w, value, 1);
+}
+
+static void putFixed(JsonWriter &w, int64_t value, uint8_t decimals)
+{
+    static const uint64_t pow10[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+                                     1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+    decimals = decimals > 9 ? 9 : decimals;
+    bool negative = value < 0;
+    uint64_t mag = negative ? (uint64_t)(-value) : (uint64_t)value;
+    if (negative && mag > 0)
+        put(w, '-');
+    putUint64(w, mag / pow10[decimals], 1);
+    if (decimals > 0)
+    {
+        put(w, '.');
+        putUint64(w, mag % pow10[decimals], decimals);
+    }
+}
+
+void jsonFixed(JsonWriter &w, const char *key, int32_t value, uint8_t decimals)
+{
+    member(w, key);
+    putFixed(w, value, decimals);
+}
+
+void jsonDouble(JsonWriter &w, const char *key, double value, uint8_t decimals)
+{
+    member(w, key);
+    if (isnan(value) || isinf(value))
+    {
+        putRaw(w, "null");
+        return;
+    }
+    double scale = 1.0;
+    for (uint8_t i = 0; i < decimals && i < 9; i++)
+        scale *= 10.0;
+    putFixed(w, (int64_t)llround(value * scale), decimals);
+}
+
+void jsonDateTime(JsonWriter &w, const char *key, const DateTime &t)
+{
+    member(w, key);
+    put(w, '"');
+    putUint64(w, t.year(), 4);
+    put(w, '-');
+    putUint64(w, t.month(), 2);
+    put(w, '-');
+    putUint64(w, t.day(), 2);
+    put(w, ' ');
+    putUint64(w, t.hour(), 2);
+    put(w, ':');
+    putUint64(w, t.minute(), 2);
+    put(w, ':');
+    putUint64(w, t.second(), 2);
+    put(w, '"');
+}
@@ -0,0 +1,58 @@
+#ifndef ST_JSON_H
+#define ST_JSON_H
+
+#include <Arduino.h>
+#include <RTClib.h>
+
+// =====================================================
+// JSON WRITER
+// =====================================================
+// Builds a JSON document into a caller-supplied buffer (normally on the
+// handler's stack) without touching the heap: no String, no printf -
+// numbers are formatted with integer math, fixed-point values directly
+// from their integer representation. Commas are inserted automatically.
+// On overflow the writer stops and jsonOk() returns false.
+//
+//   char buf[512];
+//   JsonWriter w;
+//   jsonBegin(w, buf, sizeof(buf));
+//   jsonInt(w, "yaw", 42);
+//   jsonEnd(w);
+//   sendJson(request, buf, w.len);
+
+#define JSON_MAX_DEPTH 8
+
+struct JsonWriter
+{
+    char *buf;
+    size_t cap;
+    size_t len;
+    uint8_t depth;
+    uint8_t needComma; // bit per nesting level
+    uint8_t isArray;   // bit per nesting level
+    bool overflow;
+};
+
+// Opens the top-level object; jsonEnd() closes everything still open
+void jsonBegin(JsonWriter &w, char *buf, size_t cap);
+void jsonEnd(JsonWriter &w);
+bool jsonOk(const JsonWriter &w);
+
+// key = nullptr inside arrays
+void jsonObjectBegin(JsonWriter &w, const char *key);
+void jsonObjectEnd(JsonWriter &w);
+void jsonArrayBegin(JsonWriter &w, const char *key);
+void jsonArrayEnd(JsonWriter &w);
+
+void jsonString(JsonWriter &w, const char *key, const char *value);
+void jsonBool(JsonWriter &w, const char *key, bool value);
+void jsonInt(JsonWriter &w, const char *key, int32_t value);
+void jsonUint(JsonWriter &w, const char *key, uint32_t value);
+// value / 10^decimals, e.g. jsonFixed(w, "yaw", 9050, 2) -> 90.50
+void jsonFixed(JsonWriter &w, const char *key, int32_t value, uint8_t decimals);
+// Rounded to `decimals` (0..9) places, same text as String(value, decimals)
+void jsonDouble(JsonWriter &w, const char *key, double value, uint8_t decimals);
+// "YYYY-MM-DD hh:mm:ss"
+void jsonDateTime(JsonWriter &w, const char *key, const DateTime &t);
+
+#endif
@@ -0,0 +1,268 @@
+#include "st_metrics.h"
+
+#ifdef ST_METRICS
+
+#include <atomic>
+#include <memory>
+#include "config.h"
+#include "st_webserver.h"
+
+// Recorded from:  loop task        control task    sampler    async_tcp
+static const char *const stageNames[METRIC_STAGE_COUNT] = {
+    "loop",           // loop()
+    "web_service",    // loop()
+    "history_export", // loop()
+    "telemetry",      // loop()
+    "status_ring",    // loop()
+    "wifi",           // loop()
+    "time_update",    // loop()
+    "history_write",  // loop()
+    "control_step",   // control task (loop() without a task)
+    "sun_position",   // control task
+    "ldr_read",       // control task
+    "servo_write",    // motion task
+    "ldr_sample",     // sampler timer
+    "http_status",    // async_tcp
+};
+
+struct MetricSlot
+{
+    std::atomic<uint32_t> seq;
+    MetricStats stats;
+};
+
+static MetricSlot slots[METRIC_STAGE_COUNT];
+static uint32_t cyclesPerUs = 0;
+
+static uint8_t bucketOf(uint32_t cycles)
+{
+    // Round up to whole microseconds (no overflow near METRIC_SATURATED),
+    // then ceil(log2)
+    uint32_t us = cycles / cyclesPerUs + (cycles % cyclesPerUs != 0);
+    if (us <= 1)
+        return 0;
+    uint8_t b = 32 - __builtin_clz(us - 1);
+    return b < METRIC_BOUNDS ? b : METRIC_BOUNDS;
+}
+
+void metricRecord(MetricStage stage, uint32_t cycles)
+{
+    if (cyclesPerUs == 0)
+        cyclesPerUs = halCyclesPerUs();
+
+    MetricSlot &m = slots[stage];
+    uint32_t seq = m.seq.load(std::memory_order_relaxed);
+    m.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    MetricStats &s = m.stats;
+    if (s.count == 0 || cycles < s.minCycles)
+        s.minCycles = cycles;
+    if (cycles > s.maxCycles)
+        s.maxCycles = cycles;
+    s.count++;
+    s.sumCycles += cycles;
+    s.buckets[bucketOf(cycles)]++;
+    m.seq.store(seq + 2, std::memory_order_release);
+}
+
+MetricScopeLong::~MetricScopeLong()
+{
+    uint32_t cycles = halCycles() - start;
+    if (cyclesPerUs == 0)
+        cyclesPerUs = halCyclesPerUs();
+    // The counter may have wrapped; the microsecond clock cannot
+    if (halMonotonicUs() - startUs >= METRIC_SATURATED / cyclesPerUs)
+        cycles = METRIC_SATURATED;
+    metricRecord(stage, cycles);
+}
+
+void metricRead(MetricStage stage, MetricStats &s)
+{
+    MetricSlot &m = slots[stage];
+    uint32_t before, after;
+    do
+    {
+        before = m.seq.load(std::memory_order_acquire);
+        s = m.stats;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = m.seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+}
+
+// Host checks only; on the board the counters run from boot
+void metricsReset()
+{
+    for (int i = 0; i < METRIC_STAGE_COUNT; i++)
+    {
+        slots[i].seq.store(0);
+        memset(&slots[i].stats, 0, sizeof(MetricStats));
+    }
+}
+
+const char *metricStageName(MetricStage stage)
+{
+    return stage < METRIC_STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+uint32_t metricP99Cycles(const MetricStats &s)
+{
+    if (s.count == 0)
+        return 0;
+    uint32_t rank = s.count - s.count / 100; // ceil(0.99 * count)
+    uint32_t seen = 0;
+    for (int b = 0; b < METRIC_BOUNDS; b++)
+    {
+        seen += s.buckets[b];
+        if (seen >= rank)
+            return min((uint32_t)((1UL << b) * cyclesPerUs), s.maxCycles);
+    }
+    return s.maxCycles;
+}
+
+// =====================================================
+// /metrics (Prometheus text format)
+// =====================================================
+// The table is copied once per scrape, so every line of a response comes
+// from the same moment. Lines are generated one at a time into the TCP
+// buffer by the chunked filler.
+
+#define METRICS_LINE_MAX 112
+
+struct MetricsScrape
+{
+    MetricStats stats[METRIC_STAGE_COUNT];
+    uint32_t line;
+    char pending[METRICS_LINE_MAX];
+    size_t pendingLen;
+    size_t pendingOff;
+};
+
+enum MetricGauge
+{
+    GAUGE_MIN,
+    GAUGE_AVG,
+    GAUGE_P99,
+    GAUGE_MAX,
+    GAUGE_COUNT
+};
+
+static const char *const gaugeNames[GAUGE_COUNT] = {"min", "avg", "p99", "max"};
+static const uint32_t HIST_LINES = METRIC_BUCKETS + 2; // buckets, sum, count
+static const uint32_t HIST_TOTAL = 2 + METRIC_STAGE_COUNT * HIST_LINES;
+static const uint32_t GAUGE_TOTAL = 2 + METRIC_STAGE_COUNT;
+
+static double cyclesToSeconds(double cycles)
+{
+    return cycles / cyclesPerUs / 1e6;
+}
+
+// Line k of the response; 0 past the last one
+static size_t metricsLine(const MetricsScrape &m, uint32_t k, char *buf, size_t cap)
+{
+    if (k < 2)
+    {
+        return snprintf(buf, cap,
+                        k == 0 ? "# HELP st_stage_seconds Duration of one pass of a loop or control stage\n"
+                               : "# TYPE st_stage_seconds histogram\n");
+    }
+    if (k < HIST_TOTAL)
+    {
+        uint32_t stage = (k - 2) / HIST_LINES;
+        uint32_t i = (k - 2) % HIST_LINES;
+        const MetricStats &s = m.stats[stage];
+        const char *name = stageNames[stage];
+        if (i < METRIC_BOUNDS)
+        {
+            uint32_t cumulative = 0;
+            for (uint32_t b = 0; b <= i; b++)
+                cumulative += s.buckets[b];
+            return snprintf(buf, cap, "st_stage_seconds_bucket{stage=\"%s\",le=\"%g\"} %lu\n", name,
+                            (1UL << i) * 1e-6, (unsigned long)cumulative);
+        }
+        if (i == METRIC_BOUNDS)
+            return snprintf(buf, cap, "st_stage_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %lu\n", name,
+                            (unsigned long)s.count);
+        if (i == METRIC_BOUNDS + 1)
+            return snprintf(buf, cap, "st_stage_seconds_sum{stage=\"%s\"} %.9g\n", name,
+                            cyclesToSeconds((double)s.sumCycles));
+        return snprintf(buf, cap, "st_stage_seconds_count{stage=\"%s\"} %lu\n", name, (unsigned long)s.count);
+    }
+
+    k -= HIST_TOTAL;
+    uint32_t gauge = k / GAUGE_TOTAL;
+    if (gauge >= GAUGE_COUNT)
+        return 0;
+    uint32_t i = k % GAUGE_TOTAL;
+    const char *g = gaugeNames[gauge];
+    if (i == 0)
+        return snprintf(buf, cap, "# HELP st_stage_%s_seconds %s stage duration since boot\n", g, g);
+    if (i == 1)
+        return snprintf(buf, cap, "# TYPE st_stage_%s_seconds gauge\n", g);
+
+    const MetricStats &s = m.stats[i - 2];
+    double cycles = 0;
+    switch (gauge)
+    {
+    case GAUGE_MIN:
+        cycles = s.minCycles;
+        break;
+    case GAUGE_AVG:
+        cycles = s.count ? (double)s.sumCycles / s.count : 0;
+        break;
+    case GAUGE_P99:
+        cycles = metricP99Cycles(s);
+        break;
+    default:
+        cycles = s.maxCycles;
+        break;
+    }
+    return snprintf(buf, cap, "st_stage_%s_seconds{stage=\"%s\"} %.9g\n", g, stageNames[i - 2],
+                    cyclesToSeconds(cycles));
+}
+
+static size_t metricsFill(MetricsScrape &m, uint8_t *buffer, size_t maxLen)
+{
+    size_t len = 0;
+    while (len < maxLen)
+    {
+        if (m.pendingOff == m.pendingLen)
+        {
+            m.pendingLen = metricsLine(m, m.line, m.pending, sizeof(m.pending));
+            m.pendingOff = 0;
+            if (m.pendingLen == 0)
+                break;
+            m.pendingLen = min(m.pendingLen, sizeof(m.pending) - 1);
+            m.line++;
+        }
+        size_t n = min(maxLen - len, m.pendingLen - m.pendingOff);
+        memcpy(buffer + len, m.pending + m.pendingOff, n);
+        m.pendingOff += n;
+        len += n;
+    }
+    return len;
+}
+
+static void handleMetrics(AsyncWebServerRequest *request)
+{
+    if (cyclesPerUs == 0)
+        cyclesPerUs = halCyclesPerUs();
+
+    std::shared_ptr<MetricsScrape> scrape(new MetricsScrape());
+    for (int i = 0; i < METRIC_STAGE_COUNT; i++)
+        metricRead((MetricStage)i, scrape->stats[i]);
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse(
+        "text/plain; version=0.0.4",
+        [scrape](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+            (void)index;
+            return metricsFill(*scrape, buffer, maxLen);
+        });
+    request->send(response);
+}
+
+void metricsBegin()
+{
+    server.on("/metrics", HTTP_GET, handleMetrics);
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef ST_METRICS_H
+#define ST_METRICS_H
+
+#include <Arduino.h>
+#include "st_hal.h"
+
+// =====================================================
+// STAGE METRICS (/metrics)
+// =====================================================
+// Latency histograms for the stages of loop(), the control step, the
+// LDR sampler and the /status handler, timed with the CPU cycle counter
+// (halCycles()). Recording is a handful of integer operations on a
+// static table, no allocation. /metrics renders the table in the
+// Prometheus text format: one histogram family plus min/avg/p99/max
+// gauges per stage.
+//
+// Buckets are powers of two, 1 us .. 524 ms, then +Inf. Each stage is
+// recorded by one task only (see stageNames in st_metrics.cpp); a
+// sequence counter per stage lets the web server copy it from the other
+// core without locking.
+//
+// The cycle counter wraps after 2^32 cycles (17.9 s at 240 MHz). Stages
+// that can block that long (loop() and the control step: flash, WLAN)
+// use METRIC_SCOPE_LONG, which also reads halMonotonicUs() and records a
+// longer pass as METRIC_SATURATED cycles (+Inf bucket, max pinned). The
+// inner stages keep the two cycle-counter reads.
+//
+// Built with -DST_METRICS (platformio.ini). Without it METRIC_SCOPE is
+// empty, nothing is recorded and /metrics is not registered.
+
+enum MetricStage
+{
+    METRIC_LOOP,
+    METRIC_WEB_SERVICE,
+    METRIC_HISTORY_EXPORT,
+    METRIC_TELEMETRY,
+    METRIC_STATUS_RING,
+    METRIC_WIFI,
+    METRIC_TIME_UPDATE,
+    METRIC_HISTORY_WRITE,
+    METRIC_CONTROL_STEP,
+    METRIC_SUN_POSITION,
+    METRIC_LDR_READ,
+    METRIC_SERVO_WRITE,
+    METRIC_LDR_SAMPLE,
+    METRIC_HTTP_STATUS,
+    METRIC_STAGE_COUNT
+};
+
+#ifdef ST_METRICS
+
+#define METRIC_BOUNDS 20                 // le = 2^0 .. 2^19 us
+#define METRIC_BUCKETS (METRIC_BOUNDS + 1) // + Inf
+#define METRIC_SATURATED UINT32_MAX // pass longer than the cycle counter's range
+
+struct MetricStats
+{
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t sumCycles;
+    uint32_t buckets[METRIC_BUCKETS]; // per bucket, not cumulative
+};
+
+void metricRecord(MetricStage stage, uint32_t cycles);
+void metricRead(MetricStage stage, MetricStats &s);
+void metricsReset();
+const char *metricStageName(MetricStage stage);
+// Upper bound of the bucket holding the 99th percentile, capped at max
+uint32_t metricP99Cycles(const MetricStats &s);
+
+// Registers /metrics with the web server (before server.begin())
+void metricsBegin();
+
+class MetricScope
+{
+public:
+    explicit MetricScope(MetricStage stage) : stage(stage), start(halCycles()) {}
+    ~MetricScope() { metricRecord(stage, halCycles() - start); }
+
+private:
+    MetricStage stage;
+    uint32_t start;
+};
+
+class MetricScopeLong
+{
+public:
+    explicit MetricScopeLong(MetricStage stage) : stage(stage), start(halCycles()), startUs(halMonotonicUs()) {}
+    ~MetricScopeLong();
+
+private:
+    MetricStage stage;
+    uint32_t start;
+    uint64_t startUs;
+};
+
+#define METRIC_CONCAT_(a, b) a##b
+#define METRIC_CONCAT(a, b) METRIC_CONCAT_(a, b)
+// Times the rest of the enclosing block
+#define METRIC_SCOPE(stage) MetricScope METRIC_CONCAT(metricScope, __LINE__)(stage)
+// Same, for stages that may outlast the cycle counter
+#define METRIC_SCOPE_LONG(stage) MetricScopeLong METRIC_CONCAT(metricScope, __LINE__)(stage)
+
+#else
+
+#define METRIC_SCOPE(stage) do { } while (0)
+#define METRIC_SCOPE_LONG(stage) do { } while (0)
+
+#endif
+
+#endif
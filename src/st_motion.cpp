@@ -0,0 +1,245 @@
+#include "st_motion.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_servo.h"
+#include "st_supervisor.h"
+
+float motionProfileTime(float distance, float vmax, float accel)
+{
+    if (distance <= 0.0f || vmax <= 0.0f || accel <= 0.0f)
+        return 0.0f;
+    // Triangle if full speed is never reached
+    if (distance < vmax * vmax / accel)
+        return 2.0f * sqrtf(distance / accel);
+    return distance / vmax + vmax / accel;
+}
+
+// Limits of one axis for a path limited to pathV/pathA per unit of the
+// way; accel is the axis' own limit
+static void scaleAxis(MotionAxis &a, float distance, float pathV, float pathA, float accel)
+{
+    a.vmax = pathV * distance;
+    a.accel = pathA * distance;
+
+    // Still moving from the previous target: the stretched profile may
+    // brake too softly to stop in time, or the axis has to turn around
+    if (a.vel != 0.0f)
+    {
+        float e = a.target - a.pos;
+        bool towards = (a.vel > 0.0f) == (e > 0.0f) && e != 0.0f;
+        float need = towards ? a.vel * a.vel / (2.0f * fabsf(e)) : accel;
+        a.accel = min(max(a.accel, need), accel);
+    }
+}
+
+void motionPlan(MotionAxis &yaw, MotionAxis &tilt, float yawTarget, float tiltTarget)
+{
+    const float yawV = MOTION_VMAX_YAW * ANGLE_SCALE;
+    const float yawA = MOTION_ACCEL_YAW * ANGLE_SCALE;
+    const float tiltV = MOTION_VMAX_TILT * ANGLE_SCALE;
+    const float tiltA = MOTION_ACCEL_TILT * ANGLE_SCALE;
+
+    yaw.target = yawTarget;
+    tilt.target = tiltTarget;
+    float yawD = fabsf(yawTarget - yaw.pos);
+    float tiltD = fabsf(tiltTarget - tilt.pos);
+
+    // Per unit of the way, the tighter axis sets speed and acceleration
+    float pathV = 1e9f;
+    float pathA = 1e9f;
+    if (yawD > 0.0f)
+    {
+        pathV = min(pathV, yawV / yawD);
+        pathA = min(pathA, yawA / yawD);
+    }
+    if (tiltD > 0.0f)
+    {
+        pathV = min(pathV, tiltV / tiltD);
+        pathA = min(pathA, tiltA / tiltD);
+    }
+    scaleAxis(yaw, yawD, pathV, pathA, yawA);
+    scaleAxis(tilt, tiltD, pathV, pathA, tiltA);
+}
+
+bool motionAdvance(MotionAxis &a, float dt)
+{
+    float e = a.target - a.pos;
+    float dv = a.accel * dt;
+    if (e == 0.0f || (fabsf(e) < 0.5f && a.vel == 0.0f))
+    {
+        a.pos = a.target;
+        a.vel = 0.0f;
+        return false;
+    }
+
+    // Speed from which n ticks of braking land exactly on the target:
+    // steps of n, n-1 .. 1 times b * dt cover b * dt * n(n+1)/2 = |e|,
+    // with n the fewest ticks that still keep b <= dv
+    float stop = 0.0f;
+    if (dv > 0.0f)
+    {
+        float n = ceilf(sqrtf(0.25f + 2.0f * fabsf(e) / (dv * dt)) - 0.5f - 1e-4f);
+        stop = 2.0f * fabsf(e) / (dt * (n + 1.0f));
+    }
+    float want = copysignf(min(a.vmax, stop), e);
+    a.vel += constrain(want - a.vel, -dv, dv);
+
+    // The last tick ends on the target, at rest from the next one
+    float step = a.vel * dt;
+    if ((step > 0.0f) == (e > 0.0f) && fabsf(step) >= fabsf(e))
+    {
+        a.pos = a.target;
+        a.vel = e / dt;
+        return true;
+    }
+    a.pos += step;
+    return true;
+}
+
+// =====================================================
+// PLANNER STATE
+// =====================================================
+// Written by motionMoveTo() (control task) and motionTick() (motion
+// task) under the HAL critical section; the servo writes happen outside.
+
+static MotionAxis axisYaw = {};
+static MotionAxis axisTilt = {};
+static bool known = false;
+static bool moving = false;
+static int32_t targetYaw = 0;
+static int32_t targetTilt = 0;
+static uint32_t moves = 0;
+static uint32_t coalesced = 0;
+static uint32_t writes = 0;
+
+// Motion task only
+static uint16_t pulseYaw = 0;
+static uint16_t pulseTilt = 0;
+
+static void rest(MotionAxis &a, int32_t pos)
+{
+    a = {(float)pos, 0.0f, (float)pos, 0.0f, 0.0f};
+}
+
+void motionBegin()
+{
+    halCriticalEnter();
+    known = false;
+    moving = false;
+    moves = 0;
+    coalesced = 0;
+    writes = 0;
+    halCriticalExit();
+    pulseYaw = 0;
+    pulseTilt = 0;
+    halStartMotion(motionTick, MOTION_PERIOD_US);
+}
+
+void motionAssume(int32_t yaw, int32_t tilt)
+{
+    yaw = clampYawCd(yaw);
+    tilt = clampTiltCd(tilt);
+    halCriticalEnter();
+    if (!known)
+    {
+        rest(axisYaw, yaw);
+        rest(axisTilt, tilt);
+        targetYaw = yaw;
+        targetTilt = tilt;
+        known = true;
+        moving = true; // the next tick writes the pose
+    }
+    halCriticalExit();
+}
+
+void motionMoveTo(int32_t yaw, int32_t tilt)
+{
+    yaw = clampYawCd(yaw);
+    tilt = clampTiltCd(tilt);
+    halCriticalEnter();
+    if (known && yaw == targetYaw && tilt == targetTilt)
+    {
+        coalesced++;
+    }
+    else
+    {
+        if (known)
+        {
+            motionPlan(axisYaw, axisTilt, yaw, tilt);
+        }
+        else
+        {
+            rest(axisYaw, yaw);
+            rest(axisTilt, tilt);
+            known = true;
+        }
+        targetYaw = yaw;
+        targetTilt = tilt;
+        moving = true;
+        moves++;
+    }
+    halCriticalExit();
+}
+
+bool motionIdle()
+{
+    halCriticalEnter();
+    bool idle = !moving;
+    halCriticalExit();
+    return idle;
+}
+
+void motionRead(MotionStatus &s)
+{
+    halCriticalEnter();
+    s.yaw = lroundf(axisYaw.pos);
+    s.tilt = lroundf(axisTilt.pos);
+    s.targetYaw = targetYaw;
+    s.targetTilt = targetTilt;
+    s.moving = moving;
+    s.moves = moves;
+    s.coalesced = coalesced;
+    s.writes = writes;
+    halCriticalExit();
+}
+
+void motionTick()
+{
+    supervisorBeat(SUPERVISOR_MOTION);
+
+    const float dt = MOTION_PERIOD_US / 1e6f;
+    halCriticalEnter();
+    if (!moving)
+    {
+        halCriticalExit();
+        return;
+    }
+    bool yawMoving = motionAdvance(axisYaw, dt);
+    bool tiltMoving = motionAdvance(axisTilt, dt);
+    moving = yawMoving || tiltMoving;
+    int32_t yaw = lroundf(axisYaw.pos);
+    int32_t tilt = lroundf(axisTilt.pos);
+    halCriticalExit();
+
+    uint32_t written = 0;
+    uint16_t pulse = servoPulseUs(yaw);
+    if (pulse != pulseYaw)
+    {
+        servoWriteYaw(yaw);
+        pulseYaw = pulse;
+        written++;
+    }
+    pulse = servoPulseUs(tilt);
+    if (pulse != pulseTilt)
+    {
+        servoWriteTilt(tilt);
+        pulseTilt = pulse;
+        written++;
+    }
+    if (written)
+    {
+        halCriticalEnter();
+        writes += written;
+        halCriticalExit();
+    }
+}
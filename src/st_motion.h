@@ -0,0 +1,73 @@
+#ifndef ST_MOTION_H
+#define ST_MOTION_H
+
+#include <Arduino.h>
+
+// =====================================================
+// SERVO MOTION PLANNER
+// =====================================================
+// Owns both servos, nothing else writes a pulse. Callers set a target
+// pose with motionMoveTo(); motionTick() runs every MOTION_PERIOD_US off
+// a hardware timer (halStartMotion, independent of loop() and the
+// control step) and walks both axes there on a trapezoidal velocity
+// profile: accelerate at most MOTION_ACCEL_*, cruise at most
+// MOTION_VMAX_*, brake to stop on the target. The supply sees a current
+// ramp instead of both servos jumping at once.
+//
+// Moves are coordinated: both axes get the same profile per unit of
+// their distance, with speed and acceleration set by the axis that
+// needs longer, so they arrive together and the panel moves on a
+// straight line in yaw/tilt. A new target mid-move is planned from the
+// current position and speed.
+//
+// The target already set is coalesced (no re-plan), and a tick only
+// writes a servo whose pulse width changed.
+//
+// The profile (MotionAxis, motionPlan, motionAdvance) uses no HAL and no
+// state, for host checks.
+
+struct MotionAxis
+{
+    float pos;    // centidegrees
+    float vel;    // centidegrees/s
+    float target;
+    float vmax;   // limits of the current move, centidegrees/s(²)
+    float accel;
+};
+
+// Rest-to-rest move over distance (any unit) at vmax/accel (per s, s²)
+float motionProfileTime(float distance, float vmax, float accel);
+
+// New targets for both axes, limits from MOTION_VMAX_*/MOTION_ACCEL_*
+// scaled to the distances so that the two arrive together
+void motionPlan(MotionAxis &yaw, MotionAxis &tilt, float yawTarget, float tiltTarget);
+
+// One tick of dt seconds; false once the axis rests on its target
+bool motionAdvance(MotionAxis &a, float dt);
+
+struct MotionStatus
+{
+    int32_t yaw;        // commanded now (centidegrees)
+    int32_t tilt;
+    int32_t targetYaw;
+    int32_t targetTilt;
+    bool moving;
+    uint32_t moves;     // targets planned
+    uint32_t coalesced; // targets that were already set
+    uint32_t writes;    // pulse writes, both servos
+};
+
+// Starts the timer. Until motionAssume() or the first target the servo
+// position is unknown; the first target is then written directly.
+void motionBegin();
+// Where the servos still are from before the boot (only while unknown)
+void motionAssume(int32_t yaw, int32_t tilt);
+// Target pose, clamped to the mechanical limits; from any task
+void motionMoveTo(int32_t yaw, int32_t tilt);
+bool motionIdle();
+void motionRead(MotionStatus &s);
+
+// Timer callback
+void motionTick();
+
+#endif
@@ -0,0 +1,220 @@
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_ntp.h"
+
+#define NTP_PORT 123
+#define NTP_PACKET_SIZE 48
+#define NTP_UNIX_OFFSET 2208988800UL // 1900-01-01 .. 1970-01-01
+#define NTP_MIN_EPOCH 1577836800UL   // 2020-01-01, anything older is bogus
+
+static const char *const stateNames[] = {"idle", "resolving", "waiting", "backoff"};
+static const char *const resultNames[] = {"none", "ok", "dns", "send", "timeout", "kod"};
+
+static WiFiUDP udp;
+static NtpStatus status = {};
+static NtpStatus published = {};
+static uint8_t origin[8];          // transmit timestamp of the open request
+static unsigned long stateSince = 0;
+static uint64_t sentAtUs = 0;      // halMonotonicUs() of the open request
+
+static uint32_t get32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void publish()
+{
+    halCriticalEnter();
+    published = status;
+    halCriticalExit();
+}
+
+static void enter(NtpState s)
+{
+    status.state = s;
+    stateSince = millis();
+}
+
+static void fail(NtpResult r)
+{
+    status.lastResult = r;
+    if (status.failures < 255)
+        status.failures++;
+    if (r == NTP_RESULT_KOD)
+        status.retryMs = NTP_RETRY_MAX_MS;
+    else if (status.failures == 1)
+        status.retryMs = NTP_RETRY_MIN_MS;
+    else
+        status.retryMs = min(status.retryMs * 2, (uint32_t)NTP_RETRY_MAX_MS);
+    status.nextAttempt = millis() + status.retryMs;
+    enter(NTP_BACKOFF);
+    publish();
+
+    DEBUG_PRINT("NTP Sync fehlgeschlagen (");
+    DEBUG_PRINT(resultNames[r]);
+    DEBUG_PRINT("), naechster Versuch in ");
+    DEBUG_PRINT(status.retryMs / 1000);
+    DEBUG_PRINTLN(" s");
+}
+
+// Drops whatever is still queued, e.g. late answers to timed-out requests
+static void drain()
+{
+    while (udp.parsePacket() > 0)
+    {
+    }
+}
+
+static void sendRequest(uint32_t addr)
+{
+    uint8_t packet[NTP_PACKET_SIZE] = {};
+    packet[0] = 0x23; // LI 0, version 4, mode 3 (client)
+    // Transmit timestamp: we have no time to offer, any value the server
+    // echoes as origin will do (RFC 4330)
+    put32(packet + 40, status.requests + 1);
+    put32(packet + 44, micros());
+    memcpy(origin, packet + 40, sizeof(origin));
+
+    drain();
+    status.requests++;
+    if (!udp.beginPacket(IPAddress(addr), NTP_PORT) ||
+        udp.write(packet, sizeof(packet)) != sizeof(packet) ||
+        !udp.endPacket())
+    {
+        fail(NTP_RESULT_SEND);
+        return;
+    }
+    sentAtUs = halMonotonicUs();
+    enter(NTP_WAITING);
+    publish();
+}
+
+// One datagram: 1 good reply, 0 ignored, -1 kiss-o'-death
+static int parseReply(const uint8_t *p, int len, NtpTime &time)
+{
+    if (len < NTP_PACKET_SIZE || memcmp(p + 24, origin, sizeof(origin)) != 0)
+        return 0;
+    uint8_t mode = p[0] & 0x07;
+    uint8_t leap = p[0] >> 6;
+    uint8_t stratum = p[1];
+    if (mode != 4)
+        return 0;
+    if (stratum == 0)
+        return -1;
+    if (leap == 3 || stratum > 15)
+        return 0;
+
+    uint32_t secs = get32(p + 40);
+    if (secs < NTP_UNIX_OFFSET + NTP_MIN_EPOCH)
+        return 0;
+
+    uint64_t now = halMonotonicUs();
+    uint32_t rtt = (uint32_t)(now - sentAtUs);
+    uint32_t fracUs = (uint32_t)(((uint64_t)get32(p + 44) * 1000000) >> 32);
+    time.utcUs = (uint64_t)(secs - NTP_UNIX_OFFSET) * 1000000 + fracUs + rtt / 2;
+    time.atUs = now;
+    time.rttUs = rtt;
+    status.rttMs = rtt / 1000;
+    return 1;
+}
+
+void ntpBegin()
+{
+    udp.begin(NTP_LOCAL_PORT);
+    status = NtpStatus();
+    status.nextAttempt = millis();
+    enter(NTP_IDLE);
+    publish();
+}
+
+bool ntpService(NtpTime &time)
+{
+    unsigned long now = millis();
+    switch (status.state)
+    {
+    case NTP_IDLE:
+    case NTP_BACKOFF:
+        if ((long)(now - status.nextAttempt) < 0 || WiFi.status() != WL_CONNECTED)
+            return false;
+        enter(NTP_RESOLVING);
+        publish();
+        // the answer may be cached
+        [[fallthrough]];
+    case NTP_RESOLVING:
+    {
+        uint32_t addr = 0;
+        HalDnsResult r = halDnsLookup(NTP_SERVER, addr);
+        if (r == HAL_DNS_OK)
+            sendRequest(addr);
+        else if (r == HAL_DNS_FAILED || now - stateSince >= NTP_TIMEOUT_MS)
+            fail(NTP_RESULT_DNS);
+        return false;
+    }
+    case NTP_WAITING:
+    {
+        uint8_t packet[NTP_PACKET_SIZE];
+        int len;
+        while ((len = udp.parsePacket()) > 0)
+        {
+            int n = udp.read(packet, sizeof(packet));
+            int r = parseReply(packet, n < len ? n : len, time);
+            if (r > 0)
+            {
+                status.replies++;
+                status.synced = true;
+                status.failures = 0;
+                status.retryMs = 0;
+                status.lastResult = NTP_RESULT_OK;
+                status.lastSync = now;
+                status.nextAttempt = now + NTP_UPDATE_INTERVAL;
+                enter(NTP_IDLE);
+                publish();
+                return true;
+            }
+            status.rejected++;
+            if (r < 0)
+            {
+                char code[5] = {};
+                memcpy(code, packet + 12, 4); // reference id holds the code
+                DEBUG_PRINT("NTP Kiss-o'-Death: ");
+                DEBUG_PRINTLN(code);
+                fail(NTP_RESULT_KOD);
+                return false;
+            }
+        }
+        if (now - stateSince >= NTP_TIMEOUT_MS)
+        {
+            status.timeouts++;
+            fail(NTP_RESULT_TIMEOUT);
+        }
+        return false;
+    }
+    }
+    return false;
+}
+
+void ntpRead(NtpStatus &out)
+{
+    halCriticalEnter();
+    out = published;
+    halCriticalExit();
+}
+
+const char *ntpStateName(NtpState s)
+{
+    return s < sizeof(stateNames) / sizeof(stateNames[0]) ? stateNames[s] : "?";
+}
+
+const char *ntpResultName(NtpResult r)
+{
+    return r < sizeof(resultNames) / sizeof(resultNames[0]) ? resultNames[r] : "?";
+}
@@ -0,0 +1,75 @@
+#ifndef ST_NTP_H
+#define ST_NTP_H
+
+#include <Arduino.h>
+
+// =====================================================
+// NTP CLIENT (SNTP over WiFiUDP, non-blocking)
+// =====================================================
+// Replaces NTPClient::update(), which waited for the answer on the loop
+// task - up to a second per try while the server was unreachable, and
+// getCurrentTime() without RTC ran it on every sun calculation.
+//
+// ntpService() runs once per loop() pass and never waits: it starts the
+// DNS lookup (halDnsLookup), sends one 48 byte request and on later
+// passes picks up the reply, or gives up after NTP_TIMEOUT_MS. Nothing
+// is sent without a station link.
+//
+// Schedule: right after boot, then NTP_UPDATE_INTERVAL after each good
+// reply. Failures back off exponentially, NTP_RETRY_MIN_MS doubling up
+// to NTP_RETRY_MAX_MS; a kiss-o'-death answer goes straight to the
+// maximum. A reply must echo our transmit timestamp, so a late answer to
+// a request that already timed out is dropped.
+
+enum NtpState : uint8_t
+{
+    NTP_IDLE,      // next sync due at nextAttempt
+    NTP_RESOLVING, // DNS lookup in flight
+    NTP_WAITING,   // request sent
+    NTP_BACKOFF    // after a failure, retry at nextAttempt
+};
+
+enum NtpResult : uint8_t
+{
+    NTP_RESULT_NONE,
+    NTP_RESULT_OK,
+    NTP_RESULT_DNS,     // lookup failed or timed out
+    NTP_RESULT_SEND,    // request not sent
+    NTP_RESULT_TIMEOUT, // no valid reply within NTP_TIMEOUT_MS
+    NTP_RESULT_KOD      // kiss-o'-death (stratum 0), e.g. RATE
+};
+
+struct NtpStatus
+{
+    NtpState state;
+    NtpResult lastResult;
+    bool synced;        // a good reply since boot
+    uint8_t failures;   // consecutive
+    uint32_t requests;
+    uint32_t replies;   // accepted
+    uint32_t rejected;  // malformed, unsynchronized, not ours or KoD
+    uint32_t timeouts;
+    uint32_t rttMs;     // round trip of the last good reply (latency)
+    uint32_t retryMs;   // current backoff
+    uint32_t lastSync;  // millis() of the last good reply
+    uint32_t nextAttempt;
+};
+
+// UTC from one good reply (server transmit time plus half the round
+// trip), valid at halMonotonicUs() == atUs
+struct NtpTime
+{
+    uint64_t utcUs;
+    uint64_t atUs;
+    uint32_t rttUs;
+};
+
+void ntpBegin();
+// loop() only. true once per good reply.
+bool ntpService(NtpTime &time);
+// Any task (copied under the HAL critical section)
+void ntpRead(NtpStatus &out);
+const char *ntpStateName(NtpState s);
+const char *ntpResultName(NtpResult r);
+
+#endif
@@ -0,0 +1,112 @@
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_sensors.h"
+#include "st_metrics.h"
+
+struct DecimatedFrame
+{
+    uint16_t value[4];
+    unsigned long timestamp;
+};
+
+// Sampler side (timer context)
+static uint32_t accumulator[4] = {0, 0, 0, 0};
+static uint16_t accumulated = 0;
+static volatile bool flushPending = false;
+
+// Shared ring, guarded by the HAL critical section
+static DecimatedFrame ring[SENSOR_RING_FRAMES];
+static uint8_t ringHead = 0;
+static uint8_t ringCount = 0;
+static bool samplerRunning = false;
+
+static void sensorsSampleTick()
+{
+    METRIC_SCOPE(METRIC_LDR_SAMPLE);
+    if (flushPending)
+    {
+        memset(accumulator, 0, sizeof(accumulator));
+        accumulated = 0;
+        flushPending = false;
+    }
+
+    int v[4];
+    halReadLdr(v[0], v[1], v[2], v[3]);
+    for (int i = 0; i < 4; i++)
+        accumulator[i] += v[i];
+
+    if (++accumulated < SENSOR_DECIMATION)
+        return;
+
+    DecimatedFrame f;
+    for (int i = 0; i < 4; i++)
+    {
+        f.value[i] = (uint16_t)((accumulator[i] + SENSOR_DECIMATION / 2) / SENSOR_DECIMATION);
+        accumulator[i] = 0;
+    }
+    f.timestamp = millis();
+    accumulated = 0;
+
+    halCriticalEnter();
+    ring[ringHead] = f;
+    ringHead = (ringHead + 1) % SENSOR_RING_FRAMES;
+    if (ringCount < SENSOR_RING_FRAMES)
+        ringCount++;
+    halCriticalExit();
+}
+
+void sensorsBegin()
+{
+    samplerRunning = halStartSampler(sensorsSampleTick, SENSOR_SAMPLE_PERIOD_US);
+    if (!samplerRunning)
+    {
+        DEBUG_PRINTLN("⚠ LDR-Sampler nicht gestartet, nutze Einzelmessungen");
+    }
+}
+
+void sensorsRead(LdrFrame &frame)
+{
+    METRIC_SCOPE(METRIC_LDR_READ);
+    DecimatedFrame copy[SENSOR_RING_FRAMES];
+    uint8_t count;
+    uint8_t head;
+
+    halCriticalEnter();
+    count = ringCount;
+    head = ringHead;
+    memcpy(copy, ring, sizeof(copy));
+    halCriticalExit();
+
+    if (count == 0)
+    {
+        // Sampler not running or just flushed: one blocking quad read
+        halReadLdr(frame.tl, frame.tr, frame.bl, frame.br);
+        frame.timestamp = millis();
+        frame.samples = 1;
+        return;
+    }
+
+    uint32_t sum[4] = {0, 0, 0, 0};
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const DecimatedFrame &f = copy[(head + SENSOR_RING_FRAMES - 1 - i) % SENSOR_RING_FRAMES];
+        for (int c = 0; c < 4; c++)
+            sum[c] += f.value[c];
+    }
+
+    frame.tl = (sum[0] + count / 2) / count;
+    frame.tr = (sum[1] + count / 2) / count;
+    frame.bl = (sum[2] + count / 2) / count;
+    frame.br = (sum[3] + count / 2) / count;
+    frame.timestamp = copy[(head + SENSOR_RING_FRAMES - 1) % SENSOR_RING_FRAMES].timestamp;
+    frame.samples = count * SENSOR_DECIMATION;
+}
+
+void sensorsFlush()
+{
+    halCriticalEnter();
+    ringCount = 0;
+    flushPending = true;
+    halCriticalExit();
+}
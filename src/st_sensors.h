@@ -0,0 +1,28 @@
+#ifndef ST_SENSORS_H
+#define ST_SENSORS_H
+
+#include <Arduino.h>
+
+// =====================================================
+// LDR ACQUISITION
+// =====================================================
+// A timer samples all four LDRs in the background, decimates
+// SENSOR_DECIMATION samples into one frame and keeps the last
+// SENSOR_RING_FRAMES frames. sensorsRead() averages the ring without
+// touching the ADC.
+
+struct LdrFrame
+{
+    int tl;
+    int tr;
+    int bl;
+    int br;
+    unsigned long timestamp; // millis() of the newest sample
+    uint16_t samples;        // raw quad samples behind this frame
+};
+
+void sensorsBegin();
+void sensorsRead(LdrFrame &frame);
+void sensorsFlush(); // drop old frames, e.g. after a servo move
+
+#endif
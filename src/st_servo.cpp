@@ -0,0 +1,49 @@
+#include "config.h"
+#include "st_servo.h"
+#include "st_hal.h"
+#include "st_metrics.h"
+
+uint16_t servoPulseUs(int32_t angleCd)
+{
+    const int32_t minCd = SERVO_MIN * ANGLE_SCALE;
+    const int32_t maxCd = SERVO_MAX * ANGLE_SCALE;
+    angleCd = constrain(angleCd, minCd, maxCd);
+
+    // Rounded integer interpolation, 64 bit keeps it overflow-free for any span
+    int64_t span = (int64_t)(SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US) * (angleCd - minCd);
+    int32_t range = maxCd - minCd;
+    return (uint16_t)(SERVO_PULSE_MIN_US + (span + range / 2) / range);
+}
+
+int32_t servoPulseToCd(uint16_t pulseUs)
+{
+    const int32_t minCd = SERVO_MIN * ANGLE_SCALE;
+    const int32_t maxCd = SERVO_MAX * ANGLE_SCALE;
+    int32_t us = constrain((int32_t)pulseUs, (int32_t)SERVO_PULSE_MIN_US, (int32_t)SERVO_PULSE_MAX_US);
+
+    int64_t span = (int64_t)(maxCd - minCd) * (us - SERVO_PULSE_MIN_US);
+    int32_t range = SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US;
+    return minCd + (int32_t)((span + range / 2) / range);
+}
+
+int32_t clampYawCd(int32_t angleCd)
+{
+    return constrain(angleCd, (int32_t)YAW_MIN * ANGLE_SCALE, (int32_t)YAW_MAX * ANGLE_SCALE);
+}
+
+int32_t clampTiltCd(int32_t angleCd)
+{
+    return constrain(angleCd, (int32_t)TILT_MIN * ANGLE_SCALE, (int32_t)TILT_MAX * ANGLE_SCALE);
+}
+
+void servoWriteYaw(int32_t angleCd)
+{
+    METRIC_SCOPE(METRIC_SERVO_WRITE);
+    halServoWriteYawUs(servoPulseUs(clampYawCd(angleCd)));
+}
+
+void servoWriteTilt(int32_t angleCd)
+{
+    METRIC_SCOPE(METRIC_SERVO_WRITE);
+    halServoWriteTiltUs(servoPulseUs(clampTiltCd(angleCd)));
+}
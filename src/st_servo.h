@@ -0,0 +1,40 @@
+#ifndef ST_SERVO_H
+#define ST_SERVO_H
+
+#include <Arduino.h>
+
+// =====================================================
+// SERVO ANGLES (fixed point)
+// =====================================================
+// All positions are carried as centidegrees (int32_t, 9000 = 90.00°) from
+// the sun mapping through controller, history and calibration file down
+// to the servo pulse. The servos get writeMicroseconds(): SERVO_MIN..MAX
+// spans SERVO_PULSE_MIN_US..MAX_US, ~10 us per degree, i.e. ~0.1° steps
+// instead of the 1° of Servo::write(int).
+
+#define ANGLE_SCALE 100 // centidegrees per degree
+
+inline int32_t degToCd(float deg)
+{
+    return (int32_t)lroundf(deg * ANGLE_SCALE);
+}
+
+inline float cdToDeg(int32_t cd)
+{
+    return (float)cd / ANGLE_SCALE;
+}
+
+// Servo angle -> pulse width, clamped to SERVO_MIN..SERVO_MAX
+uint16_t servoPulseUs(int32_t angleCd);
+// Inverse of servoPulseUs (for host fakes and diagnostics)
+int32_t servoPulseToCd(uint16_t pulseUs);
+
+// Mechanical limits YAW_/TILT_MIN..MAX
+int32_t clampYawCd(int32_t angleCd);
+int32_t clampTiltCd(int32_t angleCd);
+
+// Clamp to the mechanical limits and write through the HAL
+void servoWriteYaw(int32_t angleCd);
+void servoWriteTilt(int32_t angleCd);
+
+#endif
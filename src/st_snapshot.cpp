@@ -0,0 +1,26 @@
+#include <atomic>
+#include "st_snapshot.h"
+
+static std::atomic<uint32_t> snapshotSeq(0);
+static TrackerSnapshot snapshot = {};
+
+void snapshotPublish(const TrackerSnapshot &s)
+{
+    uint32_t seq = snapshotSeq.load(std::memory_order_relaxed);
+    snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    snapshot = s;
+    snapshotSeq.store(seq + 2, std::memory_order_release);
+}
+
+void snapshotRead(TrackerSnapshot &s)
+{
+    uint32_t before, after;
+    do
+    {
+        before = snapshotSeq.load(std::memory_order_acquire);
+        s = snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = snapshotSeq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+}
@@ -0,0 +1,33 @@
+#ifndef ST_SNAPSHOT_H
+#define ST_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "tracker_state.h"
+#include "st_calibration.h"
+#include "st_control.h"
+
+// =====================================================
+// TRACKER SNAPSHOT
+// =====================================================
+// Written by the control step after every pass, read by the web handlers
+// on the other core. Seqlock: the writer makes the sequence odd, copies,
+// makes it even again; a reader retries while it is odd or has changed
+// under it. Readers never block the control task.
+
+struct TrackerSnapshot
+{
+    TrackerState state;
+    int32_t yaw; // centidegrees
+    int32_t tilt;
+    double sunAzimuth;
+    double sunAltitude;
+    bool backtracking; // sun target held back for row shading
+    uint16_t ldr[4]; // raw, last READ_INTERVAL frame: tl, tr, bl, br
+    CalibrationStatus calibration;
+    ControlTiming timing;
+};
+
+void snapshotPublish(const TrackerSnapshot &s); // control task only
+void snapshotRead(TrackerSnapshot &s);
+
+#endif
@@ -0,0 +1,92 @@
+#include <atomic>
+#include "config.h"
+#include "time_rtc.h"
+#include "st_servo.h"
+#include "st_snapshot.h"
+#include "st_control.h"
+#include "st_status_bin.h"
+
+// External references from main.cpp
+extern std::atomic<bool> weatherSaysStop;
+
+static StatusSample ring[STATUS_RING_SIZE];
+static std::atomic<uint32_t> ringWritten(0); // samples ever written
+static unsigned long lastSampleMs = 0;
+
+void statusBinHeader(StatusBinHeader &h, uint16_t count)
+{
+    h.magic = STATUS_BIN_MAGIC;
+    h.version = STATUS_BIN_VERSION;
+    h.headerSize = sizeof(StatusBinHeader);
+    h.sampleSize = sizeof(StatusSample);
+    h.count = count;
+}
+
+void statusSampleNow(StatusSample &s)
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+
+    memset(&s, 0, sizeof(s));
+    s.uptimeMs = millis();
+    s.yaw = snap.yaw;
+    s.tilt = snap.tilt;
+    for (int i = 0; i < 4; i++)
+        s.ldr[i] = snap.ldr[i];
+    s.freeHeap = ESP.getFreeHeap();
+    s.periods = snap.timing.periods;
+    s.lastPeriodUs = snap.timing.lastPeriodUs;
+    s.jitterMeanUs = snap.timing.meanJitterUs;
+    s.jitterMaxUs = snap.timing.maxJitterUs;
+    s.late = snap.timing.late;
+    s.state = (uint8_t)snap.state;
+
+    if (timeInitialized)
+    {
+        s.epoch = getCurrentTime().unixtime();
+        s.sunAz = degToCd(snap.sunAzimuth);
+        s.sunAlt = degToCd(snap.sunAltitude);
+        s.flags |= STATUS_FLAG_TIME;
+    }
+    if (weatherSaysStop)
+        s.flags |= STATUS_FLAG_WEATHER;
+    if (WiFi.status() == WL_CONNECTED)
+        s.flags |= STATUS_FLAG_WIFI;
+    if (controlTaskRunning())
+        s.flags |= STATUS_FLAG_TASK;
+}
+
+void statusRingService()
+{
+    unsigned long now = millis();
+    uint32_t written = ringWritten.load(std::memory_order_relaxed);
+    if (written > 0 && now - lastSampleMs < STATUS_BIN_SAMPLE_MS)
+        return;
+    lastSampleMs = now;
+
+    // Readers check ringWritten after copying a slot (statusRingRead);
+    // the fence keeps the slot write after the last count they saw
+    StatusSample s;
+    statusSampleNow(s);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring[written % STATUS_RING_SIZE] = s;
+    ringWritten.store(written + 1, std::memory_order_release);
+}
+
+uint32_t statusRingFirst(uint16_t n, uint16_t &count)
+{
+    uint32_t written = ringWritten.load(std::memory_order_acquire);
+    // One slot short of full: the oldest one may be rewritten right now
+    uint32_t available = min(written, (uint32_t)STATUS_RING_SIZE - 1);
+    count = min((uint32_t)n, available);
+    return written - count;
+}
+
+bool statusRingRead(uint32_t seq, StatusSample &s)
+{
+    s = ring[seq % STATUS_RING_SIZE];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Writing sample `written` overwrites seq written - STATUS_RING_SIZE
+    uint32_t written = ringWritten.load(std::memory_order_relaxed);
+    return seq < written && written - seq < STATUS_RING_SIZE;
+}
@@ -0,0 +1,76 @@
+#ifndef ST_STATUS_BIN_H
+#define ST_STATUS_BIN_H
+
+#include <Arduino.h>
+
+// =====================================================
+// BINARY STATUS (/status.bin)
+// =====================================================
+// For collectors that scrape many trackers: the /status values as one
+// packed little-endian struct, copied byte for byte into the response.
+// No text, no heap of our own.
+//
+// Response: StatusBinHeader, then `count` StatusSample records, oldest
+// first. GET /status.bin is one live sample; ?n=N returns the last N
+// samples of a RAM ring that loop() fills every STATUS_BIN_SAMPLE_MS.
+//
+// Versioning: fields are only ever appended. Readers check magic and
+// version, then step through the records by header.sampleSize, so a
+// newer firmware with a longer sample still parses with an old reader.
+
+#define STATUS_BIN_MAGIC 0x5453 // "ST"
+#define STATUS_BIN_VERSION 1
+#define STATUS_BIN_CONTENT_TYPE "application/octet-stream"
+#define STATUS_RING_SIZE 64
+
+// StatusSample.flags
+#define STATUS_FLAG_TIME 0x01    // epoch and sun position valid
+#define STATUS_FLAG_WEATHER 0x02 // weather stop active
+#define STATUS_FLAG_WIFI 0x04    // station connected
+#define STATUS_FLAG_TASK 0x08    // control runs in its own task
+
+struct __attribute__((packed)) StatusBinHeader
+{
+    uint16_t magic;      // STATUS_BIN_MAGIC
+    uint8_t version;     // STATUS_BIN_VERSION
+    uint8_t headerSize;  // sizeof(StatusBinHeader)
+    uint16_t sampleSize; // sizeof(StatusSample)
+    uint16_t count;      // samples that follow
+};
+
+struct __attribute__((packed)) StatusSample
+{
+    uint32_t epoch;    // RTC local time (s), 0 without valid time
+    uint32_t uptimeMs; // millis()
+    int32_t yaw;       // centidegrees
+    int32_t tilt;
+    int32_t sunAz;     // centidegrees, 0 without valid time
+    int32_t sunAlt;
+    uint16_t ldr[4];   // raw ADC: top left, top right, bottom left, bottom right
+    uint32_t freeHeap; // bytes
+    // Control period (st_control ControlTiming)
+    uint32_t periods;
+    uint32_t lastPeriodUs;
+    uint32_t jitterMeanUs;
+    uint32_t jitterMaxUs;
+    uint32_t late;
+    uint8_t state;     // TrackerState
+    uint8_t flags;     // STATUS_FLAG_*
+    uint16_t reserved;
+};
+
+static_assert(sizeof(StatusBinHeader) == 8, "StatusBinHeader layout is part of the protocol");
+static_assert(sizeof(StatusSample) == 60, "StatusSample v1 layout is part of the protocol");
+
+void statusBinHeader(StatusBinHeader &h, uint16_t count);
+// From the control snapshot; time from st_clock (no I2C read)
+void statusSampleNow(StatusSample &s);
+
+// Ring, written by statusRingService() in loop() only
+void statusRingService();
+// Sequence number of the oldest of the last n samples, count = how many exist
+uint32_t statusRingFirst(uint16_t n, uint16_t &count);
+// false if the sample was overwritten (or is being overwritten) meanwhile
+bool statusRingRead(uint32_t seq, StatusSample &s);
+
+#endif
@@ -0,0 +1,61 @@
+#include <atomic>
+#include "st_strategy.h"
+
+static const char *const strategyNames[STRATEGY_COUNT] = {"astro", "ldr", "hybrid", "backtrack"};
+
+const char *strategyName(TrackStrategyId id)
+{
+    return id < STRATEGY_COUNT ? strategyNames[id] : "unknown";
+}
+
+bool strategyFromName(const char *name, TrackStrategyId &id)
+{
+    for (uint8_t i = 0; i < STRATEGY_COUNT; i++)
+    {
+        if (strcmp(name, strategyNames[i]) == 0)
+        {
+            id = (TrackStrategyId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef ST_STRATEGY_RUNTIME
+
+// Set by the driver, read by the control step
+static std::atomic<uint8_t> selected(ST_STRATEGY);
+
+TrackStrategyId strategySelected()
+{
+    return (TrackStrategyId)selected.load();
+}
+
+void strategySelect(TrackStrategyId id)
+{
+    if (id >= STRATEGY_COUNT)
+        return;
+    selected = id;
+    controllerReset();
+}
+
+void strategyStep(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+{
+    switch (strategySelected())
+    {
+    case STRATEGY_ASTRO:
+        StrategyPolicy<STRATEGY_ASTRO>::type::step(in, yaw, tilt);
+        break;
+    case STRATEGY_LDR:
+        StrategyPolicy<STRATEGY_LDR>::type::step(in, yaw, tilt);
+        break;
+    case STRATEGY_BACKTRACK:
+        StrategyPolicy<STRATEGY_BACKTRACK>::type::step(in, yaw, tilt);
+        break;
+    default:
+        StrategyPolicy<STRATEGY_HYBRID>::type::step(in, yaw, tilt);
+        break;
+    }
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef ST_STRATEGY_H
+#define ST_STRATEGY_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "st_controller.h"
+
+// =====================================================
+// TRACKING STRATEGIES
+// =====================================================
+// What one TRACKING step does with the sun target and the LDR error.
+// controlStep() fills a TrackInput once per READ_INTERVAL and hands it
+// to the selected policy, a struct with a static step():
+//   astro     sun target only, LDRs ignored; holds without time
+//   ldr       LDR differential only (PI on the position), sun ignored
+//   hybrid    sun target as feed-forward, the LDR PI learns the offset;
+//             too little light -> sun target only (default)
+//   backtrack hybrid, but while the sun target is backtracked (row
+//             shading) tilt ignores the LDRs, which would pull the
+//             panel back into the shade
+//
+// Build time: -DST_STRATEGY=STRATEGY_ASTRO (platformio.ini) compiles
+// exactly that policy into controlStep(), the others are never
+// instantiated. -DST_STRATEGY_RUNTIME (native build) compiles all of
+// them behind strategySelect(), so the host harness can compare them.
+
+enum TrackStrategyId : uint8_t
+{
+    STRATEGY_ASTRO,
+    STRATEGY_LDR,
+    STRATEGY_HYBRID,
+    STRATEGY_BACKTRACK,
+    STRATEGY_COUNT
+};
+
+#ifndef ST_STRATEGY
+#define ST_STRATEGY STRATEGY_HYBRID
+#endif
+
+struct TrackInput
+{
+    bool haveSun;      // time valid and sun above the horizon
+    bool backtracking; // sun target tilt is backtracked
+    int32_t sunYaw;    // sun target, centidegrees
+    int32_t sunTilt;
+    float errorYaw;    // normalized LDR error, -1..1
+    float errorTilt;
+    int totalSum;      // sum of the four LDRs
+};
+
+struct AstroStrategy
+{
+    static void step(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+    {
+        if (in.haveSun)
+        {
+            yaw = in.sunYaw;
+            tilt = in.sunTilt;
+        }
+    }
+};
+
+struct LdrStrategy
+{
+    static void step(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+    {
+        if (in.totalSum >= MIN_LIGHT_SUM)
+        {
+            controllerStep(false, 0, 0, in.errorYaw, in.errorTilt, yaw, tilt);
+        }
+    }
+};
+
+struct HybridStrategy
+{
+    static void step(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+    {
+        if (in.totalSum < MIN_LIGHT_SUM)
+        {
+            AstroStrategy::step(in, yaw, tilt);
+            return;
+        }
+        controllerStep(in.haveSun, in.sunYaw, in.sunTilt, in.errorYaw, in.errorTilt, yaw, tilt);
+    }
+};
+
+struct BacktrackStrategy
+{
+    static void step(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+    {
+        if (!in.backtracking)
+        {
+            HybridStrategy::step(in, yaw, tilt);
+            return;
+        }
+        // Zero tilt error: the PI keeps the offset it learned in the open
+        TrackInput held = in;
+        held.errorTilt = 0.0f;
+        HybridStrategy::step(held, yaw, tilt);
+    }
+};
+
+template <TrackStrategyId id>
+struct StrategyPolicy;
+template <>
+struct StrategyPolicy<STRATEGY_ASTRO>
+{
+    typedef AstroStrategy type;
+};
+template <>
+struct StrategyPolicy<STRATEGY_LDR>
+{
+    typedef LdrStrategy type;
+};
+template <>
+struct StrategyPolicy<STRATEGY_HYBRID>
+{
+    typedef HybridStrategy type;
+};
+template <>
+struct StrategyPolicy<STRATEGY_BACKTRACK>
+{
+    typedef BacktrackStrategy type;
+};
+
+const char *strategyName(TrackStrategyId id);
+// "astro", "ldr", ...; false if the name is unknown
+bool strategyFromName(const char *name, TrackStrategyId &id);
+
+#ifdef ST_STRATEGY_RUNTIME
+TrackStrategyId strategySelected();
+void strategySelect(TrackStrategyId id); // also resets the controller
+void strategyStep(const TrackInput &in, int32_t &yaw, int32_t &tilt);
+#else
+inline TrackStrategyId strategySelected()
+{
+    return ST_STRATEGY;
+}
+
+inline void strategyStep(const TrackInput &in, int32_t &yaw, int32_t &tilt)
+{
+    StrategyPolicy<ST_STRATEGY>::type::step(in, yaw, tilt);
+}
+#endif
+
+#endif
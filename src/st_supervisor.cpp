@@ -0,0 +1,267 @@
+#include <atomic>
+#include <LittleFS.h>
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_supervisor.h"
+
+// External references from main.cpp
+extern bool littlefsAvailable;
+
+#define RESET_LOG_PATH "/reset.log"
+#define RESET_LOG_MAGIC 0x4C545352 // "RSTL"
+#define STALL_MAGIC 0x4C415453     // "STAL"
+
+struct Slot
+{
+    std::atomic<uint32_t> since; // periodic: last beat, operation: busy since (millis)
+    std::atomic<bool> active;    // periodic: has beaten, operation: busy
+    bool subscribed;             // beating task is on the task watchdog
+    uint32_t fed;                // last task watchdog feed (beating task only)
+};
+
+// Written to RTC memory right before the supervisor resets the chip
+struct StallRecord
+{
+    uint32_t magic;
+    uint8_t subsystem;
+    uint32_t stalledMs;
+    uint32_t uptimeMs;
+    uint32_t check;
+};
+static_assert(sizeof(StallRecord) <= HAL_NOINIT_SIZE, "stall record must fit the noinit area");
+
+struct ResetLogFile
+{
+    uint32_t magic;
+    uint32_t boots;
+    uint8_t next;  // slot of the next entry
+    uint8_t count;
+    uint16_t reserved;
+    ResetLogEntry entries[RESET_LOG_ENTRIES];
+};
+
+static const char *const subsystemNames[SUPERVISOR_COUNT] = {"control", "loop", "web", "time", "storage", "motion"};
+static const char *const causeNames[] = {"power_on", "software", "stall", "task_wdt", "panic", "brownout", "other"};
+
+static Slot slots[SUPERVISOR_COUNT];
+static ResetLogFile resetLog = {};
+static bool restartPending = false;
+
+static const unsigned long *limitOf(uint8_t s)
+{
+    switch (s)
+    {
+    case SUPERVISOR_CONTROL:
+        return &SUPERVISOR_CONTROL_STALL_MS;
+    case SUPERVISOR_LOOP:
+        return &SUPERVISOR_LOOP_STALL_MS;
+    case SUPERVISOR_WEB:
+        return &SUPERVISOR_WEB_STALL_MS;
+    case SUPERVISOR_TIME:
+        return &SUPERVISOR_TIME_STALL_MS;
+    case SUPERVISOR_MOTION:
+        return &SUPERVISOR_MOTION_STALL_MS;
+    default:
+        return &SUPERVISOR_STORAGE_STALL_MS;
+    }
+}
+
+static uint32_t stallCheck(const StallRecord &r)
+{
+    return r.magic ^ ((uint32_t)r.subsystem << 24) ^ r.stalledMs ^ (r.uptimeMs * 2654435761u);
+}
+
+static uint8_t causeOf(HalResetReason reason, const StallRecord &stall)
+{
+    switch (reason)
+    {
+    case HAL_RESET_POWER_ON:
+        return RESET_POWER_ON;
+    case HAL_RESET_SOFTWARE:
+        return stall.magic == STALL_MAGIC && stall.check == stallCheck(stall) ? RESET_STALL : RESET_SOFTWARE;
+    case HAL_RESET_WATCHDOG:
+        return RESET_TASK_WDT;
+    case HAL_RESET_PANIC:
+        return RESET_PANIC;
+    case HAL_RESET_BROWNOUT:
+        return RESET_BROWNOUT;
+    default:
+        return RESET_OTHER;
+    }
+}
+
+static void loadResetLog()
+{
+    memset(&resetLog, 0, sizeof(resetLog));
+    if (!littlefsAvailable || !LittleFS.exists(RESET_LOG_PATH))
+        return;
+    File f = LittleFS.open(RESET_LOG_PATH, "r");
+    if (!f)
+        return;
+    bool ok = f.read((uint8_t *)&resetLog, sizeof(resetLog)) == sizeof(resetLog);
+    f.close();
+    if (!ok || resetLog.magic != RESET_LOG_MAGIC || resetLog.next >= RESET_LOG_ENTRIES ||
+        resetLog.count > RESET_LOG_ENTRIES)
+        memset(&resetLog, 0, sizeof(resetLog));
+}
+
+static void saveResetLog()
+{
+    if (!littlefsAvailable)
+        return;
+    File f = LittleFS.open(RESET_LOG_PATH, "w");
+    if (f)
+    {
+        f.write((const uint8_t *)&resetLog, sizeof(resetLog));
+        f.close();
+    }
+}
+
+void supervisorBegin()
+{
+    StallRecord stall;
+    memcpy(&stall, halNoinit(), sizeof(stall));
+    memset(halNoinit(), 0, HAL_NOINIT_SIZE);
+
+    ResetLogEntry e = {};
+    e.cause = causeOf(halResetReason(), stall);
+    e.subsystem = SUPERVISOR_NONE;
+    if (e.cause == RESET_STALL)
+    {
+        e.subsystem = stall.subsystem;
+        e.stalledMs = stall.stalledMs;
+        e.uptimeMs = stall.uptimeMs;
+    }
+
+    loadResetLog();
+    resetLog.magic = RESET_LOG_MAGIC;
+    e.boot = ++resetLog.boots;
+    resetLog.entries[resetLog.next] = e;
+    resetLog.next = (resetLog.next + 1) % RESET_LOG_ENTRIES;
+    if (resetLog.count < RESET_LOG_ENTRIES)
+        resetLog.count++;
+    saveResetLog();
+
+    DEBUG_PRINT("Neustart #");
+    DEBUG_PRINT(e.boot);
+    DEBUG_PRINT(": ");
+    DEBUG_PRINT(resetCauseName(e.cause));
+    if (e.cause == RESET_STALL)
+    {
+        DEBUG_PRINT(" (");
+        DEBUG_PRINT(supervisorSubsystemName(e.subsystem));
+        DEBUG_PRINT(" ");
+        DEBUG_PRINT(e.stalledMs);
+        DEBUG_PRINT(" ms)");
+    }
+    DEBUG_PRINTLN();
+
+    for (int i = 0; i < SUPERVISOR_COUNT; i++)
+    {
+        slots[i].since.store(0);
+        slots[i].active.store(false);
+        slots[i].subscribed = false;
+        slots[i].fed = 0;
+    }
+    restartPending = false;
+    halWatchdogBegin(SUPERVISOR_TWDT_MS);
+    halStartSupervisor(supervisorCheck, SUPERVISOR_CHECK_MS);
+}
+
+void supervisorBeat(SupervisorSubsystem s)
+{
+    Slot &slot = slots[s];
+    if (!slot.subscribed)
+    {
+        halWatchdogAddTask();
+        slot.subscribed = true;
+    }
+    uint32_t now = millis();
+    // The feed takes a spinlock; once per check period is plenty
+    if (now - slot.fed >= SUPERVISOR_CHECK_MS)
+    {
+        halWatchdogFeed();
+        slot.fed = now;
+    }
+    slot.since.store(now, std::memory_order_relaxed);
+    slot.active.store(true, std::memory_order_release);
+}
+
+void supervisorBusy(SupervisorSubsystem s)
+{
+    slots[s].since.store(millis(), std::memory_order_relaxed);
+    slots[s].active.store(true, std::memory_order_release);
+}
+
+void supervisorIdle(SupervisorSubsystem s)
+{
+    slots[s].active.store(false, std::memory_order_release);
+}
+
+ArRequestHandlerFunction supervised(ArRequestHandlerFunction fn)
+{
+    return [fn](AsyncWebServerRequest *request) {
+        SupervisorScope busy(SUPERVISOR_WEB);
+        fn(request);
+    };
+}
+
+void supervisorCheck()
+{
+    if (restartPending)
+        return;
+
+    uint32_t now = millis();
+    // A hanging sync or flash write inside loop() is reported as itself
+    bool loopInside = slots[SUPERVISOR_TIME].active.load() || slots[SUPERVISOR_STORAGE].active.load();
+    for (uint8_t s = 0; s < SUPERVISOR_COUNT; s++)
+    {
+        if (!slots[s].active.load(std::memory_order_acquire) || (s == SUPERVISOR_LOOP && loopInside))
+            continue;
+        uint32_t stalled = now - slots[s].since.load(std::memory_order_relaxed);
+        if (stalled <= *limitOf(s))
+            continue;
+
+        StallRecord r;
+        r.magic = STALL_MAGIC;
+        r.subsystem = s;
+        r.stalledMs = stalled;
+        r.uptimeMs = now;
+        r.check = stallCheck(r);
+        memcpy(halNoinit(), &r, sizeof(r));
+
+        DEBUG_PRINT("⚠ Supervisor: ");
+        DEBUG_PRINT(subsystemNames[s]);
+        DEBUG_PRINT(" hängt seit ");
+        DEBUG_PRINT(stalled);
+        DEBUG_PRINTLN(" ms -> Neustart");
+        restartPending = true;
+        halRestart();
+        return;
+    }
+}
+
+const char *supervisorSubsystemName(uint8_t s)
+{
+    return s < SUPERVISOR_COUNT ? subsystemNames[s] : "-";
+}
+
+const char *resetCauseName(uint8_t cause)
+{
+    return cause <= RESET_OTHER ? causeNames[cause] : "?";
+}
+
+uint8_t resetLogRead(ResetLogEntry *out, uint8_t max)
+{
+    uint8_t n = min(resetLog.count, max);
+    uint8_t first = (resetLog.next + RESET_LOG_ENTRIES - resetLog.count) % RESET_LOG_ENTRIES;
+    for (uint8_t i = 0; i < n; i++)
+        out[i] = resetLog.entries[(first + resetLog.count - n + i) % RESET_LOG_ENTRIES];
+    return n;
+}
+
+uint32_t supervisorBootCount()
+{
+    return resetLog.boots;
+}
@@ -0,0 +1,100 @@
+#ifndef ST_SUPERVISOR_H
+#define ST_SUPERVISOR_H
+
+#include "config.h"
+
+// =====================================================
+// SUPERVISOR (heartbeats, task watchdog, reset log)
+// =====================================================
+// Every subsystem reports progress, and a check outside the watched
+// tasks (halStartSupervisor: esp_timer task on the board) compares
+// those reports with its limit every SUPERVISOR_CHECK_MS:
+//
+//   control  controlStep() beats every period    SUPERVISOR_CONTROL_STALL_MS
+//   loop     loop() beats every pass             SUPERVISOR_LOOP_STALL_MS
+//   web      busy while a handler runs           SUPERVISOR_WEB_STALL_MS
+//   time     busy during WLAN/NTP/RTC steps      SUPERVISOR_TIME_STALL_MS
+//   storage  busy during flash writes            SUPERVISOR_STORAGE_STALL_MS
+//   motion   motionTick() beats every tick       SUPERVISOR_MOTION_STALL_MS
+//
+// A stalled subsystem is written, with how long it stalled, to RTC
+// memory that survives the reset, then the chip restarts. The next boot
+// appends it to /reset.log (last RESET_LOG_ENTRIES boots, any cause).
+// time and storage run inside loop(): while one of them is busy the loop
+// limit does not apply, so the log names the real culprit.
+//
+// The loop, control and motion tasks are also subscribed to the ESP32 task
+// watchdog (SUPERVISOR_TWDT_MS) and feed it with their beats. It resets
+// the chip if even the supervisor check cannot run.
+
+enum SupervisorSubsystem
+{
+    SUPERVISOR_CONTROL,
+    SUPERVISOR_LOOP,
+    SUPERVISOR_WEB,
+    SUPERVISOR_TIME,
+    SUPERVISOR_STORAGE,
+    SUPERVISOR_MOTION,
+    SUPERVISOR_COUNT,
+    SUPERVISOR_NONE = 0xFF // reset not caused by a stall
+};
+
+enum ResetCause
+{
+    RESET_POWER_ON,
+    RESET_SOFTWARE,  // ESP.restart() outside the supervisor
+    RESET_STALL,     // supervisor, see subsystem
+    RESET_TASK_WDT,  // task watchdog fired before the supervisor could
+    RESET_PANIC,
+    RESET_BROWNOUT,
+    RESET_OTHER
+};
+
+#define RESET_LOG_ENTRIES 16
+
+struct ResetLogEntry
+{
+    uint32_t boot;      // boot counter
+    uint8_t cause;      // ResetCause
+    uint8_t subsystem;  // SupervisorSubsystem for RESET_STALL
+    uint16_t reserved;
+    uint32_t stalledMs; // how long the subsystem had not made progress
+    uint32_t uptimeMs;  // at the reset
+};
+
+// Reads the previous reset, logs it, starts the check. Early in setup(),
+// after the file system.
+void supervisorBegin();
+
+// Periodic subsystems (control, loop, motion): progress, also feeds the task
+// watchdog of the calling task
+void supervisorBeat(SupervisorSubsystem s);
+// Operation subsystems (web, time, storage)
+void supervisorBusy(SupervisorSubsystem s);
+void supervisorIdle(SupervisorSubsystem s);
+
+// Busy for the rest of the enclosing block
+class SupervisorScope
+{
+public:
+    explicit SupervisorScope(SupervisorSubsystem s) : subsystem(s) { supervisorBusy(s); }
+    ~SupervisorScope() { supervisorIdle(subsystem); }
+
+private:
+    SupervisorSubsystem subsystem;
+};
+
+// Wraps a web handler in SUPERVISOR_WEB busy/idle
+ArRequestHandlerFunction supervised(ArRequestHandlerFunction fn);
+
+// Check body, normally run by the supervisor timer
+void supervisorCheck();
+
+const char *supervisorSubsystemName(uint8_t s);
+const char *resetCauseName(uint8_t cause);
+
+// Oldest first; returns the number of entries copied
+uint8_t resetLogRead(ResetLogEntry *out, uint8_t max);
+uint32_t supervisorBootCount();
+
+#endif
@@ -0,0 +1,148 @@
+#include <atomic>
+#include "st_debug.h"
+#include "config.h"
+#include "time_rtc.h"
+#include "st_json.h"
+#include "st_servo.h"
+#include "st_snapshot.h"
+#include "st_webserver.h"
+#include "st_telemetry.h"
+
+// External references from main.cpp
+extern std::atomic<bool> weatherSaysStop;
+
+AsyncEventSource events("/events");
+
+enum TelemetryField : uint8_t
+{
+    TELEMETRY_STATE = 1 << 0,
+    TELEMETRY_YAW = 1 << 1,
+    TELEMETRY_TILT = 1 << 2,
+    TELEMETRY_SUN = 1 << 3,
+    TELEMETRY_WEATHER = 1 << 4,
+    TELEMETRY_ALL = 0x1F
+};
+
+struct TelemetryFrame
+{
+    TrackerState state;
+    int32_t yaw; // centidegrees
+    int32_t tilt;
+    int32_t sunAz;
+    int32_t sunAlt;
+    bool sunKnown;
+    bool weatherStop;
+};
+
+static TelemetryFrame sent = {};
+static bool haveSent = false;
+static std::atomic<bool> fullPending(false);
+static uint32_t eventId = 0;
+static unsigned long lastEventMs = 0;
+
+static void readFrame(TelemetryFrame &f)
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    f.state = snap.state;
+    f.yaw = snap.yaw;
+    f.tilt = snap.tilt;
+    f.sunKnown = timeInitialized;
+    f.sunAz = degToCd(snap.sunAzimuth);
+    f.sunAlt = degToCd(snap.sunAltitude);
+    f.weatherStop = weatherSaysStop;
+}
+
+static uint8_t changedFields(const TelemetryFrame &cur)
+{
+    uint8_t fields = 0;
+    if (cur.state != sent.state)
+        fields |= TELEMETRY_STATE;
+    if (cur.yaw != sent.yaw)
+        fields |= TELEMETRY_YAW;
+    if (cur.tilt != sent.tilt)
+        fields |= TELEMETRY_TILT;
+    // Below the deadband the sun is not resent, so small steps add up
+    // against the last sent value instead of getting lost
+    if (cur.sunKnown && (!sent.sunKnown || abs(cur.sunAz - sent.sunAz) >= TELEMETRY_SUN_DEADBAND_CD ||
+                         abs(cur.sunAlt - sent.sunAlt) >= TELEMETRY_SUN_DEADBAND_CD))
+        fields |= TELEMETRY_SUN;
+    if (cur.weatherStop != sent.weatherStop)
+        fields |= TELEMETRY_WEATHER;
+    return fields;
+}
+
+static size_t buildFrame(char *buf, size_t cap, const TelemetryFrame &f, uint8_t fields)
+{
+    JsonWriter w;
+    jsonBegin(w, buf, cap);
+    if (fields & TELEMETRY_STATE)
+        jsonString(w, "st", trackerStateName(f.state));
+    if (fields & TELEMETRY_YAW)
+        jsonInt(w, "y", f.yaw);
+    if (fields & TELEMETRY_TILT)
+        jsonInt(w, "t", f.tilt);
+    if ((fields & TELEMETRY_SUN) && f.sunKnown)
+    {
+        jsonInt(w, "az", f.sunAz);
+        jsonInt(w, "al", f.sunAlt);
+    }
+    if (fields & TELEMETRY_WEATHER)
+        jsonUint(w, "w", f.weatherStop ? 1 : 0);
+    jsonEnd(w);
+    return jsonOk(w) ? w.len : 0;
+}
+
+void telemetryBegin()
+{
+    // async_tcp task: only flag it, loop() builds the event
+    events.onConnect([](AsyncEventSourceClient *client) {
+        (void)client;
+        fullPending = true;
+    });
+    server.addHandler(&events);
+}
+
+void telemetryService()
+{
+    unsigned long now = millis();
+    if (now - lastEventMs < TELEMETRY_MIN_INTERVAL_MS)
+        return;
+
+    // Nobody watching: no work; the next viewer starts with a full event
+    if (events.count() == 0)
+    {
+        haveSent = false;
+        return;
+    }
+
+    TelemetryFrame cur;
+    readFrame(cur);
+    bool full = fullPending.exchange(false) || !haveSent;
+    uint8_t fields = full ? (uint8_t)TELEMETRY_ALL : changedFields(cur);
+    if (fields == 0 && now - lastEventMs < TELEMETRY_KEEPALIVE_MS)
+        return;
+
+    char json[TELEMETRY_JSON_MAX];
+    size_t len = buildFrame(json, sizeof(json), cur, fields);
+    if (len == 0)
+        return;
+    events.send(json, full ? "full" : "delta", ++eventId);
+
+    if (fields & TELEMETRY_STATE)
+        sent.state = cur.state;
+    if (fields & TELEMETRY_YAW)
+        sent.yaw = cur.yaw;
+    if (fields & TELEMETRY_TILT)
+        sent.tilt = cur.tilt;
+    if (fields & TELEMETRY_SUN)
+    {
+        sent.sunKnown = cur.sunKnown;
+        sent.sunAz = cur.sunAz;
+        sent.sunAlt = cur.sunAlt;
+    }
+    if (fields & TELEMETRY_WEATHER)
+        sent.weatherStop = cur.weatherStop;
+    haveSent = true;
+    lastEventMs = now;
+}
@@ -0,0 +1,30 @@
+#ifndef ST_TELEMETRY_H
+#define ST_TELEMETRY_H
+
+#include "config.h"
+
+// =====================================================
+// LIVE TELEMETRY (SSE /events)
+// =====================================================
+// Push instead of /status polling. telemetryService() runs in loop(),
+// compares the control snapshot with what was sent last and broadcasts
+// only the fields that changed, at most every TELEMETRY_MIN_INTERVAL_MS.
+// Each update is serialized once and queued to every connected viewer.
+// A new viewer makes the next event a "full" one (for everybody), so it
+// never has to be told apart from the others.
+//
+// Events ("full" / "delta"), flat JSON, integers only:
+//   st  state name          y, t  yaw, tilt (centidegrees)
+//   az, al  sun position (centidegrees, only with valid time)
+//   w   weather stop (0/1)
+// An empty delta {} is sent after TELEMETRY_KEEPALIVE_MS without changes.
+
+#define TELEMETRY_JSON_MAX 96
+
+extern AsyncEventSource events;
+
+// Registers /events with the web server (before server.begin())
+void telemetryBegin();
+void telemetryService();
+
+#endif
@@ -0,0 +1,453 @@
+// Generated by tools/web_assets.py from web/ - do not edit.
+// Rebuilt automatically by PlatformIO; by hand: python3 tools/web_assets.py
+
+#include "st_web_assets.h"
+
+// calibrate.html: 2683 bytes, 1228 gzip
+static const uint8_t ASSET_CALIBRATE_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x56, 0xcb, 0x6e, 0xdc, 0x36,
+    0x14, 0xdd, 0xe7, 0x2b, 0x6e, 0xb5, 0x91, 0x06, 0x89, 0x35, 0xb6, 0x53, 0x20, 0x81, 0xa3, 0x91,
+    0x61, 0xe7, 0x81, 0x04, 0x8d, 0x5d, 0xa3, 0x76, 0x1b, 0x24, 0x3b, 0x8a, 0xba, 0x1a, 0xd1, 0x43,
+    0x51, 0x03, 0x92, 0xf2, 0x23, 0x45, 0x80, 0xfe, 0x81, 0x17, 0x05, 0x0a, 0x34, 0x28, 0xd0, 0x2c,
+    0x82, 0xae, 0xbd, 0x6c, 0x81, 0xae, 0xec, 0x3f, 0xc9, 0x0f, 0xb4, 0x9f, 0xd0, 0x4b, 0x4a, 0xb2,
+    0x47, 0xb6, 0xf3, 0xe8, 0x62, 0x30, 0x22, 0x79, 0x79, 0xee, 0x39, 0xf7, 0x25, 0x25, 0x5f, 0x3d,
+    0xfa, 0xf6, 0xe1, 0xde, 0xcb, 0x9d, 0xc7, 0x50, 0xda, 0x4a, 0xa6, 0xb7, 0x92, 0xfe, 0x0f, 0x59,
+    0x9e, 0xde, 0x02, 0x48, 0x2a, 0xb4, 0x0c, 0x78, 0xc9, 0xb4, 0x41, 0x3b, 0x09, 0xbe, 0xdf, 0x7b,
+    0xb2, 0x74, 0x3f, 0xf0, 0x07, 0x56, 0x58, 0x89, 0xe9, 0x37, 0x4c, 0x8a, 0x4c, 0x0b, 0xd4, 0x8d,
+    0x9a, 0x26, 0xe3, 0x76, 0xcf, 0x9d, 0x4a, 0xa1, 0x66, 0xa0, 0x51, 0x4e, 0x02, 0x63, 0x8f, 0x25,
+    0x9a, 0x12, 0xd1, 0x06, 0x50, 0x6a, 0x2c, 0x26, 0xc1, 0xd8, 0x6f, 0xc5, 0xdc, 0x98, 0xf5, 0x83,
+    0x49, 0x71, 0x6f, 0x75, 0xf5, 0xde, 0x2a, 0xe7, 0xf7, 0x57, 0xbe, 0x5e, 0xce, 0x19, 0xae, 0x10,
+    0x78, 0x32, 0x6e, 0xbd, 0x27, 0x59, 0x9d, 0x1f, 0x7b, 0xb4, 0x72, 0x35, 0xfd, 0xf0, 0xf6, 0xd7,
+    0x7f, 0xfe, 0x3c, 0x81, 0x8d, 0xc6, 0xd6, 0x15, 0xb3, 0xc2, 0xf0, 0x12, 0x61, 0xe8, 0x9c, 0x8c,
+    0x9c, 0x6d, 0x2e, 0x0e, 0x80, 0x4b, 0x66, 0xcc, 0x24, 0xe0, 0xb5, 0xb2, 0x4c, 0x28, 0xd4, 0x9e,
+    0xf1, 0xf0, 0x4c, 0xa8, 0xa2, 0x5e, 0xca, 0xea, 0xa3, 0xee, 0xc8, 0x39, 0xb9, 0x9b, 0x6e, 0xcc,
+    0x6c, 0x83, 0x52, 0x0e, 0x91, 0x4d, 0xce, 0x2c, 0xaa, 0x35, 0x72, 0x70, 0xf7, 0xc2, 0x36, 0x4b,
+    0x5f, 0xb2, 0x43, 0x88, 0x36, 0x5e, 0x8b, 0xaa, 0xb1, 0x23, 0x3a, 0xcb, 0x52, 0x48, 0xcc, 0x9c,
+    0x29, 0x10, 0x39, 0x49, 0x66, 0x07, 0x98, 0x93, 0x41, 0x90, 0xc6, 0x71, 0x9c, 0x8c, 0xdd, 0x7e,
+    0x7a, 0x76, 0x9a, 0x64, 0x7a, 0xe1, 0xfe, 0x9e, 0x90, 0x16, 0xa2, 0x6d, 0x14, 0x53, 0x72, 0x71,
+    0x33, 0x82, 0x33, 0x19, 0x42, 0xb4, 0x2a, 0xc6, 0x24, 0x63, 0x41, 0x90, 0xb3, 0x9f, 0xeb, 0x7a,
+    0xaa, 0xd1, 0x98, 0x4d, 0x27, 0xe8, 0xaa, 0x41, 0xa7, 0xf8, 0x90, 0x69, 0x25, 0xd4, 0x34, 0xa0,
+    0x50, 0xbe, 0x73, 0xa1, 0x7c, 0x24, 0x86, 0x3a, 0xc1, 0x58, 0xa6, 0x2d, 0x5a, 0xc8, 0x50, 0xd0,
+    0x6f, 0xc6, 0x94, 0xb2, 0xa8, 0xe1, 0x15, 0x0a, 0x0b, 0x44, 0x2b, 0xa7, 0xe7, 0xdd, 0x5a, 0x29,
+    0x54, 0xf3, 0xda, 0x08, 0x2b, 0x6a, 0x05, 0x91, 0xa9, 0x95, 0xb1, 0x30, 0xd5, 0x75, 0x86, 0x06,
+    0xbe, 0x63, 0x86, 0xec, 0x47, 0x9d, 0xc4, 0x46, 0xe5, 0x70, 0x80, 0xba, 0x40, 0x17, 0x7f, 0xc2,
+    0x14, 0x06, 0x58, 0x53, 0xc0, 0xca, 0xd9, 0x69, 0x0c, 0x8f, 0x08, 0xaa, 0xb5, 0x5e, 0xda, 0x3d,
+    0x44, 0x9c, 0x43, 0x25, 0x0c, 0xe1, 0x30, 0x17, 0xf9, 0x95, 0xe5, 0xb3, 0xd3, 0xa5, 0x57, 0x2e,
+    0x09, 0xca, 0x63, 0xe4, 0xac, 0x71, 0xf7, 0x09, 0x46, 0x4c, 0x11, 0xb6, 0x84, 0x6a, 0x28, 0x19,
+    0x71, 0xe7, 0xe4, 0xc5, 0xf9, 0x7b, 0x2a, 0x29, 0x95, 0xe7, 0x24, 0x9d, 0xec, 0xe7, 0xac, 0x31,
+    0xc2, 0x59, 0xe7, 0xcc, 0xc0, 0x9e, 0x66, 0x7c, 0x46, 0x7a, 0xef, 0xf8, 0xd5, 0x0b, 0xcc, 0x84,
+    0x93, 0x53, 0x30, 0x8e, 0x90, 0x49, 0x14, 0x19, 0x61, 0x6a, 0x8d, 0x82, 0x97, 0x19, 0xd3, 0x3d,
+    0xde, 0x36, 0xe3, 0xa5, 0x73, 0x85, 0x15, 0x6c, 0x63, 0xe3, 0xe3, 0x01, 0x87, 0x42, 0x13, 0x8b,
+    0xab, 0xb1, 0x2a, 0x6a, 0x6d, 0xa7, 0x48, 0x3d, 0xf1, 0xda, 0xf6, 0x97, 0x9d, 0x2a, 0xef, 0x94,
+    0xfe, 0x4d, 0xc3, 0x4b, 0xeb, 0x6f, 0xed, 0xf4, 0xc1, 0xaa, 0x28, 0x8c, 0x15, 0x3b, 0x12, 0x15,
+    0x93, 0x64, 0xf0, 0x9c, 0x1c, 0x5b, 0xa2, 0x9b, 0x21, 0xe9, 0xf1, 0x42, 0xcd, 0xdc, 0x91, 0xf1,
+    0xec, 0x05, 0x01, 0x53, 0x34, 0x0c, 0xec, 0x3a, 0x06, 0x7d, 0xb8, 0xe3, 0xc5, 0xbc, 0x66, 0x8d,
+    0xb5, 0x04, 0xda, 0xa5, 0xd6, 0x33, 0x5d, 0xca, 0xac, 0x0a, 0xa0, 0x56, 0x5c, 0x0a, 0x3e, 0xa3,
+    0x02, 0x2f, 0x22, 0xaa, 0xff, 0x42, 0xe8, 0x2a, 0x0a, 0x07, 0xd4, 0xf7, 0x1d, 0xe9, 0x2e, 0xd9,
+    0x6a, 0x3d, 0x1c, 0x8d, 0x48, 0xa2, 0xca, 0xeb, 0xc3, 0x58, 0xd6, 0x9c, 0x79, 0x47, 0xbe, 0x4d,
+    0xc3, 0x31, 0xf7, 0xb7, 0xa8, 0xf8, 0xc7, 0xde, 0x38, 0x0c, 0xd2, 0x7f, 0x7f, 0x7f, 0xfb, 0xd3,
+    0x4d, 0x35, 0xa3, 0xa8, 0x7c, 0x3d, 0xa1, 0x21, 0xbb, 0x1b, 0xb9, 0xfc, 0x50, 0x4b, 0x69, 0xec,
+    0xf9, 0x7b, 0x95, 0x53, 0x42, 0xd5, 0xb0, 0x0e, 0xfe, 0x3f, 0xa9, 0xf5, 0xaa, 0xce, 0x71, 0x32,
+    0xd5, 0x22, 0x27, 0x7a, 0x1f, 0x7e, 0xf9, 0x63, 0x80, 0x77, 0x33, 0xab, 0x7e, 0x38, 0x30, 0xc5,
+    0x51, 0x5e, 0x09, 0x5a, 0x81, 0x96, 0x97, 0xd1, 0xa2, 0x97, 0xd6, 0x2c, 0x1c, 0xc5, 0xb6, 0x44,
+    0x15, 0xc9, 0x9a, 0xe5, 0x3b, 0x5d, 0xaf, 0x8d, 0xc8, 0xe1, 0xc9, 0x5f, 0xb0, 0x91, 0x65, 0x1a,
+    0x29, 0x71, 0x57, 0x63, 0xc0, 0xfa, 0x69, 0x47, 0x0d, 0xd9, 0x79, 0xb6, 0xc7, 0x73, 0x9c, 0x04,
+    0xed, 0xc2, 0x05, 0xf3, 0xe4, 0x1d, 0xbc, 0x6a, 0xf4, 0xf9, 0xdf, 0x7c, 0x76, 0x71, 0x37, 0x19,
+    0x33, 0x3f, 0xc5, 0xfa, 0x54, 0x27, 0x86, 0x6b, 0x31, 0xb7, 0x2d, 0x66, 0xd1, 0x28, 0xee, 0x6b,
+    0x69, 0x91, 0x46, 0x34, 0x82, 0x1f, 0xbb, 0x0a, 0xbc, 0xce, 0x9e, 0x62, 0x64, 0x1b, 0xd3, 0xb3,
+    0xd7, 0x30, 0x49, 0x41, 0xc7, 0xfb, 0xd4, 0xb6, 0xd1, 0xa8, 0xdb, 0xdb, 0x77, 0x7b, 0x3d, 0x00,
+    0x00, 0xf7, 0x1d, 0x9d, 0xc1, 0x04, 0xf2, 0x9a, 0x37, 0x15, 0x2a, 0x1b, 0x4f, 0xd1, 0x3e, 0x96,
+    0xe8, 0x1e, 0x37, 0x8f, 0x9f, 0xe5, 0x51, 0xb8, 0x30, 0x6b, 0xc2, 0xd1, 0x83, 0x8b, 0x9b, 0xa2,
+    0x80, 0x68, 0x3f, 0x66, 0x44, 0xf0, 0x00, 0x47, 0x0b, 0x88, 0x00, 0x59, 0x2c, 0x68, 0x6c, 0xe8,
+    0xa7, 0x7b, 0x5b, 0xcf, 0x09, 0x37, 0x4c, 0xe6, 0x69, 0x08, 0xb7, 0x9d, 0xb1, 0xcb, 0x1d, 0x4c,
+    0x68, 0xcb, 0xe7, 0x0f, 0xd6, 0x21, 0x5c, 0xcc, 0x5e, 0x08, 0x6b, 0x10, 0xee, 0x52, 0x23, 0x61,
+    0x38, 0x22, 0xfb, 0x10, 0xe4, 0xf9, 0xfb, 0xa6, 0xb0, 0x6b, 0xb0, 0xd3, 0xa8, 0x99, 0x05, 0x87,
+    0xb1, 0x1f, 0xe7, 0xb5, 0x42, 0x7f, 0x38, 0x76, 0xcd, 0x15, 0x77, 0xbb, 0xb6, 0xb6, 0x4c, 0xc2,
+    0xed, 0x05, 0x0e, 0x00, 0xe1, 0x1d, 0xd8, 0xe5, 0xa5, 0x16, 0xb6, 0xbf, 0x4a, 0x9e, 0xe6, 0xee,
+    0xea, 0xd9, 0x69, 0x47, 0x87, 0x44, 0x91, 0xe2, 0xdc, 0xf1, 0x80, 0x68, 0xa1, 0xc1, 0x47, 0x9e,
+    0x89, 0x23, 0x71, 0x15, 0x50, 0xd5, 0x34, 0x2f, 0x38, 0x6b, 0xdd, 0x6e, 0x31, 0x5b, 0xc6, 0x1c,
+    0x85, 0xf4, 0x50, 0x15, 0xbd, 0x78, 0x68, 0xfa, 0x6c, 0x19, 0x62, 0xb6, 0xb2, 0xbc, 0xbc, 0xdc,
+    0x4a, 0x30, 0xc9, 0x78, 0x9e, 0x26, 0x7d, 0x04, 0x1d, 0xe5, 0x49, 0x30, 0xa0, 0x0c, 0x61, 0x00,
+    0x07, 0x4c, 0x36, 0xd8, 0xef, 0xf7, 0x02, 0xdd, 0x58, 0xef, 0xef, 0xb9, 0xf8, 0x0d, 0xa9, 0x50,
+    0x4c, 0x37, 0x91, 0x04, 0x99, 0x76, 0xb0, 0xb8, 0x71, 0x4b, 0xa3, 0x64, 0xad, 0x53, 0x4a, 0xd3,
+    0xd9, 0xee, 0x36, 0x95, 0x67, 0xe0, 0x86, 0xbb, 0x7b, 0x77, 0x5d, 0x9e, 0xb8, 0x95, 0x0f, 0x03,
+    0x31, 0xf5, 0x6f, 0xa5, 0xcb, 0x23, 0xbf, 0xf4, 0x67, 0x8e, 0x77, 0x78, 0x99, 0xec, 0x37, 0x80,
+    0x92, 0x66, 0x54, 0x9b, 0x73, 0x17, 0x37, 0xb2, 0x73, 0x89, 0x74, 0x6c, 0xc3, 0xcf, 0x65, 0xff,
+    0xc3, 0x6f, 0x3f, 0x0f, 0x87, 0x08, 0xcb, 0x28, 0xd2, 0xbc, 0x94, 0xb5, 0x9b, 0xe2, 0xf1, 0x17,
+    0xba, 0x6a, 0x1b, 0x53, 0x62, 0xfe, 0x59, 0x7f, 0xd7, 0x7c, 0x65, 0xba, 0x76, 0x0d, 0xfb, 0x11,
+    0x4f, 0x9f, 0x00, 0x5b, 0x34, 0xee, 0x9e, 0xde, 0x74, 0x2d, 0xd0, 0xae, 0xaf, 0x75, 0xa0, 0x6f,
+    0xb6, 0x2f, 0xee, 0xbf, 0x8f, 0xf6, 0x5c, 0xff, 0x45, 0xe1, 0x90, 0xf0, 0xc8, 0x3e, 0xa4, 0x0f,
+    0x1b, 0x3a, 0x23, 0x4a, 0xfb, 0xf1, 0x31, 0x3b, 0xa4, 0xe2, 0x79, 0x22, 0x8e, 0x30, 0x8f, 0x56,
+    0x2f, 0xfa, 0xf1, 0xd3, 0x48, 0x2e, 0xaf, 0x37, 0x40, 0x59, 0xda, 0xbe, 0x86, 0xd5, 0x0b, 0x1c,
+    0xce, 0x9c, 0x76, 0x8f, 0xda, 0xe3, 0x99, 0x7b, 0xab, 0x52, 0xc5, 0x0e, 0x46, 0xe3, 0x1d, 0x58,
+    0x75, 0x25, 0xff, 0xc0, 0x4f, 0xb2, 0x7e, 0x82, 0xd1, 0x8c, 0xf3, 0xdf, 0x73, 0xf4, 0x21, 0xe5,
+    0xbf, 0x31, 0xff, 0x03, 0xd3, 0x09, 0x1e, 0x4c, 0x7b, 0x0a, 0x00, 0x00,
+};
+
+// debug.html: 1087 bytes, 610 gzip
+static const uint8_t ASSET_DEBUG_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x54, 0xcd, 0x6e, 0xd3, 0x40,
+    0x10, 0xbe, 0xf7, 0x29, 0x06, 0x5f, 0x9c, 0x08, 0xc5, 0x6e, 0x23, 0xa4, 0x56, 0xc5, 0x76, 0xd5,
+    0x9f, 0x20, 0x55, 0x88, 0x82, 0x68, 0x8a, 0x04, 0xb7, 0xb5, 0x77, 0x62, 0x6f, 0xb3, 0x59, 0x47,
+    0xbb, 0xe3, 0xa6, 0x11, 0xe2, 0x8c, 0xc4, 0x05, 0x24, 0x90, 0x38, 0x80, 0x54, 0x1e, 0xa4, 0xb7,
+    0xbe, 0x09, 0x4f, 0xd0, 0x47, 0x60, 0xbd, 0xb6, 0x9b, 0x84, 0x43, 0x4f, 0xbb, 0xfe, 0xbe, 0x9d,
+    0x6f, 0xbe, 0x99, 0xd9, 0x75, 0xf4, 0xe4, 0xe4, 0xf5, 0xf1, 0xf8, 0xfd, 0x9b, 0x11, 0x14, 0x34,
+    0x93, 0xc9, 0x56, 0xd4, 0x2d, 0xc8, 0x78, 0xb2, 0x05, 0x10, 0xcd, 0x90, 0x18, 0x64, 0x05, 0xd3,
+    0x06, 0x29, 0xf6, 0x2e, 0xc6, 0x2f, 0x06, 0x7b, 0x9e, 0x23, 0x48, 0x90, 0xc4, 0xe4, 0x04, 0xd3,
+    0x2a, 0x1f, 0xbc, 0x2a, 0x79, 0x65, 0xa2, 0xb0, 0x81, 0x6a, 0x52, 0x0a, 0x35, 0x05, 0x8d, 0x32,
+    0xf6, 0x0c, 0x2d, 0x25, 0x9a, 0x02, 0x91, 0x3c, 0x28, 0x34, 0x4e, 0x62, 0x2f, 0x74, 0x50, 0x90,
+    0x19, 0x73, 0x70, 0x15, 0x4f, 0x76, 0x87, 0xc3, 0xdd, 0x61, 0x96, 0xed, 0xed, 0x3c, 0xdb, 0xe6,
+    0x0c, 0x77, 0xac, 0x76, 0x14, 0x36, 0xc9, 0xa3, 0xb4, 0xe4, 0x4b, 0xa7, 0x56, 0x0c, 0x93, 0xfb,
+    0x9b, 0x6f, 0xbf, 0x60, 0x23, 0x99, 0x05, 0x6b, 0x8e, 0x8b, 0x2b, 0xc8, 0x24, 0x33, 0x26, 0xf6,
+    0xb2, 0x52, 0x11, 0x13, 0x0a, 0xb5, 0x33, 0xb8, 0xc9, 0x09, 0x35, 0x29, 0x07, 0x69, 0x79, 0xdd,
+    0x52, 0x9b, 0xa4, 0x21, 0x46, 0x95, 0xf1, 0x92, 0x73, 0xb7, 0xee, 0x43, 0x64, 0xe6, 0x4c, 0x81,
+    0xe0, 0x0d, 0x83, 0x5e, 0x12, 0x04, 0x41, 0x14, 0xd6, 0x60, 0x12, 0x85, 0x36, 0xae, 0x95, 0x5f,
+    0xdb, 0xce, 0x6d, 0x23, 0xf4, 0xba, 0x3f, 0x30, 0x84, 0x15, 0x6a, 0x02, 0x2e, 0x10, 0x0c, 0x6a,
+    0x81, 0x52, 0x22, 0x1c, 0x56, 0x26, 0x67, 0x29, 0xc2, 0xdd, 0x6d, 0x6a, 0x8f, 0x5f, 0x9c, 0x1f,
+    0x05, 0x70, 0x84, 0xc2, 0xc6, 0xb1, 0x29, 0x89, 0x2b, 0x81, 0xba, 0x52, 0x39, 0x2c, 0x50, 0x73,
+    0x54, 0x30, 0x45, 0x5b, 0x4a, 0x27, 0x89, 0x92, 0x5b, 0xca, 0xa2, 0x33, 0x2c, 0x34, 0x30, 0x2b,
+    0x83, 0x39, 0xa6, 0xa8, 0xac, 0xad, 0x79, 0x6b, 0x21, 0xad, 0x88, 0x4a, 0xd5, 0x95, 0x44, 0x65,
+    0x9e, 0x4b, 0x1c, 0xa4, 0xa4, 0x3c, 0x57, 0x48, 0xf3, 0xdd, 0x56, 0xd2, 0x1c, 0x6d, 0xe3, 0x58,
+    0x37, 0x16, 0x2f, 0xe9, 0x34, 0x68, 0x39, 0xc7, 0xd8, 0x6b, 0x3e, 0x3c, 0xdb, 0xfa, 0xaf, 0x7f,
+    0xe0, 0x43, 0xa5, 0xef, 0x6e, 0xb3, 0xe9, 0x43, 0x6c, 0x14, 0x32, 0xd7, 0xfe, 0xae, 0x07, 0x91,
+    0xc9, 0xb4, 0x98, 0x53, 0xa3, 0x39, 0x41, 0xca, 0x8a, 0x9e, 0x1f, 0xf2, 0xda, 0x7c, 0x70, 0x69,
+    0x4a, 0xe5, 0xf7, 0x03, 0x2a, 0x50, 0xf5, 0x34, 0xc4, 0x09, 0x68, 0x07, 0xf5, 0xfa, 0x2d, 0x76,
+    0x59, 0x63, 0x1f, 0xdb, 0xb1, 0xd8, 0x19, 0x1a, 0x02, 0x03, 0x31, 0xf0, 0x32, 0xab, 0x66, 0xa8,
+    0x28, 0xc8, 0x91, 0x46, 0x12, 0xeb, 0xed, 0xd1, 0xf2, 0x94, 0xf7, 0x7c, 0x37, 0x13, 0xbf, 0xff,
+    0xbc, 0x8d, 0x30, 0x81, 0x2b, 0xf9, 0x8c, 0xcd, 0xd0, 0x46, 0x5d, 0x06, 0xa8, 0x58, 0x2a, 0x91,
+    0xc3, 0x01, 0xf8, 0x36, 0x2f, 0xec, 0xdb, 0x65, 0x32, 0xf1, 0x57, 0xa7, 0x09, 0xaf, 0xe9, 0xd8,
+    0xde, 0x14, 0xab, 0xf7, 0xff, 0xf9, 0xc3, 0x97, 0xe3, 0xd3, 0x77, 0xa7, 0xa3, 0xb7, 0x63, 0xf8,
+    0xfb, 0xfb, 0xbb, 0x0b, 0x3d, 0x19, 0xad, 0x63, 0x3f, 0x1f, 0x64, 0x1a, 0x9b, 0xe9, 0x63, 0x36,
+    0x9b, 0x8e, 0xaf, 0x7c, 0xa6, 0x8f, 0x65, 0xbe, 0xbf, 0xf9, 0xf1, 0xb9, 0x99, 0x35, 0xac, 0x52,
+    0x8e, 0xce, 0x9c, 0x07, 0xcb, 0x7d, 0x69, 0xb9, 0x35, 0x66, 0x25, 0x5b, 0xaa, 0x4c, 0x8a, 0x6c,
+    0x6a, 0x25, 0x7b, 0xfd, 0xba, 0x95, 0x0b, 0xa1, 0x78, 0xb9, 0x08, 0x64, 0x99, 0x31, 0x12, 0xa5,
+    0x0a, 0xea, 0xf1, 0x5a, 0xb2, 0x1d, 0x47, 0x68, 0xdf, 0xf1, 0x41, 0x9b, 0x39, 0xf6, 0xe1, 0x29,
+    0xf4, 0x36, 0x8c, 0x6c, 0xbb, 0x94, 0x3b, 0x9d, 0xed, 0x4f, 0x6e, 0xb5, 0x77, 0xbf, 0x9d, 0xae,
+    0x9d, 0xbf, 0x7b, 0x94, 0xf6, 0xf9, 0xb9, 0xff, 0xc4, 0x3f, 0x17, 0xd9, 0xb2, 0xa3, 0x3f, 0x04,
+    0x00, 0x00,
+};
+
+// geo.html: 2183 bytes, 980 gzip
+static const uint8_t ASSET_GEO_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x56, 0xcd, 0x6e, 0xdb, 0x46,
+    0x10, 0xbe, 0xe7, 0x29, 0xa6, 0xbc, 0x88, 0x02, 0xa2, 0x5f, 0xa7, 0x49, 0x90, 0x50, 0x34, 0xfc,
+    0xa3, 0x04, 0x45, 0xe3, 0x5a, 0xb0, 0x64, 0x04, 0xf5, 0x6d, 0x45, 0x8e, 0xc8, 0xb5, 0xc9, 0x5d,
+    0x65, 0x77, 0x29, 0x5b, 0x2a, 0x02, 0xf4, 0x05, 0x8a, 0x14, 0x2d, 0x0a, 0xb4, 0xbd, 0xa4, 0x87,
+    0x3e, 0x40, 0x4f, 0x45, 0x0f, 0x45, 0x0f, 0xf5, 0x9b, 0xe4, 0x05, 0x9a, 0x47, 0xe8, 0x2c, 0x97,
+    0xfa, 0x4b, 0x51, 0x2b, 0x3a, 0x48, 0xb3, 0xb3, 0x33, 0xf3, 0xed, 0x37, 0x7f, 0x76, 0xf0, 0xc9,
+    0xf1, 0xe9, 0xd1, 0xe8, 0xcb, 0x41, 0x1f, 0x52, 0x93, 0x67, 0xe1, 0xbd, 0x60, 0xf9, 0x83, 0x2c,
+    0x0e, 0xef, 0x01, 0x04, 0x39, 0x1a, 0x06, 0x51, 0xca, 0x94, 0x46, 0xd3, 0xf3, 0xce, 0x47, 0xcf,
+    0x1a, 0x8f, 0xbd, 0xf2, 0xc2, 0x70, 0x93, 0x61, 0xf8, 0xb9, 0x14, 0x13, 0x9e, 0x14, 0x8a, 0x19,
+    0x2e, 0x45, 0xd0, 0x72, 0x4a, 0x7b, 0x9d, 0x71, 0x71, 0x05, 0x0a, 0xb3, 0x9e, 0xa7, 0xcd, 0x3c,
+    0x43, 0x9d, 0x22, 0x1a, 0x0f, 0x52, 0x85, 0x93, 0x9e, 0xd7, 0x2a, 0x55, 0xcd, 0x48, 0xeb, 0xfd,
+    0x59, 0x6f, 0xf2, 0xa8, 0xdb, 0x7d, 0xd4, 0x8d, 0xa2, 0xc7, 0x9d, 0x07, 0xed, 0x98, 0x61, 0x87,
+    0xa2, 0x07, 0x2d, 0x07, 0x1f, 0x8c, 0x65, 0x3c, 0x2f, 0xa3, 0xa5, 0xdd, 0xf0, 0xdd, 0xcf, 0x3f,
+    0xfd, 0xf3, 0xc7, 0x1b, 0x18, 0xce, 0xb5, 0xc1, 0x1c, 0x3e, 0xc0, 0xa5, 0x7b, 0x6b, 0x36, 0x91,
+    0x2a, 0x07, 0x16, 0x59, 0x1d, 0xa1, 0x24, 0x28, 0x5b, 0x9a, 0xcd, 0xd0, 0x03, 0x22, 0x91, 0xca,
+    0xb8, 0xe7, 0x0d, 0x4e, 0x87, 0xa3, 0xf2, 0xf5, 0x36, 0xe4, 0x5e, 0xf8, 0xfe, 0xed, 0xf7, 0xdf,
+    0xc0, 0x73, 0x94, 0x8d, 0x81, 0xd4, 0xbc, 0x0a, 0xb4, 0xe7, 0xae, 0x0f, 0x15, 0x72, 0x83, 0x22,
+    0x51, 0x2c, 0x06, 0xff, 0x05, 0xa1, 0x98, 0x22, 0xc6, 0xfa, 0x13, 0x08, 0xb8, 0x98, 0x16, 0x06,
+    0xcc, 0x7c, 0x8a, 0x3d, 0x4f, 0x14, 0xf9, 0x18, 0x95, 0x07, 0x82, 0xe5, 0x74, 0xca, 0x18, 0x11,
+    0xe4, 0x71, 0x25, 0xd0, 0x2b, 0xa7, 0x3d, 0xaf, 0xdd, 0x6c, 0xdb, 0x4f, 0xc7, 0xa3, 0x54, 0xbc,
+    0x2a, 0xb8, 0xc2, 0x38, 0x0c, 0xc6, 0xca, 0x41, 0xbc, 0xb8, 0xfd, 0x55, 0x24, 0x2b, 0x08, 0x29,
+    0x92, 0x8f, 0xc1, 0x90, 0xa2, 0xc2, 0xb0, 0xc2, 0x6e, 0x0c, 0xc7, 0xf2, 0x87, 0x6f, 0xe1, 0x82,
+    0xe8, 0x2c, 0xa4, 0xc0, 0x35, 0xc3, 0x83, 0xc2, 0xc8, 0x9c, 0x88, 0xe9, 0x28, 0x45, 0x18, 0xca,
+    0x3c, 0x47, 0xb5, 0x20, 0x23, 0xf0, 0xfb, 0xe7, 0xf6, 0x0d, 0x1a, 0x33, 0x8c, 0x4c, 0x05, 0xcb,
+    0xc8, 0x36, 0xd6, 0x15, 0xbd, 0xe5, 0xc1, 0x85, 0x21, 0x0c, 0x39, 0xb5, 0xb9, 0x83, 0x19, 0xcb,
+    0x0a, 0xb2, 0xa5, 0x02, 0x1e, 0x5c, 0x19, 0x3e, 0xe3, 0xa8, 0x28, 0xd8, 0x49, 0xff, 0xa2, 0x75,
+    0xd2, 0x1f, 0x5e, 0xd4, 0x83, 0x96, 0x33, 0xfb, 0x1f, 0xaf, 0xb6, 0x17, 0x1e, 0x23, 0x5b, 0xfa,
+    0x6d, 0x1b, 0x07, 0x2d, 0xf7, 0x98, 0x35, 0xad, 0x13, 0x26, 0x0a, 0xcc, 0x32, 0x5c, 0xd1, 0x02,
+    0xff, 0x7c, 0x74, 0x04, 0xa7, 0x93, 0x09, 0x75, 0x29, 0x70, 0x01, 0x43, 0x53, 0x88, 0x18, 0xc5,
+    0xdd, 0xc9, 0x24, 0xcf, 0xd2, 0xc1, 0xd1, 0x5a, 0x9f, 0x96, 0x69, 0xfd, 0x94, 0x1a, 0x87, 0x53,
+    0x23, 0x35, 0x3a, 0x5d, 0x92, 0xd8, 0x0d, 0x71, 0x7b, 0xe0, 0x6d, 0xe4, 0x56, 0xe7, 0x2c, 0xcb,
+    0xc2, 0x97, 0x5c, 0xc5, 0x20, 0x0a, 0x05, 0x33, 0x54, 0xd7, 0x48, 0xa8, 0x06, 0xe8, 0x47, 0x94,
+    0xf9, 0x6d, 0x6c, 0xe4, 0x35, 0x5e, 0xd3, 0x03, 0xae, 0x89, 0xa2, 0x73, 0xdf, 0x2a, 0xd5, 0xbb,
+    0x1f, 0xbf, 0xb6, 0x3d, 0x7e, 0x86, 0x3c, 0x45, 0x01, 0xfe, 0x21, 0x8b, 0xae, 0x8c, 0xa2, 0x2f,
+    0x2e, 0x92, 0xfa, 0xba, 0x72, 0xee, 0x9a, 0x8d, 0xb5, 0x61, 0x82, 0x5a, 0x27, 0xbf, 0x0f, 0x07,
+    0x51, 0xaa, 0x11, 0x16, 0x85, 0x13, 0xee, 0x66, 0xad, 0xe4, 0xf5, 0x94, 0x9b, 0x28, 0x75, 0xac,
+    0xd7, 0xa7, 0x55, 0x33, 0x75, 0x2a, 0xda, 0xed, 0x0d, 0xae, 0x03, 0x26, 0x30, 0x1b, 0x97, 0x33,
+    0x41, 0x80, 0x77, 0x03, 0x4c, 0xad, 0xed, 0x35, 0x8f, 0x4d, 0x05, 0xb1, 0x79, 0xbe, 0x13, 0xe4,
+    0x8c, 0x47, 0x29, 0xd5, 0x2d, 0x21, 0x22, 0x0a, 0xbe, 0x60, 0x51, 0x3a, 0x66, 0x4a, 0x59, 0xae,
+    0xe0, 0xff, 0xfd, 0x1b, 0x1c, 0x2c, 0x78, 0x5e, 0x98, 0x9d, 0xdc, 0xd8, 0x62, 0x45, 0xcc, 0x8a,
+    0x0e, 0x70, 0x8d, 0xe6, 0xea, 0xb8, 0xf7, 0xb0, 0xfd, 0xdf, 0x42, 0x6e, 0x72, 0x4c, 0x6f, 0x7f,
+    0xa7, 0x4c, 0xd2, 0x02, 0xd0, 0xdb, 0xd9, 0x6e, 0xc2, 0x21, 0xf2, 0x18, 0xa1, 0x0d, 0x3d, 0xe8,
+    0x73, 0xb1, 0xc0, 0x8c, 0x89, 0x8c, 0x25, 0x78, 0x1f, 0xae, 0x90, 0xda, 0x6e, 0xb3, 0x60, 0x4d,
+    0x78, 0x7e, 0x74, 0x66, 0x07, 0x89, 0xf8, 0x97, 0x2f, 0x4a, 0x22, 0xe5, 0x85, 0x0d, 0xaa, 0x3b,
+    0x29, 0xc2, 0xcd, 0xf2, 0xaf, 0x1f, 0x32, 0x2e, 0x8c, 0xa1, 0x99, 0x70, 0xd4, 0x74, 0x31, 0xce,
+    0x39, 0x8d, 0xd9, 0xfb, 0xb7, 0xdf, 0xfd, 0x05, 0xc3, 0x29, 0x52, 0x76, 0x50, 0xd1, 0x8a, 0x72,
+    0x46, 0x95, 0x07, 0x5b, 0xae, 0x54, 0xcb, 0x67, 0xd3, 0xdb, 0x1d, 0xac, 0xf7, 0x9b, 0x5f, 0xe0,
+    0xa2, 0x50, 0xb7, 0x7f, 0x46, 0x57, 0x2b, 0xdf, 0xa0, 0xc5, 0xca, 0x7d, 0xd9, 0xb2, 0x0b, 0xb3,
+    0x94, 0x74, 0xa4, 0xf8, 0xd4, 0xb8, 0xa0, 0x13, 0xa4, 0x86, 0xf0, 0x6b, 0x76, 0x7f, 0x36, 0x2f,
+    0xb5, 0x14, 0xb5, 0x7a, 0xd3, 0x50, 0x0a, 0x7c, 0x05, 0xbd, 0x10, 0x54, 0xa9, 0xf2, 0xeb, 0x95,
+    0xee, 0xd2, 0xea, 0xbe, 0xaa, 0x66, 0x3a, 0x96, 0x51, 0x91, 0xa3, 0x30, 0xcd, 0x04, 0x4d, 0x3f,
+    0x43, 0x2b, 0x1e, 0xce, 0x3f, 0x8b, 0xfd, 0x1a, 0x6d, 0x44, 0x0a, 0x52, 0x8e, 0x3a, 0x25, 0xee,
+    0xb2, 0x99, 0x55, 0x0b, 0xf5, 0xe9, 0x4e, 0xc7, 0x12, 0x7d, 0xc3, 0x71, 0xb9, 0x26, 0x77, 0x7a,
+    0x56, 0x5b, 0x6a, 0xcb, 0xbb, 0xd0, 0x68, 0xa7, 0xf2, 0x78, 0x38, 0x82, 0x7d, 0xa8, 0x75, 0x6a,
+    0xf0, 0x04, 0x6a, 0xed, 0xda, 0xce, 0x50, 0xcb, 0xcd, 0xb0, 0x15, 0x2b, 0xa7, 0x15, 0xc4, 0xb2,
+    0x11, 0xcf, 0xd1, 0xee, 0x1f, 0xb7, 0x79, 0x76, 0x46, 0x5a, 0x4e, 0xdb, 0x56, 0x24, 0x52, 0x0e,
+    0xac, 0x72, 0xa7, 0xf7, 0x7a, 0x90, 0xb6, 0xfc, 0x4b, 0xf5, 0x4b, 0xab, 0xfe, 0x18, 0x7c, 0xb6,
+    0xf8, 0x10, 0xdc, 0x0d, 0xd6, 0x6e, 0x67, 0xea, 0x5f, 0xdb, 0x09, 0x78, 0x63, 0x8e, 0xa4, 0xa0,
+    0xd1, 0x30, 0x65, 0x00, 0xd2, 0x42, 0x48, 0xf3, 0xb0, 0xef, 0xe4, 0xa6, 0x91, 0xcf, 0xf8, 0x0d,
+    0xc6, 0x7e, 0xb7, 0x6e, 0xb3, 0xdb, 0xa8, 0xb2, 0xfb, 0xba, 0xfe, 0xb4, 0xec, 0xb7, 0x65, 0x9b,
+    0x51, 0x27, 0x96, 0x7f, 0xda, 0x69, 0xa9, 0x95, 0xff, 0x6f, 0xfc, 0x0b, 0xdc, 0x87, 0xe2, 0xbf,
+    0x87, 0x08, 0x00, 0x00,
+};
+
+// index.html: 9208 bytes, 2758 gzip
+static const uint8_t ASSET_INDEX_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0xdd, 0x6e, 0xdb, 0xc8,
+    0x15, 0xbe, 0xdf, 0xa7, 0x98, 0xc8, 0x40, 0x48, 0xd6, 0x12, 0x45, 0x49, 0x96, 0xe2, 0xe8, 0x6f,
+    0xe1, 0x75, 0xec, 0xdd, 0x74, 0x9d, 0xc4, 0x88, 0xbd, 0x75, 0xb3, 0xc5, 0xa2, 0x18, 0x91, 0x23,
+    0x69, 0x2c, 0x9a, 0x34, 0xc8, 0xa1, 0x65, 0x39, 0x1b, 0xa0, 0xbd, 0xe8, 0x5d, 0x8b, 0x5d, 0x20,
+    0x2d, 0xba, 0xbb, 0x5d, 0x20, 0x2d, 0xd0, 0x07, 0xd8, 0xcb, 0x5e, 0xb7, 0x6f, 0x92, 0x17, 0x68,
+    0x1e, 0xa1, 0x67, 0x66, 0xf8, 0x33, 0x24, 0x25, 0x59, 0xc6, 0xba, 0x49, 0x10, 0xcb, 0x3c, 0xbf,
+    0x73, 0xe6, 0x9c, 0xef, 0x9c, 0x19, 0xaa, 0xff, 0xe0, 0xc9, 0x8b, 0xfd, 0xd3, 0x57, 0xc7, 0x07,
+    0x68, 0xca, 0x2e, 0xdc, 0xe1, 0x47, 0xfd, 0xe4, 0x07, 0xc1, 0xce, 0xf0, 0x23, 0x84, 0xfa, 0x17,
+    0x84, 0x61, 0x64, 0x4f, 0x71, 0x10, 0x12, 0x36, 0xa8, 0x7c, 0x71, 0x7a, 0x58, 0xdb, 0xad, 0x08,
+    0x02, 0xa3, 0xcc, 0x25, 0xc3, 0x13, 0xdf, 0xc5, 0xc1, 0x69, 0x80, 0xed, 0x19, 0x09, 0xfa, 0x75,
+    0xf9, 0x8c, 0x53, 0x43, 0xb6, 0x90, 0x9f, 0x10, 0x1a, 0xf9, 0xce, 0x02, 0xbd, 0x46, 0x63, 0xdf,
+    0x63, 0xb5, 0x31, 0xbe, 0xa0, 0xee, 0xa2, 0x8b, 0x42, 0xec, 0x85, 0xb5, 0x90, 0x04, 0x74, 0xdc,
+    0x43, 0x23, 0x10, 0x9e, 0x04, 0x7e, 0xe4, 0x39, 0xdd, 0xad, 0xf1, 0x0e, 0xff, 0xdb, 0x43, 0x97,
+    0xd8, 0x71, 0xa8, 0x37, 0xe9, 0x36, 0xad, 0xcb, 0xeb, 0x1e, 0x7a, 0x23, 0xf4, 0x4c, 0x1b, 0xa0,
+    0xe5, 0x02, 0x07, 0x13, 0xea, 0xd5, 0x46, 0x3e, 0x63, 0xfe, 0x45, 0x17, 0x35, 0x14, 0xfa, 0x28,
+    0x82, 0x67, 0x1e, 0xf0, 0x24, 0xc2, 0x9c, 0x88, 0x1a, 0xbb, 0x9c, 0x43, 0x8a, 0x75, 0xdb, 0xfc,
+    0xb3, 0x70, 0x24, 0xa4, 0x37, 0xa4, 0xdb, 0xe8, 0x64, 0xd2, 0xa6, 0x3f, 0x03, 0x51, 0xd5, 0x97,
+    0x9d, 0xfd, 0xbd, 0xc3, 0xb6, 0xd5, 0x43, 0xb6, 0xef, 0xfa, 0x41, 0x77, 0x3e, 0xa5, 0x8c, 0x80,
+    0xb3, 0x7e, 0xe0, 0x90, 0xa0, 0xeb, 0xf9, 0x1e, 0x49, 0x25, 0x43, 0xe6, 0x5f, 0x16, 0x64, 0xc7,
+    0x3b, 0x3b, 0xad, 0x56, 0x67, 0x03, 0x59, 0xea, 0x8d, 0xfd, 0x82, 0x6c, 0xb3, 0xf1, 0xb8, 0x73,
+    0xd8, 0xba, 0x5d, 0x76, 0x2b, 0x64, 0x98, 0x45, 0xe1, 0x27, 0xfe, 0x75, 0x16, 0x17, 0xf0, 0xa4,
+    0xdb, 0x10, 0xab, 0x54, 0x83, 0x90, 0x8b, 0x71, 0x5e, 0x61, 0x03, 0x42, 0x14, 0xfa, 0x2e, 0x75,
+    0xd0, 0x96, 0x6d, 0xdb, 0xa9, 0x5b, 0x8c, 0x5e, 0x90, 0x64, 0xcf, 0x44, 0xa8, 0xe2, 0x38, 0x8a,
+    0x07, 0x73, 0x42, 0x27, 0x53, 0xd6, 0x05, 0x15, 0xae, 0x93, 0xb8, 0x89, 0xb6, 0x5a, 0xad, 0x56,
+    0x6f, 0xdd, 0xf6, 0x6c, 0x5d, 0xd1, 0x30, 0xc2, 0xee, 0x3e, 0x68, 0xc0, 0xd4, 0x23, 0xc1, 0x3d,
+    0x3a, 0xcd, 0xc8, 0x35, 0xab, 0x61, 0x97, 0x4e, 0xbc, 0xae, 0x4d, 0x3c, 0x46, 0x82, 0xd4, 0x26,
+    0x93, 0x99, 0xb9, 0x8f, 0xbd, 0x2b, 0x1c, 0xf2, 0x38, 0x97, 0x14, 0x38, 0x8e, 0x93, 0x4f, 0x41,
+    0xb2, 0x0b, 0x29, 0x38, 0x96, 0x1a, 0xfa, 0xf5, 0x38, 0x8f, 0xfb, 0x75, 0x59, 0x10, 0x7d, 0x9e,
+    0xcc, 0x22, 0xc1, 0xa7, 0x8d, 0x5c, 0xee, 0xa3, 0x83, 0x93, 0xe3, 0x56, 0x13, 0xd8, 0x1a, 0x82,
+    0xea, 0xd0, 0x2b, 0x44, 0x9d, 0x41, 0x85, 0xc7, 0x11, 0x36, 0xa8, 0x82, 0x6c, 0x17, 0x87, 0xa1,
+    0xfc, 0xbd, 0x32, 0xfc, 0x92, 0x50, 0x86, 0xe6, 0x34, 0x70, 0xd0, 0x84, 0xb8, 0xd8, 0x21, 0x9e,
+    0x69, 0x9a, 0xfd, 0x3a, 0xc8, 0x08, 0xd9, 0x4b, 0x59, 0x36, 0xfd, 0x38, 0x9f, 0x63, 0x49, 0x7f,
+    0x56, 0x41, 0xbe, 0x67, 0xbb, 0xd4, 0x9e, 0x0d, 0x2a, 0x63, 0xc2, 0xec, 0xa9, 0xae, 0xd5, 0xe7,
+    0x04, 0xb3, 0x29, 0x09, 0x3e, 0x0e, 0x20, 0xa2, 0x03, 0xeb, 0xe1, 0x6c, 0x30, 0x23, 0x8b, 0x5a,
+    0xa3, 0xd9, 0xd2, 0x0c, 0x13, 0x9e, 0x7b, 0x7a, 0x30, 0x18, 0xba, 0x3e, 0x76, 0x4e, 0x44, 0xa2,
+    0xe8, 0x86, 0x51, 0x01, 0x9f, 0x3d, 0x8f, 0xa0, 0x3a, 0x3a, 0x03, 0x17, 0x78, 0xc5, 0x4a, 0x23,
+    0x4b, 0x2d, 0xf2, 0xb4, 0xbe, 0xcd, 0x66, 0x63, 0x13, 0x9b, 0x2f, 0xc9, 0x84, 0x78, 0x60, 0xf3,
+    0x04, 0x14, 0x5e, 0xae, 0x35, 0xc9, 0xab, 0x41, 0x31, 0xa9, 0xea, 0x01, 0xd7, 0xc5, 0x27, 0x24,
+    0x02, 0x76, 0x17, 0x2d, 0x73, 0xea, 0x39, 0xfe, 0xdc, 0x74, 0x7d, 0x1b, 0x33, 0xea, 0x7b, 0xe6,
+    0x34, 0x20, 0xe3, 0x81, 0x56, 0x9f, 0x52, 0x58, 0x60, 0xb0, 0xd0, 0x2a, 0xc3, 0xcf, 0xc4, 0x27,
+    0x4a, 0x10, 0x2c, 0x2b, 0xe2, 0xe9, 0x73, 0x5f, 0x26, 0x26, 0xc4, 0x07, 0xf5, 0x1f, 0xde, 0xbd,
+    0xfd, 0x13, 0x3a, 0xf6, 0x43, 0xca, 0x49, 0xe8, 0x3f, 0xff, 0xf4, 0x20, 0x03, 0xef, 0x43, 0xfb,
+    0x9c, 0x8e, 0xa9, 0x54, 0xff, 0x0f, 0x74, 0x46, 0x0f, 0xe9, 0x3d, 0xaa, 0xb6, 0xa1, 0x98, 0x46,
+    0x01, 0x66, 0x04, 0xf4, 0xbf, 0xff, 0xe1, 0xfb, 0xff, 0xfe, 0xeb, 0x1b, 0xf4, 0xb9, 0x78, 0x44,
+    0x79, 0x84, 0x26, 0xf7, 0x60, 0xc1, 0x21, 0xa3, 0x68, 0x22, 0xbc, 0xff, 0xf6, 0x6f, 0xe8, 0x09,
+    0xff, 0xa5, 0xf6, 0xcc, 0x77, 0xa2, 0x50, 0x55, 0xdd, 0xaf, 0x5f, 0xe6, 0x8a, 0xa9, 0x00, 0x20,
+    0x95, 0xd8, 0xfc, 0xb4, 0x35, 0x4c, 0x8a, 0xf0, 0x57, 0x82, 0x83, 0x86, 0x89, 0x9b, 0x40, 0x92,
+    0x3c, 0xb6, 0x04, 0x00, 0x51, 0x92, 0x2a, 0x24, 0x54, 0xa0, 0x0c, 0x1d, 0x36, 0x1d, 0x54, 0x76,
+    0x2c, 0xab, 0x02, 0xfb, 0xcf, 0x81, 0x4d, 0xfe, 0x32, 0xec, 0xd7, 0xa5, 0x90, 0xf4, 0x24, 0x29,
+    0xce, 0xc4, 0x97, 0x14, 0x7b, 0xd3, 0xbc, 0x5c, 0x5e, 0xcf, 0xa2, 0x17, 0xda, 0x01, 0xbd, 0x64,
+    0xd2, 0x93, 0x71, 0xe4, 0xd9, 0x22, 0x0f, 0x9c, 0x00, 0xcf, 0x63, 0xb7, 0xf5, 0x73, 0x03, 0xbd,
+    0x16, 0x54, 0x04, 0x68, 0xea, 0x85, 0x0c, 0xc5, 0xee, 0x0e, 0x90, 0xe3, 0xdb, 0xd1, 0x05, 0x40,
+    0x9a, 0x39, 0x21, 0xec, 0xc0, 0x25, 0xfc, 0xe3, 0x27, 0x8b, 0xa7, 0x8e, 0xae, 0xe5, 0x56, 0xa1,
+    0x19, 0xbd, 0xbc, 0x38, 0xbb, 0x06, 0x59, 0xa9, 0x84, 0x4b, 0xf2, 0x90, 0x01, 0x44, 0xea, 0x5a,
+    0xd3, 0x29, 0xb2, 0xce, 0x33, 0x46, 0x11, 0x89, 0x3c, 0x75, 0x9a, 0x51, 0x65, 0x6c, 0x0a, 0x76,
+    0xb8, 0x99, 0x39, 0x54, 0x76, 0xb3, 0xf0, 0x7c, 0x01, 0xcf, 0xa7, 0xf2, 0x79, 0x42, 0x60, 0xd7,
+    0xa6, 0xed, 0x12, 0x1c, 0xbc, 0x24, 0x36, 0xd3, 0xad, 0x2a, 0x82, 0x7f, 0xf3, 0x2a, 0x9a, 0x1a,
+    0x39, 0x8e, 0x31, 0x75, 0xdd, 0x13, 0x8e, 0xb8, 0x20, 0xaf, 0xc5, 0x48, 0xac, 0xf5, 0x0a, 0x0c,
+    0x6b, 0x35, 0x84, 0x2c, 0xf0, 0x67, 0x24, 0xd3, 0xf1, 0xf8, 0xf1, 0xe3, 0x9c, 0x02, 0x17, 0x32,
+    0xe7, 0x8c, 0x2f, 0x14, 0xa8, 0x0d, 0x95, 0x30, 0x22, 0xd0, 0x8a, 0x8e, 0x01, 0xda, 0x74, 0x43,
+    0x7d, 0x8c, 0x03, 0x5b, 0xb7, 0xaf, 0xab, 0xb0, 0xa4, 0x2a, 0x6a, 0xb4, 0xa5, 0xd5, 0x26, 0xfa,
+    0x05, 0x7a, 0x06, 0x9c, 0xe6, 0xf1, 0xd3, 0x1c, 0xaf, 0xb4, 0xad, 0xaf, 0x77, 0x08, 0x1a, 0x56,
+    0xce, 0x21, 0x18, 0xab, 0x8e, 0xc0, 0xa7, 0x27, 0x38, 0x9c, 0xea, 0xbf, 0x69, 0x57, 0x51, 0xfb,
+    0x2b, 0x63, 0x03, 0xb7, 0x2e, 0xfc, 0x2b, 0x72, 0xea, 0xc7, 0x9e, 0xa1, 0x1a, 0x77, 0xcd, 0x28,
+    0x2e, 0x33, 0xa3, 0x6f, 0x97, 0xe8, 0xa9, 0xbc, 0x94, 0xe5, 0x5c, 0xcb, 0xe5, 0xa5, 0x6c, 0x89,
+    0x9e, 0x2d, 0x75, 0xc5, 0x4a, 0xbe, 0x5a, 0xb7, 0xb1, 0x9d, 0x4e, 0x27, 0xbf, 0xab, 0x90, 0x9f,
+    0x9c, 0xd0, 0x68, 0xf2, 0xbe, 0x9c, 0x8e, 0x86, 0x39, 0x1e, 0x9e, 0xc0, 0x7b, 0xbc, 0xc5, 0x73,
+    0x46, 0xd9, 0xe5, 0x4b, 0x99, 0x71, 0x2a, 0x92, 0xfc, 0xb9, 0x06, 0xee, 0xa6, 0x81, 0xe9, 0xb4,
+    0x8d, 0xe5, 0x6c, 0x27, 0x19, 0x1b, 0xac, 0x71, 0xd7, 0x5a, 0xc1, 0x76, 0x20, 0xd8, 0x38, 0x4b,
+    0xa7, 0x1d, 0x33, 0xaf, 0xd2, 0x78, 0x26, 0x59, 0x6b, 0x05, 0xd6, 0x98, 0x97, 0x8e, 0x91, 0x7e,
+    0x6e, 0x72, 0xdc, 0x80, 0x20, 0x0c, 0x60, 0x11, 0x27, 0x47, 0x07, 0x07, 0xc7, 0x5a, 0x56, 0xfa,
+    0xf9, 0x58, 0xf0, 0xe1, 0x0a, 0x35, 0x77, 0x96, 0x07, 0x64, 0x59, 0x50, 0x61, 0xfe, 0x2a, 0xd0,
+    0xd7, 0x85, 0xac, 0xe0, 0xfb, 0xb9, 0x19, 0xb7, 0x75, 0xde, 0xa3, 0xd1, 0xc7, 0x48, 0x7b, 0xff,
+    0xdd, 0xef, 0x39, 0xea, 0x9f, 0x11, 0x06, 0x52, 0x35, 0xfe, 0x54, 0x43, 0x5d, 0xa4, 0x7d, 0x78,
+    0xf7, 0xc7, 0xef, 0xd1, 0x73, 0x6c, 0xc3, 0x29, 0x81, 0xa3, 0xb5, 0x1a, 0xe9, 0x56, 0x16, 0xc1,
+    0xc2, 0xae, 0x76, 0x36, 0x5f, 0x84, 0x9a, 0x19, 0xc5, 0xf0, 0x26, 0x20, 0x4f, 0x3d, 0x3c, 0x63,
+    0xf4, 0x2a, 0xb7, 0x7d, 0x56, 0x16, 0xe7, 0x24, 0xd2, 0xca, 0x82, 0xd4, 0x18, 0x2f, 0xb1, 0x1a,
+    0x4c, 0x46, 0x58, 0x6f, 0x58, 0x90, 0xe5, 0xd9, 0x7f, 0x96, 0xd9, 0x32, 0x14, 0x4f, 0x56, 0x16,
+    0x63, 0x19, 0x27, 0xc0, 0x9d, 0x0e, 0x28, 0xd8, 0x59, 0x8d, 0x15, 0xaa, 0x13, 0xfa, 0xd2, 0xa7,
+    0x59, 0x40, 0xda, 0xed, 0x76, 0xc9, 0x8d, 0x24, 0xb0, 0x6d, 0x6b, 0x55, 0x60, 0x8b, 0xa1, 0x7b,
+    0xff, 0xdd, 0x9f, 0xd5, 0x70, 0xed, 0xaa, 0x5b, 0xf5, 0x06, 0x11, 0x37, 0x24, 0x1b, 0x44, 0xa8,
+    0xd9, 0x86, 0xac, 0x16, 0xff, 0xdd, 0x4f, 0x84, 0x5a, 0xed, 0x7b, 0x89, 0xd0, 0xee, 0xee, 0xee,
+    0xca, 0x08, 0xed, 0xb4, 0x37, 0x8d, 0x10, 0x4f, 0xec, 0xd5, 0x21, 0xfa, 0x28, 0x17, 0xaa, 0x52,
+    0x25, 0x9f, 0xbe, 0xdc, 0xdb, 0xff, 0xfc, 0xe9, 0xf3, 0x4f, 0x35, 0xf4, 0xf0, 0x21, 0x02, 0x4a,
+    0xe4, 0xed, 0xdd, 0xd0, 0x8b, 0x08, 0x9a, 0xcc, 0x83, 0x01, 0xf2, 0x22, 0xd7, 0xcd, 0x9e, 0xbb,
+    0x70, 0x44, 0x8e, 0x1c, 0x92, 0x10, 0x72, 0xd5, 0x2f, 0x7a, 0x27, 0x8e, 0x25, 0x07, 0x39, 0x45,
+    0xbd, 0x22, 0x57, 0xa2, 0x67, 0x90, 0xd7, 0xab, 0x54, 0x41, 0xa2, 0xee, 0x25, 0x76, 0x80, 0x4b,
+    0x4f, 0xf4, 0xd6, 0xd0, 0x63, 0xcb, 0xc8, 0x42, 0x0e, 0x4d, 0x1a, 0xb0, 0xaf, 0xa8, 0x3e, 0xc0,
+    0x0e, 0x8d, 0xf8, 0xfc, 0x01, 0xd8, 0x0f, 0xbc, 0x7a, 0x03, 0xc4, 0x52, 0x93, 0x75, 0xae, 0xa1,
+    0x28, 0x01, 0x3e, 0xfc, 0x9a, 0x0f, 0x0b, 0x1c, 0x29, 0x63, 0xe9, 0xd8, 0x86, 0xed, 0x87, 0xba,
+    0xf0, 0x62, 0x99, 0xcc, 0x2b, 0x2e, 0xb3, 0x28, 0xc9, 0x84, 0xd4, 0x4b, 0x65, 0x72, 0x68, 0x50,
+    0xe8, 0xa6, 0x4a, 0x5e, 0x5a, 0xb2, 0xde, 0x2c, 0xb3, 0x6d, 0x14, 0x10, 0x44, 0x6d, 0xf9, 0xcd,
+    0x3c, 0x69, 0x69, 0xba, 0x96, 0xfa, 0xab, 0x51, 0xd6, 0x07, 0x34, 0xbe, 0xe2, 0xaa, 0x58, 0x43,
+    0x81, 0x5e, 0x1a, 0x03, 0x92, 0xf5, 0x4e, 0xf8, 0x22, 0x89, 0xc8, 0x4c, 0x31, 0x0e, 0x05, 0x80,
+    0x50, 0x04, 0x16, 0x49, 0xb1, 0xfb, 0x69, 0x4c, 0x52, 0xb4, 0xc2, 0x28, 0x20, 0x3e, 0xa4, 0xbf,
+    0x36, 0xdb, 0x8a, 0xa1, 0x44, 0x97, 0x09, 0x27, 0xe6, 0x7d, 0x7e, 0x02, 0xe7, 0x38, 0xc7, 0xa7,
+    0x22, 0x6d, 0xeb, 0xf0, 0xf0, 0xc9, 0x23, 0xcb, 0xd2, 0x6e, 0x67, 0x36, 0xdb, 0x92, 0x7d, 0xaf,
+    0xbd, 0x09, 0x7b, 0xa3, 0xaa, 0xc6, 0x5b, 0xb4, 0xb8, 0x04, 0x05, 0x8c, 0xd5, 0x90, 0x9e, 0xe8,
+    0xda, 0x30, 0xee, 0x1c, 0x24, 0xf2, 0x6b, 0x5e, 0x83, 0x11, 0x2a, 0x42, 0xac, 0xcb, 0x92, 0x64,
+    0x89, 0x3f, 0x3f, 0x2d, 0xee, 0xec, 0xde, 0x92, 0x5c, 0x18, 0xfb, 0x01, 0xd2, 0x5d, 0xc2, 0x10,
+    0x05, 0xc3, 0x56, 0x0f, 0x7e, 0xf4, 0xd1, 0x2e, 0xfc, 0xd8, 0xde, 0x2e, 0xb4, 0x29, 0x59, 0xbf,
+    0xde, 0x44, 0x2c, 0x82, 0xe6, 0x4a, 0x76, 0xa7, 0x57, 0x62, 0xbc, 0x6e, 0x00, 0x97, 0xa8, 0xc2,
+    0x6d, 0x68, 0xc5, 0xb9, 0xe2, 0xe3, 0x2a, 0x8c, 0xb2, 0xc4, 0x22, 0x96, 0x78, 0x95, 0x93, 0x10,
+    0xa5, 0xb7, 0x42, 0xe2, 0xba, 0x99, 0xd9, 0xd8, 0xd9, 0xcc, 0x46, 0x33, 0xb3, 0xb1, 0x73, 0x9b,
+    0x8d, 0xf5, 0xfd, 0x23, 0x2e, 0xc9, 0x6b, 0xc8, 0xc3, 0x45, 0xa3, 0x44, 0x8d, 0x8b, 0xf2, 0xba,
+    0x09, 0xd4, 0x66, 0x89, 0x5a, 0x1c, 0x57, 0x39, 0xa4, 0xdf, 0x69, 0x94, 0xca, 0x4d, 0x65, 0x8d,
+    0xb5, 0x53, 0xd9, 0x1d, 0xa6, 0x2e, 0xe8, 0xcb, 0xbf, 0xe3, 0x53, 0x96, 0xb8, 0x94, 0xd9, 0x6c,
+    0x96, 0x6a, 0xde, 0x36, 0x4b, 0x49, 0xc5, 0x7b, 0x37, 0x30, 0xac, 0x41, 0xcc, 0x63, 0xd4, 0x37,
+    0x99, 0x7f, 0x48, 0xaf, 0x89, 0xa3, 0x37, 0x0c, 0x78, 0xa8, 0xfd, 0xfb, 0xa7, 0xdc, 0x88, 0x6c,
+    0x19, 0x2b, 0xd5, 0xb8, 0x2c, 0xd6, 0x13, 0x83, 0xff, 0x1a, 0x45, 0xb9, 0x61, 0x37, 0x19, 0xc2,
+    0x16, 0x78, 0x9e, 0xef, 0x81, 0x8c, 0xba, 0x6c, 0x59, 0xf3, 0x4b, 0x13, 0x06, 0xcf, 0xe3, 0x86,
+    0x25, 0x85, 0x6f, 0x69, 0x57, 0x89, 0x18, 0x57, 0xfb, 0x32, 0x6d, 0x5a, 0x56, 0xda, 0xb4, 0x62,
+    0x83, 0x85, 0x96, 0x95, 0x4a, 0xc9, 0x89, 0x32, 0x6d, 0x5c, 0x8a, 0x16, 0x25, 0xb7, 0xa5, 0x4b,
+    0xab, 0xc5, 0xd3, 0x1e, 0x56, 0x16, 0xe7, 0x89, 0x9e, 0x8a, 0xdf, 0x3a, 0x60, 0x3d, 0xea, 0x00,
+    0xae, 0x3e, 0x02, 0x48, 0xd9, 0x15, 0xc0, 0xda, 0xb9, 0xf3, 0x78, 0x95, 0xac, 0xa7, 0x9a, 0xba,
+    0xc6, 0x0f, 0xad, 0x1b, 0x4f, 0x59, 0x4b, 0x8b, 0x26, 0xab, 0x0a, 0x79, 0x1f, 0xae, 0x2d, 0xab,
+    0xbc, 0x25, 0x38, 0xfa, 0xff, 0x74, 0x78, 0x09, 0xaa, 0x2e, 0x2b, 0xe3, 0xf1, 0x78, 0xbc, 0x72,
+    0x32, 0x94, 0x85, 0xdc, 0x59, 0x3f, 0x1e, 0xae, 0x2f, 0xe5, 0xd2, 0xf9, 0x44, 0x4b, 0x97, 0xa1,
+    0x2c, 0x28, 0x77, 0x5e, 0x2c, 0x8d, 0x92, 0xeb, 0xce, 0x7e, 0xd6, 0xcf, 0x39, 0x36, 0xdd, 0x05,
+    0x85, 0x9e, 0x7a, 0x94, 0xd1, 0xec, 0xda, 0xcc, 0x34, 0xcd, 0xb4, 0xaa, 0x53, 0xcf, 0xa5, 0xdf,
+    0x31, 0x6a, 0xd6, 0xeb, 0xe8, 0x08, 0x43, 0x01, 0xd4, 0xe5, 0x2d, 0x58, 0x15, 0x01, 0x34, 0x07,
+    0x2e, 0xa6, 0x0e, 0x9a, 0x53, 0xc8, 0x03, 0x38, 0x76, 0x21, 0x46, 0xf8, 0x6d, 0x15, 0x0b, 0x16,
+    0x08, 0x36, 0x8b, 0xe0, 0x0b, 0xa4, 0xd7, 0xc9, 0x15, 0xb8, 0x01, 0xcc, 0x21, 0xfb, 0x6d, 0x4a,
+    0x35, 0x84, 0x3e, 0xde, 0x0d, 0xa5, 0x2a, 0x24, 0x91, 0xa1, 0x97, 0x3e, 0xe6, 0x9c, 0xe9, 0xc3,
+    0xfc, 0x0d, 0x5a, 0x40, 0xf8, 0x75, 0xa7, 0x7a, 0x79, 0x26, 0x31, 0x87, 0xdf, 0xb1, 0xab, 0xd0,
+    0xb2, 0xfa, 0x0e, 0x4d, 0x5e, 0xce, 0x6b, 0x86, 0x49, 0x01, 0x7f, 0x83, 0xcf, 0x4e, 0x9f, 0x1d,
+    0xf1, 0x68, 0x7d, 0x78, 0xf7, 0xf6, 0x0f, 0x02, 0xf4, 0xa4, 0xaa, 0xde, 0xaa, 0x1d, 0xbb, 0xab,
+    0xde, 0xf7, 0xdf, 0xfc, 0x84, 0xce, 0x70, 0x00, 0x87, 0x06, 0x1c, 0x8d, 0x11, 0x7f, 0x07, 0x40,
+    0xcb, 0x81, 0xcf, 0xc7, 0x7b, 0x8d, 0x91, 0xf4, 0x02, 0x32, 0x6f, 0x26, 0xf5, 0x4e, 0xeb, 0x8f,
+    0x86, 0x5f, 0x46, 0xc0, 0xe5, 0x39, 0xdd, 0x7e, 0x7d, 0x34, 0x8c, 0x57, 0x24, 0x4f, 0x2d, 0xdb,
+    0x2a, 0x5b, 0x30, 0x04, 0xd6, 0x57, 0x78, 0xae, 0xb2, 0x71, 0xe8, 0x95, 0xf8, 0xbe, 0x84, 0xf7,
+    0x14, 0x70, 0x4e, 0x65, 0x16, 0x10, 0xbb, 0x92, 0x5b, 0x34, 0x37, 0xaf, 0x26, 0x0f, 0x32, 0x99,
+    0x98, 0x9e, 0x3b, 0x27, 0x7d, 0xfd, 0x35, 0xd2, 0x9e, 0xd7, 0xf7, 0x34, 0xe3, 0x76, 0x3d, 0x71,
+    0x27, 0x2a, 0x69, 0x4a, 0x8e, 0x27, 0x1b, 0xa8, 0x52, 0x6e, 0x35, 0xd4, 0x75, 0xa8, 0x57, 0x20,
+    0x25, 0x21, 0x21, 0x98, 0xbb, 0xca, 0xcf, 0x79, 0xe0, 0xe2, 0x65, 0xe6, 0xab, 0x29, 0xd9, 0xf7,
+    0x26, 0x25, 0x7a, 0xc9, 0xaf, 0x0f, 0xef, 0xfe, 0xf2, 0xad, 0x48, 0x8c, 0x1b, 0xdf, 0x8b, 0x17,
+    0xf8, 0xc5, 0xe9, 0x7e, 0xac, 0x82, 0x67, 0x15, 0x7f, 0xfe, 0x62, 0x3c, 0x0e, 0xa1, 0x30, 0x86,
+    0x30, 0x3c, 0xf2, 0x8b, 0x9a, 0x6d, 0x71, 0x2f, 0x23, 0xcc, 0x95, 0x78, 0xc0, 0x03, 0xa4, 0xc7,
+    0xe2, 0x51, 0x48, 0xf6, 0x22, 0xe6, 0x3f, 0x39, 0x39, 0xe5, 0x52, 0xfc, 0x23, 0x82, 0xcf, 0x42,
+    0xf8, 0x19, 0xf6, 0x22, 0xe2, 0xba, 0xd2, 0x65, 0x63, 0x59, 0xc0, 0x78, 0xea, 0x72, 0xbf, 0x72,
+    0x4b, 0xe6, 0xc6, 0x12, 0xe8, 0xb8, 0x21, 0x8e, 0xb8, 0x35, 0xfa, 0xf1, 0x2d, 0x7a, 0xca, 0xb1,
+    0xc6, 0x23, 0x4c, 0xa8, 0x7e, 0xff, 0xc3, 0xdf, 0xd1, 0x91, 0x3f, 0xc3, 0xee, 0x8a, 0xf5, 0xc6,
+    0xaf, 0x2e, 0x72, 0x7a, 0xf9, 0x7b, 0x8d, 0x7d, 0xbe, 0xd9, 0x36, 0x4b, 0xb5, 0x4a, 0x65, 0x3f,
+    0xfe, 0x55, 0xcb, 0x30, 0x3f, 0x7f, 0x81, 0xde, 0x53, 0xf1, 0x29, 0x85, 0x88, 0xe8, 0xd2, 0x81,
+    0x74, 0xd7, 0xf3, 0x08, 0xf1, 0x40, 0x96, 0x8e, 0x01, 0x00, 0xc2, 0xa2, 0xc0, 0xcb, 0x5f, 0x5d,
+    0x9f, 0x43, 0xa5, 0xbe, 0x18, 0x9d, 0x83, 0x6d, 0x13, 0x87, 0x21, 0xe0, 0xa7, 0xfe, 0xfa, 0x4d,
+    0x35, 0x06, 0xa7, 0x14, 0x0c, 0xb9, 0x16, 0x0e, 0x4c, 0x2a, 0xca, 0x00, 0x26, 0xee, 0xf1, 0x91,
+    0x36, 0x44, 0xd4, 0x43, 0x1c, 0x70, 0xa9, 0x43, 0x26, 0x01, 0x21, 0x61, 0x0f, 0x79, 0x3e, 0xcc,
+    0x61, 0x75, 0xec, 0x72, 0x0a, 0x06, 0xe7, 0x60, 0x16, 0x12, 0x58, 0x28, 0x47, 0x63, 0x14, 0x79,
+    0x33, 0xcf, 0x9f, 0x7b, 0xa9, 0xa6, 0xf4, 0x6a, 0x41, 0x80, 0x1f, 0xfc, 0xd2, 0x53, 0x48, 0xbc,
+    0x30, 0x63, 0xc2, 0x82, 0x0f, 0x43, 0x96, 0xa5, 0x52, 0x45, 0x25, 0xc6, 0x64, 0x56, 0x26, 0x2b,
+    0x05, 0x17, 0x33, 0xe1, 0x1b, 0x18, 0xc6, 0x06, 0xe0, 0x82, 0x43, 0xc6, 0xd0, 0xc7, 0x79, 0xb8,
+    0xb7, 0xf5, 0x84, 0x22, 0xe4, 0x0d, 0x75, 0xe4, 0xeb, 0x2a, 0xe8, 0x9c, 0xa9, 0xcc, 0xee, 0x22,
+    0xa4, 0xa4, 0xbb, 0x52, 0xa7, 0xbb, 0x91, 0x4e, 0xb5, 0x0e, 0x63, 0x9d, 0xb0, 0x68, 0xe5, 0xbe,
+    0x3e, 0x01, 0xc7, 0xb4, 0x03, 0x2c, 0xdf, 0x7d, 0xf5, 0xf5, 0x61, 0xba, 0x53, 0xc9, 0x6b, 0x4c,
+    0xb9, 0xa5, 0x9a, 0x91, 0xda, 0x8d, 0xdf, 0x5e, 0xa2, 0xc1, 0x10, 0x05, 0xe6, 0x79, 0xe8, 0x7b,
+    0xba, 0x51, 0x24, 0x9e, 0x73, 0xa2, 0x3a, 0xb3, 0xa6, 0x4d, 0xeb, 0x5c, 0x1d, 0x0b, 0x92, 0xac,
+    0x53, 0xba, 0xbe, 0xa2, 0xc9, 0xc6, 0xdc, 0x01, 0x52, 0x54, 0x75, 0x57, 0xa0, 0x47, 0xda, 0x21,
+    0x99, 0xba, 0x24, 0x40, 0x23, 0x42, 0x2f, 0xa0, 0x1d, 0x3b, 0xc4, 0xd3, 0x54, 0x83, 0xb9, 0x90,
+    0xa8, 0x91, 0x90, 0x04, 0x9e, 0xc2, 0xf1, 0xab, 0xb9, 0x03, 0x9e, 0x8b, 0x27, 0x7e, 0x14, 0xd8,
+    0xa4, 0xf8, 0x1e, 0x8a, 0x88, 0x86, 0x4c, 0xe6, 0x48, 0xe1, 0x81, 0xd8, 0xc9, 0x4e, 0x9e, 0x1d,
+    0xfb, 0x21, 0xf7, 0x5f, 0x78, 0xee, 0x82, 0x7f, 0x4d, 0xc4, 0x9b, 0xc0, 0x86, 0x8f, 0x29, 0x71,
+    0x1d, 0x48, 0x7c, 0x87, 0xb8, 0x0c, 0x87, 0xe0, 0x21, 0x9c, 0x79, 0x89, 0x18, 0x0b, 0xc6, 0x34,
+    0x00, 0xb5, 0x4a, 0x09, 0x60, 0x20, 0x00, 0x34, 0x41, 0xdd, 0x84, 0xb1, 0x32, 0x12, 0xf2, 0x7b,
+    0x07, 0x61, 0xf0, 0x88, 0x86, 0x8c, 0xc0, 0x8a, 0x75, 0x8d, 0x4b, 0x00, 0x9a, 0xca, 0xa8, 0x25,
+    0x43, 0xc1, 0x2f, 0x4f, 0x5e, 0x3c, 0x37, 0x2f, 0xf9, 0x37, 0x53, 0x74, 0x62, 0x42, 0xc8, 0xb1,
+    0xd1, 0xcb, 0x62, 0x9f, 0x86, 0x60, 0x85, 0x46, 0xe1, 0x5b, 0xa6, 0x52, 0x29, 0xe9, 0x42, 0xfd,
+    0xf3, 0xa7, 0xd5, 0x25, 0xb6, 0xf2, 0xc6, 0x14, 0x73, 0x10, 0x8d, 0x7d, 0xd7, 0xb7, 0x67, 0x55,
+    0x80, 0xb6, 0xda, 0x21, 0x85, 0x23, 0xbc, 0x83, 0x2e, 0x93, 0xd7, 0xbf, 0x32, 0x44, 0x28, 0x74,
+    0xfd, 0xb9, 0xbb, 0x88, 0x05, 0x00, 0xaa, 0x05, 0x68, 0x5e, 0x61, 0x57, 0xcf, 0x76, 0xaa, 0x8a,
+    0x3a, 0x16, 0xfc, 0x49, 0x36, 0x32, 0x3f, 0x7d, 0xac, 0x12, 0x69, 0x2b, 0x12, 0xf2, 0xfb, 0x0b,
+    0xf1, 0xbb, 0x47, 0x00, 0x58, 0xf1, 0xcd, 0x85, 0x7e, 0x5d, 0x7e, 0xc1, 0xe7, 0x7f, 0x89, 0x80,
+    0xde, 0x5e, 0xf8, 0x23, 0x00, 0x00,
+};
+
+// style.css: 928 bytes, 394 gzip
+static const uint8_t ASSET_STYLE_CSS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x53, 0xcb, 0x6e, 0x83, 0x30,
+    0x10, 0xbc, 0xf7, 0x2b, 0x56, 0x8a, 0x7a, 0x0b, 0x15, 0xef, 0xb6, 0x70, 0xaa, 0x2a, 0xe5, 0x3f,
+    0x8c, 0x1f, 0x60, 0x15, 0x6c, 0x64, 0x1b, 0x41, 0x5a, 0xe5, 0xdf, 0x6b, 0x0c, 0x24, 0x40, 0xa2,
+    0x88, 0xdb, 0x7a, 0x76, 0x66, 0x76, 0x76, 0x29, 0x24, 0x39, 0xc3, 0x1f, 0x30, 0x29, 0x8c, 0xc7,
+    0x50, 0xc3, 0xeb, 0x73, 0x06, 0x1a, 0x09, 0xed, 0x69, 0xaa, 0x38, 0xcb, 0xa1, 0x45, 0x84, 0x70,
+    0x51, 0x66, 0x10, 0xfa, 0xed, 0x90, 0x43, 0x81, 0xf0, 0x4f, 0xa9, 0x64, 0x27, 0x48, 0x06, 0x07,
+    0x16, 0x8f, 0x5f, 0x0e, 0x97, 0x17, 0x26, 0x55, 0x73, 0x84, 0x37, 0x6c, 0x59, 0x10, 0x17, 0x54,
+    0x59, 0xc6, 0x35, 0xb2, 0xaf, 0xb8, 0xa1, 0xf7, 0x5c, 0x52, 0x11, 0xaa, 0x32, 0x08, 0xda, 0x01,
+    0xb4, 0xac, 0x39, 0x81, 0x03, 0xc6, 0x38, 0x87, 0x06, 0x0d, 0x5e, 0xcf, 0x89, 0xa9, 0x32, 0x48,
+    0x7c, 0x87, 0xbc, 0xbc, 0x6c, 0xa8, 0x57, 0x80, 0x74, 0x01, 0x70, 0xd1, 0x76, 0xe6, 0x08, 0x9a,
+    0xd6, 0x14, 0x1b, 0x8b, 0xb9, 0x6a, 0x7d, 0x8c, 0xef, 0x0d, 0x52, 0x25, 0x17, 0x96, 0xcf, 0x4a,
+    0xf9, 0x39, 0xcc, 0xcd, 0x81, 0xef, 0xbf, 0x8e, 0x36, 0x06, 0x4f, 0xf3, 0x5f, 0x07, 0x9e, 0x2c,
+    0x79, 0xb6, 0x34, 0x72, 0x16, 0x9d, 0x31, 0x52, 0xac, 0xc9, 0x02, 0xab, 0x06, 0xc1, 0x86, 0xd2,
+    0x95, 0x1c, 0xef, 0xc8, 0xec, 0x72, 0xb4, 0x6c, 0xd4, 0x3e, 0xa4, 0x77, 0x81, 0x85, 0xc1, 0x67,
+    0x7a, 0x8a, 0x72, 0xc0, 0xb2, 0x96, 0xea, 0x1a, 0xcb, 0x92, 0x83, 0x90, 0x82, 0xba, 0x59, 0x7b,
+    0xa4, 0x84, 0x95, 0xdb, 0x85, 0x78, 0x60, 0x8c, 0x45, 0x98, 0x3c, 0xcc, 0x8d, 0x31, 0x1c, 0xf8,
+    0xef, 0xf9, 0xd6, 0xe8, 0xce, 0xa3, 0xbf, 0x74, 0x7a, 0x0a, 0x11, 0xde, 0xe9, 0x0c, 0xe2, 0x39,
+    0x5b, 0x2e, 0x98, 0x1c, 0x67, 0xde, 0x0b, 0xd2, 0x88, 0x85, 0xec, 0xb1, 0xe0, 0x32, 0xc9, 0x4d,
+    0x30, 0xd9, 0x08, 0x26, 0x4f, 0x05, 0xb5, 0x41, 0xca, 0x78, 0x85, 0x11, 0x7b, 0xc5, 0xf8, 0xfb,
+    0xeb, 0x94, 0xf8, 0xd3, 0xc2, 0x91, 0xc0, 0xb4, 0x7e, 0x04, 0x62, 0x71, 0x1c, 0x45, 0xa9, 0x03,
+    0x19, 0x59, 0x96, 0x35, 0x7d, 0xc6, 0xb4, 0x5e, 0x88, 0xdb, 0xdb, 0xc6, 0x31, 0x84, 0xc9, 0xcd,
+    0x92, 0xe9, 0xf4, 0xf2, 0x27, 0x4c, 0x0d, 0xd3, 0x99, 0xba, 0x42, 0x4f, 0x79, 0x59, 0x99, 0xf1,
+    0x40, 0x6a, 0x72, 0x9f, 0xab, 0xed, 0x77, 0x77, 0x32, 0xef, 0x75, 0x3d, 0x86, 0x64, 0x6c, 0xf5,
+    0x70, 0xb3, 0xde, 0x2a, 0x59, 0x2a, 0xaa, 0x47, 0xc5, 0xcd, 0x35, 0x56, 0xb3, 0x50, 0x38, 0xdf,
+    0xf5, 0x3f, 0x53, 0x1e, 0x46, 0x22, 0xa0, 0x03, 0x00, 0x00,
+};
+
+// wifi.html: 1023 bytes, 623 gzip
+static const uint8_t ASSET_WIFI_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x53, 0xcd, 0x6e, 0xd4, 0x30,
+    0x10, 0xbe, 0xf7, 0x29, 0x06, 0x1f, 0xe8, 0xae, 0x04, 0x09, 0x5d, 0x10, 0xad, 0x68, 0x12, 0x54,
+    0x28, 0x45, 0x15, 0xa8, 0x5d, 0x69, 0x17, 0x10, 0x5c, 0x90, 0x63, 0x4f, 0x36, 0xee, 0x3a, 0xce,
+    0x62, 0x3b, 0xbb, 0xdd, 0x22, 0x9e, 0xa1, 0x12, 0xdc, 0xb8, 0x50, 0x24, 0x1e, 0x82, 0x43, 0xc5,
+    0xa5, 0x6f, 0xc2, 0x0b, 0xc0, 0x23, 0x60, 0x3b, 0x4d, 0x7f, 0x10, 0x12, 0xa7, 0x4c, 0x66, 0xe6,
+    0xfb, 0x66, 0xfc, 0x7d, 0x76, 0x72, 0x63, 0x7b, 0xff, 0xf1, 0xf8, 0xf5, 0xf0, 0x09, 0x94, 0xb6,
+    0x92, 0xd9, 0x4a, 0xd2, 0x7d, 0x90, 0xf2, 0x6c, 0x05, 0x20, 0xa9, 0xd0, 0x52, 0x60, 0x25, 0xd5,
+    0x06, 0x6d, 0x4a, 0x5e, 0x8c, 0x77, 0x6e, 0x6f, 0x90, 0x50, 0xb0, 0xc2, 0x4a, 0xcc, 0x5e, 0x89,
+    0x1d, 0x01, 0xcf, 0x6a, 0x55, 0x88, 0x49, 0xa3, 0xa9, 0x15, 0xb5, 0x4a, 0xe2, 0xb6, 0xe2, 0x7b,
+    0xa4, 0x50, 0x53, 0xd0, 0x28, 0x53, 0x62, 0xec, 0x52, 0xa2, 0x29, 0x11, 0x2d, 0x81, 0x52, 0x63,
+    0x91, 0x92, 0x38, 0xa4, 0x22, 0x66, 0xcc, 0xc3, 0x79, 0x5a, 0xac, 0x0f, 0x06, 0xeb, 0x03, 0xc6,
+    0x36, 0xd6, 0xee, 0xdd, 0xe1, 0x14, 0xd7, 0xdc, 0x88, 0x24, 0x6e, 0x77, 0x48, 0xf2, 0x9a, 0x2f,
+    0x03, 0x5b, 0x39, 0xc8, 0x7e, 0x7f, 0xf9, 0xf4, 0x15, 0xfe, 0x35, 0xd3, 0xd5, 0x7c, 0x0b, 0x17,
+    0x73, 0x60, 0x92, 0x1a, 0x93, 0x92, 0x05, 0xd5, 0x4a, 0xa8, 0x09, 0xc9, 0x7e, 0x7e, 0x3e, 0xf9,
+    0xf5, 0xfd, 0x18, 0xf6, 0x28, 0x2b, 0x81, 0x63, 0x05, 0xa3, 0x19, 0x0a, 0x56, 0xa2, 0x56, 0xb0,
+    0x10, 0x9a, 0x03, 0xa7, 0x06, 0x9e, 0xa2, 0x3e, 0xfb, 0x66, 0x61, 0x8e, 0xda, 0x34, 0xae, 0xa4,
+    0x6e, 0x81, 0x71, 0x2d, 0x50, 0x09, 0x1b, 0x10, 0x0a, 0x1b, 0x54, 0xb0, 0x87, 0xf6, 0x68, 0x81,
+    0x7a, 0x0a, 0x47, 0x8d, 0xef, 0xcc, 0x85, 0xe2, 0xa8, 0x22, 0x37, 0x15, 0x60, 0x1b, 0x35, 0x6c,
+    0x31, 0x86, 0xc6, 0xc0, 0xb0, 0x16, 0xca, 0x42, 0x6f, 0x54, 0x4b, 0xaa, 0xc7, 0x9a, 0xb2, 0x29,
+    0xea, 0xb7, 0x5b, 0xc3, 0x3e, 0xe4, 0x12, 0x45, 0x6e, 0x81, 0x4e, 0xad, 0x98, 0x47, 0x49, 0xec,
+    0x16, 0x0d, 0x0b, 0x17, 0xb5, 0xae, 0x80, 0x32, 0x7f, 0x08, 0x27, 0xc9, 0x42, 0x14, 0x22, 0x36,
+    0x74, 0x8e, 0x04, 0x9c, 0xee, 0x65, 0xcd, 0x53, 0x32, 0xdc, 0x1f, 0x8d, 0x83, 0xe0, 0x00, 0xa3,
+    0xd1, 0xee, 0x36, 0xf4, 0xba, 0x35, 0x14, 0xad, 0xb0, 0xff, 0x00, 0x12, 0xa1, 0x66, 0x8d, 0x05,
+    0xbb, 0x9c, 0x61, 0x4a, 0x2c, 0x1e, 0x3a, 0x7d, 0x7d, 0xc5, 0x29, 0x6e, 0x04, 0x27, 0x20, 0x78,
+    0x17, 0x55, 0xf4, 0x50, 0xa2, 0x9a, 0xd8, 0x32, 0x25, 0xf7, 0xef, 0x12, 0xe7, 0xca, 0xbb, 0x46,
+    0x68, 0xe4, 0x59, 0x92, 0xeb, 0x96, 0x7e, 0xe8, 0x64, 0x5b, 0xd4, 0xda, 0xfe, 0xc5, 0x39, 0x6b,
+    0xd3, 0xbc, 0xe3, 0xf5, 0xff, 0x2d, 0x6f, 0x1b, 0x5d, 0xe7, 0xbd, 0xa4, 0x4b, 0x4c, 0x45, 0xa5,
+    0xcc, 0x9e, 0xbb, 0x26, 0x27, 0xde, 0x48, 0x60, 0x50, 0xba, 0x1b, 0x02, 0x12, 0x9d, 0x66, 0xc5,
+    0xd9, 0xa9, 0x86, 0xba, 0x28, 0x50, 0xe1, 0x85, 0xbc, 0x98, 0xc4, 0x2d, 0xd2, 0x33, 0x5d, 0xb2,
+    0xe5, 0x8d, 0xb5, 0xb5, 0x3a, 0xdf, 0xc9, 0x34, 0xb9, 0xf3, 0x86, 0xb8, 0xeb, 0xf0, 0xf1, 0xc7,
+    0x15, 0x3f, 0x6f, 0xc2, 0xcb, 0xce, 0x97, 0x24, 0x6e, 0x01, 0xe7, 0x68, 0xda, 0x5d, 0x3a, 0xbf,
+    0xe0, 0x55, 0xa6, 0xf6, 0xc7, 0x33, 0x1d, 0x9f, 0xc0, 0x9b, 0x46, 0x9f, 0x9d, 0xb2, 0xe9, 0x05,
+    0x36, 0x89, 0x69, 0x30, 0x29, 0xf6, 0x2e, 0x85, 0xc8, 0x30, 0x2d, 0x66, 0xb6, 0x25, 0x2d, 0xd0,
+    0xb2, 0xb2, 0xb7, 0x1a, 0x4c, 0x8b, 0x0e, 0x4c, 0xad, 0x56, 0xfb, 0x91, 0x75, 0x97, 0xa7, 0xa7,
+    0x21, 0xcd, 0x40, 0x87, 0x54, 0xaf, 0x7f, 0x9e, 0x3b, 0xf0, 0xb9, 0xf7, 0x01, 0x07, 0xc0, 0x6b,
+    0xd6, 0x54, 0xa8, 0x6c, 0x34, 0x41, 0xfb, 0x44, 0xa2, 0x0f, 0x1f, 0x2d, 0x77, 0x79, 0x6f, 0xd5,
+    0x3b, 0xe5, 0x58, 0xe6, 0x54, 0x36, 0x08, 0x29, 0x1c, 0x44, 0x3e, 0xb1, 0xf9, 0x3f, 0x94, 0xf7,
+    0xe1, 0x1a, 0xca, 0x27, 0x5a, 0xd4, 0x87, 0xfe, 0x66, 0x38, 0x40, 0xb7, 0xb7, 0x3b, 0x5a, 0x78,
+    0x4d, 0xee, 0xc1, 0x84, 0x77, 0xfe, 0x07, 0xe0, 0x98, 0xb1, 0xd4, 0xff, 0x03, 0x00, 0x00,
+};
+
+const WebAsset WEB_ASSETS[] = {
+    {"/calibrate", "text/html; charset=utf-8", "\"c001da6423eaa15c\"", ASSET_CALIBRATE_HTML, sizeof(ASSET_CALIBRATE_HTML), 2683, "no-cache"},
+    {"/debug", "text/html; charset=utf-8", "\"b8c40e610a7066c9\"", ASSET_DEBUG_HTML, sizeof(ASSET_DEBUG_HTML), 1087, "no-cache"},
+    {"/geo", "text/html; charset=utf-8", "\"2283c893864e3669\"", ASSET_GEO_HTML, sizeof(ASSET_GEO_HTML), 2183, "no-cache"},
+    {"/", "text/html; charset=utf-8", "\"0f64557c549709fc\"", ASSET_INDEX_HTML, sizeof(ASSET_INDEX_HTML), 9208, "no-cache"},
+    {"/style.css", "text/css", "\"f72272cc8140dae1\"", ASSET_STYLE_CSS, sizeof(ASSET_STYLE_CSS), 928, "public, max-age=31536000, immutable"},
+    {"/wifi", "text/html; charset=utf-8", "\"a50d5a86a2325e1f\"", ASSET_WIFI_HTML, sizeof(ASSET_WIFI_HTML), 1023, "no-cache"},
+};
+const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
@@ -0,0 +1,29 @@
+#ifndef ST_WEB_ASSETS_H
+#define ST_WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// =====================================================
+// WEB UI ASSETS
+// =====================================================
+// Static pages, styles and scripts from web/, gzip-compressed into flash
+// by tools/web_assets.py (st_web_assets.cpp is generated - edit web/).
+// Pages fetch their values as JSON; the server sends the bytes as they
+// are with Content-Encoding: gzip, a strong ETag and Cache-Control, and
+// answers 304 when If-None-Match still matches.
+
+struct WebAsset
+{
+    const char *uri;          // "/" for index.html, "/geo" for geo.html, "/style.css"
+    const char *contentType;
+    const char *etag;         // quoted, hash of the uncompressed file
+    const uint8_t *gz;        // PROGMEM
+    size_t gzLen;
+    size_t rawLen;            // uncompressed size, for the byte counts in `program web`
+    const char *cacheControl; // pages revalidate, versioned assets are immutable
+};
+
+extern const WebAsset WEB_ASSETS[];
+extern const size_t WEB_ASSET_COUNT;
+
+#endif
@@ -1,365 +1,382 @@
+#include <atomic>
 #include "st_debug.h"
 #include "config.h"
 #include "time_rtc.h"
 #include "st_config.h"
 #include "st_calibration.h"
+#include "st_ephemeris.h"
+#include "st_servo.h"
+#include "st_history_log.h"
+#include "st_history_export.h"
+#include "st_json.h"
+#include "st_snapshot.h"
+#include "st_status_bin.h"
+#include "st_metrics.h"
+#include "st_supervisor.h"
+#include "st_wifi.h"
+#include "st_ntp.h"
+#include "st_clock.h"
+#include "st_init.h"
+#include "st_control.h"
+#include "st_strategy.h"
+#include "st_backtrack.h"
+#include "st_motion.h"
+#include "st_web_assets.h"
 #include "st_webserver.h"
 
 // External references from main.cpp
-extern TrackerState trackerState;
-extern int yawAngle;
-extern int tiltAngle;
-extern bool weatherSaysStop;
-
-// External references from config.cpp
-extern double currentLatitude;
-extern double currentLongitude;
-
-// Webserver Objekt
-WebServer server(80);
-
-const char INDEX_HTML[] PROGMEM = R"rawliteral(
-  <!DOCTYPE html>
-  <html>
-  <head>
-    <meta charset="UTF-8">
-    <title>SolarTracker</title>
-    <style>
-      body { font-family: sans-serif; background:#f4f4f4; padding:20px; }
-      h1 { margin-bottom: 10px; }
-      button { padding:10px 18px; margin:5px; font-size:16px; }
-      .ok { background:#4CAF50; color:white; border:none; }
-      .stop { background:#f44336; color:white; border:none; }
-      .info { background:#2196F3; color:white; border:none; }
-      #statusBox { margin-top:15px; padding:10px; background:white; border:1px solid #ccc; }
-      .time { font-size: 18px; font-weight: bold; color: #333; margin-bottom: 10px; }
-      #visualContainer { margin-top:15px; padding:10px; background:white; border:1px solid #ccc; text-align:center; }
-      #trackerCanvas { border:1px solid #ddd; background:#e8f4ff; }
-    </style>
-  </head>
-  <body>
-    <h1>SolarTracker ESP32</h1>
-    <div id="timeBox" class="time">Zeit wird geladen...</div>
-    <p>
-      <button class="ok" onclick="fetch('/weather?rain=0&k=key-123').then(r=>loadStatus())">Sonne / Weiter</button>
-      <button class="stop" onclick="fetch('/weather?rain=1&k=key-123').then(r=>loadStatus())">Regen / Stopp</button>
-      <button class="info" onclick="loadStatus()">Status laden</button>
-      <button class="info" onclick="window.location.href='/history'">Historie herunterladen</button>
-      <button class="info" onclick="window.location.href='/geo'">📍 Position ändern</button>
-      <button class="info" onclick="window.location.href='/wifi'">📡 WiFi ändern</button>
-      <button class="info" onclick="window.location.href='/calibrate'">⚙️ Kalibrierung</button>
-      <button class="info" onclick="window.location.href='/debug'">🐛 Debug-Modus</button>
-    </p>
-    <div id="visualContainer">
-      <h3>Tracker Visualisierung</h3>
-      <canvas id="trackerCanvas" width="400" height="400"></canvas>
-    </div>
-    <div id="statusBox">Status wird geladen...</div>
-
-    <script>
-      function drawTracker(j) {
-        const canvas = document.getElementById('trackerCanvas');
-        const ctx = canvas.getContext('2d');
-        const w = canvas.width;
-        const h = canvas.height;
-        const cx = w / 2;
-        const cy = h / 2;
-        
-        ctx.clearRect(0, 0, w, h);
-        
-        ctx.fillStyle = '#e8f4ff';
-        ctx.fillRect(0, 0, w, h);
-        
-        ctx.strokeStyle = '#999';
-        ctx.lineWidth = 1;
-        ctx.beginPath();
-        ctx.arc(cx, cy, 150, 0, 2 * Math.PI);
-        ctx.stroke();
-        
-        ctx.strokeStyle = '#ccc';
-        ctx.setLineDash([5, 5]);
-        ctx.beginPath();
-        ctx.moveTo(cx, cy - 150);
-        ctx.lineTo(cx, cy + 150);
-        ctx.moveTo(cx - 150, cy);
-        ctx.lineTo(cx + 150, cy);
-        ctx.stroke();
-        ctx.setLineDash([]);
-        
-        ctx.fillStyle = '#666';
-        ctx.font = '12px sans-serif';
-        ctx.textAlign = 'center';
-        ctx.fillText('N', cx, cy - 165);
-        ctx.fillText('S', cx, cy + 180);
-        ctx.fillText('E', cx + 165, cy + 5);
-        ctx.fillText('W', cx - 165, cy + 5);
-        
-        if (j.state === 'SLEEP') {
-          ctx.font = 'bold 24px sans-serif';
-          ctx.fillStyle = '#333';
-          ctx.textAlign = 'center';
-          ctx.fillText(j.weatherStop ? '☁️ Wetter-Stop' : '🌙 Nachtmodus', cx, cy - 30);
-          ctx.font = '16px sans-serif';
-          ctx.fillStyle = '#666';
-          ctx.fillText('Tracker inaktiv', cx, cy + 10);
-          
-          if (j.weatherStop) {
-            ctx.fillStyle = 'rgba(100, 100, 100, 0.3)';
-            ctx.beginPath();
-            ctx.arc(cx, cy + 60, 40, 0, 2 * Math.PI);
-            ctx.fill();
-            ctx.fillStyle = '#555';
-            ctx.font = '50px sans-serif';
-            ctx.fillText('☔', cx, cy + 80);
-          } else {
-            ctx.fillStyle = 'rgba(255, 255, 100, 0.3)';
-            ctx.beginPath();
-            ctx.arc(cx, cy + 60, 35, 0, 2 * Math.PI);
-            ctx.fill();
-            ctx.fillStyle = '#888';
-            ctx.font = '45px sans-serif';
-            ctx.fillText('🌙', cx, cy + 80);
-          }
-        } else if (j.state === 'TRACKING' && j.sunAzimuth != null && j.sunAltitude != null) {
-          const azimuth = j.sunAzimuth;
-          const altitude = j.sunAltitude;
-          
-          const azRad = (azimuth - 90) * Math.PI / 180;
-          const radius = 150 * (1 - altitude / 90);
-          const sunX = cx + radius * Math.cos(azRad);
-          const sunY = cy + radius * Math.sin(azRad);
-          
-          ctx.strokeStyle = 'rgba(255, 200, 0, 0.5)';
-          ctx.lineWidth = 2;
-          ctx.beginPath();
-          ctx.moveTo(cx, cy);
-          ctx.lineTo(sunX, sunY);
-          ctx.stroke();
-          
-          const gradient = ctx.createRadialGradient(sunX, sunY, 5, sunX, sunY, 25);
-          gradient.addColorStop(0, '#FFD700');
-          gradient.addColorStop(0.5, '#FFA500');
-          gradient.addColorStop(1, 'rgba(255, 165, 0, 0.3)');
-          ctx.fillStyle = gradient;
-          ctx.beginPath();
-          ctx.arc(sunX, sunY, 25, 0, 2 * Math.PI);
-          ctx.fill();
-          
-          ctx.strokeStyle = '#FFA500';
-          ctx.lineWidth = 2;
-          ctx.beginPath();
-          ctx.arc(sunX, sunY, 25, 0, 2 * Math.PI);
-          ctx.stroke();
-          
-          for (let i = 0; i < 8; i++) {
-            const angle = i * Math.PI / 4;
-            const x1 = sunX + 30 * Math.cos(angle);
-            const y1 = sunY + 30 * Math.sin(angle);
-            const x2 = sunX + 40 * Math.cos(angle);
-            const y2 = sunY + 40 * Math.sin(angle);
-            ctx.beginPath();
-            ctx.moveTo(x1, y1);
-            ctx.lineTo(x2, y2);
-            ctx.stroke();
-          }
-          
-          ctx.fillStyle = '#333';
-          ctx.font = 'bold 14px sans-serif';
-          ctx.textAlign = 'center';
-          ctx.fillText('☀️ Sonne', cx, cy - 30);
-          ctx.font = '12px sans-serif';
-          ctx.fillText('Az: ' + azimuth.toFixed(1) + '°', cx, cy - 10);
-          ctx.fillText('Alt: ' + altitude.toFixed(1) + '°', cx, cy + 5);
-          
-          if (j.yaw != null && j.tilt != null) {
-            const yawRad = (j.yaw - 90) * Math.PI / 180;
-            const tiltRadius = 100 * (1 - j.tilt / 90);
-            const trackerX = cx + tiltRadius * Math.cos(yawRad);
-            const trackerY = cy + tiltRadius * Math.sin(yawRad);
-            
-            ctx.fillStyle = 'rgba(76, 175, 80, 0.6)';
-            ctx.beginPath();
-            ctx.arc(trackerX, trackerY, 15, 0, 2 * Math.PI);
-            ctx.fill();
-            
-            ctx.strokeStyle = '#4CAF50';
-            ctx.lineWidth = 2;
-            ctx.beginPath();
-            ctx.arc(trackerX, trackerY, 15, 0, 2 * Math.PI);
-            ctx.stroke();
-            
-            ctx.fillStyle = '#fff';
-            ctx.font = 'bold 16px sans-serif';
-            ctx.textAlign = 'center';
-            ctx.fillText('T', trackerX, trackerY + 5);
-          }
-        } else {
-          ctx.font = 'bold 20px sans-serif';
-          ctx.fillStyle = '#666';
-          ctx.textAlign = 'center';
-          ctx.fillText('Initialisierung...', cx, cy);
-        }
-      }
-      
-      function loadStatus() {
-        fetch('/status')
-          .then(r => r.json())
-          .then(j => {
-            if (j.time) {
-              document.getElementById('timeBox').innerHTML = '📅 ' + j.time;
-            } else {
-              document.getElementById('timeBox').innerHTML = '⏰ Warte auf Zeitinitialisierung...';
-            }
-            document.getElementById('statusBox').innerHTML =
-              '<b>Zustand:</b> ' + j.state +
-              '<br><b>Yaw:</b> ' + j.yaw + '°' +
-              '<br><b>Tilt:</b> ' + j.tilt + '°' +
-              '<br><b>Sonnen-Azimut:</b> ' + (j.sunAzimuth || 'N/A') + '°' +
-              '<br><b>Sonnen-Altitude:</b> ' + (j.sunAltitude || 'N/A') + '°' +
-              '<br><b>Wetter-Stop:</b> ' + j.weatherStop +
-              '<br><br><b>📍 Position:</b> ' + (j.latitude || 'N/A') + ', ' + (j.longitude || 'N/A') +
-              '<br><b>🕐 Zeitzone:</b> UTC' + (j.timezoneOffset >= 0 ? '+' : '') + j.timezoneOffset + ' (' + (j.useAutoDST ? 'Auto DST' : 'Manuell') + ')' +
-              '<br><b>⏰ Zeit:</b> ' + (j.timeInitialized ? '✓ Internet' : '⚠ Lokal') +
-              '<br><b>📡 WiFi:</b> ' + (j.wifiConnected ? '✓' : '✗');
-            
-            drawTracker(j);
-          })
-          .catch(e => {
-            document.getElementById('statusBox').innerHTML = 'Fehler beim Laden';
-          });
-      }
-      loadStatus();
-      setInterval(loadStatus, 5000);
-    </script>
-  </body>
-  </html>
-  )rawliteral";
-
-void handleGeoConfig()
+extern std::atomic<bool> weatherSaysStop;
+
+// Webserver Objekt (Handler laufen im async_tcp-Task, nicht in loop())
+AsyncWebServer server(80);
+
+// /wifi/save: Neuverbindung aus loop(), nachdem die Antwort raus ist
+static volatile bool wifiReconnectPending = false;
+static unsigned long wifiReconnectRequested = 0;
+
+WebAssetHandler webAssets;
+
+// The body goes out after the handler returns, so the stack buffer is
+// copied into the response once
+static void sendJson(AsyncWebServerRequest *request, const char *json, size_t len)
 {
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>Konfiguration</title>";
-    html += "<style>body{font-family:sans-serif;padding:20px;background:#f4f4f4;}";
-    html += "form{background:white;padding:20px;border:1px solid #ccc;max-width:500px;}";
-    html += "input,select{padding:8px;margin:5px 0;width:100%;box-sizing:border-box;}";
-    html += "button{padding:10px 18px;margin:10px 5px 0 0;font-size:16px;background:#2196F3;color:white;border:none;}";
-    html += "</style></head><body>";
-    html += "<h2>⚙️ System Konfiguration</h2>";
-    html += "<form action='/geo/save' method='POST'>";
-    html += "<h3>📍 Geo-Position</h3>";
-    html += "Breitengrad (Latitude): <input type='number' name='lat' step='0.000001' value='";
-    html += String(currentLatitude, 6);
-    html += "' required><br>";
-    html += "Längengrad (Longitude): <input type='number' name='lon' step='0.000001' value='";
-    html += String(currentLongitude, 6);
-    html += "' required><br>";
-    html += "<h3>🕐 Zeitzone</h3>";
-    html += "Automatische Sommerzeit (EU): <select name='autodst'>";
-    html += "<option value='1'" + String(useAutoDST ? " selected" : "") + ">Aktiviert (MEZ/MESZ)</option>";
-    html += "<option value='0'" + String(!useAutoDST ? " selected" : "") + ">Deaktiviert</option>";
-    html += "</select><br>";
-    html += "Manuelle Zeitzone (UTC Offset in Stunden): <input type='number' name='tzoffset' step='0.5' min='-12' max='14' value='";
-    html += String(manualTimezoneOffset / 3600.0, 1);
-    html += "'><br><small>Wird nur verwendet wenn Auto-Sommerzeit deaktiviert ist</small><br><br>";
-    html += "<button type='submit'>💾 Speichern</button> ";
-    html += "<a href='/'><button type='button'>🏠 Zurück</button></a>";
-    html += "</form></body></html>";
-
-    server.send(200, "text/html", html);
+    AsyncResponseStream *response = request->beginResponseStream("application/json", len);
+    response->write((const uint8_t *)json, len);
+    request->send(response);
 }
 
-void handleGeoSave()
+// =====================================================
+// STATIC UI (st_web_assets)
+// =====================================================
+static const WebAsset *findAsset(const String &uri)
 {
-    if (server.hasArg("lat") && server.hasArg("lon") && server.hasArg("autodst") && server.hasArg("tzoffset"))
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++)
     {
-        currentLatitude = server.arg("lat").toDouble();
-        currentLongitude = server.arg("lon").toDouble();
-        useAutoDST = (server.arg("autodst") == "1");
-        manualTimezoneOffset = (int)(server.arg("tzoffset").toFloat() * 3600);
-        saveGeoConfig();
+        if (uri == WEB_ASSETS[i].uri)
+            return &WEB_ASSETS[i];
+    }
+    return nullptr;
+}
+
+// Exact paths only (on() would also take "/geo/..."). If-None-Match has
+// to be requested here, the server drops headers nobody asked for.
+bool WebAssetHandler::canHandle(AsyncWebServerRequest *request)
+{
+    if (!(request->method() & (HTTP_GET | HTTP_HEAD)) || !findAsset(request->url()))
+        return false;
+    request->addInterestingHeader("If-None-Match");
+    return true;
+}
+
+// Sent as stored: every browser in use accepts gzip
+void WebAssetHandler::handleRequest(AsyncWebServerRequest *request)
+{
+    const WebAsset *asset = findAsset(request->url());
+    AsyncWebHeader *match = request->getHeader("If-None-Match");
+    AsyncWebServerResponse *response;
+    if (match && match->value().indexOf(asset->etag) >= 0)
+    {
+        response = request->beginResponse(304);
+    }
+    else
+    {
+        response = request->beginResponse_P(200, asset->contentType, asset->gz, asset->gzLen);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", asset->cacheControl);
+    request->send(response);
+}
+
+// =====================================================
+// API
+// =====================================================
+// Values for the static pages: /geo.json, /wifi.json, /calibrate.json, /debug.json
+void handleGeoJson(AsyncWebServerRequest *request)
+{
+    Settings s;
+    settingsRead(s);
+    char json[256];
+    JsonWriter w;
+    jsonBegin(w, json, sizeof(json));
+    jsonDouble(w, "latitude", s.latitude, 6);
+    jsonDouble(w, "longitude", s.longitude, 6);
+    jsonBool(w, "useAutoDST", s.autoDst);
+    jsonDouble(w, "manualTimezoneOffset", s.timezoneOffset / 3600.0, 1);
+    jsonDouble(w, "rowPitch", s.rowPitch, 2);
+    jsonDouble(w, "panelWidth", s.panelWidth, 2);
+    jsonDouble(w, "rowAzimuth", s.rowAzimuth, 1);
+    jsonDouble(w, "gcr", backtrackGcr(), 3);
+    jsonEnd(w);
+    sendJson(request, json, w.len);
+}
+
+void handleGeoSave(AsyncWebServerRequest *request)
+{
+    if (request->hasArg("lat") && request->hasArg("lon") && request->hasArg("autodst") && request->hasArg("tzoffset"))
+    {
+        // Starts from the current values: row geometry is optional, older
+        // forms do not send it
+        Settings v;
+        settingsRead(v);
+        v.latitude = request->arg("lat").toDouble();
+        v.longitude = request->arg("lon").toDouble();
+        v.autoDst = (request->arg("autodst") == "1");
+        v.timezoneOffset = (int)(request->arg("tzoffset").toFloat() * 3600);
+        if (request->hasArg("rowpitch") && request->hasArg("panelwidth") && request->hasArg("rowaz"))
+        {
+            v.rowPitch = max(request->arg("rowpitch").toFloat(), 0.0f);
+            v.panelWidth = max(request->arg("panelwidth").toFloat(), 0.0f);
+            v.rowAzimuth = request->arg("rowaz").toFloat();
+            // Panels wider than the pitch overlap (GCR > 1); a width
+            // without a pitch has no GCR at all. Nothing is stored.
+            if (v.panelWidth > 0.0f && (v.rowPitch <= 0.0f || v.panelWidth > v.rowPitch))
+            {
+                request->send(400, "text/plain",
+                              "Reihengeometrie ungültig: Panelbreite muss kleiner als der Reihenabstand sein "
+                              "(Einzelanlage: beide 0)");
+                return;
+            }
+        }
+        // The control task applies and saves it, the ephemeris follows
+        controlPostSettings(SETTINGS_GEO, v);
 
         String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
         html += "<meta http-equiv='refresh' content='2;url=/'></head><body>";
         html += "<h2>✓ Konfiguration gespeichert!</h2>";
         html += "<p>Weiterleitung...</p></body></html>";
-        server.send(200, "text/html", html);
+        request->send(200, "text/html", html);
     }
     else
     {
-        server.send(400, "text/plain", "Fehlende Parameter");
+        request->send(400, "text/plain", "Fehlende Parameter");
     }
 }
 
-void handleRoot()
+size_t buildStatusJson(char *buf, size_t cap)
 {
-    server.send_P(200, "text/html", INDEX_HTML);
+    // Software clock (st_clock): no RTC read per request
+    DateTime now = timeInitialized ? getCurrentTime() : DateTime((uint32_t)0);
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+
+    JsonWriter w;
+    jsonBegin(w, buf, cap);
+    jsonString(w, "state", trackerStateName(snap.state));
+    jsonFixed(w, "yaw", snap.yaw, 2);
+    jsonFixed(w, "tilt", snap.tilt, 2);
+    jsonBool(w, "weatherStop", weatherSaysStop);
+
+    jsonBool(w, "timeInitialized", timeInitialized);
+    jsonBool(w, "rtcAvailable", rtcAvailable);
+    jsonBool(w, "wifiConnected", WiFi.status() == WL_CONNECTED);
+    jsonUint(w, "lastNTPUpdate", millis() - lastNTPUpdate);
+
+    // Geo-Position
+    Settings s;
+    settingsRead(s);
+    jsonDouble(w, "latitude", s.latitude, 6);
+    jsonDouble(w, "longitude", s.longitude, 6);
+    jsonBool(w, "useAutoDST", s.autoDst);
+    jsonDouble(w, "timezoneOffset", getTimezoneOffsetAt(now) / 3600.0, 1);
+
+    if (timeInitialized)
+    {
+        jsonDateTime(w, "time", now);
+        jsonDouble(w, "sunAzimuth", snap.sunAzimuth, 1);
+        jsonDouble(w, "sunAltitude", snap.sunAltitude, 1);
+        jsonBool(w, "backtracking", snap.backtracking);
+    }
+
+    // Period of the READ_INTERVAL work and its jitter (st_control)
+    jsonObjectBegin(w, "control");
+    jsonBool(w, "task", controlTaskRunning());
+    jsonString(w, "strategy", strategyName(strategySelected()));
+    jsonUint(w, "periods", snap.timing.periods);
+    jsonUint(w, "lastPeriodUs", snap.timing.lastPeriodUs);
+    jsonUint(w, "jitterMeanUs", snap.timing.meanJitterUs);
+    jsonUint(w, "jitterMaxUs", snap.timing.maxJitterUs);
+    jsonUint(w, "late", snap.timing.late);
+    jsonObjectEnd(w);
+
+    // Servo planner (st_motion): pose on the way, coalesced targets
+    MotionStatus motion;
+    motionRead(motion);
+    jsonObjectBegin(w, "motion");
+    jsonBool(w, "moving", motion.moving);
+    jsonFixed(w, "yaw", motion.yaw, 2);
+    jsonFixed(w, "tilt", motion.tilt, 2);
+    jsonUint(w, "moves", motion.moves);
+    jsonUint(w, "coalesced", motion.coalesced);
+    jsonUint(w, "writes", motion.writes);
+    jsonObjectEnd(w);
+
+    // Station link and NTP client state machines (st_wifi, st_ntp)
+    WifiLinkStatus link;
+    wifiRead(link);
+    jsonObjectBegin(w, "wifi");
+    jsonString(w, "state", wifiLinkStateName(link.state));
+    jsonInt(w, "rssi", WiFi.RSSI());
+    jsonUint(w, "attempts", link.attempts);
+    jsonUint(w, "drops", link.drops);
+    jsonUint(w, "connectMs", link.connectMs);
+    jsonUint(w, "retryMs", link.retryMs);
+    jsonObjectEnd(w);
+
+    NtpStatus ntp;
+    ntpRead(ntp);
+    jsonObjectBegin(w, "ntp");
+    jsonString(w, "state", ntpStateName(ntp.state));
+    jsonString(w, "result", ntpResultName(ntp.lastResult));
+    jsonBool(w, "synced", ntp.synced);
+    jsonUint(w, "rttMs", ntp.rttMs);
+    jsonUint(w, "requests", ntp.requests);
+    jsonUint(w, "timeouts", ntp.timeouts);
+    jsonUint(w, "rejected", ntp.rejected);
+    jsonUint(w, "retryMs", ntp.retryMs);
+    jsonObjectEnd(w);
+
+    // Software clock discipline (st_clock)
+    ClockStatus clk;
+    clockRead(clk);
+    jsonObjectBegin(w, "clock");
+    jsonString(w, "source", clockSourceName(clk.source));
+    jsonInt(w, "ratePpb", clk.ratePpb);
+    jsonUint(w, "rateBaselineS", clk.rateBaselineS);
+    jsonInt(w, "offsetUs", clk.lastOffsetUs);
+    jsonUint(w, "uncertaintyUs", clk.uncertaintyUs);
+    jsonUint(w, "steps", clk.steps);
+    jsonUint(w, "rtcReads", clk.rtcReads);
+    jsonObjectEnd(w);
+
+    // Fast boot (st_init): first pointing and time to STATE_TRACKING
+    BootInfo boot;
+    bootRead(boot);
+    jsonObjectBegin(w, "boot");
+    jsonBool(w, "tracking", boot.tracking);
+    jsonUint(w, "firstTrackMs", boot.firstTrackMs);
+    jsonString(w, "pointing", bootPointingName(boot.pointing));
+    jsonUint(w, "recordAgeS", boot.recordAgeS);
+    jsonObjectEnd(w);
+
+    jsonEnd(w);
+    return jsonOk(w) ? w.len : 0;
 }
 
-void handleStatus()
+void handleStatus(AsyncWebServerRequest *request)
 {
-    String json = "{";
-    json += "\"state\":\"";
-    switch (trackerState)
+    METRIC_SCOPE(METRIC_HTTP_STATUS);
+    char json[STATUS_JSON_MAX];
+    size_t len = buildStatusJson(json, sizeof(json));
+    if (len == 0)
     {
-    case STATE_INIT:
-        json += "INIT";
-        break;
-    case STATE_TRACKING:
-        json += "TRACKING";
-        break;
-    case STATE_SLEEP:
-        json += "SLEEP";
-        break;
+        request->send(500, "text/plain", "status too large");
+        return;
     }
-    json += "\",\"yaw\":" + String(yawAngle);
-    json += ",\"tilt\":" + String(tiltAngle);
-    json += ",\"weatherStop\":" + String(weatherSaysStop ? "true" : "false");
-
-    json += ",\"timeInitialized\":" + String(timeInitialized ? "true" : "false");
-    json += ",\"rtcAvailable\":" + String(rtcAvailable ? "true" : "false");
-    json += ",\"wifiConnected\":" + String(WiFi.status() == WL_CONNECTED ? "true" : "false");
-    json += ",\"lastNTPUpdate\":" + String(millis() - lastNTPUpdate);
+    sendJson(request, json, len);
+}
 
-    // Geo-Position
-    json += ",\"latitude\":" + String(currentLatitude, 6);
-    json += ",\"longitude\":" + String(currentLongitude, 6);
-    json += ",\"useAutoDST\":" + String(useAutoDST ? "true" : "false");
-    json += ",\"timezoneOffset\":" + String(getCurrentTimezoneOffset() / 3600.0, 1);
+// GET /status.bin[?n=N] - packed StatusSample records (st_status_bin)
+void handleStatusBin(AsyncWebServerRequest *request)
+{
+    StatusBinHeader header;
+    if (!request->hasArg("n"))
+    {
+        StatusSample sample;
+        statusSampleNow(sample);
+        statusBinHeader(header, 1);
+        AsyncResponseStream *response =
+            request->beginResponseStream(STATUS_BIN_CONTENT_TYPE, sizeof(header) + sizeof(sample));
+        response->write((const uint8_t *)&header, sizeof(header));
+        response->write((const uint8_t *)&sample, sizeof(sample));
+        request->send(response);
+        return;
+    }
 
-    if (timeInitialized)
+    String arg = request->arg("n");
+    long n = arg.toInt();
+    if (n < 1 || n >= STATUS_RING_SIZE || String(n) != arg)
     {
-        DateTime now = getCurrentTime();
-        char timeBuffer[30];
-        sprintf(timeBuffer, "%04d-%02d-%02d %02d:%02d:%02d",
-                now.year(), now.month(), now.day(),
-                now.hour(), now.minute(), now.second());
-        json += ",\"time\":\"" + String(timeBuffer) + "\"";
+        char msg[48];
+        snprintf(msg, sizeof(msg), "bad request: n = 1..%d", STATUS_RING_SIZE - 1);
+        request->send(400, "text/plain", msg);
+        return;
     }
 
-    if (timeInitialized)
+    // loop() may lap the oldest sample while we copy; start over then
+    for (int attempt = 0; attempt < 3; attempt++)
     {
-        json += ",\"sunAzimuth\":" + String(currentSunAzimuth, 1);
-        json += ",\"sunAltitude\":" + String(currentSunAltitude, 1);
+        uint16_t count;
+        uint32_t first = statusRingFirst((uint16_t)n, count);
+        statusBinHeader(header, count);
+        AsyncResponseStream *response =
+            request->beginResponseStream(STATUS_BIN_CONTENT_TYPE, sizeof(header) + count * sizeof(StatusSample));
+        response->write((const uint8_t *)&header, sizeof(header));
+        bool complete = true;
+        for (uint16_t i = 0; i < count && complete; i++)
+        {
+            StatusSample sample;
+            complete = statusRingRead(first + i, sample);
+            response->write((const uint8_t *)&sample, sizeof(sample));
+        }
+        if (complete)
+        {
+            request->send(response);
+            return;
+        }
+        delete response;
     }
+    request->send(503, "text/plain", "status ring busy");
+}
 
-    json += "}";
-    server.send(200, "application/json", json);
+// GET /resets - last RESET_LOG_ENTRIES boots and why (st_supervisor)
+void handleResets(AsyncWebServerRequest *request)
+{
+    ResetLogEntry entries[RESET_LOG_ENTRIES];
+    uint8_t n = resetLogRead(entries, RESET_LOG_ENTRIES);
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->print("{\"boots\":");
+    response->print(supervisorBootCount());
+    response->print(",\"resets\":[");
+    for (uint8_t i = 0; i < n; i++)
+    {
+        const ResetLogEntry &e = entries[i];
+        char json[128];
+        JsonWriter w;
+        jsonBegin(w, json, sizeof(json));
+        jsonUint(w, "boot", e.boot);
+        jsonString(w, "cause", resetCauseName(e.cause));
+        if (e.cause == RESET_STALL)
+        {
+            jsonString(w, "subsystem", supervisorSubsystemName(e.subsystem));
+            jsonUint(w, "stalledMs", e.stalledMs);
+            jsonUint(w, "uptimeMs", e.uptimeMs);
+        }
+        jsonEnd(w);
+        if (i > 0)
+            response->print(",");
+        response->write((const uint8_t *)json, w.len);
+    }
+    response->print("]}");
+    request->send(response);
 }
 
-void handleWeather()
+void handleWeather(AsyncWebServerRequest *request)
 {
-    if (!server.hasArg("k") || server.arg("k") != API_KEY)
+    if (!request->hasArg("k") || request->arg("k") != API_KEY)
     {
-        server.send(401, "text/plain", "unauthorized");
+        request->send(401, "text/plain", "unauthorized");
         return;
     }
 
-    if (!server.hasArg("rain"))
+    if (!request->hasArg("rain"))
     {
-        server.send(400, "text/plain", "bad request: missing rain parameter");
+        request->send(400, "text/plain", "bad request: missing rain parameter");
         return;
     }
 
-    String v = server.arg("rain");
+    String v = request->arg("rain");
     if (v == "1")
     {
         weatherSaysStop = true;
@@ -370,182 +387,193 @@ void handleWeather()
     }
     else
     {
-        server.send(400, "text/plain", "bad request: rain must be 0 or 1");
+        request->send(400, "text/plain", "bad request: rain must be 0 or 1");
         return;
     }
 
-    server.send(200, "text/plain", "ok");
+    request->send(200, "text/plain", "ok");
 }
 
-void handleHistory()
+// GET /history[?from=&to=&step=] - rows are produced in loop() (st_history_export)
+void handleHistory(AsyncWebServerRequest *request)
 {
-    if (!LittleFS.exists("/history.csv"))
+    if (historyLogCount() == 0)
     {
-        server.send(404, "text/plain", "Keine Historie verfügbar");
+        request->send(404, "text/plain", "Keine Historie verfügbar");
         return;
     }
 
-    File file = LittleFS.open("/history.csv", "r");
-    if (!file)
+    uint32_t from = 0;
+    uint32_t to = 0;
+    uint32_t step = 0;
+    if ((request->hasArg("from") && !historyParseTime(request->arg("from"), from)) ||
+        (request->hasArg("to") && !historyParseTime(request->arg("to"), to)) ||
+        (request->hasArg("step") && !historyParseStep(request->arg("step"), step)))
+    {
+        request->send(400, "text/plain", "bad request: from/to = epoch or YYYY-MM-DD[ HH:MM[:SS]], step = seconds or 15m/1h/1d");
+        return;
+    }
+    if (to > 0 && to < from)
     {
-        server.send(404, "text/plain", "No history available");
+        request->send(400, "text/plain", "bad request: to < from");
         return;
     }
 
-    server.sendHeader("Content-Disposition", "attachment; filename=tracking_history.csv");
-    server.streamFile(file, "text/csv");
-    file.close();
+    if (!historyExportStart(request, from, to, step))
+    {
+        AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "Export läuft bereits");
+        response->addHeader("Retry-After", "10");
+        request->send(response);
+    }
 }
 
-void handleWifiConfig()
+void handleWifiJson(AsyncWebServerRequest *request)
 {
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>WiFi Konfiguration</title>";
-    html += "<style>body{font-family:sans-serif;padding:20px;background:#f4f4f4;}";
-    html += "form{background:white;padding:20px;border:1px solid #ccc;max-width:500px;}";
-    html += "input{padding:8px;margin:5px 0;width:100%;box-sizing:border-box;}";
-    html += "button{padding:10px 18px;margin:10px 5px 0 0;font-size:16px;background:#2196F3;color:white;border:none;}";
-    html += ".warning{background:#fff3cd;border:1px solid #ffc107;padding:10px;margin:10px 0;border-radius:4px;}";
-    html += "</style></head><body>";
-    html += "<h2>📡 WiFi Konfiguration</h2>";
-    html += "<div class='warning'>⚠️ Nach dem Speichern wird das Gerät versuchen, sich mit dem neuen Netzwerk zu verbinden. ";
-    html += "Der Access Point (SolarTracker_AP) bleibt aktiv.</div>";
-    html += "<form action='/wifi/save' method='POST'>";
-    html += "SSID (Netzwerkname): <input type='text' name='ssid' value='";
-    html += String(staSsid);
-    html += "' maxlength='63' required><br>";
-    html += "Passwort: <input type='password' name='pass' value='";
-    html += String(staPass);
-    html += "' maxlength='63'><br>";
-    html += "<small>Lassen Sie das Passwort leer für offene Netzwerke</small><br><br>";
-    html += "<button type='submit'>💾 Speichern & Verbinden</button> ";
-    html += "<a href='/'><button type='button'>🏠 Zurück</button></a>";
-    html += "</form></body></html>";
-
-    server.send(200, "text/html", html);
+    // Worst case: every character of both fields escaped
+    Settings s;
+    settingsRead(s);
+    char json[320];
+    JsonWriter w;
+    jsonBegin(w, json, sizeof(json));
+    jsonString(w, "ssid", s.staSsid);
+    jsonString(w, "pass", s.staPass);
+    jsonEnd(w);
+    if (!jsonOk(w))
+    {
+        request->send(500, "text/plain", "wifi config too large");
+        return;
+    }
+    sendJson(request, json, w.len);
 }
 
-void handleWifiSave()
+void handleWifiSave(AsyncWebServerRequest *request)
 {
-    if (server.hasArg("ssid"))
+    if (request->hasArg("ssid"))
     {
-        String ssid = server.arg("ssid");
-        String pass = server.hasArg("pass") ? server.arg("pass") : "";
+        String ssid = request->arg("ssid");
+        String pass = request->hasArg("pass") ? request->arg("pass") : "";
 
         ssid.trim();
         pass.trim();
 
         if (ssid.length() > 0 && ssid.length() < 64)
         {
-            ssid.toCharArray(staSsid, 64);
-            pass.toCharArray(staPass, 64);
-
-            saveWifiConfig();
+            Settings v = {};
+            ssid.toCharArray(v.staSsid, 64);
+            pass.toCharArray(v.staPass, 64);
+            controlPostSettings(SETTINGS_WIFI, v);
 
             String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
             html += "<meta http-equiv='refresh' content='3;url=/'></head><body>";
             html += "<h2>✓ WiFi-Konfiguration gespeichert!</h2>";
-            html += "<p>Verbinde mit neuem Netzwerk: <b>" + String(staSsid) + "</b></p>";
+            html += "<p>Verbinde mit neuem Netzwerk: <b>" + String(v.staSsid) + "</b></p>";
             html += "<p>Bitte warten Sie einen Moment. Das Gerät startet die Verbindung neu.</p>";
             html += "<p>Weiterleitung in 3 Sekunden...</p></body></html>";
-            server.send(200, "text/html", html);
+            request->send(200, "text/html", html);
 
-            delay(1000);
-            WiFi.disconnect();
-            delay(500);
-            WiFi.begin(staSsid, staPass);
-
-            Serial.println("WiFi-Konfiguration aktualisiert. Verbinde neu...");
+            // No delay() here: it would stall every connection
+            wifiReconnectRequested = millis();
+            wifiReconnectPending = true;
         }
         else
         {
-            server.send(400, "text/plain", "SSID ungültig (muss 1-63 Zeichen sein)");
+            request->send(400, "text/plain", "SSID ungültig (muss 1-63 Zeichen sein)");
         }
     }
     else
     {
-        server.send(400, "text/plain", "Fehlende Parameter");
+        request->send(400, "text/plain", "Fehlende Parameter");
     }
 }
 
-void handleCalibrate()
+void handleCalibrateJson(AsyncWebServerRequest *request)
 {
-    int savedYaw = 90;
-    int savedTilt = 90;
+    int32_t savedYaw = 9000;
+    int32_t savedTilt = 9000;
     loadCalibrationData(savedYaw, savedTilt);
 
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>Kalibrierung</title>";
-    html += "<style>body{font-family:sans-serif;padding:20px;background:#f4f4f4;}";
-    html += ".container{background:white;padding:20px;border:1px solid #ccc;max-width:600px;}";
-    html += "button{padding:10px 18px;margin:10px 5px 0 0;font-size:16px;background:#2196F3;color:white;border:none;}";
-    html += ".start-btn{background:#4CAF50;}";
-    html += ".info-box{background:#e3f2fd;border:1px solid #2196F3;padding:15px;margin:15px 0;border-radius:4px;}";
-    html += ".warning{background:#fff3cd;border:1px solid #ffc107;padding:10px;margin:10px 0;border-radius:4px;}";
-    html += "</style></head><body>";
-    html += "<h2>⚙️ Automatische Kalibrierung</h2>";
-    html += "<div class='container'>";
-    html += "<div class='info-box'>";
-    html += "<h3>Aktuelle Kalibrierungsdaten:</h3>";
-    html += "<b>Yaw (Azimut):</b> " + String(savedYaw) + "°<br>";
-    html += "<b>Tilt (Neigung):</b> " + String(savedTilt) + "°";
-    html += "</div>";
-    html += "<div class='warning'>⚠️ Die Kalibrierung führt einen Servo-Sweep durch und kann mehrere Minuten dauern. ";
-    html += "Der Tracker sucht die Position mit maximaler Lichtausbeute und speichert diese als Startposition.</div>";
-    html += "<button class='start-btn' onclick=\"if(confirm('Kalibrierung jetzt starten?')) window.location.href='/calibrate/start'\">🚀 Kalibrierung starten</button> ";
-    html += "<a href='/'><button type='button'>🏠 Zurück</button></a>";
-    html += "</div></body></html>";
-
-    server.send(200, "text/html", html);
+    char json[64];
+    JsonWriter w;
+    jsonBegin(w, json, sizeof(json));
+    jsonFixed(w, "yaw", savedYaw, 2);
+    jsonFixed(w, "tilt", savedTilt, 2);
+    jsonEnd(w);
+    sendJson(request, json, w.len);
 }
 
-void handleCalibrateStart()
+void handleCalibrateStart(AsyncWebServerRequest *request)
 {
+    // Started by the control step; a pending command counts as running
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    ControlCommand cmd = request->arg("mode") == "grid" ? CONTROL_CMD_CALIBRATE_GRID : CONTROL_CMD_CALIBRATE_ADAPTIVE;
+    if (snap.calibration.active || !controlPost(cmd))
+    {
+        request->send(409, "text/plain", "Kalibrierung läuft bereits");
+        return;
+    }
+
     String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
-    html += "<meta http-equiv='refresh' content='5;url=/calibrate'></head><body>";
+    html += "<meta http-equiv='refresh' content='2;url=/calibrate'></head><body>";
     html += "<h2>⚙️ Kalibrierung gestartet...</h2>";
-    html += "<p>Der Tracker führt jetzt einen Sweep durch und sucht die optimale Position.</p>";
-    html += "<p>Dies kann einige Minuten dauern. Bitte warten Sie.</p>";
-    html += "<p>Automatische Weiterleitung in 5 Sekunden...</p></body></html>";
-    server.send(200, "text/html", html);
+    html += "<p>Der Tracker sucht jetzt die Position mit maximaler Lichtausbeute.</p>";
+    html += "<p>Der Fortschritt wird auf der Kalibrierungsseite angezeigt.</p></body></html>";
+    request->send(200, "text/html", html);
+}
+
+void handleCalibrateStatus(AsyncWebServerRequest *request)
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    const CalibrationStatus &cal = snap.calibration;
+
+    char json[256];
+    JsonWriter w;
+    jsonBegin(w, json, sizeof(json));
+    jsonBool(w, "active", cal.active);
+    jsonBool(w, "resumed", cal.resumed);
+    jsonString(w, "result", cal.result == CAL_RESULT_DONE        ? "done"
+                            : cal.result == CAL_RESULT_CANCELLED ? "cancelled"
+                                                                 : "none");
+    jsonString(w, "mode", cal.mode == CAL_MODE_GRID ? "grid" : "adaptive");
+    jsonUint(w, "done", cal.done);
+    jsonUint(w, "total", cal.total);
+    jsonFixed(w, "step", cal.step, 2);
+    jsonUint(w, "remainingMs", cal.remainingMs);
+    jsonFixed(w, "bestYaw", cal.bestYaw, 2);
+    jsonFixed(w, "bestTilt", cal.bestTilt, 2);
+    jsonInt(w, "bestSum", cal.bestSum);
+    jsonEnd(w);
+    sendJson(request, json, w.len);
+}
 
-    delay(100);
-    startCalibration();
+void handleCalibrateCancel(AsyncWebServerRequest *request)
+{
+    TrackerSnapshot snap;
+    snapshotRead(snap);
+    if (!snap.calibration.active || !controlPost(CONTROL_CMD_CALIBRATE_CANCEL))
+    {
+        request->send(409, "text/plain", "Keine Kalibrierung aktiv");
+        return;
+    }
+    request->send(200, "text/plain", "ok");
 }
 
-void handleDebug()
+void handleDebugJson(AsyncWebServerRequest *request)
 {
-    String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>Debug-Modus</title>";
-    html += "<style>body{font-family:sans-serif;padding:20px;background:#f4f4f4;}";
-    html += ".container{background:white;padding:20px;border:1px solid #ccc;max-width:600px;}";
-    html += "button{padding:10px 18px;margin:10px 5px 0 0;font-size:16px;background:#2196F3;color:white;border:none;}";
-    html += ".toggle-btn{background:#4CAF50;font-size:18px;padding:15px 25px;}";
-    html += ".info-box{background:#e3f2fd;border:1px solid #2196F3;padding:15px;margin:15px 0;border-radius:4px;}";
-    html += ".status{font-size:20px;font-weight:bold;margin:10px 0;}";
-    html += ".on{color:#4CAF50;} .off{color:#f44336;}";
-    html += "</style></head><body>";
-    html += "<h2>🐛 Debug-Modus</h2>";
-    html += "<div class='container'>";
-    html += "<div class='info-box'>";
-    html += "<div class='status'>Status: <span class='";
-    html += isDebugEnabled() ? "on'>AKTIVIERT ✓" : "off'>DEAKTIVIERT ✗";
-    html += "</span></div>";
-    html += "</div>";
-    html += "<p>Der Debug-Modus steuert die serielle Ausgabe über USB. Bei Deaktivierung werden keine Debug-Meldungen mehr ausgegeben.</p>";
-    html += "<button class='toggle-btn' onclick=\"window.location.href='/debug/set?enabled=";
-    html += isDebugEnabled() ? "0" : "1";
-    html += "'\">";
-    html += isDebugEnabled() ? "🔇 Debug DEAKTIVIEREN" : "🔊 Debug AKTIVIEREN";
-    html += "</button> ";
-    html += "<a href='/'><button type='button'>🏠 Zurück</button></a>";
-    html += "</div></body></html>";
-
-    server.send(200, "text/html", html);
+    char json[32];
+    JsonWriter w;
+    jsonBegin(w, json, sizeof(json));
+    jsonBool(w, "enabled", isDebugEnabled());
+    jsonEnd(w);
+    sendJson(request, json, w.len);
 }
 
-void handleDebugSet()
+void handleDebugSet(AsyncWebServerRequest *request)
 {
-    if (server.hasArg("enabled"))
+    if (request->hasArg("enabled"))
     {
-        bool enable = (server.arg("enabled") == "1");
+        bool enable = (request->arg("enabled") == "1");
         setDebugEnabled(enable);
 
         String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
@@ -554,15 +582,23 @@ void handleDebugSet()
         html += enable ? "aktiviert" : "deaktiviert";
         html += "!</h2>";
         html += "<p>Weiterleitung...</p></body></html>";
-        server.send(200, "text/html", html);
+        request->send(200, "text/html", html);
     }
     else
     {
-        server.send(400, "text/plain", "Fehlende Parameter");
+        request->send(400, "text/plain", "Fehlende Parameter");
     }
 }
 
-void handleNotFound()
+void handleNotFound(AsyncWebServerRequest *request)
 {
-    server.send(404, "text/plain", "Not Found");
+    request->send(404, "text/plain", "Not Found");
+}
+
+void webserverService()
+{
+    if (!wifiReconnectPending || millis() - wifiReconnectRequested < 1000)
+        return;
+    wifiReconnectPending = false;
+    wifiReconnect();
 }
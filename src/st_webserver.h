@@ -4,24 +4,40 @@
 #include "config.h"
 
 // Webserver Objekt
-extern WebServer server;
+extern AsyncWebServer server;
 
-// HTML Content
-extern const char INDEX_HTML[] PROGMEM;
+// Statische Seiten aus web/ (gzip, ETag, 304), siehe st_web_assets.h
+class WebAssetHandler : public AsyncWebHandler
+{
+public:
+    bool canHandle(AsyncWebServerRequest *request) override;
+    void handleRequest(AsyncWebServerRequest *request) override;
+};
+extern WebAssetHandler webAssets;
+
+// JSON-Antworten (st_json, ohne Heap); Rückgabe = Länge, 0 bei Überlauf
+#define STATUS_JSON_MAX 1280
+size_t buildStatusJson(char *buf, size_t cap);
 
 // HTTP Handler Funktionen
-void handleRoot();
-void handleStatus();
-void handleWeather();
-void handleHistory();
-void handleGeoConfig();
-void handleGeoSave();
-void handleWifiConfig();
-void handleWifiSave();
-void handleCalibrate();
-void handleCalibrateStart();
-void handleDebug();
-void handleDebugSet();
-void handleNotFound();
+void handleStatus(AsyncWebServerRequest *request);
+void handleStatusBin(AsyncWebServerRequest *request);
+void handleResets(AsyncWebServerRequest *request);
+void handleWeather(AsyncWebServerRequest *request);
+void handleHistory(AsyncWebServerRequest *request);
+void handleGeoJson(AsyncWebServerRequest *request);
+void handleGeoSave(AsyncWebServerRequest *request);
+void handleWifiJson(AsyncWebServerRequest *request);
+void handleWifiSave(AsyncWebServerRequest *request);
+void handleCalibrateJson(AsyncWebServerRequest *request);
+void handleCalibrateStart(AsyncWebServerRequest *request);
+void handleCalibrateStatus(AsyncWebServerRequest *request);
+void handleCalibrateCancel(AsyncWebServerRequest *request);
+void handleDebugJson(AsyncWebServerRequest *request);
+void handleDebugSet(AsyncWebServerRequest *request);
+void handleNotFound(AsyncWebServerRequest *request);
+
+// Aus loop(): Arbeit, die nicht in einen Handler gehört (WLAN-Neuverbindung)
+void webserverService();
 
 #endif
@@ -0,0 +1,130 @@
+#include "st_debug.h"
+#include "config.h"
+#include "st_hal.h"
+#include "st_wifi.h"
+
+static const char *const stateNames[] = {"off", "connecting", "up", "backoff"};
+
+static WifiLinkStatus status = {};
+static WifiLinkStatus published = {};
+static unsigned long attemptStart = 0;
+
+static void publish()
+{
+    halCriticalEnter();
+    published = status;
+    halCriticalExit();
+}
+
+static void enter(WifiLinkState s)
+{
+    status.state = s;
+    status.since = millis();
+    publish();
+}
+
+static void connect()
+{
+    status.attempts++;
+    attemptStart = millis();
+    Settings s;
+    settingsRead(s);
+    WiFi.begin(s.staSsid, s.staPass);
+    enter(WIFI_LINK_CONNECTING);
+}
+
+void wifiBegin()
+{
+    DEBUG_PRINTLN("Starte WLAN im AP+Station Modus...");
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.setAutoReconnect(false);
+
+    DEBUG_PRINT("Starte AP: ");
+    DEBUG_PRINTLN(AP_SSID);
+    if (WiFi.softAP(AP_SSID, AP_PASS))
+    {
+        DEBUG_PRINT("AP gestartet. IP: ");
+        DEBUG_PRINTLN(WiFi.softAPIP());
+    }
+    else
+    {
+        DEBUG_PRINTLN("AP konnte nicht gestartet werden!");
+    }
+
+    DEBUG_PRINT("Verbinde mit WLAN: ");
+    Settings s;
+    settingsRead(s);
+    DEBUG_PRINTLN(s.staSsid);
+    status = WifiLinkStatus();
+    connect();
+}
+
+void wifiService()
+{
+    unsigned long now = millis();
+    bool linked = WiFi.status() == WL_CONNECTED;
+
+    switch (status.state)
+    {
+    case WIFI_LINK_OFF:
+        break;
+    case WIFI_LINK_CONNECTING:
+        if (linked)
+        {
+            status.connects++;
+            status.failures = 0;
+            status.retryMs = 0;
+            status.connectMs = now - attemptStart;
+            enter(WIFI_LINK_UP);
+            DEBUG_PRINT("WLAN verbunden! IP: ");
+            DEBUG_PRINTLN(WiFi.localIP());
+        }
+        else if (now - attemptStart >= WIFI_CONNECT_TIMEOUT_MS)
+        {
+            // Stop the driver's attempt, begin() again after the backoff
+            WiFi.disconnect();
+            if (status.failures < 255)
+                status.failures++;
+            status.retryMs = status.failures == 1 ? WIFI_RETRY_MIN_MS
+                                                  : min(status.retryMs * 2, (uint32_t)WIFI_RETRY_MAX_MS);
+            enter(WIFI_LINK_BACKOFF);
+            DEBUG_PRINT("WLAN-Verbindung fehlgeschlagen, naechster Versuch in ");
+            DEBUG_PRINT(status.retryMs / 1000);
+            DEBUG_PRINTLN(" s");
+        }
+        break;
+    case WIFI_LINK_UP:
+        if (!linked)
+        {
+            status.drops++;
+            DEBUG_PRINTLN("WLAN-Verbindung verloren, verbinde neu...");
+            connect();
+        }
+        break;
+    case WIFI_LINK_BACKOFF:
+        if (now - status.since >= status.retryMs)
+            connect();
+        break;
+    }
+}
+
+void wifiReconnect()
+{
+    WiFi.disconnect();
+    status.failures = 0;
+    status.retryMs = 0;
+    connect();
+    Serial.println("WiFi-Konfiguration aktualisiert. Verbinde neu...");
+}
+
+void wifiRead(WifiLinkStatus &out)
+{
+    halCriticalEnter();
+    out = published;
+    halCriticalExit();
+}
+
+const char *wifiLinkStateName(WifiLinkState s)
+{
+    return s < sizeof(stateNames) / sizeof(stateNames[0]) ? stateNames[s] : "?";
+}
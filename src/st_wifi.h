@@ -0,0 +1,52 @@
+#ifndef ST_WIFI_H
+#define ST_WIFI_H
+
+#include <Arduino.h>
+
+// =====================================================
+// WLAN STATION (connect/reconnect state machine)
+// =====================================================
+// setup() used to wait up to 10 s for WL_CONNECTED, and /wifi/save
+// reconnected with a delay() in loop(). Now wifiBegin() only issues
+// WiFi.begin() and wifiService() - once per loop() pass - looks at
+// WiFi.status():
+//
+//   CONNECTING  begin() issued; UP on WL_CONNECTED, BACKOFF after
+//               WIFI_CONNECT_TIMEOUT_MS
+//   UP          link up; when it drops, CONNECTING right away
+//   BACKOFF     waits WIFI_RETRY_MIN_MS, doubled after each failed
+//               attempt up to WIFI_RETRY_MAX_MS, then CONNECTING
+//
+// The core's auto-reconnect is off, so this is the only caller of
+// WiFi.begin(). The access point is independent of it and always up.
+
+enum WifiLinkState : uint8_t
+{
+    WIFI_LINK_OFF,
+    WIFI_LINK_CONNECTING,
+    WIFI_LINK_UP,
+    WIFI_LINK_BACKOFF
+};
+
+struct WifiLinkStatus
+{
+    WifiLinkState state;
+    uint8_t failures;   // consecutive failed attempts
+    uint32_t attempts;  // WiFi.begin() calls
+    uint32_t connects;
+    uint32_t drops;     // link lost while up
+    uint32_t connectMs; // begin() .. WL_CONNECTED of the last connect
+    uint32_t retryMs;   // current backoff
+    uint32_t since;     // millis() of the last state change
+};
+
+void wifiBegin();
+// loop() only
+void wifiService();
+// New station credentials: drop the link, connect again now
+void wifiReconnect();
+// Any task (copied under the HAL critical section)
+void wifiRead(WifiLinkStatus &out);
+const char *wifiLinkStateName(WifiLinkState s);
+
+#endif
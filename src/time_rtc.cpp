@@ -1,10 +1,12 @@
 #include "st_debug.h"
 #include "time_rtc.h"
-
-// RTC und NTP Objekte
-RTC_DS3231 rtc;
-WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, "pool.ntp.org", 0, 60000);
+#include "st_hal.h"
+#include "st_ephemeris.h"
+#include "st_metrics.h"
+#include "st_servo.h"
+#include "st_ntp.h"
+#include "st_clock.h"
+#include "st_backtrack.h"
 
 // Zeit-Synchronisations-Flags
 bool timeInitialized = false;
@@ -14,14 +16,14 @@ unsigned long lastNTPUpdate = 0;
 // Sonnenpositions-Variablen
 double currentSunAzimuth = 0.0;
 double currentSunAltitude = 0.0;
-int targetYawFromSun = 90;
-int targetTiltFromSun = 90;
+int32_t targetYawFromSun = 9000;
+int32_t targetTiltFromSun = 9000;
+bool sunBacktracking = false;
 
 void initRTC()
 {
-    Wire.begin();
-    
-    if (!rtc.begin())
+    clockBegin();
+    if (!halRtcBegin())
     {
         Serial.println("DS3231 RTC nicht gefunden!");
         rtcAvailable = false;
@@ -31,15 +33,17 @@ void initRTC()
     rtcAvailable = true;
     Serial.println("DS3231 RTC gefunden!");
     
-    if (rtc.lostPower())
+    if (halRtcLostPower())
     {
         Serial.println("RTC hat Stromversorgung verloren, Zeit wird ungültig sein.");
         Serial.println("Versuche NTP-Synchronisation...");
     }
     else
     {
+        // The only plain RTC read, the software clock takes it from here
+        clockSeedFromRtc();
         timeInitialized = true;
-        DateTime now = rtc.now();
+        DateTime now = getCurrentTime();
         Serial.print("RTC-Zeit: ");
         Serial.print(now.year());
         Serial.print("-");
@@ -55,126 +59,103 @@ void initRTC()
     }
 }
 
-bool syncRTCFromNTP()
+int timezoneOffsetForUtc(uint32_t utc)
 {
-    if (WiFi.status() != WL_CONNECTED)
-    {
-        Serial.println("NTP Sync fehlgeschlagen: WiFi nicht verbunden");
-        return false;
-    }
-    
-    static bool ntpBegun = false;
-    if (!ntpBegun)
-    {
-        timeClient.begin();
-        ntpBegun = true;
-    }
-    
-    if (timeClient.update())
-    {
-        unsigned long epochTime = timeClient.getEpochTime();
-        
-        if (epochTime >= 1577836800UL)
-        {
-            int offset = getCurrentTimezoneOffset();
-            epochTime += offset;
-            
-            if (rtcAvailable)
-            {
-                rtc.adjust(DateTime(epochTime));
-                Serial.print("RTC mit NTP synchronisiert (");
-            }
-            else
-            {
-                Serial.print("Zeit via NTP synchronisiert (ohne RTC) (");
-            }
-            Serial.print(offset == 7200 ? "MESZ" : "MEZ");
-            Serial.print("): ");
-            timeInitialized = true;
-            lastNTPUpdate = millis();
-            DateTime localTime = DateTime(epochTime);
-            char buffer[25];
-            sprintf(buffer, "%04d-%02d-%02d %02d:%02d:%02d",
-                    localTime.year(), localTime.month(), localTime.day(),
-                    localTime.hour(), localTime.minute(), localTime.second());
-            Serial.println(buffer);
-            return true;
-        }
-        else
-        {
-            Serial.println("NTP Sync fehlgeschlagen: Ungueltige Epochenzeit");
-            return false;
-        }
-    }
-    
-    Serial.println("NTP Sync fehlgeschlagen: timeClient.update() fehlgeschlagen");
-    return false;
+    if (!settings.autoDst)
+        return settings.timezoneOffset;
+    DateTime standard(utc + 3600);
+    return isEUDaylightSavingTime(standard.year(), standard.month(), standard.day(), standard.hour()) ? 7200 : 3600;
 }
 
-DateTime getCurrentTime()
+int timezoneOffsetForLocal(uint32_t local)
+{
+    if (!settings.autoDst)
+        return settings.timezoneOffset;
+    DateTime t(local);
+    return isEUDaylightSavingTime(t.year(), t.month(), t.day(), t.hour()) ? 7200 : 3600;
+}
+
+void applyNtpTime(const NtpTime &t)
 {
+    clockDiscipline(CLOCK_SOURCE_NTP, t.utcUs, t.atUs, t.rttUs / 2);
     if (rtcAvailable)
     {
-        return rtc.now();
+        // Written by clockService() at the next seconds edge
+        clockWriteRtc();
+        Serial.print("RTC mit NTP synchronisiert (");
     }
-    else if (timeInitialized && WiFi.status() == WL_CONNECTED)
+    else
     {
-        timeClient.update();
-        unsigned long epochTime = timeClient.getEpochTime();
-        return DateTime((uint32_t)epochTime);
+        Serial.print("Zeit via NTP synchronisiert (ohne RTC) (");
     }
-    else
+    timeInitialized = true;
+    lastNTPUpdate = millis();
+
+    DateTime localTime = getCurrentTime();
+    Serial.print(getTimezoneOffsetAt(localTime) == 7200 ? "MESZ" : "MEZ");
+    Serial.print("): ");
+    char buffer[25];
+    sprintf(buffer, "%04d-%02d-%02d %02d:%02d:%02d",
+            localTime.year(), localTime.month(), localTime.day(),
+            localTime.hour(), localTime.minute(), localTime.second());
+    Serial.println(buffer);
+}
+
+DateTime getCurrentTime()
+{
+    // Software clock (st_clock): no I2C, no network
+    uint64_t utcUs = clockUtcUs();
+    if (utcUs == 0)
     {
         return DateTime(1970, 1, 1, 0, 0, 0);
     }
+    uint32_t utc = (uint32_t)(utcUs / 1000000ULL);
+    return DateTime(utc + timezoneOffsetForUtc(utc));
 }
 
 void updateTime()
 {
-    if (rtcAvailable && !timeInitialized)
-    {
-        if (!rtc.lostPower())
-        {
-            timeInitialized = true;
-        }
-    }
-    
-    if (WiFi.status() == WL_CONNECTED)
+    NtpTime t;
+    if (ntpService(t))
     {
-        if (!timeInitialized || (millis() - lastNTPUpdate >= NTP_UPDATE_INTERVAL))
-        {
-            syncRTCFromNTP();
-        }
+        applyNtpTime(t);
     }
+    clockService();
 }
 
 void calculateSunPosition()
 {
+    METRIC_SCOPE(METRIC_SUN_POSITION);
     if (!timeInitialized)
         return;
 
     DateTime now = getCurrentTime();
     
-    calcHorizontalCoordinates(now.year(), now.month(), now.day(),
-                               now.hour(), now.minute(), now.second(),
-                               currentLatitude, currentLongitude,
-                               currentSunAzimuth, currentSunAltitude);
-    
-    sunPositionToServoAngles(currentSunAzimuth, currentSunAltitude);
+    // Table lookup, the full SolarCalculator run happens once per day
+    ephemerisSunPosition(now.year(), now.month(), now.day(),
+                         now.hour(), now.minute(), now.second(),
+                         settings.latitude, settings.longitude,
+                         currentSunAzimuth, currentSunAltitude);
+
+    // In a row installation a low sun is not chased into the neighbour's shade
+    float aim;
+    sunBacktracking = backtrackAim(currentSunAzimuth, currentSunAltitude, aim);
+    sunPositionToServoAngles(currentSunAzimuth, aim);
 }
 
 void sunPositionToServoAngles(float azimuth, float altitude)
 {
-    targetYawFromSun = map((int)azimuth, 0, 360, 0, 180);
-    targetYawFromSun = constrain(targetYawFromSun, YAW_MIN, YAW_MAX);
-    
-    targetTiltFromSun = map((int)altitude, 0, 90, TILT_MIN, TILT_MAX);
-    targetTiltFromSun = constrain(targetTiltFromSun, TILT_MIN, TILT_MAX);
+    // Azimuth 0..360° -> yaw 0..180°, altitude 0..90° -> TILT_MIN..TILT_MAX,
+    // kept in centidegrees (no more 2° steps from the int map())
+    targetYawFromSun = clampYawCd(degToCd(azimuth * 180.0f / 360.0f));
+
+    float tilt = TILT_MIN + altitude * (TILT_MAX - TILT_MIN) / 90.0f;
+    targetTiltFromSun = clampTiltCd(degToCd(tilt));
 }
 
 bool rtcLostPower()
 {
-    return rtcAvailable && rtc.lostPower();
+    return rtcAvailable && halRtcLostPower();
 }
 
 bool isEUDaylightSavingTime(int year, int month, int day, int hour)
@@ -200,14 +181,22 @@ bool isEUDaylightSavingTime(int year, int month, int day, int hour)
 
 int getCurrentTimezoneOffset()
 {
-    if (useAutoDST && timeInitialized)
+    if (settings.autoDst && timeInitialized)
     {
-        DateTime now = getCurrentTime();
-        bool isDST = isEUDaylightSavingTime(now.year(), now.month(), now.day(), now.hour());
-        return isDST ? 7200 : 3600;
+        return getTimezoneOffsetAt(getCurrentTime());
     }
     else
     {
-        return manualTimezoneOffset;
+        return settings.timezoneOffset;
+    }
+}
+
+int getTimezoneOffsetAt(const DateTime &now)
+{
+    if (settings.autoDst && timeInitialized)
+    {
+        bool isDST = isEUDaylightSavingTime(now.year(), now.month(), now.day(), now.hour());
+        return isDST ? 7200 : 3600;
     }
+    return settings.timezoneOffset;
 }
@@ -2,11 +2,9 @@
 #define ST_TIME_RTC_H
 
 #include "config.h"
+#include "st_ntp.h"
 
-// RTC und NTP Objekte
-extern RTC_DS3231 rtc;
-extern WiFiUDP ntpUDP;
-extern NTPClient timeClient;
+// RTC liegt hinter st_hal.h, NTP in st_ntp, die Uhr selbst in st_clock
 
 // Zeit-Synchronisations-Flags
 extern bool timeInitialized;
@@ -16,18 +14,22 @@ extern unsigned long lastNTPUpdate;
 // Sonnenpositions-Variablen
 extern double currentSunAzimuth;
 extern double currentSunAltitude;
-extern int targetYawFromSun;
-extern int targetTiltFromSun;
+extern int32_t targetYawFromSun;  // centidegrees
+extern int32_t targetTiltFromSun;
+extern bool sunBacktracking;      // target tilt held back for row shading (st_backtrack)
 
 // Funktionen
 void initRTC();
-bool syncRTCFromNTP();
-DateTime getCurrentTime();
-void updateTime();
-void calculateSunPosition();
-void sunPositionToServoAngles(float azimuth, float altitude);
+void applyNtpTime(const NtpTime &t); // disciplines the clock, RTC follows
+DateTime getCurrentTime();           // local time, no I2C, no network
+void updateTime();                   // every loop() pass, never waits
+void calculateSunPosition();              // sun position, then the (backtracked) target
+void sunPositionToServoAngles(float azimuth, float altitude); // plain mapping, no backtracking
 bool rtcLostPower();
 bool isEUDaylightSavingTime(int year, int month, int day, int hour);
 int getCurrentTimezoneOffset();
+int getTimezoneOffsetAt(const DateTime &now); // no RTC read
+int timezoneOffsetForUtc(uint32_t utc);       // local - UTC, RTC convention
+int timezoneOffsetForLocal(uint32_t local);
 
 #endif
@@ -5,7 +5,24 @@ enum TrackerState
 {
     STATE_INIT,
     STATE_TRACKING,
-    STATE_SLEEP
+    STATE_SLEEP,
+    STATE_CALIBRATING
 };
 
+inline const char *trackerStateName(int state)
+{
+    switch (state)
+    {
+    case STATE_INIT:
+        return "INIT";
+    case STATE_TRACKING:
+        return "TRACKING";
+    case STATE_SLEEP:
+        return "SLEEP";
+    case STATE_CALIBRATING:
+        return "CALIBRATING";
+    }
+    return "?";
+}
+
 #endif
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Packs web/ into src/st_web_assets.cpp (gzip, strong ETags).
+
+Runs before every PlatformIO build (extra_scripts = pre:tools/web_assets.py)
+and can be run by hand: python3 tools/web_assets.py
+
+- Every file in web/ becomes one gzip-compressed PROGMEM array.
+- index.html is served at "/", other pages at "/<name>" without ".html",
+  everything else at "/<file name>".
+- Links from pages to other assets ("/style.css") get "?v=<etag>" appended,
+  so those assets can be cached for a year and still change with the
+  firmware. Pages themselves are revalidated with If-None-Match.
+- Output is deterministic (gzip mtime 0) and only rewritten when it
+  changes, so unchanged assets do not trigger a rebuild.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+CONTENT_TYPES = {
+    ".html": "text/html; charset=utf-8",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+}
+
+CACHE_PAGE = "no-cache"
+CACHE_VERSIONED = "public, max-age=31536000, immutable"
+
+
+def project_dir():
+    # Under PlatformIO the script runs inside SCons: no __file__, but env
+    try:
+        Import("env")  # noqa: F821
+        return env.subst("$PROJECT_DIR")  # noqa: F821
+    except NameError:
+        return os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def etag_of(data):
+    return '"' + hashlib.sha1(data).hexdigest()[:16] + '"'
+
+
+def uri_of(name):
+    if name == "index.html":
+        return "/"
+    if name.endswith(".html"):
+        return "/" + name[: -len(".html")]
+    return "/" + name
+
+
+def symbol_of(name):
+    return "ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i : i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def build(root):
+    web = os.path.join(root, "web")
+    names = sorted(n for n in os.listdir(web) if os.path.splitext(n)[1] in CONTENT_TYPES)
+
+    raw = {}
+    for n in names:
+        with open(os.path.join(web, n), "rb") as f:
+            raw[n] = f.read()
+
+    # Assets first, so pages can link to their versioned URIs
+    etags = {}
+    for n in names:
+        if not n.endswith(".html"):
+            etags[n] = etag_of(raw[n])
+    for n in names:
+        if n.endswith(".html"):
+            for asset, tag in etags.items():
+                link = ('"/%s"' % asset).encode()
+                versioned = ('"/%s?v=%s"' % (asset, tag.strip('"'))).encode()
+                raw[n] = raw[n].replace(link, versioned)
+            etags[n] = etag_of(raw[n])
+
+    out = []
+    out.append("// Generated by tools/web_assets.py from web/ - do not edit.")
+    out.append("// Rebuilt automatically by PlatformIO; by hand: python3 tools/web_assets.py")
+    out.append("")
+    out.append('#include "st_web_assets.h"')
+    out.append("")
+    table = []
+    for n in names:
+        gz = gzip.compress(raw[n], compresslevel=9, mtime=0)
+        sym = symbol_of(n)
+        ext = os.path.splitext(n)[1]
+        out.append("// %s: %d bytes, %d gzip" % (n, len(raw[n]), len(gz)))
+        out.append("static const uint8_t %s[] PROGMEM = {" % sym)
+        out.append(c_array(gz))
+        out.append("};")
+        out.append("")
+        cache = CACHE_PAGE if ext == ".html" else CACHE_VERSIONED
+        table.append(
+            '    {"%s", "%s", "%s", %s, sizeof(%s), %d, "%s"},'
+            % (uri_of(n), CONTENT_TYPES[ext], etags[n].replace('"', '\\"'), sym, sym, len(raw[n]), cache)
+        )
+    out.append("const WebAsset WEB_ASSETS[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    text = "\n".join(out)
+
+    target = os.path.join(root, "src", "st_web_assets.cpp")
+    try:
+        with open(target, "r") as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(target, "w") as f:
+        f.write(text)
+    print("web_assets: %s aktualisiert (%d Dateien)" % (os.path.relpath(target, root), len(names)))
+
+
+build(project_dir())